@@ -0,0 +1,90 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark script comparing the latency of the AOT executor of the C++ runtime with the graph
+executor, on small convolutions where the overhead of the executor matters, e.g.
+
+    python3 cpu_aot_executor_bench.py --sizes 8 32 --number 200
+"""
+import argparse
+import time
+
+import numpy as np
+
+import tvm
+from tvm import relay
+from tvm.contrib import aot_executor, graph_executor, utils
+from tvm.relay.backend import Executor, Runtime
+
+
+def conv_model(size, channels=8):
+    data = relay.var("data", shape=(1, 3, size, size), dtype="float32")
+    weight = relay.var("weight", shape=(channels, 3, 3, 3), dtype="float32")
+    bias = relay.var("bias", shape=(channels,), dtype="float32")
+    conv = relay.nn.conv2d(data, weight, padding=(1, 1), channels=channels, kernel_size=(3, 3))
+    out = relay.nn.relu(relay.nn.bias_add(conv, bias))
+    mod = tvm.IRModule.from_expr(relay.Function([data, weight, bias], out))
+    params = {
+        "weight": np.random.uniform(-1, 1, (channels, 3, 3, 3)).astype("float32"),
+        "bias": np.random.uniform(-1, 1, (channels,)).astype("float32"),
+    }
+    return mod, params
+
+
+def build_and_load(mod, params, executor, temp_dir):
+    with tvm.transform.PassContext(opt_level=3, config={"tir.disable_vectorize": True}):
+        factory = relay.build(
+            mod, target="c", executor=Executor(executor), runtime=Runtime("cpp"), params=params
+        )
+    path = temp_dir.relpath("%s.so" % executor)
+    factory.export_library(path)
+    return tvm.runtime.load_module(path)
+
+
+def mean_us(module, number):
+    module.run()
+    start = time.perf_counter()
+    for _ in range(number):
+        module.run()
+    return (time.perf_counter() - start) / number * 1e6
+
+
+def benchmark(size, number):
+    mod, params = conv_model(size)
+    data = np.random.uniform(-1, 1, (1, 3, size, size)).astype("float32")
+    dev = tvm.cpu(0)
+    temp_dir = utils.tempdir()
+    graph_lib = build_and_load(mod, params, "graph", temp_dir)
+    gmod = graph_executor.GraphModule(graph_lib["default"](dev))
+    amod = aot_executor.AotModule(build_and_load(mod, params, "aot", temp_dir)["default"](dev))
+    gmod.set_input("data", data)
+    amod.set_input("data", data)
+    graph_us = mean_us(gmod, number)
+    aot_us = mean_us(amod, number)
+    print(
+        "conv2d 1x3x%dx%d: %.1f us with the graph executor, %.1f us with the AOT executor"
+        % (size, size, graph_us, aot_us)
+    )
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--sizes", type=int, nargs="+", default=[8, 32])
+    parser.add_argument("--number", type=int, default=200)
+    args = parser.parse_args()
+
+    for size in args.sizes:
+        benchmark(size, args.number)
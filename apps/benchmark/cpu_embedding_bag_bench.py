@@ -0,0 +1,73 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark script for embedding_bag on the CPU, with synthetic tables much larger
+than the last level cache. Compares the generic TE implementation with the
+tvm.contrib.sparse.embedding_bag kernel for float32, float16 and int8 tables, e.g.
+
+    python3 cpu_embedding_bag_bench.py --rows 4000000 --dim 64
+"""
+import argparse
+
+import numpy as np
+
+import tvm
+from tvm import te, topi
+
+
+def build_and_time(compute, weight, indices, offsets, repeat):
+    dev = tvm.cpu(0)
+    W = te.placeholder(weight.shape, str(weight.dtype))
+    I = te.placeholder(indices.shape, str(indices.dtype))
+    O = te.placeholder(offsets.shape, str(offsets.dtype))
+    Y = compute(W, I, O, "sum", 1.0)
+    s = topi.generic.schedule_extern([Y])
+    func = tvm.build(s, [W, I, O, Y], "llvm")
+    args = [tvm.nd.array(x, dev) for x in (weight, indices, offsets)]
+    args.append(tvm.nd.empty((offsets.shape[0], weight.shape[1]), "float32", dev))
+    timer = func.time_evaluator(func.entry_name, dev, number=repeat)
+    return timer(*args).mean * 1000
+
+
+def benchmark(rows, dim, batch, pooling, dtype, repeat):
+    weight = np.random.uniform(-1, 1, (rows, dim))
+    weight = (weight * 127 if dtype == "int8" else weight).astype(dtype)
+    indices = np.random.randint(0, rows, batch * pooling).astype("int64")
+    offsets = np.arange(0, batch * pooling, pooling).astype("int64")
+
+    cases = [("generic", topi.nn.embedding_bag)]
+    if tvm.get_global_func("tvm.contrib.sparse.embedding_bag", True):
+        cases.append(("contrib", topi.x86.embedding_bag_contrib))
+    table_mb = weight.nbytes / (1 << 20)
+    for name, compute in cases:
+        cost = build_and_time(compute, weight, indices, offsets, repeat)
+        print(
+            "%-8s %-8s table=%7.1f MB batch=%-5d pooling=%-4d %10.3f ms %8.2f Mrows/s"
+            % (name, dtype, table_mb, batch, pooling, cost, batch * pooling / cost / 1000)
+        )
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--rows", type=int, default=4000000)
+    parser.add_argument("--dim", type=int, default=64)
+    parser.add_argument("--batch", type=int, default=2048)
+    parser.add_argument("--pooling", type=int, default=80)
+    parser.add_argument("--repeat", type=int, default=10)
+    args = parser.parse_args()
+
+    for dtype in ["float32", "float16", "int8"]:
+        benchmark(args.rows, args.dim, args.batch, args.pooling, dtype, args.repeat)
@@ -0,0 +1,87 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark script comparing the Relay interpreter with the VM on list processing, where
+most of the time goes to calls of small primitive functions, e.g.
+
+    python3 cpu_relay_interpreter_bench.py --length 2000
+"""
+import argparse
+import time
+
+import numpy as np
+
+import tvm
+from tvm import relay
+from tvm.relay.scope_builder import ScopeBuilder
+
+
+def list_model():
+    """Return a module whose main maps double over [n - 1, ..., 0] and sums the result."""
+    mod = tvm.IRModule()
+    relay.prelude.Prelude(mod)
+    _, cons, nil = mod.get_type("List")
+    list_map = mod.get_global_var("map")
+    foldl = mod.get_global_var("foldl")
+
+    make_list = relay.GlobalVar("make_list")
+    i = relay.var("i", shape=[], dtype="int32")
+    sb = ScopeBuilder()
+    with sb.if_scope(relay.equal(i, relay.const(0, "int32"))):
+        sb.ret(nil())
+    with sb.else_scope():
+        one_less = relay.subtract(i, relay.const(1, "int32"))
+        sb.ret(cons(one_less, relay.Call(make_list, [one_less])))
+    mod[make_list] = relay.Function([i], sb.get())
+
+    x = relay.var("x", shape=[], dtype="int32")
+    double = relay.Function([x], relay.add(x, x))
+    a = relay.var("a", shape=[], dtype="int32")
+    b = relay.var("b", shape=[], dtype="int32")
+    add = relay.Function([a, b], relay.add(a, b))
+    n = relay.var("n", shape=[], dtype="int32")
+    mod["main"] = relay.Function(
+        [n], foldl(add, relay.const(0, "int32"), list_map(double, relay.Call(make_list, [n])))
+    )
+    return mod
+
+
+def benchmark(length, repeat):
+    mod = list_model()
+    n_data = np.array(length, dtype="int32")
+    dev = tvm.cpu()
+    target = tvm.target.Target("llvm")
+    for kind, name in [("debug", "interpreter"), ("vm", "VM")]:
+        func = relay.create_executor(kind, mod=mod, device=dev, target=target).evaluate()
+        func(n_data)
+        costs = []
+        for _ in range(repeat):
+            start = time.perf_counter()
+            func(n_data)
+            costs.append(time.perf_counter() - start)
+        print(
+            "map and foldl over a list of %d with the %-11s %10.1f ms (%.1f ms)"
+            % (length, name, np.mean(costs) * 1000, np.std(costs) * 1000)
+        )
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--length", type=int, default=2000)
+    parser.add_argument("--repeat", type=int, default=5)
+    args = parser.parse_args()
+
+    benchmark(args.length, args.repeat)
@@ -0,0 +1,69 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark script for the CPU sort kernels in tvm.contrib.sort.
+Run it on two builds of TVM to compare the kernels, e.g.
+
+    TVM_NUM_THREADS=1 python3 cpu_sort_bench.py
+    python3 cpu_sort_bench.py --k 10
+"""
+import argparse
+import time
+
+import numpy as np
+
+import tvm
+
+
+def measure(func, repeat):
+    func()
+    costs = []
+    for _ in range(repeat):
+        start = time.perf_counter()
+        func()
+        costs.append(time.perf_counter() - start)
+    return np.mean(costs) * 1000, np.std(costs) * 1000
+
+
+def benchmark(shape, dtype, k, repeat):
+    dev = tvm.cpu(0)
+    np_data = np.random.uniform(-1000, 1000, size=shape).astype(dtype)
+    data = tvm.nd.array(np_data, dev)
+    indices = tvm.nd.empty(shape, "int32", dev)
+    topk_shape = shape[:-1] + (k,)
+    topk_values = tvm.nd.empty(topk_shape, dtype, dev)
+    topk_indices = tvm.nd.empty(topk_shape, "int32", dev)
+
+    argsort = tvm.get_global_func("tvm.contrib.sort.argsort")
+    topk = tvm.get_global_func("tvm.contrib.sort.topk")
+    cases = [
+        ("argsort", lambda: argsort(data, indices, -1, True)),
+        ("topk k=%d" % k, lambda: topk(data, topk_values, topk_indices, k, -1, "both", False)),
+    ]
+    for name, func in cases:
+        mean, std = measure(func, repeat)
+        print("%-12s %-20s %-8s %10.3f ms (%.3f ms)" % (name, str(shape), dtype, mean, std))
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--k", type=int, default=100)
+    parser.add_argument("--repeat", type=int, default=20)
+    args = parser.parse_args()
+
+    for shape in [(1, 100000), (32, 8192), (1000, 1000), (10000, 128)]:
+        for dtype in ["float32", "int32", "float64"]:
+            benchmark(shape, dtype, min(args.k, shape[-1]), args.repeat)
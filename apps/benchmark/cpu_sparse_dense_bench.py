@@ -0,0 +1,95 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark script for BSR sparse_dense on the CPU.
+Compares a dense matmul, the TE sparse_dense schedule and the
+tvm.contrib.sparse.bsr_dense kernel at several sparsity levels, e.g.
+
+    TVM_NUM_THREADS=1 python3 cpu_sparse_dense_bench.py
+    python3 cpu_sparse_dense_bench.py --m 1 --n 3072 --k 768
+"""
+import argparse
+import itertools
+
+import numpy as np
+import scipy.sparse as sp
+
+import tvm
+from tvm import te, topi
+
+
+def random_bsr_matrix(M, N, BS_R, BS_C, density):
+    Y = np.zeros((M, N), dtype="float32")
+    nnz = max(int(density * M * N / (BS_R * BS_C)), 1)
+    candidates = np.array(list(itertools.product(range(0, M, BS_R), range(0, N, BS_C))))
+    chosen = candidates[np.random.choice(len(candidates), size=nnz, replace=False)]
+    for r, c in chosen:
+        Y[r : r + BS_R, c : c + BS_C] = np.random.randn(BS_R, BS_C)
+    return sp.bsr_matrix(Y, blocksize=(BS_R, BS_C))
+
+
+def build_and_time(compute, schedule, inputs, out_shape, repeat):
+    target = "llvm -mcpu=native"
+    dev = tvm.cpu(0)
+    placeholders = [te.placeholder(x.shape, str(x.dtype)) for x in inputs]
+    with tvm.target.Target(target):
+        out = compute(*placeholders)
+        s = schedule([out])
+        func = tvm.build(s, placeholders + [out])
+    args = [tvm.nd.array(x, dev) for x in inputs]
+    args.append(tvm.nd.empty(out_shape, "float32", dev))
+    timer = func.time_evaluator(func.entry_name, dev, number=repeat)
+    return timer(*args).mean * 1000
+
+
+def benchmark(M, N, K, bs_r, density, repeat):
+    X = np.random.randn(M, K).astype("float32")
+    W = random_bsr_matrix(N, K, bs_r, 1, density)
+    W_dense = np.asarray(W.todense())
+    bsr = [W.data, W.indices.astype("int32"), W.indptr.astype("int32")]
+
+    cases = [
+        ("dense", topi.x86.dense_nopack, topi.x86.schedule_dense_nopack, [X, W_dense]),
+        ("sparse_dense", topi.nn.sparse_dense, topi.x86.schedule_sparse_dense, [X] + bsr),
+    ]
+    if tvm.get_global_func("tvm.contrib.sparse.bsr_dense", True):
+        cases.append(
+            (
+                "bsr_contrib",
+                topi.x86.sparse_dense_bsr_contrib,
+                topi.x86.schedule_sparse_dense_bsr_contrib,
+                [X] + bsr,
+            )
+        )
+    for name, compute, schedule, inputs in cases:
+        cost = build_and_time(compute, schedule, inputs, (M, N), repeat)
+        print(
+            "%-14s %-16s bs=%-3d density=%-5.2f %10.3f ms"
+            % (name, str((M, N, K)), bs_r, density, cost)
+        )
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--m", type=int, default=128)
+    parser.add_argument("--n", type=int, default=768)
+    parser.add_argument("--k", type=int, default=768)
+    parser.add_argument("--repeat", type=int, default=20)
+    args = parser.parse_args()
+
+    for bs_r in [1, 4, 16]:
+        for density in [0.5, 0.3, 0.2, 0.1, 0.05]:
+            benchmark(args.m, args.n, args.k, bs_r, density, args.repeat)
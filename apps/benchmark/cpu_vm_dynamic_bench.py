@@ -0,0 +1,80 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark script for the latency of the Relay VM on a model with a dynamic batch dimension,
+which allocates a handful of runtime objects per inference. It reports the mean latency and the
+runtime objects allocated from the system per inference; run it on builds of TVM with
+USE_OBJECT_POOL ON and OFF to compare, e.g.
+
+    python3 cpu_vm_dynamic_bench.py --batches 1 4 16 --number 1000
+"""
+import argparse
+import time
+
+import numpy as np
+
+import tvm
+from tvm import relay
+from tvm.runtime.vm import VirtualMachine
+
+
+def dynamic_mlp(units=64, layers=4):
+    data = relay.var("data", shape=(relay.Any(), units), dtype="float32")
+    out = data
+    params = {}
+    for i in range(layers):
+        weight = relay.var("weight%d" % i, shape=(units, units), dtype="float32")
+        out = relay.nn.relu(relay.nn.dense(out, weight))
+        params[weight.name_hint] = np.random.uniform(-1, 1, (units, units)).astype("float32")
+    mod = tvm.IRModule.from_expr(relay.Function(relay.analysis.free_vars(out), out))
+    return mod, params
+
+
+def benchmark(vm, batch, units, number):
+    thread_stats = tvm.get_global_func("runtime.ObjectPoolThreadStats")
+    data = tvm.nd.array(np.random.uniform(-1, 1, (batch, units)).astype("float32"))
+    vm.set_input("main", data)
+    vm.invoke_stateful("main")
+    reused, system_allocs = thread_stats()
+    start = time.perf_counter()
+    for _ in range(number):
+        vm.invoke_stateful("main")
+    cost = (time.perf_counter() - start) / number * 1e6
+    new_reused, new_system_allocs = thread_stats()
+    print(
+        "batch %4d: %8.1f us, %.1f objects from the pool and %.1f from the system per inference"
+        % (
+            batch,
+            cost,
+            (new_reused - reused) / number,
+            (new_system_allocs - system_allocs) / number,
+        )
+    )
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--batches", type=int, nargs="+", default=[1, 4, 16])
+    parser.add_argument("--units", type=int, default=64)
+    parser.add_argument("--number", type=int, default=1000)
+    args = parser.parse_args()
+
+    mod, params = dynamic_mlp(args.units)
+    with tvm.transform.PassContext(opt_level=3):
+        exe = relay.vm.compile(mod, target="llvm", params=params)
+    vm = VirtualMachine(exe, tvm.cpu(0))
+    for batch in args.batches:
+        benchmark(vm, batch, args.units, args.number)
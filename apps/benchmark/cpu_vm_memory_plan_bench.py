@@ -0,0 +1,84 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark script for the VM memory planning pass. It runs a model with a dynamic batch
+dimension and a static branch on the VM, compiled with and without MemoryPlan, and reports the
+buffers the allocator allocates per inference and its peak memory, e.g.
+
+    python3 cpu_vm_memory_plan_bench.py --batch 16 --layers 8
+"""
+import argparse
+import time
+
+import numpy as np
+
+import tvm
+from tvm import relay
+from tvm.runtime.vm import VirtualMachine
+
+
+def dynamic_model(units, layers):
+    data = relay.var("data", shape=(relay.Any(), units), dtype="float32")
+    state = relay.var("state", shape=(1, units), dtype="float32")
+    params = {}
+    out, bias = data, state
+    for i in range(layers):
+        weight = relay.var("weight%d" % i, shape=(units, units), dtype="float32")
+        params[weight.name_hint] = np.random.uniform(-1, 1, (units, units)).astype("float32")
+        # The static branch has constant-size allocations for MemoryPlan to coalesce and reuse.
+        bias = relay.nn.relu(relay.nn.dense(bias, weight))
+        out = relay.nn.relu(relay.nn.dense(out, weight))
+    out = relay.add(out, bias)
+    mod = tvm.IRModule.from_expr(relay.Function(relay.analysis.free_vars(out), out))
+    return mod, params
+
+
+def benchmark(name, exe, inputs, number):
+    dev = tvm.cpu(0)
+    allocator_stats = tvm.get_global_func("runtime.VMAllocatorStats")
+    # The naive allocator frees each buffer, so its peak is the memory the model needs at once.
+    vm = VirtualMachine(exe, dev, memory_cfg="naive")
+    vm.set_input("main", **inputs)
+    vm.invoke_stateful("main")
+    allocator_stats(dev.device_type, dev.device_id, True)
+    start = time.perf_counter()
+    for _ in range(number):
+        vm.invoke_stateful("main")
+    cost = (time.perf_counter() - start) / number * 1e6
+    num_allocs, peak_bytes = allocator_stats(dev.device_type, dev.device_id, True)
+    print(
+        "%-20s %8.1f us, %6.1f allocations per inference, peak %d bytes"
+        % (name, cost, num_allocs / number, peak_bytes)
+    )
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--batch", type=int, default=16)
+    parser.add_argument("--units", type=int, default=64)
+    parser.add_argument("--layers", type=int, default=8)
+    parser.add_argument("--number", type=int, default=1000)
+    args = parser.parse_args()
+
+    mod, params = dynamic_model(args.units, args.layers)
+    inputs = {
+        "data": np.random.uniform(-1, 1, (args.batch, args.units)).astype("float32"),
+        "state": np.random.uniform(-1, 1, (1, args.units)).astype("float32"),
+    }
+    for name, disabled_pass in [("with MemoryPlan", []), ("without MemoryPlan", ["MemoryPlan"])]:
+        with tvm.transform.PassContext(opt_level=3, disabled_pass=disabled_pass):
+            exe = relay.vm.compile(mod, target="llvm", params=params)
+        benchmark(name, exe, inputs, args.number)
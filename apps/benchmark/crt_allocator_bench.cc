@@ -0,0 +1,119 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file crt_allocator_bench.cc
+ * \brief Time the page and TLSF allocators of the CRT replaying the allocations of a model.
+ *
+ *  The trace is the one tests/crt/tlsf_allocator_test.cc checks the pool size with. Build the
+ *  `crtbench` target from the TVM build directory and run it:
+ *
+ *    make crtbench && ./crtbench
+ */
+#include <stdarg.h>
+#include <tvm/runtime/crt/page_allocator.h>
+#include <tvm/runtime/crt/platform.h>
+#include <tvm/runtime/crt/tlsf_allocator.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "allocation_traces.h"
+
+extern "C" {
+
+void TVMPlatformAbort(tvm_crt_error_t error_code) {
+  fprintf(stderr, "TVMPlatformAbort: %d\n", static_cast<int>(error_code));
+  exit(2);
+}
+
+void TVMLogf(const char* fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  vfprintf(stderr, fmt, args);
+  va_end(args);
+}
+}
+
+namespace {
+
+typedef tvm_crt_error_t (*CreateMemoryManager)(MemoryManagerInterface** manager, uint8_t* pool,
+                                               size_t pool_size);
+
+tvm_crt_error_t CreatePageMemoryManager(MemoryManagerInterface** manager, uint8_t* pool,
+                                        size_t pool_size) {
+  return PageMemoryManagerCreate(manager, pool, pool_size, 8 /* page_size_log2 */);
+}
+
+// Replay trace on a new memory manager made in pool, and return the time spent in the memory
+// manager in microseconds, or a negative value if an allocation fails.
+template <size_t N>
+double ReplayMicroseconds(CreateMemoryManager create, const AllocationTraceOp (&trace)[N],
+                          std::vector<uint8_t>* pool) {
+  MemoryManagerInterface* interface;
+  // The page allocator expects a zeroed pool.
+  memset(pool->data(), 0, pool->size());
+  if (create(&interface, pool->data(), pool->size()) != kTvmErrorNoError) {
+    return -1;
+  }
+  DLDevice dev = {kDLCPU, 0};
+  std::vector<void*> blocks(N);
+  auto begin = std::chrono::steady_clock::now();
+  for (const AllocationTraceOp& op : trace) {
+    if (op.op == 'a') {
+      if (interface->Allocate(interface, op.num_bytes, dev, &blocks[op.id]) != kTvmErrorNoError) {
+        return -1;
+      }
+    } else {
+      interface->Free(interface, blocks[op.id], dev);
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(end - begin).count();
+}
+
+template <size_t N>
+void Report(const char* name, CreateMemoryManager create, const AllocationTraceOp (&trace)[N],
+            std::vector<uint8_t>* pool) {
+  const int kRepeat = 20;
+  double total_us = 0;
+  for (int i = 0; i < kRepeat; i++) {
+    double us = ReplayMicroseconds(create, trace, pool);
+    if (us < 0) {
+      printf("%-8s allocation failed\n", name);
+      return;
+    }
+    total_us += us;
+  }
+  printf("%-8s %10.2f us per replay\n", name, total_us / kRepeat);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::vector<uint8_t> pool(16 * 1024 * 1024);
+  size_t num_calls = sizeof(kMobileNetV1Trace) / sizeof(kMobileNetV1Trace[0]);
+  printf("MobileNetV1 trace, %zu calls\n", num_calls);
+  Report("page", CreatePageMemoryManager, kMobileNetV1Trace, &pool);
+  Report("tlsf", TLSFMemoryManagerCreate, kMobileNetV1Trace, &pool);
+  return 0;
+}
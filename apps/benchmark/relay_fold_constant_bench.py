@@ -0,0 +1,64 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark script timing FoldConstant on a quantized network whose weight quantization and
+layout transforms are all folded. Run it on a build of TVM from before and after FoldConstant
+evaluated the folded sub-expressions in one batch to compare, e.g.
+
+    python3 relay_fold_constant_bench.py --layers 64 --repeat 5
+"""
+import argparse
+import time
+
+import numpy as np
+
+import tvm
+from tvm import relay
+
+
+def quantized_network(num_layers, channels):
+    x = relay.var("x", shape=(1, channels, 8, 8), dtype="int8")
+    y = x
+    for _ in range(num_layers):
+        w = np.random.uniform(-1, 1, (channels, channels, 3, 3)).astype("float32")
+        scale = np.float32(np.abs(w).max() / 127)
+        qw = relay.round(relay.const(w) / relay.const(scale))
+        qw = relay.cast(relay.clip(qw, -127, 127), "int8")
+        qw = relay.layout_transform(qw, "OIHW", "HWIO")
+        y = relay.nn.conv2d(y, qw, padding=(1, 1), kernel_layout="HWIO", out_dtype="int32")
+        y = relay.cast(relay.clip(relay.right_shift(y, relay.const(8)), -127, 127), "int8")
+    mod = tvm.IRModule.from_expr(relay.Function([x], y))
+    return relay.transform.InferType()(mod)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--layers", type=int, default=64)
+    parser.add_argument("--channels", type=int, default=16)
+    parser.add_argument("--repeat", type=int, default=5)
+    args = parser.parse_args()
+
+    np.random.seed(0)
+    mod = quantized_network(args.layers, args.channels)
+    costs = []
+    for _ in range(args.repeat):
+        start = time.perf_counter()
+        relay.transform.FoldConstant()(mod)
+        costs.append(time.perf_counter() - start)
+    print(
+        "FoldConstant on %d int8 layers: %.3f s (%.3f s)"
+        % (args.layers, np.mean(costs), np.std(costs))
+    )
@@ -0,0 +1,108 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file runtime_batching_server_bench.cc
+ * \brief Measure the throughput and latency of the VM batching server under synthetic load.
+ *
+ *  Client threads submit single-row requests to a stand-in model whose run time has a fixed
+ *  part per call and a part per row, without batching and with batches of up to one request per
+ *  client. Build the `runtime_batching_server_bench` target from the TVM build directory:
+ *
+ *    make runtime_batching_server_bench && ./runtime_batching_server_bench [clients] [requests]
+ */
+#include <tvm/runtime/container/adt.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/packed_func.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "../../src/runtime/vm/batching_server.h"
+
+using namespace tvm::runtime;
+using namespace tvm::runtime::vm;
+
+namespace {
+
+constexpr DLDevice kCPU{kDLCPU, 0};
+constexpr int64_t kWidth = 4;
+
+// Stands in for a model with a dynamic batch axis, which returns twice its input.
+PackedFunc Model(std::chrono::microseconds per_call, std::chrono::microseconds per_row) {
+  return PackedFunc([=](TVMArgs args, TVMRetValue* rv) {
+    NDArray x = args[0];
+    int64_t rows = x->shape[0];
+    std::this_thread::sleep_for(per_call + per_row * rows);
+    NDArray doubled = NDArray::Empty({rows, kWidth}, x->dtype, kCPU);
+    const float* in = static_cast<const float*>(x->data);
+    float* out = static_cast<float*>(doubled->data);
+    for (int64_t i = 0; i < rows * kWidth; ++i) {
+      out[i] = 2 * in[i];
+    }
+    *rv = doubled;
+  });
+}
+
+void Run(int num_clients, int num_requests, int64_t max_batch_size) {
+  const auto per_call = std::chrono::microseconds(500);
+  const auto per_row = std::chrono::microseconds(20);
+  auto server = make_object<BatchingServer>(Model(per_call, per_row),
+                                            BatchingConfig{max_batch_size, 200});
+  std::atomic<int64_t> latency_us{0};
+  auto begin = std::chrono::steady_clock::now();
+  std::vector<std::thread> clients;
+  for (int c = 0; c < num_clients; ++c) {
+    clients.emplace_back([&, c] {
+      NDArray input = NDArray::Empty({1, kWidth}, {kDLFloat, 32, 1}, kCPU);
+      std::fill_n(static_cast<float*>(input->data), kWidth, static_cast<float>(c));
+      for (int r = 0; r < num_requests; ++r) {
+        auto sent = std::chrono::steady_clock::now();
+        server->Submit({input}).get();
+        latency_us += std::chrono::duration_cast<std::chrono::microseconds>(
+                          std::chrono::steady_clock::now() - sent)
+                          .count();
+      }
+    });
+  }
+  for (std::thread& client : clients) {
+    client.join();
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+  int total = num_clients * num_requests;
+  printf("max batch %3ld: %10.1f requests/s %10.1f us mean latency %6ld batches\n",
+         static_cast<long>(max_batch_size), total / seconds,
+         static_cast<double>(latency_us.load()) / total, static_cast<long>(server->NumBatches()));
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int num_clients = argc > 1 ? atoi(argv[1]) : 16;
+  int num_requests = argc > 2 ? atoi(argv[2]) : 40;
+  printf("%d clients, %d requests each\n", num_clients, num_requests);
+  Run(num_clients, num_requests, 1);
+  Run(num_clients, num_requests, num_clients);
+  return 0;
+}
@@ -0,0 +1,110 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+/*!
+ * \file runtime_numa_replicas_bench.cc
+ * \brief Compare serving a memory-bound workload with one thread pool over all CPUs and with one
+ *  replica per NUMA node, each with its own memory.
+ *
+ *  Build the `runtime_numa_replicas_bench` target from the TVM build directory and run it with the
+ *  number of requests. Set TVM_NUMA_SYSFS_ROOT to simulate a topology on a machine with one node:
+ *
+ *    make runtime_numa_replicas_bench && ./runtime_numa_replicas_bench [num_requests]
+ */
+#include <tvm/runtime/c_backend_api.h>
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/threading_backend.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace tvm::runtime;
+
+namespace {
+
+constexpr size_t kSize = 8 << 20;
+
+// Sum the floats of an array in parallel on the thread pool of the calling thread.
+float ParallelSum(const float* data, size_t size) {
+  struct Job {
+    const float* data;
+    size_t size;
+    std::atomic<float> sum{0.0f};
+  } job;
+  job.data = data;
+  job.size = size;
+  TVMBackendParallelLaunch(
+      [](int task_id, TVMParallelGroupEnv* penv, void* cdata) -> int {
+        Job* job = static_cast<Job*>(cdata);
+        size_t chunk = (job->size + penv->num_task - 1) / penv->num_task;
+        size_t end = std::min(job->size, (task_id + 1) * chunk);
+        float sum = 0.0f;
+        for (size_t i = task_id * chunk; i < end; ++i) {
+          sum += job->data[i];
+        }
+        float expected = job->sum.load();
+        while (!job->sum.compare_exchange_weak(expected, expected + sum)) {
+        }
+        return 0;
+      },
+      &job, 0);
+  return job.sum.load();
+}
+
+// Serve requests on the memory of the calling thread, counting the wrong sums.
+void Serve(int num_requests, std::atomic<int>* num_wrong) {
+  DLDevice cpu{kDLCPU, 0};
+  DLDataType float32{kDLFloat, 32, 1};
+  DeviceAPI* api = DeviceAPI::Get(cpu);
+  float* data = static_cast<float*>(api->AllocDataSpace(cpu, kSize * sizeof(float), 64, float32));
+  std::fill_n(data, kSize, 1.0f);
+  for (int r = 0; r < num_requests; ++r) {
+    if (ParallelSum(data, kSize) != static_cast<float>(kSize)) ++*num_wrong;
+  }
+  api->FreeDataSpace(cpu, data);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int num_requests = argc > 1 ? atoi(argv[1]) : 32;
+  int num_nodes = static_cast<int>(threading::NUMATopology().size());
+  std::atomic<int> num_wrong{0};
+
+  auto begin = std::chrono::steady_clock::now();
+  Serve(num_requests, &num_wrong);
+  auto mid = std::chrono::steady_clock::now();
+  threading::RunPerNUMANode(
+      [&](int node) { Serve((num_requests + num_nodes - 1) / num_nodes, &num_wrong); });
+  auto end = std::chrono::steady_clock::now();
+  if (num_wrong.load() != 0) {
+    fprintf(stderr, "%d requests computed a wrong sum\n", num_wrong.load());
+    return 1;
+  }
+
+  printf("%d requests on %d NUMA nodes: %.2f ms with one thread pool, %.2f ms with a replica "
+         "per node\n",
+         num_requests, num_nodes, std::chrono::duration<double, std::milli>(mid - begin).count(),
+         std::chrono::duration<double, std::milli>(end - mid).count());
+  return 0;
+}
@@ -0,0 +1,87 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file runtime_registry_bench.cc
+ * \brief Measure the lookup throughput of Registry::Get as the number of threads grows.
+ *
+ *  Build the `runtime_registry_bench` target from the TVM build directory:
+ *
+ *    make runtime_registry_bench && ./runtime_registry_bench [max_threads]
+ */
+#include <tvm/runtime/packed_func.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tvm::runtime;
+
+namespace {
+
+std::string BenchFuncName(int i) { return "testing.registry_bench." + std::to_string(i); }
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  constexpr int kNumFuncs = 1000;
+  constexpr int kNumLookups = 200000;
+  unsigned max_threads = argc > 1 ? static_cast<unsigned>(atoi(argv[1]))
+                                  : std::max(4u, std::thread::hardware_concurrency());
+  std::vector<std::string> names;
+  for (int i = 0; i < kNumFuncs; ++i) {
+    names.push_back(BenchFuncName(i));
+    Registry::Register(names.back()).set_body_typed([i]() { return i; });
+  }
+
+  for (unsigned num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+    std::atomic<int> num_missing{0};
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&, t]() {
+        for (int k = 0; k < kNumLookups; ++k) {
+          if (Registry::Get(names[(k + t * 13) % kNumFuncs]) == nullptr) num_missing++;
+        }
+      });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+    double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    if (num_missing.load() != 0) {
+      fprintf(stderr, "%d lookups failed\n", num_missing.load());
+      return 1;
+    }
+    printf("%3u threads: %8.2f M lookups/s\n", num_threads,
+           num_threads * kNumLookups / seconds / 1e6);
+  }
+
+  for (const std::string& name : names) {
+    Registry::Remove(name);
+  }
+  return 0;
+}
@@ -105,6 +105,9 @@ set(USE_GRAPH_EXECUTOR ON)
 # Whether enable tiny graph executor with CUDA Graph
 set(USE_GRAPH_EXECUTOR_CUDA_GRAPH OFF)
 
+# Whether enable the AOT executor, which runs models built with the AOT executor on the host.
+set(USE_AOT_EXECUTOR ON)
+
 # Whether enable pipeline executor.
 set(USE_PIPELINE_EXECUTOR OFF)
 
@@ -201,6 +204,9 @@ set(USE_ROCBLAS OFF)
 # Whether use contrib sort
 set(USE_SORT ON)
 
+# Whether use contrib sparse kernels
+set(USE_SPARSE ON)
+
 # Whether use MKL-DNN (DNNL) codegen
 set(USE_DNNL_CODEGEN OFF)
 
@@ -282,6 +288,10 @@ set(USE_PT_TVMDSOOP OFF)
 # Whether to use STL's std::unordered_map or TVM's POD compatible Map
 set(USE_FALLBACK_STL_MAP OFF)
 
+# Whether to reuse the memory of hot runtime objects (NDArray containers, shape tuples,
+# ADTs and VM closures) through thread-local pools instead of calling new/delete each time
+set(USE_OBJECT_POOL ON)
+
 # Whether to use hexagon device
 set(USE_HEXAGON_DEVICE OFF)
 set(USE_HEXAGON_SDK /path/to/sdk)
@@ -62,6 +62,7 @@ function(add_lib_info src_file)
     TVM_INFO_USE_TF_TVMDSOOP="${USE_TF_TVMDSOOP}"
     TVM_INFO_USE_PT_TVMDSOOP="${USE_PT_TVMDSOOP}"
     TVM_INFO_USE_FALLBACK_STL_MAP="${USE_FALLBACK_STL_MAP}"
+    TVM_INFO_USE_OBJECT_POOL="${USE_OBJECT_POOL}"
     TVM_INFO_USE_BYODT_POSIT="${USE_BYODT_POSIT}"
     TVM_INFO_USE_BLAS="${USE_BLAS}"
     TVM_INFO_USE_MKL="${USE_MKL}"
@@ -75,6 +76,7 @@ function(add_lib_info src_file)
     TVM_INFO_USE_SORT="${USE_SORT}"
     TVM_INFO_USE_NNPACK="${USE_NNPACK}"
     TVM_INFO_USE_RANDOM="${USE_RANDOM}"
+    TVM_INFO_USE_SPARSE="${USE_SPARSE}"
     TVM_INFO_USE_MICRO_STANDALONE_RUNTIME="${USE_MICRO_STANDALONE_RUNTIME}"
     TVM_INFO_USE_CPP_RPC="${USE_CPP_RPC}"
     TVM_INFO_USE_TFLITE="${USE_TFLITE}"
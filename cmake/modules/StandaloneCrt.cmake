@@ -133,6 +133,20 @@ if(USE_MICRO)
       gtest_discover_tests(crttest)
     endif()
 
+    # Create the `crtbench` target, which times the CRT memory allocators.
+    add_executable(crtbench ${CMAKE_SOURCE_DIR}/apps/benchmark/crt_allocator_bench.cc)
+    target_include_directories(crtbench SYSTEM PUBLIC ${CMAKE_CURRENT_BINARY_DIR}/standalone_crt/include ${CMAKE_SOURCE_DIR}/src/runtime/micro ${CMAKE_SOURCE_DIR}/tests/crt)
+    target_link_libraries(crtbench PRIVATE host_standalone_crt_memory)
+    set_target_properties(crtbench PROPERTIES EXCLUDE_FROM_ALL 1)
+    set_target_properties(crtbench PROPERTIES EXCLUDE_FROM_DEFAULT_BUILD 1)
+
+    # Create the `crtsessionbench` target, which measures the throughput of the RPC session.
+    add_executable(crtsessionbench ${CMAKE_SOURCE_DIR}/apps/benchmark/crt_session_bench.cc)
+    target_include_directories(crtsessionbench SYSTEM PUBLIC ${CMAKE_CURRENT_BINARY_DIR}/standalone_crt/include ${CMAKE_SOURCE_DIR}/src/runtime/micro)
+    target_link_libraries(crtsessionbench PRIVATE host_standalone_crt_microtvm_rpc_common)
+    set_target_properties(crtsessionbench PROPERTIES EXCLUDE_FROM_ALL 1)
+    set_target_properties(crtsessionbench PROPERTIES EXCLUDE_FROM_DEFAULT_BUILD 1)
+
   endfunction()
 
   tvm_crt_define_targets()
@@ -1574,6 +1574,19 @@ struct NLLLossAttrs : public tvm::AttrsNode<NLLLossAttrs> {
   }
 };  // struct NLLLossAttrs
 
+/*! \brief Attributes used in embedding_bag operator */
+struct EmbeddingBagAttrs : public tvm::AttrsNode<EmbeddingBagAttrs> {
+  std::string mode;
+  double scale;
+
+  TVM_DECLARE_ATTRS(EmbeddingBagAttrs, "relay.attrs.EmbeddingBagAttrs") {
+    TVM_ATTR_FIELD(mode).set_default("sum").describe(
+        "How the rows of a bag are pooled. Can be 'sum' or 'mean'.");
+    TVM_ATTR_FIELD(scale).set_default(1.0).describe(
+        "Factor applied to the pooled rows, e.g. the dequantization scale of an int8 table.");
+  }
+};  // struct EmbeddingBagAttrs
+
 }  // namespace relay
 }  // namespace tvm
 #endif  // TVM_RELAY_ATTRS_NN_H_
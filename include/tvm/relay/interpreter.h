@@ -161,7 +161,9 @@ class ConstructorValue : public ObjectRef {
  * with properties given by \p target. All other Relay constructs are interpreted.
  *
  * The interpreter is intended to be a 'reference' implementation of the Relay semantics
- * for testing and interactive use. It is not intended to be particularly efficient.
+ * for testing and interactive use. Relay functions are compiled to closures with their
+ * variables resolved to frame slots on their first call, so loops and recursion over ADTs
+ * do not re-traverse the Relay IR.
  *
  * \param mod A module containing definitions which can be referenced from
  * \p expr. May be empty or undefined.
@@ -42,6 +42,7 @@ class ADTObj : public Object, public InplaceArrayBase<ADTObj, ObjectRef> {
   // The fields of the structure follows directly in memory.
 
   static constexpr const uint32_t _type_index = TypeIndex::kRuntimeADT;
+  static constexpr bool _type_use_object_pool = true;
   static constexpr const char* _type_key = "runtime.ADT";
   TVM_DECLARE_FINAL_OBJECT_INFO(ADTObj, Object);
 
@@ -43,6 +43,7 @@ class ShapeTupleObj : public Object {
   uint64_t size;
 
   static constexpr const uint32_t _type_index = runtime::TypeIndex::kRuntimeShapeTuple;
+  static constexpr bool _type_use_object_pool = true;
   static constexpr const char* _type_key = "runtime.ShapeTuple";
   TVM_DECLARE_FINAL_OBJECT_INFO(ShapeTupleObj, Object);
 
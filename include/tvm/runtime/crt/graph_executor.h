@@ -69,6 +69,74 @@ typedef struct TVMGraphExecutor TVMGraphExecutor;
 int TVMGraphExecutor_Create(const char* sym_json, TVMModuleHandle module_handle,
                             const DLDevice* devices, TVMGraphExecutor** executor);
 
+/*!
+ * \brief Allocate a new GraphExecutor with TVMPlatformMemoryAllocate and initialize it from a
+ *  binary graph made by tvm.micro.graph_binary. The graph is used in place and must outlive
+ *  the executor; it is not parsed and its tables are not copied.
+ *
+ * \param graph_binary The binary graph, 8-byte aligned.
+ * \param graph_binary_size Size of graph_binary in bytes.
+ * \param module_handle TVM Module that exposes the functions to call.
+ * \param devices runtime execution device.
+ * \param executor Pointer which receives a pointer to the newly-created instance.
+ * \return 0 if successful.
+ */
+int TVMGraphExecutor_CreateFromBinary(const void* graph_binary, size_t graph_binary_size,
+                                      TVMModuleHandle module_handle, const DLDevice* devices,
+                                      TVMGraphExecutor** executor);
+
+/*! \brief Alignment of a graph executor arena and of every block allocated from it. */
+#define TVM_GRAPH_EXECUTOR_ARENA_ALIGNMENT 16
+
+/*! \brief Bytes of an arena used by each part of a graph executor, see
+ *  TVMGraphExecutor_GetArenaFootprint. */
+typedef struct TVMGraphExecutorArenaFootprint {
+  /*! \brief The executor and its storage pool table. */
+  size_t executor;
+  /*! \brief The tensors of the node entries and their shapes. */
+  size_t tensors;
+  /*! \brief The operator table, which holds the argument arrays of every operator. */
+  size_t op_execs;
+  /*! \brief The intermediate storage of the graph. */
+  size_t storage;
+  /*! \brief The size of the arena, the sum of the above. */
+  size_t total;
+} TVMGraphExecutorArenaFootprint;
+
+/*!
+ * \brief Compute the exact arena needed by TVMGraphExecutor_CreateInArena for a binary graph.
+ *
+ * \param graph_binary The binary graph, 8-byte aligned.
+ * \param graph_binary_size Size of graph_binary in bytes.
+ * \param footprint Receives the size of the arena and of its parts.
+ * \return 0 if successful.
+ */
+int TVMGraphExecutor_GetArenaFootprint(const void* graph_binary, size_t graph_binary_size,
+                                       TVMGraphExecutorArenaFootprint* footprint);
+
+/*!
+ * \brief Create a GraphExecutor from a binary graph inside a caller-supplied arena.
+ *
+ *  The executor, its tables and the graph storage are all placed in the arena, so neither this
+ *  function nor TVMGraphExecutor_Run call TVMPlatformMemoryAllocate or TVMPlatformMemoryFree.
+ *  TVMGraphExecutor_Release of such an executor frees nothing; the arena is reusable afterwards.
+ *  Storage of linked parameters is not taken from the arena, so the footprint is then an upper
+ *  bound. TVMGraphExecutor_LoadParams still allocates a temporary tensor per parameter.
+ *
+ * \param graph_binary The binary graph, 8-byte aligned. It must outlive the executor.
+ * \param graph_binary_size Size of graph_binary in bytes.
+ * \param module_handle TVM Module that exposes the functions to call.
+ * \param devices runtime execution device.
+ * \param arena The arena, aligned to TVM_GRAPH_EXECUTOR_ARENA_ALIGNMENT bytes.
+ * \param arena_size Size of arena in bytes, at least the total of
+ *  TVMGraphExecutor_GetArenaFootprint.
+ * \param executor Pointer which receives a pointer to the newly-created instance.
+ * \return 0 if successful.
+ */
+int TVMGraphExecutor_CreateInArena(const void* graph_binary, size_t graph_binary_size,
+                                   TVMModuleHandle module_handle, const DLDevice* devices,
+                                   void* arena, size_t arena_size, TVMGraphExecutor** executor);
+
 int TVMGraphExecutor_GetInputIndex(TVMGraphExecutor* executor, const char* name);
 
 /*!
@@ -250,6 +250,16 @@ class Framer {
   tvm_crt_error_t WriteAndCrc(const uint8_t* data, size_t data_size_bytes, bool escape,
                               bool update_crc);
 
+  /*!
+   * \brief Write already-escaped data to wire, and update crc_ if requested.
+   *
+   * \param data Escaped data to write.
+   * \param data_size_bytes Number of valid bytes in data.
+   * \param update_crc true if crc_ should be updated with data.
+   * \return kTvmErrorNoError on success, negative value on error.
+   */
+  tvm_crt_error_t WriteChunk(const uint8_t* data, size_t data_size_bytes, bool update_crc);
+
   /*! \brief Called to write framed data to the transport. */
   WriteStream* stream_;
 
@@ -0,0 +1,58 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file tvm/runtime/crt/tlsf_allocator.h
+ * \brief A two-level segregated fit (TLSF) memory allocator for microcontrollers.
+ *
+ * Allocate and Free run in constant time: free blocks are kept in lists segregated by size class,
+ * and a two-level bitmap finds a non-empty class with a couple of bit scans. Adjacent free blocks
+ * are merged on Free, and a request is served from a class whose smallest block is at least the
+ * request, so the memory lost to rounding is below 1/16 of the request.
+ */
+
+#ifndef TVM_RUNTIME_CRT_TLSF_ALLOCATOR_H_
+#define TVM_RUNTIME_CRT_TLSF_ALLOCATOR_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <tvm/runtime/crt/error_codes.h>
+#include <tvm/runtime/crt/page_allocator.h>
+
+/*!
+ * \brief Create a TLSF memory manager, a drop-in replacement for the page allocator.
+ *
+ * The manager state is placed at the start of memory_pool; the rest is given out to callers.
+ *
+ * \param manager Pointer, initialized with the new MemoryManagerInterface.
+ * \param memory_pool Pointer to the global memory pool used by the CRT.
+ * \param memory_pool_size_bytes Size of `memory_pool`, in bytes.
+ * \return kTvmErrorNoError on success, kTvmErrorPlatformNoMemory if the pool is too small.
+ */
+tvm_crt_error_t TLSFMemoryManagerCreate(MemoryManagerInterface** manager, uint8_t* memory_pool,
+                                        size_t memory_pool_size_bytes);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // TVM_RUNTIME_CRT_TLSF_ALLOCATOR_H_
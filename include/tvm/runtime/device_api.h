@@ -279,6 +279,26 @@ inline const char* DeviceName(int type) {
  */
 inline bool IsRPCSessionDevice(Device dev) { return (dev.device_type / kRPCSessMask) > 0; }
 
+/*!
+ * \brief Return true if the data pointer of a Device can be moved to an offset in its buffer.
+ *  Views and the tensors of a planned storage region on such devices then keep a zero
+ *  byte_offset, as kernels expect. The data of other devices is an opaque handle, and the
+ *  offset stays in byte_offset.
+ */
+inline bool SupportsDataPointerOffset(Device dev) {
+  switch (dev.device_type) {
+    case kDLCPU:
+    case kDLCUDA:
+    case kDLCUDAHost:
+    case kDLCUDAManaged:
+    case kDLROCM:
+    case kDLROCMHost:
+      return true;
+    default:
+      return false;
+  }
+}
+
 /*!
  * \brief Return the RPCSessTable index of the RPC Session that owns this device.
  * \return the table index.
@@ -25,7 +25,10 @@
 
 #include <tvm/runtime/object.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <new>
 #include <type_traits>
 #include <utility>
 
@@ -45,10 +48,12 @@ inline ObjectPtr<T> make_object(Args&&... args);
 // The current design allows swapping the
 // allocator pattern when necessary.
 //
+// Objects whose type sets _type_use_object_pool are allocated by
+// PooledObjAllocator, which keeps thread-local pools of freed blocks,
+// one pool per size class. Other objects use SimpleObjAllocator.
+//
 // Possible future allocator optimizations:
 // - Arena allocator that gives ownership of memory to arena (deleter_= nullptr)
-// - Thread-local object pools: one pool per size and alignment requirement.
-// - Can specialize by type of object to give the specific allocator to each object.
 
 /*!
  * \brief Base class of object allocators that implements make.
@@ -191,15 +196,142 @@ class SimpleObjAllocator : public ObjAllocatorBase<SimpleObjAllocator> {
   };
 };
 
+/*!
+ * \brief Thread-caching pool of memory blocks for small objects.
+ *
+ *  Blocks are grouped in size classes of kSizeClassBytes. Each thread keeps a free list
+ *  per size class, so a freed block is reused by the next allocation of the same size class
+ *  on the same thread without locking. Blocks larger than kMaxBlockBytes, and blocks freed
+ *  once a thread has cached kMaxCachedBlocks of a size class, go to the system allocator.
+ *
+ *  When TVM is built with USE_OBJECT_POOL=OFF, the pool forwards every request to the
+ *  system allocator.
+ */
+class ObjectPool {
+ public:
+  /*! \brief The granularity of the size classes. */
+  static constexpr size_t kSizeClassBytes = 16;
+  /*! \brief The largest block served from the pool. */
+  static constexpr size_t kMaxBlockBytes = 512;
+  /*! \brief The maximum number of free blocks a thread caches per size class. */
+  static constexpr uint32_t kMaxCachedBlocks = 256;
+
+  /*! \brief Allocation statistics of the calling thread. */
+  struct Stats {
+    /*! \brief The number of allocations served by a cached block. */
+    uint64_t num_reused;
+    /*! \brief The number of allocations served by the system allocator. */
+    uint64_t num_system_allocs;
+  };
+
+  /*!
+   * \brief Allocate a block aligned to alignof(std::max_align_t).
+   * \param size The size of the block in bytes.
+   * \return The block.
+   */
+  TVM_DLL static void* Allocate(size_t size);
+  /*!
+   * \brief Release a block returned by Allocate.
+   * \param ptr The block.
+   * \param size The size passed to Allocate.
+   */
+  TVM_DLL static void Free(void* ptr, size_t size);
+  /*! \return The allocation statistics of the calling thread. */
+  TVM_DLL static Stats ThreadStats();
+};
+
+// Allocator that recycles object memory through ObjectPool.
+class PooledObjAllocator : public ObjAllocatorBase<PooledObjAllocator> {
+ public:
+  /*!
+   * \brief Create an object in pooled memory without setting its deleter.
+   *  This is used by objects that install their own deleter, which must release
+   *  the object with Delete.
+   * \tparam T The type to be allocated.
+   * \param args The arguments to the constructor.
+   * \return The object.
+   */
+  template <typename T, typename... Args>
+  static T* New(Args&&... args) {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "object alignment constraint");
+    void* data = ObjectPool::Allocate(sizeof(T));
+    return new (data) T(std::forward<Args>(args)...);
+  }
+
+  /*!
+   * \brief Destroy an object created by New and return its memory to the pool.
+   * \param ptr The object.
+   */
+  template <typename T>
+  static void Delete(T* ptr) {
+    // Call the destructor of T explicitly, see SimpleObjAllocator::Handler.
+    ptr->T::~T();
+    ObjectPool::Free(ptr, sizeof(T));
+  }
+
+  template <typename T>
+  class Handler {
+   public:
+    template <typename... Args>
+    static T* New(PooledObjAllocator*, Args&&... args) {
+      return PooledObjAllocator::New<T>(std::forward<Args>(args)...);
+    }
+
+    static Object::FDeleter Deleter() { return Deleter_; }
+
+   private:
+    static void Deleter_(Object* objptr) { PooledObjAllocator::Delete(static_cast<T*>(objptr)); }
+  };
+
+  // Array handler that prefixes the array with its allocation size,
+  // which the deleter needs to find the size class.
+  template <typename ArrayType, typename ElemType>
+  class ArrayHandler {
+   public:
+    static constexpr size_t kPrefixBytes = alignof(std::max_align_t);
+    static_assert(kPrefixBytes >= sizeof(size_t) && alignof(ArrayType) <= kPrefixBytes,
+                  "array alignment constraint");
+    static_assert(alignof(ArrayType) % alignof(ElemType) == 0 &&
+                      sizeof(ArrayType) % alignof(ElemType) == 0,
+                  "element alignment constraint");
+
+    template <typename... Args>
+    static ArrayType* New(PooledObjAllocator*, size_t num_elems, Args&&... args) {
+      size_t size = kPrefixBytes + sizeof(ArrayType) + num_elems * sizeof(ElemType);
+      char* data = static_cast<char*>(ObjectPool::Allocate(size));
+      *reinterpret_cast<size_t*>(data) = size;
+      return new (data + kPrefixBytes) ArrayType(std::forward<Args>(args)...);
+    }
+
+    static Object::FDeleter Deleter() { return Deleter_; }
+
+   private:
+    static void Deleter_(Object* objptr) {
+      ArrayType* tptr = static_cast<ArrayType*>(objptr);
+      tptr->ArrayType::~ArrayType();
+      char* data = reinterpret_cast<char*>(tptr) - kPrefixBytes;
+      ObjectPool::Free(data, *reinterpret_cast<size_t*>(data));
+    }
+  };
+};
+
+/*!
+ * \brief The allocator of objects of type T, selected by T::_type_use_object_pool.
+ * \tparam T The object type.
+ */
+template <typename T>
+using ObjAllocatorFor = typename std::conditional<T::_type_use_object_pool, PooledObjAllocator,
+                                                  SimpleObjAllocator>::type;
+
 template <typename T, typename... Args>
 inline ObjectPtr<T> make_object(Args&&... args) {
-  return SimpleObjAllocator().make_object<T>(std::forward<Args>(args)...);
+  return ObjAllocatorFor<T>().template make_object<T>(std::forward<Args>(args)...);
 }
 
 template <typename ArrayType, typename ElemType, typename... Args>
 inline ObjectPtr<ArrayType> make_inplace_array_object(size_t num_elems, Args&&... args) {
-  return SimpleObjAllocator().make_inplace_array<ArrayType, ElemType>(num_elems,
-                                                                      std::forward<Args>(args)...);
+  return ObjAllocatorFor<ArrayType>().template make_inplace_array<ArrayType, ElemType>(
+      num_elems, std::forward<Args>(args)...);
 }
 
 }  // namespace runtime
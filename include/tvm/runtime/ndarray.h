@@ -99,6 +99,14 @@ class NDArray : public ObjectRef {
    * \note The copy always triggers a TVMSynchronize.
    */
   TVM_DLL void CopyFromBytes(const void* data, size_t nbytes);
+  /*!
+   * \brief Copy data content from another array, converting the elements to the
+   *  data type of this array.
+   * \param other The source array, of the same shape.
+   * \note Only float32 to and from float16/bfloat16 between contiguous arrays on CPU
+   *       is supported. The conversion is synchronous.
+   */
+  TVM_DLL void CopyFromConverted(const NDArray& other);
   /*!
    * \brief Copy data content into another array.
    * \param other The source array to be copied from.
@@ -139,6 +147,24 @@ class NDArray : public ObjectRef {
    * \note The memory size of new array must be smaller than the current one.
    */
   TVM_DLL NDArray CreateView(ShapeTuple shape, DLDataType dtype);
+  /*!
+   * \brief Create a strided NDArray that shares the data memory with the current one.
+   * \param shape The shape of the new array.
+   * \param strides The strides of the new array in elements, empty for a compact array.
+   * \param elem_offset The offset in elements of the first element of the new array
+   *        from the first element of the current one.
+   * \note The elements of the new array must lie within the memory of the current one.
+   *       The strides of the view are nullptr when its layout is compact.
+   */
+  TVM_DLL NDArray CreateView(ShapeTuple shape, ShapeTuple strides, int64_t elem_offset) const;
+  /*!
+   * \brief Create a view of a range of indices along an axis, without copying.
+   * \param axis The axis to slice.
+   * \param begin The first index of the range.
+   * \param end One past the last index of the range.
+   * \return The view, which is compact when slicing the outermost axis of a compact array.
+   */
+  TVM_DLL NDArray Slice(int axis, int64_t begin, int64_t end) const;
   /*!
    * \brief Create a reference view of NDArray that
    *  represents as DLManagedTensor.
@@ -163,12 +189,18 @@ class NDArray : public ObjectRef {
    * that is DLPack compatible.
    *
    * The memory is retained until the NDArray went out of scope.
+   * Strided tensors are referenced as well, their strides are
+   * dropped when the layout is compact.
    * \param tensor The DLPack tensor to copy from.
    * \return The created NDArray view.
    */
   TVM_DLL static NDArray FromDLPack(DLManagedTensor* tensor);
   /*!
    * \brief Function to copy data from one array to another.
+   *
+   *  The bytes of the arrays, which must have the same size, are copied as is; see
+   *  CopyFromConverted for copies converting the elements. Non-contiguous arrays are supported on CPU; a copy between
+   *  a non-contiguous CPU array and another device goes through a compact CPU buffer.
    * \param from The source array.
    * \param to The target array.
    * \param stream The stream used in copy.
@@ -252,6 +284,11 @@ class NDArray::ContainerBase {
    *  can be used used for shape data.
    */
   ShapeTuple shape_;
+  /*!
+   * \brief The strides of a strided view, in elements.
+   *  dl_tensor.strides points to its data when the view is not compact.
+   */
+  std::vector<ShapeTuple::index_type> strides_;
 };
 
 /*!
@@ -298,6 +335,7 @@ class NDArray::Container : public Object, public NDArray::ContainerBase {
   static constexpr const uint32_t _type_index = TypeIndex::kRuntimeNDArray;
   static constexpr const uint32_t _type_child_slots = 0;
   static constexpr const uint32_t _type_child_slots_can_overflow = true;
+  static constexpr bool _type_use_object_pool = true;
   static constexpr const char* _type_key = "runtime.NDArray";
   TVM_DECLARE_BASE_OBJECT_INFO(NDArray::Container, Object);
 
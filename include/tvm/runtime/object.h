@@ -230,6 +230,8 @@ class TVM_DLL Object {
   static constexpr bool _type_has_method_visit_attrs = true;
   static constexpr bool _type_has_method_sequal_reduce = false;
   static constexpr bool _type_has_method_shash_reduce = false;
+  // allocation: hot runtime types set this to allocate through PooledObjAllocator
+  static constexpr bool _type_use_object_pool = false;
   // NOTE: the following field is not type index of Object
   // but was intended to be used by sub-classes as default value.
   // The type index of Object is TypeIndex::kRoot
@@ -24,8 +24,11 @@
 #ifndef TVM_RUNTIME_THREADING_BACKEND_H_
 #define TVM_RUNTIME_THREADING_BACKEND_H_
 
+#include <tvm/runtime/c_runtime_api.h>
+
 #include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace tvm {
@@ -64,21 +67,25 @@ class ThreadGroup {
   enum AffinityMode : int {
     kBig = 1,
     kLittle = -1,
+    /*! \brief Keep the workers and the main thread on the CPUs of one NUMA node. */
+    kNUMANode = 2,
   };
 
   /*!
    * \brief configure the CPU id affinity
    *
-   * \param mode The preferred CPU type (1 = big, -1 = little).
+   * \param mode The preferred CPU type (1 = big, -1 = little, 2 = one NUMA node).
    * \param nthreads The number of threads to use (0 = use all).
    * \param exclude_worker0 Whether to use the main thread as a worker.
    *        If  `true`, worker0 will not be launched in a new thread and
    *        `worker_callback` will only be called for values >= 1. This
    *        allows use of the main thread as a worker.
+   * \param numa_node The NUMA node of kNUMANode mode (-1 = the node the
+   *        calling thread runs on).
    *
    * \return The number of workers to use.
    */
-  int Configure(AffinityMode mode, int nthreads, bool exclude_worker0);
+  int Configure(AffinityMode mode, int nthreads, bool exclude_worker0, int numa_node = -1);
 
  private:
   Impl* impl_;
@@ -102,6 +109,69 @@ int MaxConcurrency();
  */
 void ResetThreadPool();
 
+/*! \brief A NUMA node and its CPUs. */
+struct NUMANode {
+  /*! \brief The id of the node. */
+  int id;
+  /*! \brief The logical CPUs of the node, in ascending order. */
+  std::vector<unsigned int> cpus;
+};
+
+/*!
+ * \brief Read the NUMA topology from sysfs.
+ *
+ * \param sysfs_root The mount point of sysfs. Another directory with the same
+ *        layout simulates a topology.
+ * \return The nodes that have CPUs, ordered by id. A single node holding all
+ *         CPUs when sysfs has no NUMA information.
+ */
+TVM_DLL std::vector<NUMANode> ReadNUMATopology(const std::string& sysfs_root = "/sys");
+
+/*!
+ * \return The NUMA topology of the system, read once from the sysfs root given by
+ *         the environment variable TVM_NUMA_SYSFS_ROOT, "/sys" by default.
+ */
+TVM_DLL const std::vector<NUMANode>& NUMATopology();
+
+/*!
+ * \return The index in NUMATopology() of the node the calling thread runs on.
+ */
+TVM_DLL int CurrentNUMANode();
+
+/*!
+ * \brief Bind the calling thread to the CPUs of a NUMA node.
+ * \param node The index of the node in NUMATopology().
+ */
+TVM_DLL void BindToNUMANode(int node);
+
+/*!
+ * \return The index of the NUMA node the thread pool of the calling thread is
+ *         confined to, -1 when it is not confined or the system has one node.
+ */
+TVM_DLL int PreferredNUMANode();
+
+/*!
+ * \brief Ask the kernel to place the pages of a buffer on a NUMA node, moving the
+ *        pages that are already resident. Only whole pages inside the buffer are
+ *        placed, and failures are ignored.
+ *
+ * \param ptr The buffer.
+ * \param nbytes The size of the buffer.
+ * \param node The index of the node in NUMATopology().
+ */
+TVM_DLL void PlaceOnNUMANode(void* ptr, size_t nbytes, int node);
+
+/*!
+ * \brief Run one replica of a task per NUMA node and wait for all of them.
+ *
+ *  Each replica runs on its own thread, bound to its node together with its
+ *  thread pool, so that the memory it allocates is local to the node. Use it to
+ *  serve independent executor replicas per socket.
+ *
+ * \param ftask The task, called with the index of the node in NUMATopology().
+ */
+TVM_DLL void RunPerNUMANode(std::function<void(int node)> ftask);
+
 }  // namespace threading
 }  // namespace runtime
 }  // namespace tvm
@@ -28,6 +28,7 @@
 #include <tvm/runtime/ndarray.h>
 #include <tvm/runtime/object.h>
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -81,8 +82,28 @@ class Allocator {
    */
   virtual size_t UsedMemory() const = 0;
 
+  /*! \brief Statistics of the buffers an allocator allocates from the device. */
+  struct Stats {
+    /*! \brief The number of buffers allocated from the device. */
+    size_t num_allocs;
+    /*! \brief The largest amount of memory allocated from the device at once, in bytes. */
+    size_t peak_bytes;
+  };
+  /*! \return The statistics since the allocator was created or they were last reset. */
+  Stats GetStats() const;
+  /*! \brief Resets the statistics, starting the peak from the memory currently allocated. */
+  void ResetStats();
+
+ protected:
+  /*! \brief Records a buffer allocated from the device.
+   *  \param used_memory The amount of memory allocated, including the buffer.
+   */
+  void RecordAlloc(size_t used_memory);
+
  private:
   AllocatorType type_;
+  std::atomic<size_t> num_allocs_{0};
+  std::atomic<size_t> peak_bytes_{0};
 };
 
 class MemoryManager {
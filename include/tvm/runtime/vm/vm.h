@@ -24,6 +24,7 @@
 #ifndef TVM_RUNTIME_VM_VM_H_
 #define TVM_RUNTIME_VM_VM_H_
 
+#include <tvm/runtime/c_backend_api.h>
 #include <tvm/runtime/container/closure.h>
 #include <tvm/runtime/module.h>
 #include <tvm/runtime/object.h>
@@ -57,6 +58,7 @@ class VMClosureObj : public ClosureObj {
   std::vector<ObjectRef> free_vars;
 
   static constexpr const uint32_t _type_index = TypeIndex::kDynamic;
+  static constexpr bool _type_use_object_pool = true;
   static constexpr const char* _type_key = "vm.Closure";
   TVM_DECLARE_FINAL_OBJECT_INFO(VMClosureObj, ClosureObj);
 };
@@ -289,6 +291,11 @@ class VirtualMachine : public runtime::ModuleNode {
  protected:
   /*! \brief The virtual machine's packed function table. */
   std::vector<PackedFunc> packed_funcs_;
+  /*!
+   * \brief The generated functions called by packed_funcs_, nullptr where unknown. InvokePacked
+   *  calls these directly, see GetBackendPackedCFunc.
+   */
+  std::vector<TVMBackendPackedCFunc> packed_cfuncs_;
   /*! \brief The current stack of call frames. */
   std::vector<VMFrame> frames_;
   /*! \brief The fuction table index of the current function. */
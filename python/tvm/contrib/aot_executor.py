@@ -0,0 +1,239 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Executor running the main function generated by the AOT executor codegen on the host."""
+import tvm._ffi
+
+from tvm._ffi.base import string_types
+from tvm.runtime import ndarray
+
+
+def create(executor_config, libmod, device):
+    """Create an AOT executor module given the executor config and the library of a model.
+
+    Parameters
+    ----------
+    executor_config : str
+        The inputs and outputs of the main function of the model in json format,
+        as returned by get_executor_config of the AOT executor factory.
+
+    libmod : tvm.runtime.Module
+        The module holding the main function of the model.
+
+    device : Device
+        The host CPU device.
+
+    Returns
+    -------
+    aot_module : AotModule
+        Runtime AOT module that can be used to run the model.
+    """
+    assert isinstance(executor_config, string_types)
+    fcreate = tvm._ffi.get_global_func("tvm.aot_executor.create")
+    return AotModule(fcreate(executor_config, libmod, device.device_type, device.device_id))
+
+
+class AotModule(object):
+    """Wrapper runtime module.
+
+    This is a thin wrapper of the underlying TVM module, with the interface of
+    :py:class:`~tvm.contrib.graph_executor.GraphModule`. The parameters are linked
+    into the library, so all the modules created from a library share them.
+
+    Parameters
+    ----------
+    module : tvm.runtime.Module
+        The internal tvm module that calls the main function of the model.
+
+    Attributes
+    ----------
+    module : tvm.runtime.Module
+        The internal tvm module that calls the main function of the model.
+
+    Examples
+    --------
+
+    .. code-block:: python
+
+        import tvm
+        from tvm import relay
+        from tvm.contrib import aot_executor
+
+        # build the library using the AOT executor
+        lib = relay.build(..., target="c", executor=relay.backend.Executor("aot"))
+        lib.export_library("compiled_lib.so")
+        # load it back as a runtime
+        lib: tvm.runtime.Module = tvm.runtime.load_module("compiled_lib.so")
+        # Call the library factory function for default and create
+        # a new runtime.Module, wrap with aot module.
+        amod = aot_executor.AotModule(lib["default"](dev))
+        # use the aot module.
+        amod.set_input("x", data)
+        amod.run()
+    """
+
+    def __init__(self, module):
+        self.module = module
+        self._set_input = module["set_input"]
+        self._set_input_zero_copy = module["set_input_zero_copy"]
+        self._set_output_zero_copy = module["set_output_zero_copy"]
+        self._run = module["run"]
+        self._get_output = module["get_output"]
+        self._get_input = module["get_input"]
+        self._get_num_outputs = module["get_num_outputs"]
+        self._get_input_index = module["get_input_index"]
+        self._get_num_inputs = module["get_num_inputs"]
+
+    def set_input(self, key=None, value=None, **params):
+        """Set inputs to the module via kwargs
+
+        Parameters
+        ----------
+        key : int or str
+           The input key
+
+        value : the input value.
+           The input key
+
+        params : dict of str to NDArray
+           Additional arguments
+        """
+        if key is not None:
+            if isinstance(key, string_types) and self._get_input_index(key) < 0:
+                raise RuntimeError("Could not find '%s' in the model's inputs" % key)
+            self._set_input(key, ndarray.array(value))
+
+        for k, v in params.items():
+            self._set_input(k, ndarray.array(v))
+
+    def set_input_zero_copy(self, key, value):
+        """Bind an input to an array, which the following runs read without a copy.
+
+        Parameters
+        ----------
+        key : int or str
+           The input key
+
+        value : NDArray
+           The array, of the shape and dtype of the input, kept alive by the caller.
+        """
+        self._set_input_zero_copy(key, value)
+
+    def set_output_zero_copy(self, index, value):
+        """Bind an output to an array, which the following runs write without a copy.
+
+        Parameters
+        ----------
+        index : int
+           The output index
+
+        value : NDArray
+           The array, of the shape and dtype of the output, kept alive by the caller.
+        """
+        self._set_output_zero_copy(index, value)
+
+    def run(self, **input_dict):
+        """Run the model
+
+        Parameters
+        ----------
+        input_dict: dict of str to NDArray
+            List of input values to be feed to
+        """
+        if input_dict:
+            self.set_input(**input_dict)
+        self._run()
+
+    def get_num_outputs(self):
+        """Get the number of outputs of the model
+
+        Returns
+        -------
+        count : int
+            The number of outputs.
+        """
+        return self._get_num_outputs()
+
+    def get_num_inputs(self):
+        """Get the number of inputs of the model
+
+        Returns
+        -------
+        count : int
+            The number of inputs.
+        """
+        return self._get_num_inputs()
+
+    def get_input(self, index, out=None):
+        """Get index-th input to out
+
+        Parameters
+        ----------
+        index : int or str
+            The input index
+
+        out : NDArray
+            The output array container
+        """
+        if out:
+            self._get_input(index).copyto(out)
+            return out
+
+        return self._get_input(index)
+
+    def get_input_index(self, name):
+        """Get inputs index via input name.
+
+        Parameters
+        ----------
+        name : str
+           The input key name
+
+        Returns
+        -------
+        index: int
+            The input index. -1 will be returned if the given input name is not found.
+        """
+        return self._get_input_index(name)
+
+    def get_output(self, index, out=None):
+        """Get index-th output to out
+
+        An output bound with set_output_zero_copy can only be copied to out.
+
+        Parameters
+        ----------
+        index : int
+            The output index
+
+        out : NDArray
+            The output array container
+        """
+        if out:
+            self._get_output(index, out)
+            return out
+
+        return self._get_output(index)
+
+    def __getitem__(self, key):
+        """Get internal module function
+
+        Parameters
+        ----------
+        key : str
+            The key to the module.
+        """
+        return self.module[key]
@@ -153,6 +153,7 @@ class GraphModule(object):
     def __init__(self, module):
         self.module = module
         self._set_input = module["set_input"]
+        self._prefetch_input = module["prefetch_input"]
         self._run = module["run"]
         self._get_output = module["get_output"]
         self._get_input = module["get_input"]
@@ -194,6 +195,23 @@ class GraphModule(object):
                 if val:
                     self._get_input(k).copyfrom(params[k])
 
+    def prefetch_input(self, key, value):
+        """Copy an input of the next run asynchronously, overlapping with the current run.
+
+        The copy goes to a second storage of the input, which the run in flight does not use,
+        so it can be called from another thread while run() executes. The next run reads the
+        input from that storage.
+
+        Parameters
+        ----------
+        key : int or str
+           The input key
+
+        value : NDArray
+           The input value, kept alive until the next run.
+        """
+        self._prefetch_input(key, value)
+
     def run(self, **input_dict):
         """Run forward execution of the graph
 
@@ -52,6 +52,61 @@ def matmul(lhs, rhs, transa=False, transb=False, **kwargs):
     )
 
 
+def pack_matrix(rhs, n, transb=False):
+    """Pack the constant right hand side of a matrix mult with mkl, once and for all calls.
+
+    The packed format depends on the MKL version and on the CPU, so the packed matrix
+    can only be used by matmul_packed on a machine where MKL picks the same code path.
+
+    Parameters
+    ----------
+    rhs: NDArray
+        The right matrix operand
+    n: int
+        The number of rows of the left matrix operand
+    transb: bool
+        Whether transpose rhs
+
+    Returns
+    -------
+    packed: NDArray
+        The packed matrix, a uint8 buffer.
+    """
+    return tvm.get_global_func("tvm.contrib.mkl.pack_matrix")(rhs, n, transb)
+
+
+def matmul_packed(lhs, packed_rhs, units, transa=False, **kwargs):
+    """Create an extern op that compute matrix mult of lhs and a rhs packed by pack_matrix
+    with mkl.
+
+    Parameters
+    ----------
+    lhs: Tensor
+        The left matrix operand
+    packed_rhs: Tensor
+        The right matrix operand, as packed by pack_matrix
+    units: int
+        The number of columns of the result
+    transa: bool
+        Whether transpose lhs
+
+    Returns
+    -------
+    C: Tensor
+        The result tensor.
+    """
+    n = lhs.shape[1] if transa else lhs.shape[0]
+    return te.extern(
+        (n, units),
+        [lhs, packed_rhs],
+        lambda ins, outs: tvm.tir.call_packed(
+            "tvm.contrib.mkl.matmul_packed", ins[0], ins[1], outs[0], transa
+        ),
+        name="C",
+        **kwargs,
+    )
+
+
 def matmul_u8s8s32(lhs, rhs, transa=False, transb=False, **kwargs):
     """Create an extern op that compute matrix mult of A and rhs with CrhsLAS
     This function serves as an example on how to call external libraries.
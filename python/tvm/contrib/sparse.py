@@ -18,6 +18,7 @@
 # pylint: disable=invalid-name
 import warnings
 import numpy as _np
+import tvm
 from tvm.runtime import ndarray as _nd
 from tvm import te
 from tvm.tir import expr as _expr
@@ -202,3 +203,85 @@ def placeholder(shape, nonzeros=None, dtype=None, name="placeholder", stype=None
     else:
         raise NotImplementedError("stype=%s is not supported yet." % (stype,))
     return ret
+
+
+def bsr_dense(data, weight_data, weight_indices, weight_indptr, **kwargs):
+    """Create an extern op that computes `data * W^T` where `W` is a block sparse
+    matrix in the BSR format, using the CPU kernels of contrib.sparse.
+
+    Parameters
+    ----------
+    data : tvm.te.Tensor
+        2-D float32 tensor with shape [M, K]
+
+    weight_data : tvm.te.Tensor
+        3-D float32 tensor with shape [num_blocks, bs_r, bs_c]
+
+    weight_indices : tvm.te.Tensor
+        1-D int32 tensor with shape [num_blocks]
+
+    weight_indptr : tvm.te.Tensor
+        1-D int32 tensor with shape [N / bs_r + 1]
+
+    Returns
+    -------
+    output : tvm.te.Tensor
+        2-D tensor with shape [M, N]
+    """
+    m = data.shape[0]
+    n = (weight_indptr.shape[0] - 1) * weight_data.shape[1]
+    return te.extern(
+        (m, n),
+        [data, weight_data, weight_indices, weight_indptr],
+        lambda ins, outs: tvm.tir.call_packed(
+            "tvm.contrib.sparse.bsr_dense", ins[0], ins[1], ins[2], ins[3], outs[0]
+        ),
+        name="bsr_dense",
+        dtype=data.dtype,
+        **kwargs,
+    )
+
+
+def embedding_bag(weight, indices, offsets, mode="sum", scale=1.0, **kwargs):
+    """Create an extern op that pools rows of an embedding table, using the CPU kernel of
+    contrib.sparse. Bag `b` pools `weight[indices[offsets[b]:offsets[b + 1]]]`.
+
+    Parameters
+    ----------
+    weight : tvm.te.Tensor
+        2-D float32, float16 or int8 tensor with shape [num_rows, dim]
+
+    indices : tvm.te.Tensor
+        1-D int32 or int64 tensor with shape [num_indices]
+
+    offsets : tvm.te.Tensor
+        1-D tensor of the same type as indices with shape [num_bags]
+
+    mode : str
+        "sum" or "mean"
+
+    scale : float
+        Factor applied to the pooled rows, e.g. the dequantization scale of an int8 table
+
+    Returns
+    -------
+    output : tvm.te.Tensor
+        2-D float32 tensor with shape [num_bags, dim]
+    """
+    assert mode in ("sum", "mean"), "mode must be sum or mean, but got %s" % mode
+    return te.extern(
+        (offsets.shape[0], weight.shape[1]),
+        [weight, indices, offsets],
+        lambda ins, outs: tvm.tir.call_packed(
+            "tvm.contrib.sparse.embedding_bag",
+            ins[0],
+            ins[1],
+            ins[2],
+            outs[0],
+            0 if mode == "sum" else 1,
+            float(scale),
+        ),
+        name="embedding_bag",
+        dtype="float32",
+        **kwargs,
+    )
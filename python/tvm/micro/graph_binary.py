@@ -0,0 +1,270 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+"""Compile graph JSON into the binary graph format of the C runtime graph executor.
+
+The layout is described in
+src/runtime/crt/include/tvm/runtime/crt/internal/graph_executor/graph_binary.h and must be kept
+in sync with it. The C runtime references the binary in place, so a device does not need to parse
+JSON or allocate the graph tables.
+"""
+
+import json
+import struct
+
+from ..runtime import DataType
+
+GRAPH_BINARY_MAGIC = 0x48504152474D5654
+GRAPH_BINARY_VERSION = 1
+
+# The default TVM_CRT_MAX_NDIM of crt_config.h.
+DEFAULT_MAX_NDIM = 6
+
+_OP_TYPES = {"null": 0, "tvm_op": 1}
+
+# kDLCPU, the device type used when the graph has no device_index.
+_DEFAULT_DEVICE_TYPE = 1
+
+# TVM_GRAPH_EXECUTOR_ARENA_ALIGNMENT of the C runtime.
+ARENA_ALIGNMENT = 16
+
+_HEADER = struct.Struct("<QIIIIIIIIII")
+_NODE = struct.Struct("<IIIIIIII")
+_NODE_ENTRY = struct.Struct("<III")
+_DTYPE = struct.Struct("<BBH")
+_STORAGE = struct.Struct("<QIi")
+
+
+class _Strings:
+    """The strings section, a table of NUL terminated strings."""
+
+    def __init__(self):
+        self.data = bytearray(b"\0")
+        self.offsets = {"": 0}
+
+    def add(self, value):
+        if value not in self.offsets:
+            self.offsets[value] = len(self.data)
+            self.data += value.encode("utf-8") + b"\0"
+        return self.offsets[value]
+
+
+def _pad(data):
+    data += b"\0" * (-len(data) % 8)
+
+
+def _align(size, alignment):
+    return (size + alignment - 1) // alignment * alignment
+
+
+def _attr_list(attrs, key, default=None):
+    if key not in attrs:
+        if default is None:
+            raise ValueError(f"graph JSON is missing attrs.{key}")
+        return default
+    return attrs[key][1]
+
+
+def compile_graph_binary(graph_json, max_ndim=DEFAULT_MAX_NDIM):
+    """Compile a graph executor JSON graph into a binary graph.
+
+    Parameters
+    ----------
+    graph_json : str or dict
+        The graph, as returned by executor_factory.get_graph_json().
+
+    max_ndim : int
+        TVM_CRT_MAX_NDIM of the runtime that will load the graph.
+
+    Returns
+    -------
+    bytes
+        The binary graph. It must be placed at an 8-byte aligned address on the device.
+    """
+    graph = json.loads(graph_json) if isinstance(graph_json, str) else graph_json
+    nodes = graph["nodes"]
+    node_row_ptr = graph["node_row_ptr"]
+    attrs = graph["attrs"]
+    num_entries = node_row_ptr[-1]
+    storage_id = _attr_list(attrs, "storage_id")
+    shapes = _attr_list(attrs, "shape")
+    dltypes = _attr_list(attrs, "dltype")
+    device_index = _attr_list(attrs, "device_index", [_DEFAULT_DEVICE_TYPE] * num_entries)
+    if len(node_row_ptr) != len(nodes) + 1:
+        raise ValueError("node_row_ptr must have one more element than nodes")
+    for name, values in (("storage_id", storage_id), ("shape", shapes), ("dltype", dltypes)):
+        if len(values) != num_entries:
+            raise ValueError(f"attrs.{name} has {len(values)} entries, expected {num_entries}")
+
+    strings = _Strings()
+    node_section = bytearray()
+    node_inputs = bytearray()
+    num_node_inputs = 0
+    for node in nodes:
+        if node["op"] not in _OP_TYPES:
+            raise ValueError(f"unsupported op type {node['op']} of node {node['name']}")
+        node_attrs = node.get("attrs", {})
+        inputs = node["inputs"]
+        node_section += _NODE.pack(
+            _OP_TYPES[node["op"]],
+            strings.add(node["name"]),
+            strings.add(node_attrs.get("func_name", "")),
+            int(node_attrs.get("num_inputs", 0)),
+            int(node_attrs.get("num_outputs", 0)),
+            int(node_attrs.get("flatten_data", 0)),
+            num_node_inputs,
+            len(inputs),
+        )
+        for entry in inputs:
+            node_inputs += _NODE_ENTRY.pack(entry[0], entry[1], entry[2] if len(entry) > 2 else 0)
+        num_node_inputs += len(inputs)
+
+    ndims = bytearray()
+    dtypes = bytearray()
+    shape_section = bytearray()
+    storage = {}
+    for eid in range(num_entries):
+        shape = shapes[eid]
+        if len(shape) > max_ndim:
+            raise ValueError(f"entry {eid} has {len(shape)} dims, more than max_ndim={max_ndim}")
+        dtype = DataType(dltypes[eid])
+        ndims += struct.pack("<I", len(shape))
+        dtypes += _DTYPE.pack(dtype.type_code, dtype.bits, dtype.lanes)
+        padded_shape = list(shape) + [0] * (max_ndim - len(shape))
+        shape_section += struct.pack(f"<{max_ndim}q", *padded_shape)
+
+        # Same as the storage plan computed by the runtime from JSON: the largest entry sets the
+        # size and the last entry sets the shape of a linked parameter.
+        size = (dtype.bits * dtype.lanes + 7) // 8
+        for dim in shape:
+            size *= dim
+        sid = storage_id[eid]
+        storage[sid] = (max(storage.get(sid, (0,))[0], size), eid, device_index[eid])
+
+    num_storage = max(storage) + 1 if storage else 0
+    storage_section = bytearray()
+    for sid in range(num_storage):
+        storage_section += _STORAGE.pack(*storage.get(sid, (0, 0, _DEFAULT_DEVICE_TYPE)))
+
+    sections = [
+        node_section,
+        struct.pack(f"<{len(graph['arg_nodes'])}I", *graph["arg_nodes"]),
+        struct.pack(f"<{len(node_row_ptr)}I", *node_row_ptr),
+        b"".join(_NODE_ENTRY.pack(e[0], e[1], e[2] if len(e) > 2 else 0) for e in graph["heads"]),
+        node_inputs,
+        struct.pack(f"<{num_entries}I", *storage_id),
+        ndims,
+        dtypes,
+        shape_section,
+        storage_section,
+        strings.data,
+    ]
+    binary = bytearray(
+        _HEADER.pack(
+            GRAPH_BINARY_MAGIC,
+            GRAPH_BINARY_VERSION,
+            max_ndim,
+            len(nodes),
+            len(graph["arg_nodes"]),
+            len(graph["heads"]),
+            num_node_inputs,
+            num_entries,
+            num_storage,
+            len(strings.data),
+            0,
+        )
+    )
+    for section in sections:
+        binary += section
+        _pad(binary)
+    return bytes(binary)
+
+
+def arena_sizes(graph_binary):
+    """Compute the arguments of TVM_GRAPH_EXECUTOR_ARENA_SIZE for a binary graph.
+
+    The arena of TVMGraphExecutor_CreateInArena holds the executor tables, whose size depends on
+    the target, and the graph storage, which is computed here.
+
+    Parameters
+    ----------
+    graph_binary : bytes
+        The binary graph, as returned by compile_graph_binary.
+
+    Returns
+    -------
+    dict
+        storage_size, the bytes of graph storage, and num_storage, num_entries and num_nodes.
+    """
+    header = _HEADER.unpack_from(graph_binary)
+    max_ndim, num_nodes, num_input_nodes, num_outputs, num_node_inputs = header[2:7]
+    num_entries, num_storage = header[7:9]
+    section_sizes = [
+        num_nodes * _NODE.size,
+        num_input_nodes * 4,
+        (num_nodes + 1) * 4,
+        num_outputs * _NODE_ENTRY.size,
+        num_node_inputs * _NODE_ENTRY.size,
+        num_entries * 4,
+        num_entries * 4,
+        num_entries * _DTYPE.size,
+        num_entries * max_ndim * 8,
+    ]
+    offset = _HEADER.size
+    for size in section_sizes:
+        offset += _align(size, 8)
+    storage_size = 0
+    for sid in range(num_storage):
+        size = _STORAGE.unpack_from(graph_binary, offset + sid * _STORAGE.size)[0]
+        storage_size += _align(size, ARENA_ALIGNMENT)
+    return {
+        "storage_size": storage_size,
+        "num_storage": num_storage,
+        "num_entries": num_entries,
+        "num_nodes": num_nodes,
+    }
+
+
+def emit_c_array(graph_binary, name):
+    """Emit a binary graph as a C array definition.
+
+    The array is declared as uint64_t so that the compiler aligns it to 8 bytes.
+
+    Parameters
+    ----------
+    graph_binary : bytes
+        The binary graph, as returned by compile_graph_binary.
+
+    name : str
+        Name of the C array.
+
+    Returns
+    -------
+    str
+        C source defining the array and a size_t {name}_size holding its size in bytes, preceded
+        by the defines {NAME}_STORAGE_SIZE, {NAME}_NUM_STORAGE, {NAME}_NUM_ENTRIES and
+        {NAME}_NUM_NODES to pass to TVM_GRAPH_EXECUTOR_ARENA_SIZE.
+    """
+    words = struct.unpack(f"<{len(graph_binary) // 8}Q", graph_binary)
+    sizes = arena_sizes(graph_binary)
+    lines = [f"#define {name.upper()}_{key.upper()} {value}" for key, value in sizes.items()]
+    lines.append(f"const uint64_t {name}[{len(words)}] = {{")
+    for i in range(0, len(words), 4):
+        lines.append("    " + ", ".join(f"0x{w:016x}ULL" for w in words[i : i + 4]) + ",")
+    lines.append("};")
+    lines.append(f"const size_t {name}_size = sizeof({name});")
+    return "\n".join(lines) + "\n"
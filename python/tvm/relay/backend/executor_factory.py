@@ -91,6 +91,9 @@ class AOTExecutorFactoryModule(ExecutorFactoryModule):
         This holds a map function names to their information
     devices : List[str]
         List of devices used in the module
+    executor_config : str
+        The inputs and outputs of the main function in JSON, from which the AOT executor runs
+        the module. It is empty when the main function does not use the packed API.
     """
 
     def __init__(
@@ -104,7 +107,13 @@ class AOTExecutorFactoryModule(ExecutorFactoryModule):
         params,
         function_metadata,
         devices,
+        executor_config=None,
     ):
+        fcreate = get_global_func("tvm.aot_executor_factory.create", allow_missing=True)
+        self.module = None
+        if executor_config and fcreate is not None:
+            self.module = fcreate(executor_config, libmod, libmod_name)
+        self.executor_config = executor_config
         self.ir_mod = ir_mod
         self.lowered_ir_mods = lowered_ir_mods
         self.target = target
@@ -116,6 +125,10 @@ class AOTExecutorFactoryModule(ExecutorFactoryModule):
         self.function_metadata = function_metadata
         self.devices = devices
 
+    def export_library(self, file_name, fcompile=None, addons=None, **kwargs):
+        assert self.module is not None, "The module cannot run on the AOT executor"
+        return self.module.export_library(file_name, fcompile, addons, **kwargs)
+
     def get_devices(self):
         return self.devices
 
@@ -123,7 +136,7 @@ class AOTExecutorFactoryModule(ExecutorFactoryModule):
         return self.params
 
     def get_executor_config(self):
-        return None
+        return self.executor_config
 
     def get_lib(self):
         return self.lib
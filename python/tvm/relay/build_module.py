@@ -192,7 +192,7 @@ class BuildModule(object):
         # Get artifacts
         mod = self.get_module()
         params = self.get_params()
-        executor_config = self.get_graph_json() if str(executor) == "graph" else None
+        executor_config = self.get_graph_json() if str(executor) in ("graph", "aot") else None
 
         return executor_config, mod, params
 
@@ -469,6 +469,7 @@ def build(
                 params,
                 func_metadata,
                 devices,
+                graph_json,
             )
         elif str(executor) == "graph":
             executor_factory = _executor_factory.GraphExecutorFactoryModule(
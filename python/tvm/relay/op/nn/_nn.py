@@ -115,6 +115,11 @@ reg.register_strategy("nn.contrib_dense_pack", strategy.dense_pack_strategy)
 reg.register_pattern("nn.contrib_dense_pack", reg.OpPattern.OUT_ELEMWISE_FUSABLE)
 
 
+# dense_mkl_packed
+reg.register_strategy("nn.contrib_dense_mkl_packed", strategy.dense_mkl_packed_strategy)
+reg.register_pattern("nn.contrib_dense_mkl_packed", reg.OpPattern.OUT_ELEMWISE_FUSABLE)
+
+
 # fifo_buffer
 @reg.register_compute("nn.fifo_buffer")
 def compute_fifo_buffer(attrs, inputs, out_type):
@@ -1011,6 +1016,11 @@ reg.register_reduce_schedule("nn.nll_loss")
 reg.register_pattern("nn.nll_loss", OpPattern.OUT_ELEMWISE_FUSABLE)
 
 
+# embedding_bag
+reg.register_strategy("nn.contrib_embedding_bag", strategy.embedding_bag_strategy)
+reg.register_pattern("nn.contrib_embedding_bag", OpPattern.OPAQUE)
+
+
 # depth_to_space
 @reg.register_compute("nn.depth_to_space")
 def compute_depth_to_space(attrs, inputs, out_dtype):
@@ -1667,6 +1667,77 @@ def contrib_dense_pack(data, weight, weight_layout="NC", units=None, out_dtype="
     return _make.contrib_dense_pack(data, weight, weight_layout, units, out_dtype)
 
 
+def contrib_dense_mkl_packed(data, packed_weight, units, out_dtype=""):
+    """Dense operator with a weight packed by MKL.
+    Applies a linear transformation
+
+    .. math::
+
+    `Y = X * W^T`
+
+    The weight is packed once, by :py:func:`tvm.contrib.mkl.pack_matrix`, for
+    the number of rows of the data. The packed format depends on the MKL version
+    and on the CPU, so the compiled module must run on a machine like the one
+    that packed the weight.
+
+    Parameters
+    ----------
+    data : tvm.relay.Expr
+        The input data to the operator, a 2-D matrix of shape `(batch, units_in)`.
+
+    packed_weight : tvm.relay.Expr
+        The weight of shape `(units, units_in)`, packed as a 1-D uint8 tensor.
+
+    units : int
+        Number of hidden units of the dense transformation.
+
+    out_dtype : str, optional
+        Specifies the output data type for mixed precision dense,
+        of shape `(batch, units)`.
+
+    Returns
+    -------
+    result : tvm.relay.Expr
+        The computed result.
+    """
+    return _make.contrib_dense_mkl_packed(data, packed_weight, units, out_dtype)
+
+
+def contrib_embedding_bag(weight, indices, offsets, mode="sum", scale=1.0):
+    """Pooled embedding lookup.
+
+    Bag `b` pools the rows of `weight` selected by `indices[offsets[b]:offsets[b + 1]]`,
+    the last bag ends at the end of `indices`. Empty bags are zero.
+
+    .. math::
+
+        out[b, :] = scale * \\mathrm{pool}_{i}(weight[indices[i], :])
+
+    Parameters
+    ----------
+    weight : tvm.relay.Expr
+        The embedding table of shape `(num_rows, dim)`, float32, float16 or int8.
+
+    indices : tvm.relay.Expr
+        1-D int tensor with the rows of all bags, concatenated.
+
+    offsets : tvm.relay.Expr
+        1-D tensor of the same type as `indices` with the start of each bag.
+
+    mode : str, optional
+        How the rows of a bag are pooled, "sum" or "mean".
+
+    scale : float, optional
+        Factor applied to the pooled rows, e.g. the dequantization scale of an int8 table.
+
+    Returns
+    -------
+    result : tvm.relay.Expr
+        The float32 tensor of shape `(num_bags, dim)`.
+    """
+    return _make.contrib_embedding_bag(weight, indices, offsets, mode, scale)
+
+
 def fifo_buffer(data, buffer, axis):
     """FIFO buffer to enable computation reuse in CNNs with sliding indow input
 
@@ -609,6 +609,11 @@ class NLLLossAttrs(Attrs):
     """Attributes for nn.nll_loss"""
 
 
+@tvm._ffi.register_object("relay.attrs.EmbeddingBagAttrs")
+class EmbeddingBagAttrs(Attrs):
+    """Attributes for nn.contrib_embedding_bag"""
+
+
 @tvm._ffi.register_object("relay.attrs.FixedPointMultiplyAttrs")
 class FixedPointMultiplyAttrs(Attrs):
     """Attributes used in fixed_point_multiply operators"""
@@ -818,6 +818,12 @@ def dense_pack_strategy(attrs, inputs, out_type, target):
     return strategy
 
 
+@override_native_generic_func("dense_mkl_packed_strategy")
+def dense_mkl_packed_strategy(attrs, inputs, out_type, target):
+    """dense_mkl_packed generic strategy"""
+    raise ValueError("No generic implemenation for dense_mkl_packed")
+
+
 # batch_matmul
 def wrap_compute_batch_matmul(topi_compute, need_auto_scheduler_layout=False, need_out_dtype=False):
     """wrap batch_matmul topi compute"""
@@ -1037,6 +1043,28 @@ def searchsorted_strategy(attrs, inputs, out_type, target):
     return strategy
 
 
+# embedding_bag
+def wrap_compute_embedding_bag(topi_compute):
+    """Wrap embedding_bag compute"""
+
+    def _compute_embedding_bag(attrs, inputs, out_type):
+        return [topi_compute(inputs[0], inputs[1], inputs[2], attrs.mode, attrs.scale)]
+
+    return _compute_embedding_bag
+
+
+@override_native_generic_func("embedding_bag_strategy")
+def embedding_bag_strategy(attrs, inputs, out_type, target):
+    """embedding_bag generic strategy"""
+    strategy = _op.OpStrategy()
+    strategy.add_implementation(
+        wrap_compute_embedding_bag(topi.nn.embedding_bag),
+        wrap_topi_schedule(topi.generic.schedule_extern),
+        name="embedding_bag.generic",
+    )
+    return strategy
+
+
 # multibox_prior
 def wrap_compute_multibox_prior(topi_compute):
     """Wrap multibox_prior compute"""
@@ -19,7 +19,7 @@
 import logging
 
 import re
-from tvm import topi
+from tvm import tir, topi
 from tvm.auto_scheduler import is_auto_scheduler_enabled
 from tvm.te import SpecializedCondition
 from tvm.relay.ty import is_dynamic
@@ -509,6 +509,32 @@ def dense_strategy_cpu(attrs, inputs, out_type, target):
     return strategy
 
 
+def wrap_compute_dense_mkl_packed(topi_compute):
+    """wrap dense_mkl_packed topi compute"""
+
+    def _compute_dense_mkl_packed(attrs, inputs, out_type):
+        """Compute definition of dense_mkl_packed"""
+        out_dtype = attrs.out_dtype
+        out_dtype = inputs[0].dtype if out_dtype == "" else out_dtype
+        return [topi_compute(inputs[0], inputs[1], attrs.units, None, out_dtype)]
+
+    return _compute_dense_mkl_packed
+
+
+@dense_mkl_packed_strategy.register("cpu")
+def dense_mkl_packed_strategy_cpu(attrs, inputs, out_type, target):
+    """dense_mkl_packed x86 strategy"""
+    if "mkl" not in target.libs:
+        raise ValueError("dense_mkl_packed requires a target with -libs=mkl")
+    strategy = _op.OpStrategy()
+    strategy.add_implementation(
+        wrap_compute_dense_mkl_packed(topi.x86.dense_mkl_packed),
+        wrap_topi_schedule(topi.x86.schedule_dense_mkl_packed),
+        name="dense_mkl_packed.x86",
+    )
+    return strategy
+
+
 @dense_pack_strategy.register("cpu")
 def dense_pack_strategy_cpu(attrs, inputs, out_type, target):
     """dense_pack x86 strategy"""
@@ -568,6 +594,46 @@ def sparse_dense_strategy_cpu(attrs, inputs, out_type, target):
         name="sparse_dense.x86",
         plevel=10,
     )
+    data, weight_data, weight_indices, weight_indptr = inputs
+    if (
+        not attrs["sparse_lhs"]
+        and "sparse" in target.libs
+        and len(data.shape) == 2
+        and len(weight_data.shape) == 3
+        and data.dtype == "float32"
+        and weight_indices.dtype == "int32"
+        and weight_indptr.dtype == "int32"
+        and isinstance(weight_data.shape[1], tir.IntImm)
+        and weight_data.shape[1].value in (1, 4, 16)
+    ):
+        # Register blocked kernels for the common block sizes of pruned models.
+        strategy.add_implementation(
+            wrap_compute_sparse_dense(topi.x86.sparse_dense_bsr_contrib),
+            wrap_topi_schedule(topi.x86.schedule_sparse_dense_bsr_contrib),
+            name="sparse_dense_bsr_contrib.x86",
+            plevel=15,
+        )
+    return strategy
+
+
+@embedding_bag_strategy.register("cpu")
+def embedding_bag_strategy_cpu(attrs, inputs, out_type, target):
+    """embedding_bag x86 strategy"""
+    strategy = _op.OpStrategy()
+    strategy.add_implementation(
+        wrap_compute_embedding_bag(topi.nn.embedding_bag),
+        wrap_topi_schedule(topi.generic.schedule_extern),
+        name="embedding_bag.generic",
+        plevel=10,
+    )
+    if "sparse" in target.libs:
+        # Row gather with software prefetch, for tables much larger than the caches.
+        strategy.add_implementation(
+            wrap_compute_embedding_bag(topi.x86.embedding_bag_contrib),
+            wrap_topi_schedule(topi.x86.schedule_embedding_bag_contrib),
+            name="embedding_bag_contrib.x86",
+            plevel=15,
+        )
     return strategy
 
 
@@ -135,6 +135,34 @@ def _percentile_scale(mod, dataset):
     return func
 
 
+def _streaming_scale(mod, dataset, mode, num_bins=8001, num_quantized_bins=255, percentile=0.99999):
+    """Find the scales in a single pass over the dataset. The statistics of every profiled
+    tensor are updated after each batch, so the memory does not grow with the dataset."""
+    logging.info("collecting streaming statistics for calibration...")
+    runtime = _get_profile_runtime(mod)
+    num_outputs = runtime.get_num_outputs()
+    stats = _quantize.CalibrationStats(num_outputs, num_bins)
+    for batch in dataset:
+        runtime.set_input(**batch)
+        runtime.run()
+        _quantize.CalibrationStatsUpdate(stats, [runtime.get_output(i) for i in range(num_outputs)])
+
+    logging.info("finding threshold with %s for calibration...", mode)
+    thresholds = _quantize.CalibrationStatsFindThresholds(
+        stats, mode, num_quantized_bins, percentile
+    )
+    scales = [threshold.value for threshold in thresholds]
+
+    def func(_):
+        scale = scales[func.scale_idx]
+        func.scale_idx += 1
+        return scale
+
+    func.scale_idx = 0
+
+    return func
+
+
 def _set_params(mod, input_scale_func, weight_scale_func):
     quantize_op = _op.get("relay.op.annotation.simulated_quantize")
     cfg = quantize.current_qconfig()
@@ -217,10 +245,12 @@ def calibrate(dataset=None):
         """make transform.module pass happy"""
         cfg = quantize.current_qconfig()
 
-        if cfg.calibrate_mode == "kl_divergence":
-            input_scale_func = _kl_scale(mod, dataset)
-        elif cfg.calibrate_mode == "global_scale":
+        if cfg.calibrate_mode == "global_scale":
             input_scale_func = _global_scale
+        elif cfg.calibrate_streaming and cfg.calibrate_mode in ["kl_divergence", "percentile"]:
+            input_scale_func = _streaming_scale(mod, dataset, cfg.calibrate_mode)
+        elif cfg.calibrate_mode == "kl_divergence":
+            input_scale_func = _kl_scale(mod, dataset)
         elif cfg.calibrate_mode == "percentile":
             input_scale_func = _percentile_scale(mod, dataset)
         else:
@@ -86,6 +86,7 @@ class QConfig(Object):
         "debug_enabled_ops": None,
         "rounding": "UPWARD",
         "calibrate_chunk_by": -1,
+        "calibrate_streaming": False,
         "partition_conversions": "disabled",
     }
 
@@ -180,6 +181,12 @@ def qconfig(**kwargs):
     rounding: "UPWARD" or "TONEAREST"
         Rounding direction for fixed point multiplications.
 
+    calibrate_streaming: boolean
+        Whether kl_divergence and percentile calibration update per-tensor histograms after
+        each batch instead of collecting the data of the whole dataset. This makes the memory
+        independent of the dataset size, and the thresholds are found on histograms which are
+        re-binned as the value range grows. calibrate_chunk_by is ignored in this mode.
+
     partition_conversions: 'disabled', 'enabled', or 'fully_integral'
         If set to 'enabled' or 'fully_integral', partitions a quantized
         result into a module containing
@@ -695,6 +695,19 @@ def LambdaLift():
     return _ffi_api.LambdaLift()
 
 
+def MemoryPlan():
+    """
+    Coalesce the storage allocations of statically known size made by the VM into a few
+    storages, reusing storage across tensors with disjoint lifetimes.
+
+    Returns
+    -------
+    ret : tvm.transform.Pass
+        The registered pass that plans the storage of the VM.
+    """
+    return _ffi_api.MemoryPlan()
+
+
 def PartitionGraph(mod_name="default"):
     """Partition a Relay program into regions that can be executed on different
     backends.
@@ -249,6 +249,24 @@ class NDArray(NDArrayBase):
             return self._copyto(res)
         raise ValueError("Unsupported target type %s" % str(type(target)))
 
+    def convert_to(self, target):
+        """Copy array to target, converting the elements to the data type of target
+
+        Only float32 to and from float16 or bfloat16 on CPU is supported.
+
+        Parameters
+        ----------
+        target : NDArray
+            The target array to be copied, must have same shape as this array.
+
+        Returns
+        -------
+        target : NDArray
+            Reference to target.
+        """
+        _ffi_api.NDArrayConvertDType(self, target)
+        return target
+
 
 def device(dev_type, dev_id=0):
     """Construct a TVM device with given device type and id.
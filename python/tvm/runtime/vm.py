@@ -20,6 +20,8 @@ The Relay Virtual Machine runtime.
 
 Implements a Python interface to executing the compiled VM object.
 """
+from concurrent.futures import Future
+
 import numpy as np
 
 import tvm
@@ -622,3 +624,81 @@ class VirtualMachine(object):
         return self.module.time_evaluator(
             "invoke", device, repeat=repeat, number=number, min_repeat_ms=min_repeat_ms
         )(func_name)
+
+
+class BatchingServer(object):
+    """Server batching individual requests into invocations of a VM function.
+
+    A worker thread concatenates the inputs of queued requests along their outer
+    axis and invokes the function once per batch, so the function must accept a
+    dynamic batch axis, for instance through ``relay.Any()``. Each output of the
+    function must have the batch axis outermost; it is split back into the outputs
+    of the requests without a copy. A batch runs once it holds ``max_batch_size``
+    rows or once its oldest request has waited ``timeout_us`` microseconds.
+
+    The server is the only user of the virtual machine while it runs.
+
+    Parameters
+    ----------
+    vm : VirtualMachine
+        The virtual machine running the function.
+
+    func_name : str
+        The name of the function.
+
+    max_batch_size : int
+        The number of rows above which no more requests join a batch.
+
+    timeout_us : int
+        How long the oldest request of a batch waits for others to join it.
+    """
+
+    def __init__(self, vm, func_name="main", max_batch_size=8, timeout_us=1000):
+        self.module = _ffi_api._VMBatchingServer(vm.module, func_name, max_batch_size, timeout_us)
+        self._submit = self.module["submit"]
+        self._num_batches = self.module["num_batches"]
+
+    def submit(self, *args):
+        """Queue a request.
+
+        Parameters
+        ----------
+        args : list[tvm.runtime.NDArray] or list[np.ndarray]
+            The inputs of the request, with the same extent of the outer axis.
+
+        Returns
+        -------
+        result : concurrent.futures.Future
+            The future output of the function for the rows of the request.
+        """
+        future = Future()
+
+        def _done(outputs, error):
+            if error:
+                future.set_exception(_base.TVMError(error))
+            else:
+                future.set_result(outputs)
+
+        inputs = [tvm.nd.array(arg) if isinstance(arg, np.ndarray) else arg for arg in args]
+        self._submit(_done, *inputs)
+        return future
+
+    def infer(self, *args):
+        """Run a request and wait for its output.
+
+        Parameters
+        ----------
+        args : list[tvm.runtime.NDArray] or list[np.ndarray]
+            The inputs of the request, with the same extent of the outer axis.
+
+        Returns
+        -------
+        result : Object
+            The output of the function for the rows of the request.
+        """
+        return self.submit(*args).result()
+
+    @property
+    def num_batches(self):
+        """The number of batches run so far."""
+        return self._num_batches()
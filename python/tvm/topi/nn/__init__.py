@@ -50,3 +50,4 @@ from .space_to_depth import *
 from .space_to_batch_nd import *
 from .batch_to_space_nd import *
 from .loss import *
+from .embedding_bag import *
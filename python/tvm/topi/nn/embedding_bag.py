@@ -0,0 +1,85 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Embedding bag operator"""
+from tvm import te, tir
+
+
+def embedding_bag(weight, indices, offsets, mode="sum", scale=1.0):
+    """Pooled embedding lookup.
+
+    Bag `b` pools the rows of `weight` selected by `indices[offsets[b]:offsets[b + 1]]`,
+    the last bag ends at the end of `indices`. Empty bags are zero.
+
+    Parameters
+    ----------
+    weight : tvm.te.Tensor
+        2-D tensor with shape [num_rows, dim], float32, float16 or int8.
+
+    indices : tvm.te.Tensor
+        1-D int tensor with shape [num_indices].
+
+    offsets : tvm.te.Tensor
+        1-D tensor of the same type as indices with shape [num_bags].
+
+    mode : str
+        How the rows of a bag are pooled, "sum" or "mean".
+
+    scale : float
+        Factor applied to the pooled rows, e.g. the dequantization scale of an int8 table.
+
+    Returns
+    -------
+    output : tvm.te.Tensor
+        2-D float32 tensor with shape [num_bags, dim].
+    """
+    assert mode in ("sum", "mean"), "mode must be sum or mean, but got %s" % mode
+
+    def gen_ir(weight, indices, offsets, out):
+        ib = tir.ir_builder.create()
+        num_indices = indices.shape[0]
+        num_bags, dim = out.shape
+        weight = ib.buffer_ptr(weight)
+        indices = ib.buffer_ptr(indices)
+        offsets = ib.buffer_ptr(offsets)
+        out = ib.buffer_ptr(out)
+
+        with ib.for_range(0, num_bags, name="b", kind="parallel") as b:
+            begin = offsets[b].astype("int64")
+            end = tir.Select(
+                b + 1 < num_bags, offsets[b + 1].astype("int64"), tir.const(num_indices, "int64")
+            )
+            with ib.for_range(0, dim, name="d") as d:
+                out[b * dim + d] = tir.const(0, "float32")
+            with ib.for_range(0, end - begin, name="i") as i:
+                row = indices[begin + i].astype("int64")
+                with ib.for_range(0, dim, name="d") as d:
+                    out[b * dim + d] += weight[row * dim + d].astype("float32")
+            factor = tir.const(scale, "float32")
+            if mode == "mean":
+                factor = factor / tir.max(end - begin, 1).astype("float32")
+            with ib.for_range(0, dim, name="d") as d:
+                out[b * dim + d] *= factor
+
+        return ib.get()
+
+    return te.extern(
+        (offsets.shape[0], weight.shape[1]),
+        [weight, indices, offsets],
+        lambda ins, outs: gen_ir(ins[0], ins[1], ins[2], outs[0]),
+        name="embedding_bag",
+        dtype="float32",
+    )
@@ -28,7 +28,7 @@ from tvm.contrib import mkldnn
 
 from .utils import get_simd_32bit_lanes
 from .. import generic, tag
-from ..utils import traverse_inline, get_const_tuple
+from ..utils import traverse_inline, get_const_tuple, get_const_int
 
 
 def _schedule_dense_pack_template(cfg, s, C, O):
@@ -328,6 +328,25 @@ def schedule_dense_mkl(_, outs):
     return generic.schedule_extern(outs)
 
 
+@autotvm.register_topi_compute("dense_mkl_packed.x86")
+def dense_mkl_packed(cfg, data, packed_weight, units, bias=None, out_dtype=None):
+    """Compute dense using mkl with a weight packed by mkl.pack_matrix."""
+    M, K = get_const_tuple(data.shape)
+    N = get_const_int(units)
+    if isinstance(M, int) and isinstance(K, int):
+        cfg.add_flop(M * K * N * 2)
+    C = mkl.matmul_packed(data, packed_weight, N)
+    if bias is not None:
+        C = te.compute(C.shape, lambda i, j: C[i, j] + bias[j].astype(out_dtype), tag=tag.BROADCAST)
+    return C
+
+
+@autotvm.register_topi_schedule("dense_mkl_packed.x86")
+def schedule_dense_mkl_packed(_, outs):
+    """Create schedule for dense_mkl_packed."""
+    return generic.schedule_extern(outs)
+
+
 @autotvm.register_topi_compute("dense_mkldnn.x86")
 def dense_mkldnn(cfg, data, weight, bias=None, out_dtype=None):
     """Compute dense using mkldnn. This is an alias of matmul_nt operator."""
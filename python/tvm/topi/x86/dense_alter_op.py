@@ -21,6 +21,7 @@ import tvm
 from tvm import te
 from tvm import relay
 from tvm import autotvm
+from tvm.contrib import mkl
 from .dense import _default_dense_pack_config
 from ..utils import get_const_tuple
 from ..nn import dense_alter_layout
@@ -64,5 +65,18 @@ def _alter_dense_layout(attrs, inputs, tinfos, out_type):
             )
             dispatch_ctx.update(target, new_workload, cfg)
             return relay.nn.contrib_dense_pack(inputs[0], inputs[1], weight_layout, None, out_dtype)
+        if (
+            topi_impl == "dense_mkl.x86"
+            and isinstance(inputs[1], relay.Constant)
+            and isinstance(M, int)
+            and data_tensor.dtype == weight_tensor.dtype == out_dtype == "float32"
+            and tvm.get_global_func("tvm.contrib.mkl.pack_matrix", allow_missing=True)
+        ):
+            # The weight is bound at compile time, so pack it for MKL once, into a constant of
+            # the module, instead of on every call. Packing needs MKL on the compiling machine.
+            packed_weight = mkl.pack_matrix(inputs[1].data, M, transb=True)
+            return relay.nn.contrib_dense_mkl_packed(
+                inputs[0], relay.const(packed_weight), N, out_dtype
+            )
 
     return None
@@ -18,7 +18,9 @@
 """sparse_dense schedule on x86"""
 from functools import partial, reduce
 from tvm import te, tir, autotvm
+from tvm.contrib import sparse
 
+from .. import generic
 from ..transform import reshape
 from ..utils import traverse_inline, get_const_int
 from .utils import get_simd_32bit_lanes
@@ -64,6 +66,27 @@ def schedule_sparse_dense(outs):
     return s
 
 
+def sparse_dense_bsr_contrib(data, weight_data, weight_indices, weight_indptr, sparse_lhs=False):
+    """Compute sparse_dense with a BSR weight using the CPU kernels of contrib.sparse"""
+    assert not sparse_lhs, "contrib.sparse only supports a sparse right hand side"
+    return sparse.bsr_dense(data, weight_data, weight_indices, weight_indptr)
+
+
+def schedule_sparse_dense_bsr_contrib(outs):
+    """Create schedule for sparse_dense_bsr_contrib"""
+    return generic.schedule_extern(outs)
+
+
+def embedding_bag_contrib(weight, indices, offsets, mode="sum", scale=1.0):
+    """Compute embedding_bag using the CPU kernel of contrib.sparse"""
+    return sparse.embedding_bag(weight, indices, offsets, mode, scale)
+
+
+def schedule_embedding_bag_contrib(outs):
+    """Create schedule for embedding_bag_contrib"""
+    return generic.schedule_extern(outs)
+
+
 @autotvm.register_topi_compute("conv3x3_spNHWC.x86")
 def spconv2d_3x3_nhwc(cfg, data, wdat, wind, wptr, layout="NHWC"):
     """Sparse Conv2d 3x3 compute (NHWC)."""
@@ -27,6 +27,7 @@
 #include <tvm/relay/attrs/call.h>
 #include <tvm/relay/executor.h>
 #include <tvm/relay/expr_functor.h>
+#include <tvm/runtime/data_type.h>
 #include <tvm/runtime/device_api.h>
 #include <tvm/runtime/object.h>
 #include <tvm/tir/analysis.h>
@@ -38,9 +39,11 @@
 
 #include <algorithm>
 #include <list>
+#include <sstream>
 #include <string>
 #include <vector>
 
+#include "../../runtime/aot_executor/aot_executor.h"
 #include "../op/annotation/annotation.h"
 #include "../op/call/call.h"
 #include "../op/memory/device_copy.h"
@@ -871,9 +874,50 @@ class AOTExecutorCodegen : public MixedModeVisitor {
     ret.metadata =
         runtime::Metadata(input_var_names, ListDevices(), return_sid_.size(),
                           runtime::kTvmExecutorAot, mod_name, interface_api, use_unpacked_api_);
+    // The AOT executor reads the interface of the main function from the config, which takes the
+    // place of the graph JSON of the graph executor. It can only call a packed main function.
+    if (!use_unpacked_api_) {
+      ret.graph_json = ExecutorConfigJSON(lowered_main_func, mod_name);
+    }
     return ret;
   }
 
+  /*!
+   * \brief Describe the inputs and outputs of the main function for the AOT executor.
+   * \param main The lowered main function.
+   * \param mod_name The module name of the model.
+   * \return The AotExecutorConfig of the model, as JSON.
+   */
+  std::string ExecutorConfigJSON(const Function& main, const String& mod_name) {
+    auto tensor_info = [](const std::string& name, const TensorType& ttype) {
+      runtime::AotTensorInfo info;
+      info.name = name;
+      for (const PrimExpr& dim : ttype->shape) {
+        const auto* extent = dim.as<IntImmNode>();
+        ICHECK(extent) << "The AOT executor requires static shapes, but " << name
+                       << " has shape " << ttype->shape;
+        info.shape.push_back(extent->value);
+      }
+      info.dtype = runtime::DLDataType2String(ttype->dtype);
+      return info;
+    };
+    runtime::AotExecutorConfig config;
+    config.mod_name = mod_name;
+    for (const Var& param : main->params) {
+      config.inputs.push_back(
+          tensor_info(param->name_hint(), Downcast<TensorType>(param->checked_type())));
+    }
+    std::vector<TensorType> output_types = FlattenTupleType(main->body->checked_type());
+    ICHECK_EQ(output_types.size(), return_sid_.size());
+    for (size_t i = 0; i < output_types.size(); ++i) {
+      config.outputs.push_back(tensor_info("output" + std::to_string(i), output_types[i]));
+    }
+    std::ostringstream os;
+    dmlc::JSONWriter writer(&os);
+    config.Save(&writer);
+    return os.str();
+  }
+
   /*!
    * \brief Get list of devices found
    * \return List of devices
@@ -935,6 +979,9 @@ class AOTExecutorCodegenModule : public runtime::ModuleNode {
     } else if (name == "get_metadata") {
       return PackedFunc(
           [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = output_.metadata; });
+    } else if (name == "get_executor_config") {
+      return PackedFunc(
+          [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = output_.graph_json; });
     } else {
       return PackedFunc([](TVMArgs args, TVMRetValue* rv) {});
     }
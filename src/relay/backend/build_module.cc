@@ -127,7 +127,10 @@ struct AOTCodegen : ExecutorCodegen {
     mod = (*pf)();
   }
 
-  void UpdateOutput(BuildOutput* ret) override { ret->graph_json = ""; }
+  void UpdateOutput(BuildOutput* ret) override { ret->graph_json = GetExecutorConfig(); }
+
+  /*! \brief The interface of the main function, which the AOT executor loads from the library. */
+  std::string GetExecutorConfig() { return CallFunc<std::string>("get_executor_config", nullptr); }
 
   ~AOTCodegen() {}
 };
@@ -37,6 +37,14 @@
 #include <tvm/runtime/object.h>
 #include <tvm/target/compilation_config.h>
 
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "../op/annotation/annotation.h"
 #include "../op/call/call.h"
 #include "../op/memory/device_copy.h"
@@ -197,52 +205,62 @@ TVM_STATIC_IR_FUNCTOR(ReprPrinter, vtable)
       p->stream << "ConstructorValueObj(" << node->tag << "," << node->fields << ")";
     });
 
+/*! \brief The values of the variables of a function during one of its calls, indexed by slot. */
+using Frame = std::vector<ObjectRef>;
+
+/*! \brief An expression compiled to a closure evaluating it in the frame of its function. */
+using Code = std::function<ObjectRef(Frame* frame)>;
+
 /*!
- * \brief A stack frame in the Relay interpreter.
- *
- * Contains a mapping from relay::Var to relay::ObjectRef.
+ * \brief A pattern compiled to a closure matching a value against it, which binds the pattern
+ * variables in the frame of its function.
  */
-struct Frame {
-  /*! \brief The set of local variables and arguments for the frame. */
-  Map<Var, ObjectRef> locals;
-
-  explicit Frame(Map<Var, ObjectRef> locals) : locals(locals) {}
-};
+using Matcher = std::function<bool(const ObjectRef& value, Frame* frame)>;
 
 /*!
- * \brief The call stack in the Relay interpreter.
+ * \brief A Relay function compiled by the interpreter.
  *
- * Contains a stack of frames; each corresponding to
- * a function call.
+ * The variables of the function are resolved to slots of its frame when it is compiled: the
+ * parameters come first, then the free variables, then the variables bound by lets and patterns.
+ * The body is compiled once and shared by all the closures over the function.
  */
-struct Stack {
-  /*! \brief The stack frames. */
-  std::vector<Frame> frames;
-  Stack() : frames() { frames.push_back(Frame({})); }
-
-  Frame& current_frame() { return frames.back(); }
-
-  ObjectRef Lookup(const Var& local) {
-    for (auto frame = frames.rbegin(); frame != frames.rend(); frame++) {
-      auto elem = frame->locals.find(local);
-      if (elem != frame->locals.end()) {
-        return (*elem).second;
-      }
-    }
+struct CompiledFunction {
+  /*! \brief The function, undefined for an expression evaluated at the top level. */
+  Function func;
+  /*! \brief The variable of each slot. */
+  std::vector<Var> slot_vars;
+  /*! \brief The free variables, which take the slots following the parameters. */
+  Array<Var> free_vars;
+  /*! \brief The compiled body, undefined for primitive functions. */
+  Code body;
+  /*! \brief The call to the debug operator, if the function is the primitive wrapping it. */
+  const CallNode* debug_call = nullptr;
+};
 
-    LOG(FATAL) << "could not find variable binding for " << local
-               << "address= " << local.operator->();
-    return ObjectRef();
-  }
-  /*!
-   * A wrapper around Frame to add RAII semantics to pushing and popping
-   * stack frames.
-   */
-  struct LocalFrame {
-    Stack& st;
-    explicit LocalFrame(Stack& st, const Frame& fr) : st(st) { st.frames.push_back(fr); }
-    ~LocalFrame() { st.frames.pop_back(); }
-  };
+/*!
+ * \brief A call to a lowered primitive. The attributes of call_lowered are decoded when the call
+ * is compiled, and the packed function is looked up on its first evaluation.
+ */
+struct PrimitiveCall {
+  GlobalVar prim_fn_var;
+  Array<GlobalVar> all_prim_fn_vars;
+  Target prim_target;
+  GlobalVar prim_shape_fn_var;
+  Array<GlobalVar> all_prim_shape_fn_vars;
+  Array<Integer> prim_shape_fn_states;
+  size_t num_shape_inputs = 0;
+  size_t num_shape_outputs = 0;
+  Target prim_shape_target;
+  /*! \brief The return type of the primitive. */
+  Type ret_type;
+  /*! \brief The tensor types of the flattened results. */
+  std::vector<TensorType> result_tensor_types;
+  /*! \brief Whether the shapes of the results come from the shape function. */
+  bool is_dyn = false;
+  /*! \brief The shapes of the results, unless they are dynamic. */
+  std::vector<std::vector<int64_t>> static_shapes;
+  /*! \brief The packed function implementing the primitive. */
+  PackedFunc packed_func;
 };
 
 /*! \brief A representation of the interpreter state which can be passed back to Python. */
@@ -293,8 +311,12 @@ InterpreterState::InterpreterState(Expr current_expr, InterpreterState::Stack st
 // contains DAG in dataflow-form.
 //
 // Conversion to ANF is recommended before running the interpretation.
-class Interpreter : public ExprFunctor<ObjectRef(const Expr& n)>,
-                    PatternFunctor<bool(const Pattern& p, const ObjectRef& v)> {
+//
+// Functions are compiled on their first call to a tree of closures by FunctionCompiler, with
+// variables resolved to slots of a flat frame, global functions to their closures and calls to
+// primitives to their PrimitiveCall. Evaluation then runs the closures without walking the
+// Relay IR, looking up variables in maps or re-decoding the attributes of call_lowered.
+class Interpreter {
  public:
   Interpreter(IRModule unified_mod, CompilationConfig config, Device device)
       : unified_mod_(unified_mod),
@@ -302,69 +324,80 @@ class Interpreter : public ExprFunctor<ObjectRef(const Expr& n)>,
         device_(device),
         debug_op_(Op::Get("debug")) {}
 
-  template <typename T>
-  T WithFrame(const Frame& fr, const std::function<T()>& f) {
-    Stack::LocalFrame lf(stack_, fr);
-    return f();
+  /*! \brief Evaluate \p expr, which must not reference local variables. */
+  ObjectRef Eval(const Expr& expr) {
+    std::unique_ptr<CompiledFunction> compiled = CompileTopLevel(expr);
+    Frame frame(compiled->slot_vars.size());
+    CallFrame call_frame(this, compiled.get(), &frame);
+    return compiled->body(&frame);
   }
 
-  void extend(const Var& id, ObjectRef v) { stack_.current_frame().locals.Set(id, v); }
-
-  ObjectRef Lookup(const Var& local) { return stack_.Lookup(local); }
-
-  ObjectRef Eval(const Expr& expr) { return VisitExpr(expr); }
-
-  ObjectRef VisitExpr_(const VarNode* var_node) final { return Lookup(GetRef<Var>(var_node)); }
-
-  ObjectRef VisitExpr_(const GlobalVarNode* op) final {
-    return Eval(unified_mod_->Lookup(GetRef<GlobalVar>(op)));
+  /*!
+   * \brief Invoke \p closure with \p args. If \p bind is defined then this is a recursive
+   * closure and \p bind should refer to itself.
+   */
+  ObjectRef Invoke(const InterpreterClosure& closure, const Array<ObjectRef>& args,
+                   const Var& bind = Var()) {
+    std::vector<ObjectRef> arg_values(args.begin(), args.end());
+    return Invoke(*GetCompiled(closure->func), closure, arg_values, bind);
   }
 
-  ObjectRef VisitExpr_(const OpNode* id) override {
-    // TODO(@jroesch): Eta-expand and return in this case.
-    LOG(FATAL) << "internal error, need to wrap intrinsic into call synthetic call node "
-               << "in this case, eta expand";
-    return ObjectRef();
-  }
+  /*!
+   * \brief Invoke \p closure, whose function is compiled to \p compiled, with \p args. If \p bind
+   * is defined then this is a recursive closure and \p bind should refer to itself.
+   */
+  ObjectRef Invoke(const CompiledFunction& compiled, const InterpreterClosure& closure,
+                   const std::vector<ObjectRef>& args, const Var& bind) {
+    ICHECK_EQ(compiled.func->params.size(), args.size());
 
-  ObjectRef VisitExpr_(const ConstantNode* op) final { return op->data.CopyTo(device_); }
+    if (compiled.debug_call != nullptr) {
+      // Special case: Calling the debug tracing function.
+      auto dattrs = compiled.debug_call->attrs.as<DebugAttrs>();
+      auto interp_state = get_state(compiled.debug_call->args[0]);
 
-  ObjectRef VisitExpr_(const TupleNode* op) final {
-    std::vector<ObjectRef> values;
+      if (dattrs->debug_func.defined()) {
+        dattrs->debug_func(interp_state);
+      } else {
+        RELAY_DEBUG_INTERP(interp_state);
+      }
 
-    for (const auto& field : op->fields) {
-      ObjectRef field_value = Eval(field);
-      values.push_back(field_value);
+      return args[0];
     }
 
-    return ADT::Tuple(values);
-  }
-
-  ObjectRef MakeClosure(const Function& func, Var letrec_name = Var()) {
-    Map<Var, ObjectRef> captured_mod;
-    Array<Var> free_vars = FreeVars(func);
+    ICHECK(compiled.body != nullptr)
+        << "Calls to primitive functions should have been removed by lowering";
 
-    for (const auto& var : free_vars) {
-      // Evaluate the free var (which could be a function call) if it hasn't
-      // shown up in a letting binding that has invoked the function.
-      if (letrec_name.defined() && letrec_name == var) {
-        continue;
+    // Allocate a frame with the parameters and free variables.
+    Frame frame(compiled.slot_vars.size());
+    std::copy(args.begin(), args.end(), frame.begin());
+    size_t slot = args.size();
+    for (const Var& var : compiled.free_vars) {
+      if (bind.defined() && var.same_as(bind)) {
+        frame[slot++] = RecClosure(closure, bind);
+      } else {
+        auto it = closure->env.find(var);
+        ICHECK(it != closure->env.end())
+            << "could not find variable binding for " << var << "address= " << var.operator->();
+        frame[slot++] = (*it).second;
       }
-
-      captured_mod.Set(var, Eval(var));
     }
 
-    // We must use mutation here to build a self referential closure.
-    InterpreterClosure closure(captured_mod, func);
-    if (letrec_name.defined()) {
-      return RecClosure(closure, letrec_name);
-    }
-    return std::move(closure);
+    CallFrame call_frame(this, &compiled, &frame);
+    return compiled.body(&frame);
   }
 
-  ObjectRef VisitExpr_(const FunctionNode* func_node) final {
-    auto func = GetRef<Function>(func_node);
-    return MakeClosure(func);
+  /*! \brief Returns \p func compiled, compiling it on its first call. */
+  const CompiledFunction* GetCompiled(const Function& func);
+
+  /*! \brief Returns the closure of the global function bound to \p var. */
+  ObjectRef GlobalValue(const GlobalVar& var) {
+    auto it = global_values_.find(var);
+    if (it != global_values_.end()) {
+      return it->second;
+    }
+    ObjectRef value = Eval(unified_mod_->Lookup(var));
+    global_values_.emplace(var, value);
+    return value;
   }
 
   /*!
@@ -386,7 +419,9 @@ class Interpreter : public ExprFunctor<ObjectRef(const Expr& n)>,
       return packed_itr->second;
     }
 
-    // Project out just the function(s) we need.
+    // Project out all the functions lowered for the target, so that an expression calling
+    // many primitives (such as the batch of sub-expressions FoldConstant evaluates) is
+    // compiled by a single build rather than one per primitive.
     IRModule lowered_projected_mod;
     Map<Target, IRModule> per_target_module = tec::GetPerTargetModules(unified_mod_);
     std::unordered_map<Target, IRModule, backend::TargetStrHash, backend::TargetStrEqual>
@@ -399,7 +434,9 @@ class Interpreter : public ExprFunctor<ObjectRef(const Expr& n)>,
       ICHECK(target_module->ContainGlobalVar(var->name_hint))
           << "No global var for '" << var->name_hint << "' in module for target "
           << target->ToDebugString();
-      lowered_projected_mod->Add(var, target_module->Lookup(var->name_hint));
+    }
+    for (const auto& kv : target_module->functions) {
+      lowered_projected_mod->Add(kv.first, kv.second);
     }
 
     // Compile (aka 'build') the projected module into a runtime module of packed functions.
@@ -412,7 +449,8 @@ class Interpreter : public ExprFunctor<ObjectRef(const Expr& n)>,
     }
 
     // Extract all the packed functions.
-    for (const auto& var : all_tir_fn_vars) {
+    for (const auto& kv : lowered_projected_mod->functions) {
+      const GlobalVar& var = kv.first;
       PackedFunc packed_func = runtime_module.GetFunction(var->name_hint);
       ICHECK(packed_func != nullptr)
           << "No packed function for global var '" << var->name_hint
@@ -559,43 +597,78 @@ class Interpreter : public ExprFunctor<ObjectRef(const Expr& n)>,
   }
 
   /*!
-   * \brief Call primitive op bound to \p prim_fn_var with \p args. If necessary, evaluate dynamic
-   * shape function bound to \p prim_shape_fn_var to calculate shapes of result tensors.
+   * \brief Decode the attributes of the call_lowered call described by \p props.
+   */
+  std::shared_ptr<PrimitiveCall> MakePrimitiveCall(const CallLoweredProps& props) {
+    auto call = std::make_shared<PrimitiveCall>();
+    call->prim_fn_var = props.lowered_func;
+    // TODO(mbs): Make calling convention first-class in Relay.
+    const auto& metadata = props.attrs.metadata;
+    if (metadata.count("all_prim_fn_vars")) {
+      call->all_prim_fn_vars = Downcast<Array<GlobalVar>>(metadata.at("all_prim_fn_vars"));
+    }
+    if (metadata.count("prim_shape_fn_var")) {
+      call->prim_shape_fn_var = Downcast<GlobalVar>(metadata.at("prim_shape_fn_var"));
+    }
+    if (metadata.count("all_prim_shape_fn_vars")) {
+      call->all_prim_shape_fn_vars =
+          Downcast<Array<GlobalVar>>(metadata.at("all_prim_shape_fn_vars"));
+    }
+    if (metadata.count("prim_shape_fn_states")) {
+      call->prim_shape_fn_states = Downcast<Array<Integer>>(metadata.at("prim_shape_fn_states"));
+    }
+    if (metadata.count("prim_shape_fn_num_inputs")) {
+      call->num_shape_inputs = static_cast<size_t>(
+          Downcast<Integer>(metadata.at("prim_shape_fn_num_inputs"))->value);
+    }
+    if (metadata.count("prim_shape_fn_num_outputs")) {
+      call->num_shape_outputs = static_cast<size_t>(
+          Downcast<Integer>(metadata.at("prim_shape_fn_num_outputs"))->value);
+    }
+    ICHECK(config_->optional_homogeneous_target.defined());
+    call->prim_target = config_->optional_homogeneous_target;
+    call->prim_shape_target = config_->host_se_scope->target;
+
+    ICHECK(call->prim_fn_var->checked_type().defined());
+    const FuncTypeNode* ftn = call->prim_fn_var->checked_type().as<FuncTypeNode>();
+    ICHECK(ftn);
+    call->ret_type = ftn->ret_type;
+    // TVM's primitive calling convention is for the final arguments to be for output
+    // buffers. We must allocate space for those buffers based on the return type.
+    call->result_tensor_types = FlattenTupleType(ftn->ret_type);
+    call->is_dyn = IsDynamic(ftn->ret_type);
+    if (call->is_dyn) {
+      ICHECK(call->prim_shape_fn_var.defined());
+      ICHECK(call->prim_shape_fn_states.defined());
+    } else {
+      for (const auto& ttype : call->result_tensor_types) {
+        call->static_shapes.push_back(ConcreteShape(ttype->shape));
+      }
+    }
+    return call;
+  }
+
+  /*!
+   * \brief Call the primitive of \p call with \p args. If necessary, evaluate its dynamic
+   * shape function to calculate shapes of result tensors.
    *
-   * @param prim_fn_var Global bound to lowered primitive.
-   * @param all_prim_fn_vars  All globals references by lowered primitive, plus prim_fn_var itself.
-   * @param prim_shape_fn_var Global bound to lowered shape function for primitive, if needed.
-   * @param all_prim_shape_fn_vars All globals references by lowered shape function, plus
-   * prim_shape_fn_var itself.
-   * @param prim_shape_fn_states Records whether shape and/or data is needed by the dynamic
-   * shape function (if any) for each (flattened) argument.
-   * @param num_shape_inputs Number of arguments to the dynamic shape function (if any).
-   * @param num_shape_outputs Number of outputs from the dynamic shape function (if any).
+   * @param call The primitive call.
    * @param args Already evaluated arguments to primitive.
    * @return Result of primitive.
    */
-  ObjectRef InvokePrimitiveOp(const GlobalVar& prim_fn_var, const Array<GlobalVar> all_prim_fn_vars,
-                              Target prim_target, const GlobalVar& prim_shape_fn_var,
-                              const Array<GlobalVar>& all_prim_shape_fn_vars,
-                              const Array<Integer>& prim_shape_fn_states, size_t num_shape_inputs,
-                              size_t num_shape_outputs, Target prim_shape_target,
-                              const std::vector<ObjectRef>& args) {
-    ICHECK(prim_fn_var->checked_type().defined());
-    const FuncTypeNode* ftn = prim_fn_var->checked_type().as<FuncTypeNode>();
-    ICHECK(ftn);
-
-    // 'Compile' the TIR primitive to appropriate callable form (on the desired target).
-    PackedFunc packed_func = TIRToPackedFunc(prim_fn_var, all_prim_fn_vars, prim_target);
+  ObjectRef InvokePrimitiveOp(PrimitiveCall* call, const std::vector<ObjectRef>& args) {
+    if (call->packed_func == nullptr) {
+      // 'Compile' the TIR primitive to appropriate callable form (on the desired target).
+      call->packed_func = TIRToPackedFunc(call->prim_fn_var, call->all_prim_fn_vars,
+                                          call->prim_target);
+    }
 
     // Argument tuples are flattened.
     std::vector<NDArray> arg_nd_arrays = FlattenADTs(args);
     const size_t num_inputs = arg_nd_arrays.size();
     // num_inputs should equal size(concat(map(FlattenTupleType, function arg types)))
 
-    // TVM's primitive calling convention is for the final arguments to be for output
-    // buffers. We must allocate space for those buffers based on the return type.
-    std::vector<TensorType> result_tensor_types = FlattenTupleType(ftn->ret_type);
-    const size_t arg_len = num_inputs + result_tensor_types.size();
+    const size_t arg_len = num_inputs + call->result_tensor_types.size();
 
     std::vector<TVMValue> values(arg_len);
     std::vector<int> codes(arg_len);
@@ -613,331 +686,517 @@ class Interpreter : public ExprFunctor<ObjectRef(const Expr& n)>,
     // If necessary, retrieve concrete shapes for outputs from shape function rather
     // than relying on TensorType shapes.
     Array<Shape> runtime_shapes;
-    bool is_dyn = IsDynamic(ftn->ret_type);
-    if (is_dyn) {
-      ICHECK(prim_shape_fn_var.defined());
-      ICHECK(prim_shape_fn_states.defined());
-      runtime_shapes =
-          ComputeDynamicShape(prim_shape_fn_var, all_prim_shape_fn_vars, prim_shape_fn_states,
-                              num_shape_inputs, num_shape_outputs, prim_shape_target, args);
-      ICHECK_EQ(runtime_shapes.size(), result_tensor_types.size());
+    if (call->is_dyn) {
+      runtime_shapes = ComputeDynamicShape(
+          call->prim_shape_fn_var, call->all_prim_shape_fn_vars, call->prim_shape_fn_states,
+          call->num_shape_inputs, call->num_shape_outputs, call->prim_shape_target, args);
+      ICHECK_EQ(runtime_shapes.size(), call->result_tensor_types.size());
     }
 
     // Prepare the result tensors for the call.
     TVMRetValue rv;  // ignored
     std::vector<NDArray> result_nd_arrays;
-    for (size_t i = 0; i < result_tensor_types.size(); ++i) {
-      const auto& ttype = result_tensor_types[i];
-      const Shape& shape = is_dyn ? runtime_shapes[i] : ttype->shape;
+    for (size_t i = 0; i < call->result_tensor_types.size(); ++i) {
       // Allocate output tensor of appropriate shape.
-      std::vector<int64_t> concrete_shape;
-      for (const auto& dim : shape) {
-        const auto* ivalue = tir::as_const_int(dim);
-        ICHECK(ivalue) << "expected concrete dimensions";
-        concrete_shape.push_back(ivalue[0]);
-      }
-      NDArray nd_array = NDArray::Empty(concrete_shape, ttype->dtype, device_);
+      NDArray nd_array = NDArray::Empty(
+          call->is_dyn ? ConcreteShape(runtime_shapes[i]) : call->static_shapes[i],
+          call->result_tensor_types[i]->dtype, device_);
       setter(num_inputs + i, nd_array);
       result_nd_arrays.emplace_back(nd_array);
     }
 
     // Call the primitive.
-    packed_func.CallPacked(TVMArgs(values.data(), codes.data(), static_cast<int>(arg_len)), &rv);
+    call->packed_func.CallPacked(
+        TVMArgs(values.data(), codes.data(), static_cast<int>(arg_len)), &rv);
 
     // Unflatten the results.
-    return ToADTOrNDArray(ftn->ret_type, result_nd_arrays);
+    return ToADTOrNDArray(call->ret_type, result_nd_arrays);
   }
 
-  /*!
-   * \brief Invoke \p closure with \p args. If \p bind is defined then this is a recursive
-   * closure and \p bind should refer to itself.
-   */
-  ObjectRef Invoke(const InterpreterClosure& closure, const Array<ObjectRef>& args,
-                   const Var& bind = Var()) {
-    // Get a reference to the function inside the closure.
-    Function func = closure->func;
-    ICHECK_EQ(func->params.size(), args.size());
-
-    if (func->HasNonzeroAttr(attr::kPrimitive)) {
-      if (const CallNode* call_node = closure->func->body.as<CallNode>()) {
-        if (call_node->op == debug_op_) {
-          // Special case: Calling the debug tracing function.
-          auto dattrs = call_node->attrs.as<DebugAttrs>();
-          auto interp_state = get_state(call_node->args[0]);
-
-          if (dattrs->debug_func.defined()) {
-            dattrs->debug_func(interp_state);
-          } else {
-            RELAY_DEBUG_INTERP(interp_state);
-          }
-
-          return args[0];
+  InterpreterState get_state(Expr e = Expr()) const {
+    InterpreterStateObj::Stack stack;
+    for (const auto& entry : call_stack_) {
+      const CompiledFunction* compiled = entry.first;
+      const Frame& locals = *entry.second;
+      InterpreterStateObj::Frame frame;
+      for (size_t i = 0; i < locals.size(); ++i) {
+        if (locals[i].defined()) {
+          frame.Set(compiled->slot_vars[i], locals[i]);
         }
       }
+      stack.push_back(frame);
     }
+    auto state = InterpreterState(e, stack);
+    return state;
+  }
 
-    ICHECK(!func->HasNonzeroAttr(attr::kPrimitive))
-        << "Calls to primitive functions should have been removed by lowering";
+ private:
+  friend class FunctionCompiler;
 
-    // Allocate a frame with the parameters and free variables.
-    Map<Var, ObjectRef> locals;
-    for (size_t i = 0; i < func->params.size(); i++) {
-      ICHECK_EQ(locals.count(func->params[i]), 0);
-      locals.Set(func->params[i], args[i]);
+  /*! \brief Pushes a frame on the call stack for the duration of a call. */
+  struct CallFrame {
+    CallFrame(Interpreter* interp, const CompiledFunction* compiled, Frame* frame)
+        : interp(interp) {
+      interp->call_stack_.emplace_back(compiled, frame);
+    }
+    ~CallFrame() { interp->call_stack_.pop_back(); }
+    Interpreter* interp;
+  };
+
+  /*! \brief Compile \p expr, evaluated at the top level, to a function without parameters. */
+  std::unique_ptr<CompiledFunction> CompileTopLevel(const Expr& expr);
+
+  /*! \brief The concrete dimensions of \p shape. */
+  static std::vector<int64_t> ConcreteShape(const Shape& shape) {
+    std::vector<int64_t> concrete_shape;
+    for (const auto& dim : shape) {
+      const auto* ivalue = tir::as_const_int(dim);
+      ICHECK(ivalue) << "expected concrete dimensions";
+      concrete_shape.push_back(ivalue[0]);
     }
+    return concrete_shape;
+  }
+
+  // Unified module. Functions are annotated with their target.
+  // All expressions are eval'ed w.r.t. the definitions in this module.
+  // This module contains functions that used to be in main_module and the per_target_module (TIR
+  // functions) in one module.
+  IRModule unified_mod_;
+  // Cached packed functions for the primitives and shape functions, keyed by target and
+  // global var name.
+  std::unordered_map<std::pair<Target, std::string>, PackedFunc, PairHash> compiled_packed_funcs_;
+  /*! \brief Compilation config describing the available targets. */
+  CompilationConfig config_;
+  // Unique device on which primitives (but not shape functions) will be executed.
+  // (For simplicity we only run the interpreter on a single device.)
+  Device device_;
+  // The compiled Relay functions, which also keeps them alive for the closures referring to them.
+  std::unordered_map<Function, std::unique_ptr<CompiledFunction>, ObjectPtrHash, ObjectPtrEqual>
+      compiled_funcs_;
+  // The closures of the global functions.
+  std::unordered_map<GlobalVar, ObjectRef, ObjectPtrHash, ObjectPtrEqual> global_values_;
+  // Call stack, the compiled function and frame of each call in progress.
+  std::vector<std::pair<const CompiledFunction*, Frame*>> call_stack_;
+  // The distinguished 'debug' operator, which is handled specially.
+  const Op& debug_op_;
+};
 
-    // Add the var to value mappings from the Closure's environment.
-    for (auto it = closure->env.begin(); it != closure->env.end(); ++it) {
-      ICHECK_EQ(locals.count((*it).first), 0);
-      locals.Set((*it).first, (*it).second);
+/*!
+ * \brief Compiles a Relay function, or an expression evaluated at the top level, to closures over
+ * the frame of its calls.
+ */
+class FunctionCompiler : public ExprFunctor<Code(const Expr& n)>,
+                         PatternFunctor<Matcher(const Pattern& p)> {
+ public:
+  FunctionCompiler(Interpreter* interp, CompiledFunction* compiled)
+      : interp_(interp), compiled_(compiled) {}
+
+  void CompileFunction(const Function& func) {
+    compiled_->func = func;
+    for (const Var& param : func->params) {
+      Bind(param);
+    }
+    compiled_->free_vars = FreeVars(func);
+    for (const Var& var : compiled_->free_vars) {
+      Bind(var);
+    }
+    if (func->HasNonzeroAttr(attr::kPrimitive)) {
+      // Calls to primitives are lowered, except for the debug operator.
+      const auto* call_node = func->body.as<CallNode>();
+      if (call_node != nullptr && call_node->op == interp_->debug_op_) {
+        compiled_->debug_call = call_node;
+      }
+      return;
     }
+    compiled_->body = VisitExpr(func->body);
+  }
 
-    if (bind.defined()) {
-      locals.Set(bind, RecClosure(closure, bind));
+  void CompileTopLevel(const Expr& expr) { compiled_->body = VisitExpr(expr); }
+
+ private:
+  /*! \brief Evaluate \p codes in order. */
+  static std::vector<ObjectRef> EvalAll(const std::vector<Code>& codes, Frame* frame) {
+    std::vector<ObjectRef> values;
+    values.reserve(codes.size());
+    for (const Code& code : codes) {
+      values.push_back(code(frame));
     }
+    return values;
+  }
 
-    return WithFrame<ObjectRef>(Frame(locals), [&]() { return Eval(func->body); });
+  /*! \brief Code raising \p message when it is evaluated. */
+  static Code Fail(const std::string& message) {
+    return [message](Frame* frame) -> ObjectRef {
+      LOG(FATAL) << message;
+      return ObjectRef();
+    };
   }
 
-  ObjectRef VisitExpr_(const CallNode* call_node) final {
-    DeviceCopyProps device_copy_props = GetDeviceCopyProps(call_node);
-    CallLoweredProps call_lowered_props = GetCallLoweredProps(call_node);
+  /*! \brief Give \p var a new slot of the frame. */
+  size_t Bind(const Var& var) {
+    size_t slot = compiled_->slot_vars.size();
+    compiled_->slot_vars.push_back(var);
+    slots_[var] = slot;
+    return slot;
+  }
 
-    if (device_copy_props.body.defined()) {
-      // TODO(mbs): device_copy cleanup
-      LOG(FATAL) << "The interpreter does not support device_copy";
-      return {};
-    } else if (call_lowered_props.lowered_func.defined()) {
-      // Special case: Call a lowered TIR function.
+  std::vector<Code> VisitExprs(const Array<Expr>& exprs) {
+    std::vector<Code> codes;
+    for (const Expr& expr : exprs) {
+      codes.push_back(VisitExpr(expr));
+    }
+    return codes;
+  }
 
-      // Evaluate only function args
-      std::vector<ObjectRef> args;
-      for (auto arg : call_lowered_props.arguments) {
-        args.push_back(Eval(arg));
-      }
+  Code VisitExpr_(const VarNode* var_node) final {
+    Var var = GetRef<Var>(var_node);
+    auto it = slots_.find(var);
+    if (it == slots_.end()) {
+      std::ostringstream os;
+      os << "could not find variable binding for " << var << "address= " << var.operator->();
+      return Fail(os.str());
+    }
+    size_t slot = it->second;
+    return [slot](Frame* frame) { return (*frame)[slot]; };
+  }
 
-      // TODO(mbs): Make calling convention first-class in Relay.
-      Array<GlobalVar> all_prim_fn_vars;
-      if (call_lowered_props.attrs.metadata.count("all_prim_fn_vars")) {
-        all_prim_fn_vars =
-            Downcast<Array<GlobalVar>>(call_lowered_props.attrs.metadata.at("all_prim_fn_vars"));
+  Code VisitExpr_(const GlobalVarNode* op) final {
+    Interpreter* interp = interp_;
+    GlobalVar var = GetRef<GlobalVar>(op);
+    // Global functions are resolved on their first evaluation, since they may be recursive.
+    auto value = std::make_shared<ObjectRef>();
+    return [interp, var, value](Frame* frame) {
+      if (!value->defined()) {
+        *value = interp->GlobalValue(var);
       }
-      GlobalVar prim_shape_fn_var;
-      if (call_lowered_props.attrs.metadata.count("prim_shape_fn_var")) {
-        prim_shape_fn_var =
-            Downcast<GlobalVar>(call_lowered_props.attrs.metadata.at("prim_shape_fn_var"));
-      }
-      Array<GlobalVar> all_prim_shape_fn_vars;
-      if (call_lowered_props.attrs.metadata.count("all_prim_shape_fn_vars")) {
-        all_prim_shape_fn_vars = Downcast<Array<GlobalVar>>(
-            call_lowered_props.attrs.metadata.at("all_prim_shape_fn_vars"));
-      }
-      Array<Integer> prim_shape_fn_states;
-      if (call_lowered_props.attrs.metadata.count("prim_shape_fn_states")) {
-        prim_shape_fn_states =
-            Downcast<Array<Integer>>(call_lowered_props.attrs.metadata.at("prim_shape_fn_states"));
+      return *value;
+    };
+  }
+
+  Code VisitExpr_(const OpNode* id) final {
+    // TODO(@jroesch): Eta-expand and return in this case.
+    return Fail(
+        "internal error, need to wrap intrinsic into call synthetic call node in this case, eta "
+        "expand");
+  }
+
+  Code VisitExpr_(const ConstantNode* op) final {
+    Interpreter* interp = interp_;
+    NDArray data = op->data;
+    auto value = std::make_shared<ObjectRef>();
+    return [interp, data, value](Frame* frame) {
+      if (!value->defined()) {
+        *value = data.CopyTo(interp->device_);
       }
+      return *value;
+    };
+  }
 
-      size_t num_shape_inputs = 0;
-      if (call_lowered_props.attrs.metadata.count("prim_shape_fn_num_inputs")) {
-        num_shape_inputs = static_cast<size_t>(
-            Downcast<Integer>(call_lowered_props.attrs.metadata.at("prim_shape_fn_num_inputs"))
-                ->value);
+  Code VisitExpr_(const TupleNode* op) final {
+    std::vector<Code> fields = VisitExprs(op->fields);
+    return [fields](Frame* frame) -> ObjectRef { return ADT::Tuple(EvalAll(fields, frame)); };
+  }
+
+  /*!
+   * \brief Compile the creation of a closure over \p func, which captures the values of its free
+   * variables. If \p letrec_name is defined, the closure is recursive and refers to itself by it.
+   */
+  Code MakeClosure(const Function& func, const Var& letrec_name = Var()) {
+    // Compile the function now, so that the closure only captures its free variables.
+    const CompiledFunction* inner = interp_->GetCompiled(func);
+    std::vector<std::pair<Var, Code>> captures;
+    for (const Var& var : inner->free_vars) {
+      // The closure refers to itself through the recursive closure made when it is invoked.
+      if (letrec_name.defined() && letrec_name == var) {
+        continue;
       }
-      size_t num_shape_outputs = 0;
-      if (call_lowered_props.attrs.metadata.count("prim_shape_fn_num_outputs")) {
-        num_shape_outputs = static_cast<size_t>(
-            Downcast<Integer>(call_lowered_props.attrs.metadata.at("prim_shape_fn_num_outputs"))
-                ->value);
+      captures.emplace_back(var, VisitExpr(var));
+    }
+    return [func, letrec_name, captures](Frame* frame) -> ObjectRef {
+      Map<Var, ObjectRef> env;
+      for (const auto& capture : captures) {
+        env.Set(capture.first, capture.second(frame));
       }
-      ICHECK(config_->optional_homogeneous_target.defined());
-      return InvokePrimitiveOp(call_lowered_props.lowered_func, all_prim_fn_vars,
-                               config_->optional_homogeneous_target, prim_shape_fn_var,
-                               all_prim_shape_fn_vars, prim_shape_fn_states, num_shape_inputs,
-                               num_shape_outputs, config_->host_se_scope->target, args);
-    } else {  // All other calls
-      // Evaluate all arguments
-      std::vector<ObjectRef> args;
-      for (auto arg : call_node->args) {
-        args.push_back(Eval(arg));
+      InterpreterClosure closure(env, func);
+      if (letrec_name.defined()) {
+        return RecClosure(closure, letrec_name);
       }
+      return std::move(closure);
+    };
+  }
 
-      if (call_node->op == OnDeviceOp()) {
-        // Special case: The call 'on_device(expr)' denotes that expr should be executed on
-        // a particular device. We can ignore this during interpretation.
-        ICHECK_EQ(call_node->args.size(), 1UL);
-        return args[0];
-      }
-      if (const ConstructorNode* con = call_node->op.as<ConstructorNode>()) {
-        // Special case: ADT constructor
+  Code VisitExpr_(const FunctionNode* func_node) final {
+    return MakeClosure(GetRef<Function>(func_node));
+  }
 
-        return ConstructorValue(con->tag, args, GetRef<Constructor>(con));
-      }
+  Code VisitExpr_(const CallNode* call_node) final {
+    DeviceCopyProps device_copy_props = GetDeviceCopyProps(call_node);
+    CallLoweredProps call_lowered_props = GetCallLoweredProps(call_node);
+    Interpreter* interp = interp_;
 
-      if (const OpNode* op_node = call_node->op.as<OpNode>()) {
-        // Except for call_lowered and on_device, we should not find calls to operators after
-        // running fusion and lowering.
-        LOG(FATAL) << "found " << op_node->name
-                   << "; operators should have been removed by previous passes; try "
-                      "fusing and lowering";
-      }
+    if (device_copy_props.body.defined()) {
+      // TODO(mbs): device_copy cleanup
+      return Fail("The interpreter does not support device_copy");
+    } else if (call_lowered_props.lowered_func.defined()) {
+      // Special case: Call a lowered TIR function.
+      std::shared_ptr<PrimitiveCall> prim_call = interp->MakePrimitiveCall(call_lowered_props);
+      // Evaluate only function args
+      std::vector<Code> args = VisitExprs(call_lowered_props.arguments);
+      return [interp, prim_call, args](Frame* frame) {
+        return interp->InvokePrimitiveOp(prim_call.get(), EvalAll(args, frame));
+      };
+    }
+
+    // All other calls
+    std::vector<Code> args = VisitExprs(call_node->args);
+
+    if (call_node->op == OnDeviceOp()) {
+      // Special case: The call 'on_device(expr)' denotes that expr should be executed on
+      // a particular device. We can ignore this during interpretation.
+      ICHECK_EQ(call_node->args.size(), 1UL);
+      return args[0];
+    }
+    if (const ConstructorNode* con = call_node->op.as<ConstructorNode>()) {
+      // Special case: ADT constructor
+      Constructor constructor = GetRef<Constructor>(con);
+      return [constructor, args](Frame* frame) -> ObjectRef {
+        return ConstructorValue(constructor->tag, EvalAll(args, frame), constructor);
+      };
+    }
+    if (const OpNode* op_node = call_node->op.as<OpNode>()) {
+      // Except for call_lowered and on_device, we should not find calls to operators after
+      // running fusion and lowering.
+      return Fail("found " + op_node->name +
+                  "; operators should have been removed by previous passes; try fusing and "
+                  "lowering");
+    }
 
-      // Now we just evaluate and expect to find a closure.
-      // TODO(@electriclilies): How should call_lowered behave with closures?
-      ObjectRef fn_val = Eval(call_node->op);
+    // Now we just evaluate and expect to find a closure.
+    // TODO(@electriclilies): How should call_lowered behave with closures?
+    Code op = VisitExpr(call_node->op);
+    // The function last called here and its compiled form, which saves looking it up again
+    // when the same function is called, as in loops and recursion.
+    auto last_callee = std::make_shared<std::pair<const FunctionNode*, const CompiledFunction*>>(
+        nullptr, nullptr);
+    return [interp, op, args, last_callee](Frame* frame) -> ObjectRef {
+      std::vector<ObjectRef> arg_values = EvalAll(args, frame);
+      ObjectRef fn_val = op(frame);
+      InterpreterClosure closure;
+      Var bind;
       if (const InterpreterClosureObj* closure_node = fn_val.as<InterpreterClosureObj>()) {
-        auto closure = GetRef<InterpreterClosure>(closure_node);
-        return Invoke(closure, args);
+        closure = GetRef<InterpreterClosure>(closure_node);
       } else if (const RecClosureObj* closure_node = fn_val.as<RecClosureObj>()) {
-        return Invoke(closure_node->clos, args, closure_node->bind);
+        closure = closure_node->clos;
+        bind = closure_node->bind;
       } else {
         LOG(FATAL) << "internal error: type error, expected function value in the call "
                    << "position";
         return ObjectRef();
       }
-    }
+      if (last_callee->first != closure->func.get()) {
+        last_callee->first = closure->func.get();
+        last_callee->second = interp->GetCompiled(closure->func);
+      }
+      return interp->Invoke(*last_callee->second, closure, arg_values, bind);
+    };
   }
 
-  ObjectRef VisitExpr_(const LetNode* let) final {
-    if (auto func = let->value.as<FunctionNode>()) {
-      auto clo = MakeClosure(GetRef<Function>(func), let->var);
-      this->extend(let->var, clo);
-    } else {
-      auto value = Eval(let->value);
-      this->extend(let->var, value);
+  Code VisitExpr_(const LetNode* op) final {
+    // Compile a chain of lets iteratively, which keeps deep A-normal forms off the C++ stack.
+    std::vector<std::pair<size_t, Code>> bindings;
+    Expr body = GetRef<Let>(op);
+    while (const auto* let = body.as<LetNode>()) {
+      Code value;
+      if (const auto* func = let->value.as<FunctionNode>()) {
+        value = MakeClosure(GetRef<Function>(func), let->var);
+      } else {
+        value = VisitExpr(let->value);
+      }
+      bindings.emplace_back(Bind(let->var), std::move(value));
+      body = let->body;
     }
-
-    return Eval(let->body);
+    Code body_code = VisitExpr(body);
+    return [bindings, body_code](Frame* frame) {
+      for (const auto& binding : bindings) {
+        (*frame)[binding.first] = binding.second(frame);
+      }
+      return body_code(frame);
+    };
   }
 
-  ObjectRef VisitExpr_(const TupleGetItemNode* op) final {
-    ObjectRef val = Eval(op->tuple);
-    const auto* adt_obj = val.as<ADTObj>();
-    ICHECK(adt_obj) << "internal error: when evaluating TupleGetItem expected an ADT value";
-    auto adt = GetRef<ADT>(adt_obj);
-    ICHECK_LT(static_cast<size_t>(op->index), adt.size()) << "internal error: index out of bounds";
-    return adt[op->index];
+  Code VisitExpr_(const TupleGetItemNode* op) final {
+    Code tuple = VisitExpr(op->tuple);
+    size_t index = op->index;
+    return [tuple, index](Frame* frame) -> ObjectRef {
+      ObjectRef val = tuple(frame);
+      const auto* adt_obj = val.as<ADTObj>();
+      ICHECK(adt_obj) << "internal error: when evaluating TupleGetItem expected an ADT value";
+      auto adt = GetRef<ADT>(adt_obj);
+      ICHECK_LT(index, adt.size()) << "internal error: index out of bounds";
+      return adt[index];
+    };
   }
 
-  ObjectRef VisitExpr_(const IfNode* op) final {
-    ObjectRef v = Eval(op->cond);
-    if (v->IsInstance<NDArray::ContainerType>()) {
-      auto nd_array = Downcast<NDArray>(v);
-      Device cpu_dev;
-      cpu_dev.device_type = kDLCPU;
-      cpu_dev.device_id = 0;
-      NDArray cpu_array = nd_array.CopyTo(cpu_dev);
-      ICHECK_EQ(DataType(cpu_array->dtype), DataType::Bool());
-      // TODO(@jroesch, @MK): Refactor code into helper from DCE.
-      if (reinterpret_cast<uint8_t*>(cpu_array->data)[0]) {
-        return Eval(op->true_branch);
+  Code VisitExpr_(const IfNode* op) final {
+    Code cond = VisitExpr(op->cond);
+    Code true_branch = VisitExpr(op->true_branch);
+    Code false_branch = VisitExpr(op->false_branch);
+    return [cond, true_branch, false_branch](Frame* frame) -> ObjectRef {
+      ObjectRef v = cond(frame);
+      if (v->IsInstance<NDArray::ContainerType>()) {
+        auto nd_array = Downcast<NDArray>(v);
+        if (nd_array->device.device_type != kDLCPU) {
+          Device cpu_dev;
+          cpu_dev.device_type = kDLCPU;
+          cpu_dev.device_id = 0;
+          nd_array = nd_array.CopyTo(cpu_dev);
+        }
+        ICHECK_EQ(DataType(nd_array->dtype), DataType::Bool());
+        // TODO(@jroesch, @MK): Refactor code into helper from DCE.
+        if (reinterpret_cast<uint8_t*>(nd_array->data)[0]) {
+          return true_branch(frame);
+        } else {
+          return false_branch(frame);
+        }
       } else {
-        return Eval(op->false_branch);
+        LOG(FATAL) << "type error, type system should have caught this";
+        return ObjectRef();
       }
-    } else {
-      LOG(FATAL) << "type error, type system should have caught this";
-      return ObjectRef();
-    }
+    };
   }
 
-  ObjectRef VisitExpr_(const RefWriteNode* op) final {
-    ObjectRef r = Eval(op->ref);
-    if (const RefValueObj* rv = r.as<RefValueObj>()) {
-      rv->value = Eval(op->value);
-      return ADT::Tuple(std::vector<ObjectRef>());
-    } else {
-      LOG(FATAL) << "type error, type system should have caught this";
-      return ObjectRef();
-    }
+  Code VisitExpr_(const RefWriteNode* op) final {
+    Code ref = VisitExpr(op->ref);
+    Code value = VisitExpr(op->value);
+    return [ref, value](Frame* frame) -> ObjectRef {
+      ObjectRef r = ref(frame);
+      if (const RefValueObj* rv = r.as<RefValueObj>()) {
+        rv->value = value(frame);
+        return ADT::Tuple(std::vector<ObjectRef>());
+      } else {
+        LOG(FATAL) << "type error, type system should have caught this";
+        return ObjectRef();
+      }
+    };
   }
 
-  ObjectRef VisitExpr_(const RefCreateNode* op) final { return RefValue(Eval(op->value)); }
+  Code VisitExpr_(const RefCreateNode* op) final {
+    Code value = VisitExpr(op->value);
+    return [value](Frame* frame) -> ObjectRef { return RefValue(value(frame)); };
+  }
 
-  ObjectRef VisitExpr_(const RefReadNode* op) final {
-    ObjectRef r = Eval(op->ref);
-    if (const RefValueObj* rv = r.as<RefValueObj>()) {
-      return rv->value;
-    } else {
-      LOG(FATAL) << "type error, type system should have caught this";
-      return ObjectRef();
-    }
+  Code VisitExpr_(const RefReadNode* op) final {
+    Code ref = VisitExpr(op->ref);
+    return [ref](Frame* frame) -> ObjectRef {
+      ObjectRef r = ref(frame);
+      if (const RefValueObj* rv = r.as<RefValueObj>()) {
+        return rv->value;
+      } else {
+        LOG(FATAL) << "type error, type system should have caught this";
+        return ObjectRef();
+      }
+    };
   }
 
-  ObjectRef VisitExpr_(const MatchNode* op) final {
-    ObjectRef v = Eval(op->data);
+  Code VisitExpr_(const MatchNode* op) final {
+    Code data = VisitExpr(op->data);
+    std::vector<std::pair<Matcher, Code>> clauses;
     for (const Clause& c : op->clauses) {
-      if (VisitPattern(c->lhs, v)) {
-        return VisitExpr(c->rhs);
+      Matcher lhs = VisitPattern(c->lhs);
+      clauses.emplace_back(std::move(lhs), VisitExpr(c->rhs));
+    }
+    return [data, clauses](Frame* frame) -> ObjectRef {
+      ObjectRef v = data(frame);
+      for (const auto& clause : clauses) {
+        if (clause.first(v, frame)) {
+          return clause.second(frame);
+        }
       }
+      LOG(FATAL) << "did not find any match";
+      return ObjectRef();
+    };
+  }
+
+  Code VisitExprDefault_(const Object* op) final {
+    return Fail(std::string("Do not have a default for ") + op->GetTypeKey());
+  }
+
+  Matcher VisitPattern_(const PatternConstructorNode* op) final {
+    int32_t tag = op->constructor->tag;
+    ICHECK_NE(tag, -1);
+    std::vector<Matcher> patterns;
+    for (const Pattern& pattern : op->patterns) {
+      patterns.push_back(VisitPattern(pattern));
     }
-    LOG(FATAL) << "did not find any match";
-    return ObjectRef();
+    return [tag, patterns](const ObjectRef& v, Frame* frame) {
+      const ConstructorValueObj* cvn = v.as<ConstructorValueObj>();
+      ICHECK(cvn) << "need to be a constructor for match";
+      ICHECK_NE(cvn->tag, -1);
+      if (tag == cvn->tag) {
+        ICHECK_EQ(patterns.size(), cvn->fields.size());
+        for (size_t i = 0; i < patterns.size(); ++i) {
+          if (!patterns[i](cvn->fields[i], frame)) {
+            return false;
+          }
+        }
+        return true;
+      }
+      return false;
+    };
   }
 
-  bool VisitPattern_(const PatternConstructorNode* op, const ObjectRef& v) final {
-    const ConstructorValueObj* cvn = v.as<ConstructorValueObj>();
-    ICHECK(cvn) << "need to be a constructor for match";
-    ICHECK_NE(op->constructor->tag, -1);
-    ICHECK_NE(cvn->tag, -1);
-    if (op->constructor->tag == cvn->tag) {
-      ICHECK_EQ(op->patterns.size(), cvn->fields.size());
-      for (size_t i = 0; i < op->patterns.size(); ++i) {
-        if (!VisitPattern(op->patterns[i], cvn->fields[i])) {
+  Matcher VisitPattern_(const PatternTupleNode* op) final {
+    std::vector<Matcher> patterns;
+    for (const Pattern& pattern : op->patterns) {
+      patterns.push_back(VisitPattern(pattern));
+    }
+    return [patterns](const ObjectRef& v, Frame* frame) {
+      auto adt = Downcast<ADT>(v);
+      ICHECK_EQ(patterns.size(), adt.size());
+      for (size_t i = 0; i < patterns.size(); ++i) {
+        if (!patterns[i](adt[i], frame)) {
           return false;
         }
       }
       return true;
-    }
-    return false;
+    };
   }
 
-  bool VisitPattern_(const PatternTupleNode* op, const ObjectRef& v) final {
-    auto adt = Downcast<ADT>(v);
-    ICHECK_EQ(op->patterns.size(), adt.size());
-    for (size_t i = 0; i < op->patterns.size(); ++i) {
-      if (!VisitPattern(op->patterns[i], adt[i])) {
-        return false;
-      }
-    }
-    return true;
+  Matcher VisitPattern_(const PatternWildcardNode* op) final {
+    return [](const ObjectRef& v, Frame* frame) { return true; };
   }
 
-  bool VisitPattern_(const PatternWildcardNode* op, const ObjectRef& v) final { return true; }
-
-  bool VisitPattern_(const PatternVarNode* op, const ObjectRef& v) final {
-    extend(op->var, v);
-    return true;
+  Matcher VisitPattern_(const PatternVarNode* op) final {
+    size_t slot = Bind(op->var);
+    return [slot](const ObjectRef& v, Frame* frame) {
+      (*frame)[slot] = v;
+      return true;
+    };
   }
 
-  InterpreterState get_state(Expr e = Expr()) const {
-    InterpreterStateObj::Stack stack;
-    for (auto fr : this->stack_.frames) {
-      InterpreterStateObj::Frame frame = fr.locals;
-      stack.push_back(frame);
-    }
-    auto state = InterpreterState(e, stack);
-    return state;
+  Interpreter* interp_;
+  CompiledFunction* compiled_;
+  /*! \brief The slot of each variable in scope. */
+  std::unordered_map<Var, size_t, ObjectPtrHash, ObjectPtrEqual> slots_;
+};
+
+const CompiledFunction* Interpreter::GetCompiled(const Function& func) {
+  auto it = compiled_funcs_.find(func);
+  if (it != compiled_funcs_.end()) {
+    return it->second.get();
   }
+  auto compiled = std::make_unique<CompiledFunction>();
+  FunctionCompiler(this, compiled.get()).CompileFunction(func);
+  const CompiledFunction* ret = compiled.get();
+  compiled_funcs_.emplace(func, std::move(compiled));
+  return ret;
+}
 
- private:
-  // Unified module. Functions are annotated with their target.
-  // All expressions are eval'ed w.r.t. the definitions in this module.
-  // This module contains functions that used to be in main_module and the per_target_module (TIR
-  // functions) in one module.
-  IRModule unified_mod_;
-  // Cached packed functions for the primitives and shape functions, keyed by target and
-  // global var name.
-  std::unordered_map<std::pair<Target, std::string>, PackedFunc, PairHash> compiled_packed_funcs_;
-  /*! \brief Compilation config describing the available targets. */
-  CompilationConfig config_;
-  // Unique device on which primitives (but not shape functions) will be executed.
-  // (For simplicity we only run the interpreter on a single device.)
-  Device device_;
-  // Call stack.
-  Stack stack_;
-  // The distinguished 'debug' operator, which is handled specially.
-  const Op& debug_op_;
-};
+std::unique_ptr<CompiledFunction> Interpreter::CompileTopLevel(const Expr& expr) {
+  auto compiled = std::make_unique<CompiledFunction>();
+  FunctionCompiler(this, compiled.get()).CompileTopLevel(expr);
+  return compiled;
+}
 
 /*!
  * Lowers all calls to primitives in \p mod appropriate for \p config. Returns the
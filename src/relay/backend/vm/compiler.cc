@@ -63,12 +63,7 @@ namespace transform {
 
 Pass LambdaLift();
 Pass LabelOps();
-
-Pass MemoryPlan() {
-  auto f = tvm::runtime::Registry::Get("relay.transform.MemoryPlan");
-  ICHECK(f != nullptr) << "unable to load the memory planning pass";
-  return (*f)();
-}
+Pass MemoryPlan();
 
 Pass LiftConstants() {
   auto f = tvm::runtime::Registry::Get("relay.transform.LiftConstants");
@@ -969,13 +964,7 @@ transform::Sequential VMCompiler::MemoryOpt(const SEScope& host_se_scope) {
   // Fuse & lower any new allocations.
   pass_seqs.push_back(FuseAndLowerOperators(host_se_scope));
 
-  // TODO(mbrookhart, jroesch, masahi): this pass is very slow, and is
-  // incomplete to provide memory resuse optimizations. Disable it until we can
-  // rewrite it in C++ and complete it.
-  // // Perform memory planning in order to coalesce/reduce allocations.
-  // pass_seqs.push_back(transform::MemoryPlan());
-
-  // Compute away constant computation introduced by coalescing allocations.
+  // Compute away possibly introduced constant computation.
   pass_seqs.push_back(transform::FoldConstant());
 
   // Fuse & lower yet again
@@ -987,6 +976,10 @@ transform::Sequential VMCompiler::MemoryOpt(const SEScope& host_se_scope) {
   // Compute away possibly introduced constant computation.
   pass_seqs.push_back(transform::FoldConstant());
 
+  // Coalesce the allocations of statically known size into a few storages, reusing
+  // storage across tensors with disjoint lifetimes.
+  pass_seqs.push_back(transform::MemoryPlan());
+
   // Lift constants to the top-level of the block to simplify VM code generation.
   // TODO(@icemelon9, @jroesch): Remove this pass for now because some
   //  instructions need to access to constant
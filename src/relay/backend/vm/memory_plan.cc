@@ -0,0 +1,497 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file tvm/relay/backend/vm/memory_plan.cc
+ * \brief Coalesce the storage allocations made by ManifestAlloc and reuse storage
+ * across tensors with disjoint lifetimes.
+ *
+ * ManifestAlloc emits one alloc_storage per tensor. Within each let block, this pass
+ * computes the live range of every allocation whose size is known at compile time,
+ * from its binding to the last binding using the storage, a tensor in it or an alias
+ * of such a tensor. Allocations that may outlive the block, e.g. because a tensor is
+ * returned, stored in a tuple or captured, are left alone.
+ *
+ * The remaining allocations of a device and dtype are replaced by:
+ *  - a single region on devices whose buffers can be offset, where each allocation
+ *    takes the lowest offset not used by an allocation live at the same time;
+ *  - otherwise, a few regions each reused by allocations with disjoint lifetimes.
+ *
+ * Let blocks nested in if branches are planned on their own. A tensor of the
+ * enclosing block may be read in a branch, but any other use makes it escape.
+ */
+
+#include <tvm/node/structural_equal.h>
+#include <tvm/relay/attrs/memory.h>
+#include <tvm/relay/expr.h>
+#include <tvm/relay/expr_functor.h>
+#include <tvm/relay/transform.h>
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/logging.h>
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../../op/memory/memory.h"
+#include "../../op/memory/on_device.h"
+#include "../../transforms/pattern_utils.h"
+
+namespace tvm {
+namespace relay {
+namespace vm {
+
+namespace {
+
+/*! \brief Returns \p expr as a call to \p op, looking through any "on_device" annotation. */
+const CallNode* AsOpCall(const Expr& expr, const Op& op) {
+  const auto* call = AsIgnoringOnDevice<CallNode>(expr);
+  return call != nullptr && call->op == op ? call : nullptr;
+}
+
+/*! \brief Returns whether \p expr is a scalar integer constant, and its value in \p value. */
+bool GetConstantInt(const Expr& expr, int64_t* value) {
+  const auto* constant = AsIgnoringOnDevice<ConstantNode>(expr);
+  if (constant == nullptr || !constant->is_scalar() ||
+      constant->data->dtype.code != kDLInt) {
+    return false;
+  }
+  *value = static_cast<int64_t>(ToScalar(constant->data));
+  return true;
+}
+
+/*! \brief Returns \p value with the "on_device" annotation of \p original, if any. */
+Expr WithOnDeviceOf(const Expr& original, Expr value) {
+  OnDeviceProps props = GetOnDeviceProps(original);
+  return props.body.defined() ? OnDevice(std::move(value), props.se_scope, props.is_fixed)
+                              : value;
+}
+
+/*!
+ * \brief Whether allocations on \p se_scope can be placed at offsets of a larger buffer.
+ *  The VM then gives their tensors the zero byte_offset kernels expect.
+ */
+bool SupportsOffsets(const SEScope& se_scope) {
+  return runtime::SupportsDataPointerOffset(Device{se_scope->device_type(), 0});
+}
+
+inline int64_t AlignUp(int64_t value, int64_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+/*! \brief A storage allocation of a let block whose size is known at compile time. */
+struct StorageAlloc {
+  /*! \brief The binding of the allocation. */
+  Expr value;
+  /*! \brief The index of the binding. */
+  size_t begin;
+  /*! \brief The index of the last binding using the storage or one of its tensors. */
+  size_t end;
+  int64_t size;
+  int64_t alignment;
+  SEScope se_scope;
+  DataType dtype;
+  /*! \brief Whether a tensor of the storage may be used after the block. */
+  bool escapes = false;
+  /*! \brief The region and offset the allocation is planned at. */
+  int region = -1;
+  int64_t offset = 0;
+};
+
+/*! \brief A storage allocation replacing some of the allocations of a let block. */
+struct Region {
+  /*! \brief The first of its allocations, whose device, dtype and annotations it takes. */
+  const StorageAlloc* first;
+  /*! \brief The last binding using the region. */
+  size_t end;
+  int64_t size = 0;
+  int64_t alignment = 0;
+};
+
+/*!
+ * \brief Visits a binding, reporting the variables it only reads and those that
+ * escape through it, i.e. that it may alias, store, capture or return.
+ */
+class UseCollector : public ExprVisitor {
+ public:
+  UseCollector(std::function<void(const VarNode*)> fread,
+               std::function<void(const VarNode*)> fescape)
+      : fread_(std::move(fread)), fescape_(std::move(fescape)) {}
+
+  /*! \brief Visit \p expr in a position where a variable is only read. */
+  void VisitRead(const Expr& expr) {
+    if (const auto* var = AsIgnoringOnDevice<VarNode>(expr)) {
+      fread_(var);
+    } else if (const auto* tuple = expr.as<TupleNode>()) {
+      for (const Expr& field : tuple->fields) {
+        VisitRead(field);
+      }
+    } else {
+      VisitExpr(expr);
+    }
+  }
+
+  void VisitExpr_(const VarNode* var_node) final { fescape_(var_node); }
+
+  void VisitExpr_(const CallNode* call_node) final {
+    if (call_node->op == invoke_tvm_op_) {
+      // The kernel reads its inputs and writes its outputs, without keeping them.
+      VisitExpr(call_node->args[0]);
+      VisitRead(call_node->args[1]);
+      VisitRead(call_node->args[2]);
+    } else if (call_node->op == shape_of_op_ || call_node->op == device_copy_op_) {
+      VisitRead(call_node->args[0]);
+    } else {
+      ExprVisitor::VisitExpr_(call_node);
+    }
+  }
+
+  void VisitExpr_(const IfNode* if_node) final {
+    VisitRead(if_node->cond);
+    VisitExpr(if_node->true_branch);
+    VisitExpr(if_node->false_branch);
+  }
+
+ private:
+  std::function<void(const VarNode*)> fread_;
+  std::function<void(const VarNode*)> fescape_;
+  const Op& invoke_tvm_op_ = Op::Get("vm.invoke_tvm_op");
+  const Op& shape_of_op_ = Op::Get("vm.shape_of");
+  const Op& device_copy_op_ = Op::Get("device_copy");
+};
+
+/*!
+ * \brief Places \p allocs in one region, greedily by decreasing size: each allocation
+ * takes the lowest offset not overlapping an allocation live at the same time.
+ *
+ * \return The size of the region.
+ */
+int64_t PackInRegion(std::vector<StorageAlloc*> allocs, int64_t alignment) {
+  std::sort(allocs.begin(), allocs.end(), [](const StorageAlloc* a, const StorageAlloc* b) {
+    return a->size != b->size ? a->size > b->size : a->begin < b->begin;
+  });
+  std::vector<StorageAlloc*> placed;
+  int64_t region_size = 0;
+  for (StorageAlloc* alloc : allocs) {
+    std::vector<StorageAlloc*> live;
+    for (StorageAlloc* other : placed) {
+      if (other->begin <= alloc->end && alloc->begin <= other->end) {
+        live.push_back(other);
+      }
+    }
+    std::sort(live.begin(), live.end(), [](const StorageAlloc* a, const StorageAlloc* b) {
+      return a->offset < b->offset;
+    });
+    int64_t offset = 0;
+    for (const StorageAlloc* other : live) {
+      if (offset + alloc->size <= other->offset) break;
+      offset = std::max(offset, AlignUp(other->offset + other->size, alignment));
+    }
+    alloc->offset = offset;
+    placed.push_back(alloc);
+    region_size = std::max(region_size, offset + alloc->size);
+  }
+  return region_size;
+}
+
+/*!
+ * \brief Plans the storage of let blocks, see the file comment.
+ */
+class MemoryPlanner : public ExprMutator {
+ public:
+  Function Plan(const Function& func) {
+    Function ret = Downcast<Function>(Mutate(func));
+    VLOG(1) << "planned " << num_planned_ << " storage allocations of " << planned_bytes_
+            << " bytes into " << num_regions_ << " allocations of " << region_bytes_ << " bytes";
+    return ret;
+  }
+
+  Expr VisitExpr_(const FunctionNode* func_node) final {
+    if (func_node->HasNonzeroAttr(attr::kPrimitive)) {
+      return GetRef<Function>(func_node);
+    }
+    return ExprMutator::VisitExpr_(func_node);
+  }
+
+  Expr VisitExpr_(const LetNode* let_node) final {
+    // Collect the bindings iteratively, the blocks emitted by ManifestAlloc are long.
+    std::vector<std::pair<Var, Expr>> bindings;
+    Expr body = GetRef<Let>(let_node);
+    while (const auto* inner_let_node = body.as<LetNode>()) {
+      bindings.emplace_back(inner_let_node->var, Mutate(inner_let_node->value));
+      body = inner_let_node->body;
+    }
+    body = Mutate(body);
+    bindings = PlanBlock(std::move(bindings), body);
+    for (auto it = bindings.rbegin(); it != bindings.rend(); ++it) {
+      body = Let(it->first, it->second, body);
+    }
+    return body;
+  }
+
+ private:
+  std::vector<std::pair<Var, Expr>> PlanBlock(std::vector<std::pair<Var, Expr>> bindings,
+                                              const Expr& body) {
+    std::vector<StorageAlloc> allocs;
+    // The allocation of each storage, tensor in a storage, and alias of such a tensor.
+    std::unordered_map<const VarNode*, size_t> alloc_of;
+    // The allocation a binding allocates, or allocates a tensor in.
+    std::vector<int> storage_binding(bindings.size(), -1);
+    std::vector<int> tensor_binding(bindings.size(), -1);
+
+    size_t index = 0;
+    auto fread = [&](const VarNode* var) {
+      auto it = alloc_of.find(var);
+      if (it != alloc_of.end()) allocs[it->second].end = index;
+    };
+    auto fescape = [&](const VarNode* var) {
+      auto it = alloc_of.find(var);
+      if (it != alloc_of.end()) allocs[it->second].escapes = true;
+    };
+
+    for (; index < bindings.size(); ++index) {
+      // A fresh collector per binding, so that shared sub-expressions are visited again.
+      UseCollector collector(fread, fescape);
+      const VarNode* var = bindings[index].first.get();
+      const Expr& value = bindings[index].second;
+      if (const CallNode* call = AsOpCall(value, alloc_storage_op_)) {
+        const auto* attrs = call->attrs.as<AllocStorageAttrs>();
+        StorageAlloc alloc;
+        if (attrs != nullptr && GetConstantInt(call->args[0], &alloc.size) &&
+            GetConstantInt(call->args[1], &alloc.alignment) && alloc.alignment > 0) {
+          alloc.value = value;
+          alloc.begin = alloc.end = index;
+          alloc.se_scope = attrs->se_scope;
+          alloc.dtype = attrs->dtype;
+          alloc_of[var] = allocs.size();
+          storage_binding[index] = static_cast<int>(allocs.size());
+          allocs.push_back(std::move(alloc));
+          continue;
+        }
+      } else if (const CallNode* call = AsOpCall(value, alloc_tensor_op_)) {
+        const auto* storage = AsIgnoringOnDevice<VarNode>(call->args[0]);
+        auto it = storage != nullptr ? alloc_of.find(storage) : alloc_of.end();
+        int64_t offset = -1;
+        if (it != alloc_of.end() && GetConstantInt(call->args[1], &offset) && offset == 0) {
+          alloc_of[var] = it->second;
+          allocs[it->second].end = index;
+          tensor_binding[index] = static_cast<int>(it->second);
+          collector.VisitRead(call->args[2]);
+        } else {
+          collector.VisitExpr(call->args[0]);
+          collector.VisitExpr(call->args[1]);
+          collector.VisitRead(call->args[2]);
+        }
+        continue;
+      } else if (const CallNode* call = AsOpCall(value, reshape_tensor_op_)) {
+        // The reshaped tensor aliases the memory of its input.
+        const auto* data = AsIgnoringOnDevice<VarNode>(call->args[0]);
+        auto it = data != nullptr ? alloc_of.find(data) : alloc_of.end();
+        if (it != alloc_of.end()) {
+          alloc_of[var] = it->second;
+          allocs[it->second].end = index;
+          collector.VisitRead(call->args[1]);
+          continue;
+        }
+      } else if (const auto* source = AsIgnoringOnDevice<VarNode>(value)) {
+        auto it = alloc_of.find(source);
+        if (it != alloc_of.end()) {
+          alloc_of[var] = it->second;
+          allocs[it->second].end = index;
+          continue;
+        }
+      }
+      collector.VisitExpr(value);
+    }
+    // The result of the block outlives it.
+    UseCollector(fread, fescape).VisitExpr(body);
+
+    std::vector<Region> regions = PlanRegions(&allocs);
+    if (regions.empty()) {
+      return bindings;
+    }
+
+    // Allocate each region before the first of its allocations, and rewrite the tensors
+    // of planned allocations to use their region.
+    std::vector<std::vector<int>> regions_at(bindings.size());
+    for (size_t i = 0; i < regions.size(); ++i) {
+      regions_at[regions[i].first->begin].push_back(static_cast<int>(i));
+    }
+    std::vector<Var> region_vars(regions.size());
+    std::vector<std::pair<Var, Expr>> new_bindings;
+    for (size_t i = 0; i < bindings.size(); ++i) {
+      for (int region_index : regions_at[i]) {
+        const Region& region = regions[region_index];
+        const auto* alloc_call = AsIgnoringOnDevice<CallNode>(region.first->value);
+        Expr size =
+            WithOnDeviceOf(alloc_call->args[0], MakeConstantScalar(DataType::Int(64), region.size));
+        Expr alignment = MakeConstantScalar(DataType::Int(64), region.alignment);
+        Expr value = WithOnDeviceOf(
+            region.first->value,
+            AllocStorage(size, alignment, region.first->se_scope, region.first->dtype));
+        region_vars[region_index] =
+            Var("region_" + std::to_string(num_regions_ + region_index), Type(nullptr));
+        new_bindings.emplace_back(region_vars[region_index], value);
+      }
+      if (storage_binding[i] >= 0 && allocs[storage_binding[i]].region >= 0) {
+        continue;
+      }
+      if (tensor_binding[i] >= 0 && allocs[tensor_binding[i]].region >= 0) {
+        const StorageAlloc& alloc = allocs[tensor_binding[i]];
+        const Expr& value = bindings[i].second;
+        const auto* call = AsIgnoringOnDevice<CallNode>(value);
+        Expr offset =
+            WithOnDeviceOf(call->args[1], MakeConstantScalar(DataType::Int(64), alloc.offset));
+        Call new_call(call->op, {region_vars[alloc.region], offset, call->args[2]}, call->attrs,
+                      call->type_args, call->span);
+        new_bindings.emplace_back(bindings[i].first, WithOnDeviceOf(value, new_call));
+        continue;
+      }
+      new_bindings.push_back(std::move(bindings[i]));
+    }
+    num_regions_ += regions.size();
+    return new_bindings;
+  }
+
+  /*!
+   * \brief Assigns the allocations of a block that do not escape to regions.
+   * \return The regions that hold more than one allocation.
+   */
+  std::vector<Region> PlanRegions(std::vector<StorageAlloc>* allocs) {
+    // Group the allocations by device and dtype.
+    std::vector<std::vector<StorageAlloc*>> groups;
+    for (StorageAlloc& alloc : *allocs) {
+      if (alloc.escapes || alloc.end == alloc.begin) continue;
+      auto it = std::find_if(groups.begin(), groups.end(),
+                             [&](const std::vector<StorageAlloc*>& group) {
+                               return group[0]->dtype == alloc.dtype &&
+                                      StructuralEqual()(group[0]->se_scope, alloc.se_scope);
+                             });
+      if (it == groups.end()) {
+        groups.push_back({&alloc});
+      } else {
+        it->push_back(&alloc);
+      }
+    }
+
+    std::vector<Region> regions;
+    for (const std::vector<StorageAlloc*>& group : groups) {
+      // A single allocation has nothing to share with.
+      if (group.size() < 2) continue;
+      if (SupportsOffsets(group[0]->se_scope)) {
+        Region region{group[0], group[0]->end};
+        for (StorageAlloc* alloc : group) {
+          region.alignment = std::max(region.alignment, alloc->alignment);
+          region.end = std::max(region.end, alloc->end);
+          alloc->region = static_cast<int>(regions.size());
+        }
+        region.size = PackInRegion(group, region.alignment);
+        regions.push_back(region);
+      } else {
+        // Give each allocation the free region closest above its size, or else grow the
+        // largest free region. The group is in binding order.
+        size_t first_region = regions.size();
+        for (StorageAlloc* alloc : group) {
+          int best = -1;
+          for (size_t i = first_region; i < regions.size(); ++i) {
+            const Region& region = regions[i];
+            if (region.end >= alloc->begin) continue;
+            if (best < 0) {
+              best = static_cast<int>(i);
+              continue;
+            }
+            const Region& current = regions[best];
+            bool fits = region.size >= alloc->size;
+            bool current_fits = current.size >= alloc->size;
+            if ((fits && (!current_fits || region.size < current.size)) ||
+                (!fits && !current_fits && region.size > current.size)) {
+              best = static_cast<int>(i);
+            }
+          }
+          if (best < 0) {
+            best = static_cast<int>(regions.size());
+            regions.push_back(Region{alloc, alloc->end});
+          }
+          Region& region = regions[best];
+          region.size = std::max(region.size, alloc->size);
+          region.alignment = std::max(region.alignment, alloc->alignment);
+          region.end = alloc->end;
+          alloc->region = best;
+        }
+      }
+    }
+
+    // Regions that hold a single allocation are left as they are.
+    std::vector<int> num_allocs(regions.size(), 0);
+    for (const StorageAlloc& alloc : *allocs) {
+      if (alloc.region >= 0) ++num_allocs[alloc.region];
+    }
+    std::vector<int> new_index(regions.size(), -1);
+    std::vector<Region> kept;
+    for (size_t i = 0; i < regions.size(); ++i) {
+      if (num_allocs[i] > 1) {
+        new_index[i] = static_cast<int>(kept.size());
+        kept.push_back(regions[i]);
+        region_bytes_ += regions[i].size;
+      }
+    }
+    for (StorageAlloc& alloc : *allocs) {
+      if (alloc.region < 0) continue;
+      alloc.region = new_index[alloc.region];
+      if (alloc.region >= 0) {
+        ++num_planned_;
+        planned_bytes_ += alloc.size;
+      } else {
+        alloc.offset = 0;
+      }
+    }
+    return kept;
+  }
+
+  const Op& alloc_storage_op_ = Op::Get("memory.alloc_storage");
+  const Op& alloc_tensor_op_ = Op::Get("memory.alloc_tensor");
+  const Op& reshape_tensor_op_ = Op::Get("vm.reshape_tensor");
+  size_t num_planned_ = 0;
+  size_t num_regions_ = 0;
+  int64_t planned_bytes_ = 0;
+  int64_t region_bytes_ = 0;
+};
+
+}  // namespace
+
+}  // namespace vm
+
+namespace transform {
+
+Pass MemoryPlan() {
+  runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
+      [=](Function f, IRModule m, PassContext pc) { return vm::MemoryPlanner().Plan(f); };
+  return Sequential({CreateFunctionPass(pass_func, 0, "MemoryPlanImpl", {}), InferType()},
+                    "MemoryPlan");
+}
+
+TVM_REGISTER_GLOBAL("relay._transform.MemoryPlan").set_body_typed(MemoryPlan);
+
+}  // namespace transform
+
+}  // namespace relay
+}  // namespace tvm
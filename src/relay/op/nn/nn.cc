@@ -236,6 +236,67 @@ RELAY_REGISTER_OP("nn.dense")
     .add_type_rel("Dense", MatmulRel<DenseAttrs>);
 // ------------------- relay.nn.dense
 
+// ------------------- relay.nn.contrib_dense_mkl_packed
+bool DenseMKLPackedRel(const Array<Type>& types, int num_inputs, const Attrs& attrs,
+                       const TypeReporter& reporter) {
+  ICHECK_EQ(types.size(), 3);
+  const auto* data = types[0].as<TensorTypeNode>();
+  const auto* packed_weight = types[1].as<TensorTypeNode>();
+  if (data == nullptr || packed_weight == nullptr) return false;
+
+  const auto* param = attrs.as<DenseAttrs>();
+  ICHECK(param != nullptr);
+  ICHECK(param->units.defined()) << "dense_mkl_packed needs the units of the packed weight";
+  ICHECK_EQ(data->shape.size(), 2) << "dense_mkl_packed only supports 2-D data";
+  ICHECK_EQ(packed_weight->shape.size(), 1) << "The packed weight must be a 1-D buffer";
+  ICHECK(packed_weight->dtype == DataType::UInt(8)) << "The packed weight must be a uint8 buffer";
+
+  DataType out_dtype = param->out_dtype;
+  if (out_dtype.bits() == 0) {
+    out_dtype = data->dtype;
+  }
+  reporter->Assign(types[2], TensorType({data->shape[0], param->units}, out_dtype));
+  return true;
+}
+
+InferCorrectLayoutOutput DenseMKLPackedInferCorrectLayout(
+    const Attrs& attrs, const Array<Layout>& new_in_layouts, const Array<Layout>& old_in_layouts,
+    const Array<tvm::relay::Type>& old_in_types) {
+  return InferCorrectLayoutOutput({"NC", "C"}, {"NC"}, attrs);
+}
+
+// Positional relay function to create dense_mkl_packed operator used by frontend FFI.
+Expr MakeDenseMKLPacked(Expr data, Expr packed_weight, IndexExpr units, DataType out_dtype) {
+  auto attrs = make_object<DenseAttrs>();
+  attrs->units = units;
+  attrs->out_dtype = out_dtype;
+  static const Op& op = Op::Get("nn.contrib_dense_mkl_packed");
+  return Call(op, {data, packed_weight}, Attrs(attrs), {});
+}
+
+TVM_REGISTER_GLOBAL("relay.op.nn._make.contrib_dense_mkl_packed")
+    .set_body_typed(MakeDenseMKLPacked);
+
+RELAY_REGISTER_OP("nn.contrib_dense_mkl_packed")
+    .describe(R"code(Applies a linear transformation: :math:`Y = XW^T` with a weight packed by MKL.
+
+The weight is packed once by tvm.contrib.mkl.pack_matrix, for the batch of the
+data, when the constant weight is bound at compile time.
+
+- **data**: `(batch, input_dim)`
+- **packed_weight**: `(packed_bytes,)`, uint8
+- **out**: `(batch, units)`.
+
+)code" TVM_ADD_FILELINE)
+    .set_attrs_type<DenseAttrs>()
+    .set_num_inputs(2)
+    .add_argument("data", "2D Tensor", "Input data.")
+    .add_argument("packed_weight", "1D Tensor", "Weight matrix packed by MKL.")
+    .set_support_level(10)
+    .set_attr<FInferCorrectLayout>("FInferCorrectLayout", DenseMKLPackedInferCorrectLayout)
+    .add_type_rel("DenseMKLPacked", DenseMKLPackedRel);
+// ------------------- relay.nn.contrib_dense_mkl_packed
+
 // ------------------- relay.nn.contrib_dense_pack
 TVM_REGISTER_NODE_TYPE(DensePackAttrs);
 
@@ -1218,6 +1279,82 @@ Negative log likelihood loss for given prediction and target.
     .add_argument("weights", "Tensor", "The weight of each target values.")
     .add_type_rel("NLLLoss", NLLLossRel);
 
+// relay.nn.contrib_embedding_bag
+TVM_REGISTER_NODE_TYPE(EmbeddingBagAttrs);
+
+bool EmbeddingBagRel(const Array<Type>& types, int num_inputs, const Attrs& attrs,
+                     const TypeReporter& reporter) {
+  ICHECK_EQ(types.size(), 4);
+  const auto* weight = types[0].as<TensorTypeNode>();
+  const auto* indices = types[1].as<TensorTypeNode>();
+  const auto* offsets = types[2].as<TensorTypeNode>();
+  const auto* param = attrs.as<EmbeddingBagAttrs>();
+  if (weight == nullptr || indices == nullptr || offsets == nullptr) return false;
+  ICHECK(param != nullptr);
+  if (weight->shape.size() != 2 || indices->shape.size() != 1 || offsets->shape.size() != 1) {
+    reporter->GetDiagCtx().EmitFatal(Diagnostic::Error(reporter->GetSpan())
+                                     << "EmbeddingBagRel: weight should be 2-D, indices and"
+                                     << " offsets 1-D, but got weight shape = " << weight->shape
+                                     << ", indices shape = " << indices->shape
+                                     << ", offsets shape = " << offsets->shape);
+    return false;
+  }
+  const DataType wtype = weight->dtype;
+  if (!(wtype == DataType::Float(32) || wtype == DataType::Float(16) ||
+        wtype == DataType::Int(8))) {
+    reporter->GetDiagCtx().EmitFatal(Diagnostic::Error(reporter->GetSpan())
+                                     << "EmbeddingBagRel: weight should be float32, float16 or"
+                                     << " int8, but got " << wtype);
+    return false;
+  }
+  if (!indices->dtype.is_int() || indices->dtype != offsets->dtype) {
+    reporter->GetDiagCtx().EmitFatal(Diagnostic::Error(reporter->GetSpan())
+                                     << "EmbeddingBagRel: indices and offsets should be of the"
+                                     << " same int type.");
+    return false;
+  }
+  if (param->mode != "sum" && param->mode != "mean") {
+    reporter->GetDiagCtx().EmitFatal(Diagnostic::Error(reporter->GetSpan())
+                                     << "EmbeddingBagRel: mode should be 'sum' or 'mean', but got "
+                                     << param->mode);
+    return false;
+  }
+  Array<IndexExpr> oshape = {offsets->shape[0], weight->shape[1]};
+  reporter->Assign(types[3], TensorType(oshape, DataType::Float(32)));
+  return true;
+}
+
+Expr MakeEmbeddingBag(Expr weight, Expr indices, Expr offsets, String mode, double scale) {
+  auto attrs = make_object<EmbeddingBagAttrs>();
+  attrs->mode = mode;
+  attrs->scale = scale;
+  static const Op& op = Op::Get("nn.contrib_embedding_bag");
+  return Call(op, {weight, indices, offsets}, Attrs(attrs), {});
+}
+
+TVM_REGISTER_GLOBAL("relay.op.nn._make.contrib_embedding_bag").set_body_typed(MakeEmbeddingBag);
+
+RELAY_REGISTER_OP("nn.contrib_embedding_bag")
+    .describe(R"code(Pooled embedding lookup.
+
+Bag b sums, or averages, the rows of weight selected by indices[offsets[b]:offsets[b + 1]].
+The last bag ends at the end of indices and empty bags are zero. The pooled rows are
+multiplied by scale, which is the dequantization scale for int8 tables.
+
+- **weight**: `(num_rows, dim)` float32, float16 or int8
+- **indices**: `(num_indices,)`
+- **offsets**: `(num_bags,)`
+- **out**: `(num_bags, dim)` float32
+
+)code" TVM_ADD_FILELINE)
+    .set_attrs_type<EmbeddingBagAttrs>()
+    .set_num_inputs(3)
+    .add_argument("weight", "2D Tensor", "The embedding table.")
+    .add_argument("indices", "1D Tensor", "The rows of all bags, concatenated.")
+    .add_argument("offsets", "1D Tensor", "The start of each bag in indices.")
+    .set_support_level(10)
+    .add_type_rel("EmbeddingBag", EmbeddingBagRel);
+
 bool DepthToSpaceRel(const Array<Type>& types, int num_inputs, const Attrs& attrs,
                      const TypeReporter& reporter) {
   ICHECK_EQ(types.size(), 2);
@@ -26,7 +26,11 @@
 #include <tvm/relay/analysis.h>
 #include <tvm/relay/expr_functor.h>
 #include <tvm/relay/op.h>
+#include <tvm/support/parallel_for.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <numeric>
 
 #include "./quantize.h"
@@ -79,8 +83,8 @@ static float ComputeEntropy(float* p, float* q, size_t size) {
   return ret;
 }
 
-float MinimizeKL(const std::vector<int>& hist, const std::vector<float>& hist_edges, int num_bins,
-                 int num_quantized_bins) {
+float MinimizeKL(const std::vector<int64_t>& hist, const std::vector<float>& hist_edges,
+                 int num_bins, int num_quantized_bins) {
   const int zero_bin_idx = num_bins / 2;
   const int num_half_quantized_bins = num_quantized_bins / 2;
   std::vector<float> thresholds(num_bins / 2 + 1 - num_quantized_bins / 2, 0.f);
@@ -91,7 +95,7 @@ float MinimizeKL(const std::vector<int>& hist, const std::vector<float>& hist_ed
     const int p_bin_idx_stop = zero_bin_idx + i + 1;
     thresholds[i - num_half_quantized_bins] = hist_edges[p_bin_idx_stop];
 
-    std::vector<int> sliced_nd_hist(p_bin_idx_stop - p_bin_idx_start);
+    std::vector<int64_t> sliced_nd_hist(p_bin_idx_stop - p_bin_idx_start);
     std::vector<float> p(sliced_nd_hist.size());
     p[0] = 0;
     p.back() = 0;
@@ -111,18 +115,19 @@ float MinimizeKL(const std::vector<int>& hist, const std::vector<float>& hist_ed
       const int start = j * num_merged_bins;
       const int stop = (j + 1) * num_merged_bins;
       quantized_bins[j] =
-          std::accumulate(sliced_nd_hist.begin() + start, sliced_nd_hist.begin() + stop, 0);
+          std::accumulate(sliced_nd_hist.begin() + start, sliced_nd_hist.begin() + stop,
+                          static_cast<int64_t>(0));
     }
     quantized_bins.back() += std::accumulate(
         sliced_nd_hist.begin() + static_cast<int>(num_quantized_bins * num_merged_bins),
-        sliced_nd_hist.end(), 0);
+        sliced_nd_hist.end(), static_cast<int64_t>(0));
     // expand quantized_bins into p.size bins
     std::vector<float> q(sliced_nd_hist.size(), 0);
     for (int j = 0; j < num_quantized_bins; j++) {
       const int start = j * num_merged_bins;
       const int stop = (j == num_quantized_bins - 1) ? q.size() : ((j + 1) * num_merged_bins);
       int norm = std::count_if(sliced_nd_hist.begin() + start, sliced_nd_hist.begin() + stop,
-                               [](size_t i) { return i != 0; });
+                               [](int64_t i) { return i != 0; });
       if (norm) {
         for (int k = start; k < stop; k++) {
           if (p[k]) q[k] = quantized_bins[j] / norm;
@@ -209,11 +214,180 @@ TVM_REGISTER_GLOBAL("relay._quantize.FindScaleByKLMinimization")
       float* hist_edges_ptr = static_cast<float*>(static_cast<void*>(args[1]));
       int num_bins = args[2];
       int num_quantized_bins = args[3];
-      std::vector<int> hist(hist_ptr, hist_ptr + num_bins);
+      std::vector<int64_t> hist(hist_ptr, hist_ptr + num_bins);
       std::vector<float> hist_edges(hist_edges_ptr, hist_edges_ptr + num_bins + 1);
       ret[0] = MinimizeKL(hist, hist_edges, num_bins, num_quantized_bins);
     });
 
+/*!
+ * \brief The running statistics of the tensors profiled during calibration.
+ *
+ * Every tensor keeps its running min/max and a histogram with a fixed number of bins over the
+ * symmetric range [-range, range] seen so far. When a batch exceeds the range, the histogram is
+ * re-binned into the wider range. The memory is therefore independent of the size of the
+ * calibration dataset.
+ */
+class CalibrationStatsNode : public Object {
+ public:
+  /*! \brief The statistics of one profiled tensor. */
+  struct TensorStats {
+    float min_val{std::numeric_limits<float>::max()};
+    float max_val{std::numeric_limits<float>::lowest()};
+    /*! \brief The histogram covers [-range, range]. */
+    float range{0.f};
+    /*! \brief The bin counts, fractional after re-binning. */
+    std::vector<double> hist;
+  };
+
+  /*! \brief The number of histogram bins, odd so that zero is the center of a bin. */
+  int num_bins;
+  /*! \brief The statistics of each profiled tensor. */
+  std::vector<TensorStats> stats;
+
+  void VisitAttrs(AttrVisitor* v) { v->Visit("num_bins", &num_bins); }
+
+  /*!
+   * \brief Update the statistics of a tensor with a new batch of data.
+   * \param idx The index of the tensor.
+   * \param data The data of the batch.
+   * \param size The number of elements of the batch.
+   */
+  void Update(int idx, const float* data, int64_t size) {
+    TensorStats* s = &stats[idx];
+    if (size == 0) return;
+    auto minmax = std::minmax_element(data, data + size);
+    s->min_val = std::min(s->min_val, *minmax.first);
+    s->max_val = std::max(s->max_val, *minmax.second);
+    float max_abs = std::max(std::abs(s->min_val), std::abs(s->max_val));
+    if (max_abs > s->range) Rebin(s, max_abs);
+    if (s->range == 0.f) {
+      s->hist[num_bins / 2] += size;
+      return;
+    }
+    const float scale = num_bins / (2 * s->range);
+    for (int64_t i = 0; i < size; ++i) {
+      int bin = static_cast<int>((data[i] + s->range) * scale);
+      s->hist[std::min(std::max(bin, 0), num_bins - 1)] += 1;
+    }
+  }
+
+  /*!
+   * \brief Find the quantization threshold of a tensor from its statistics.
+   * \param idx The index of the tensor.
+   * \param mode The calibration mode, "kl_divergence" or "percentile".
+   * \param num_quantized_bins The number of quantized bins for kl_divergence.
+   * \param percentile The percentile of the absolute values for percentile.
+   * \return The threshold.
+   */
+  float FindThreshold(int idx, const std::string& mode, int num_quantized_bins,
+                      double percentile) const {
+    const TensorStats& s = stats[idx];
+    // Follow numpy.histogram which widens an empty range to a unit one.
+    float range = s.range == 0.f ? 0.5f : s.range;
+    float bin_width = 2 * range / num_bins;
+    if (mode == "kl_divergence") {
+      // The counts of a large calibration set exceed the range of int.
+      std::vector<int64_t> hist(num_bins);
+      std::vector<float> hist_edges(num_bins + 1);
+      for (int i = 0; i < num_bins; ++i) {
+        hist[i] = std::llround(s.hist[i]);
+        hist_edges[i] = -range + i * bin_width;
+      }
+      hist_edges[num_bins] = range;
+      return MinimizeKL(hist, hist_edges, num_bins, num_quantized_bins);
+    }
+    ICHECK_EQ(mode, "percentile") << "Unknown calibrate mode " << mode;
+    // Fold the histogram around zero and walk outwards until the percentile is reached.
+    double target = percentile * std::accumulate(s.hist.begin(), s.hist.end(), 0.0);
+    const int center = num_bins / 2;
+    double count = 0;
+    for (int k = 0; k <= center; ++k) {
+      count += s.hist[center + k] + (k > 0 ? s.hist[center - k] : 0.0);
+      if (count >= target) return (k + 0.5f) * bin_width;
+    }
+    return range;
+  }
+
+  static constexpr const char* _type_key = "relay.quantize.CalibrationStats";
+  TVM_DECLARE_FINAL_OBJECT_INFO(CalibrationStatsNode, Object);
+
+ private:
+  // Re-bin the histogram into [-range, range], splitting each old bin over the new bins it
+  // overlaps in proportion to the overlap.
+  void Rebin(TensorStats* s, float range) {
+    std::vector<double> hist(num_bins, 0.0);
+    if (s->range == 0.f) {
+      hist[num_bins / 2] = s->hist[num_bins / 2];
+    } else {
+      const double old_width = 2.0 * s->range / num_bins;
+      const double scale = num_bins / (2.0 * range);
+      for (int i = 0; i < num_bins; ++i) {
+        if (s->hist[i] == 0) continue;
+        double lo = (-s->range + i * old_width + range) * scale;
+        double hi = lo + old_width * scale;
+        for (int j = static_cast<int>(lo); j < num_bins && j < hi; ++j) {
+          double overlap = std::min(hi, j + 1.0) - std::max(lo, static_cast<double>(j));
+          hist[j] += s->hist[i] * overlap / (hi - lo);
+        }
+      }
+    }
+    s->hist.swap(hist);
+    s->range = range;
+  }
+};
+
+class CalibrationStats : public ObjectRef {
+ public:
+  CalibrationStats(int num_tensors, int num_bins) {
+    ICHECK_EQ(num_bins % 2, 1) << "The number of histogram bins must be odd";
+    auto n = make_object<CalibrationStatsNode>();
+    n->num_bins = num_bins;
+    n->stats.resize(num_tensors);
+    for (auto& s : n->stats) s.hist.resize(num_bins, 0.0);
+    data_ = std::move(n);
+  }
+
+  TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(CalibrationStats, ObjectRef, CalibrationStatsNode);
+};
+
+TVM_REGISTER_NODE_TYPE(CalibrationStatsNode);
+
+TVM_REGISTER_GLOBAL("relay._quantize.CalibrationStats").set_body_typed([](int num_tensors,
+                                                                          int num_bins) {
+  return CalibrationStats(num_tensors, num_bins);
+});
+
+TVM_REGISTER_GLOBAL("relay._quantize.CalibrationStatsUpdate")
+    .set_body_typed([](CalibrationStats stats, Array<runtime::NDArray> tensors) {
+      ICHECK_EQ(tensors.size(), stats->stats.size());
+      std::vector<runtime::NDArray> cpu_tensors;
+      for (const auto& tensor : tensors) {
+        ICHECK(tensor.DataType() == DataType::Float(32))
+            << "Calibration only supports float32 tensors, but got " << tensor.DataType();
+        cpu_tensors.push_back(tensor->device.device_type == kDLCPU
+                                  ? tensor
+                                  : tensor.CopyTo(Device{kDLCPU, 0}));
+      }
+      // The tensors are independent, update their statistics in parallel.
+      support::parallel_for(0, static_cast<int>(cpu_tensors.size()), [&](int i) {
+        const DLTensor* t = cpu_tensors[i].operator->();
+        stats->Update(i, static_cast<const float*>(t->data) + t->byte_offset / sizeof(float),
+                      runtime::GetDataSize(*t) / sizeof(float));
+      });
+    });
+
+TVM_REGISTER_GLOBAL("relay._quantize.CalibrationStatsFindThresholds")
+    .set_body_typed([](CalibrationStats stats, String mode, int num_quantized_bins,
+                       double percentile) {
+      std::vector<float> thresholds(stats->stats.size());
+      support::parallel_for(0, static_cast<int>(thresholds.size()), [&](int i) {
+        thresholds[i] = stats->FindThreshold(i, mode, num_quantized_bins, percentile);
+      });
+      Array<FloatImm> ret;
+      for (float threshold : thresholds) ret.push_back(FloatImm(DataType::Float(32), threshold));
+      return ret;
+    });
+
 }  // namespace quantize
 }  // namespace relay
 }  // namespace tvm
@@ -31,6 +31,9 @@
 #include <tvm/runtime/ndarray.h>
 #include <tvm/runtime/object.h>
 
+#include <unordered_map>
+#include <vector>
+
 #include "../op/memory/on_device.h"
 #include "./pattern_utils.h"
 
@@ -62,8 +65,75 @@ bool IsComplexConstant(const Expr& expr) {
   }
 }
 
+/*!
+ * \brief Collects the outermost sub-expressions of an expression that are in \p deferred,
+ * without visiting inside them.
+ */
+class DeferredCollector : public MixedModeVisitor {
+ public:
+  explicit DeferredCollector(
+      const std::unordered_map<Expr, Type, ObjectPtrHash, ObjectPtrEqual>& deferred)
+      : deferred_(deferred) {}
+
+  std::vector<Expr> Collect(const Expr& expr) {
+    VisitExpr(expr);
+    return std::move(found_);
+  }
+
+ private:
+  using MixedModeVisitor::VisitExpr_;
+
+  bool CheckVisited(const Expr& expr) final {
+    if (visit_counter_[expr.get()] == 0 && deferred_.count(expr)) {
+      ++visit_counter_[expr.get()];
+      found_.push_back(expr);
+      return true;
+    }
+    return MixedModeVisitor::CheckVisited(expr);
+  }
+
+  void VisitExpr_(const LetNode* let_node) final {
+    auto pre_visit = [this](const LetNode* op) {
+      this->VisitExpr(op->var);
+      this->VisitExpr(op->value);
+    };
+    auto post_visit = [this](const LetNode* op) {
+      this->VisitExpr(op->body);
+      this->visit_counter_[op] += 1;
+    };
+    ExpandANormalForm(let_node, pre_visit, post_visit);
+  }
+
+  const std::unordered_map<Expr, Type, ObjectPtrHash, ObjectPtrEqual>& deferred_;
+  std::vector<Expr> found_;
+};
+
+/*! \brief Replaces sub-expressions by their values. */
+class DeferredSubstituter : public ExprRewriter {
+ public:
+  explicit DeferredSubstituter(
+      const std::unordered_map<Expr, Expr, ObjectPtrHash, ObjectPtrEqual>& values)
+      : values_(values) {}
+
+  Expr Rewrite_(const CallNode* pre, const Expr& post) final { return Lookup(pre, post); }
+
+  Expr Rewrite_(const TupleGetItemNode* pre, const Expr& post) final { return Lookup(pre, post); }
+
+ private:
+  Expr Lookup(const ExprNode* pre, const Expr& post) {
+    auto it = values_.find(GetRef<Expr>(pre));
+    return it == values_.end() ? post : it->second;
+  }
+
+  const std::unordered_map<Expr, Expr, ObjectPtrHash, ObjectPtrEqual>& values_;
+};
+
 // TODO(tvm-team) consider combine dead-code with constant folder.
 // or make a more powerful partial evaluator.
+//
+// Rather than evaluating each foldable call as it is visited, which would compile and run
+// every sub-expression on its own, the folder defers them. The outermost deferred
+// sub-expressions are evaluated together by EvaluateDeferred, with a single compilation.
 class ConstantFolder : public MixedModeMutator {
  public:
   explicit ConstantFolder(IRModule module)
@@ -74,6 +144,31 @@ class ConstantFolder : public MixedModeMutator {
         cast_op_(Op::Get("cast")),
         ndarray_size_op_(Op::Get("ndarray_size")) {}
 
+  /*!
+   * \brief Returns \p expr with its outermost deferred sub-expressions replaced by their
+   * values, which are evaluated together.
+   */
+  Expr EvaluateDeferred(const Expr& expr) {
+    if (deferred_.empty()) {
+      return expr;
+    }
+    std::vector<Expr> batch = DeferredCollector(deferred_).Collect(expr);
+    if (batch.empty()) {
+      return expr;
+    }
+    VLOG(1) << "Evaluating " << batch.size() << " deferred sub-expressions together";
+    ObjectRef values = Evaluate(Tuple(Array<Expr>(batch.begin(), batch.end())));
+    const auto* adt = values.as<runtime::ADTObj>();
+    ICHECK(adt != nullptr && adt->size == batch.size());
+    std::unordered_map<Expr, Expr, ObjectPtrHash, ObjectPtrEqual> results;
+    for (size_t i = 0; i < batch.size(); ++i) {
+      results.emplace(batch[i], ObjectToExpr((*adt)[i]));
+      deferred_.erase(batch[i]);
+    }
+    DeferredSubstituter substituter(results);
+    return PostOrderRewrite(expr, &substituter);
+  }
+
  private:
   using ExprMutator::VisitExpr_;
 
@@ -81,7 +176,12 @@ class ConstantFolder : public MixedModeMutator {
     auto pre_visit = [this](const LetNode* op) {
       // Rely on the Memoizer to cache pre-visit values
       Expr new_value = Mutate(op->value);
-      if (IsSimpleConstant(new_value)) {
+      if (IsDeferred(new_value) && !IsDeferredTensor(new_value)) {
+        // Whether the value is inlined depends on whether it evaluates to a tensor.
+        new_value = EvaluateDeferred(new_value);
+        memo_[op->value] = new_value;
+      }
+      if (IsSimpleConstant(new_value) || IsDeferredTensor(new_value)) {
         // Inline new value (along with any on_device annotation wrapping it) at all occurrences of
         // the variable.
         //
@@ -112,7 +212,7 @@ class ConstantFolder : public MixedModeMutator {
       Expr expr = GetRef<Expr>(op);
       // Rely on the Memoizer to cache pre-visit values
       Expr new_value = this->Mutate(op->value);
-      if (IsSimpleConstant(new_value)) {
+      if (IsSimpleConstant(new_value) || IsDeferredTensor(new_value)) {
         // The let-bound value has been inlined, drop the let-binding itself.
         this->memo_[expr] = Mutate(op->body);
       } else {
@@ -186,18 +286,20 @@ class ConstantFolder : public MixedModeMutator {
       // We should think about potentially constant evaluation over these ops too.
       return std::move(post_call);
     }
-    if (!std::all_of(post_call->args.begin(), post_call->args.end(), IsComplexConstant)) {
+    if (!std::all_of(post_call->args.begin(), post_call->args.end(),
+                     [this](const Expr& arg) { return IsFoldable(arg); })) {
       // At least one non-constant argument.
       return std::move(post_call);
     }
     // During evaluation we have obviously lost all on_device annotations. However any
     // on_device wrapping this call will be left in place.
-    return ConstEvaluate(post_call);
+    return Defer(post_call, pre_call->checked_type_);
   }
 
   Expr VisitExpr_(const IfNode* if_node) final {
     If new_if = Downcast<If>(ExprMutator::VisitExpr_(if_node));
-    if (const auto* const_node = AsIgnoringOnDevice<ConstantNode>(new_if->cond)) {
+    Expr cond = IsDeferred(new_if->cond) ? EvaluateDeferred(new_if->cond) : new_if->cond;
+    if (const auto* const_node = AsIgnoringOnDevice<ConstantNode>(cond)) {
       if (reinterpret_cast<uint8_t*>(const_node->data->data)[0]) {
         return new_if->true_branch;
       } else {
@@ -220,9 +322,45 @@ class ConstantFolder : public MixedModeMutator {
         return result;
       }
     }
+    if (IsDeferred(post_tuple_get_item_node->tuple)) {
+      return Defer(post_tuple_get_item, tuple_get_item_node->checked_type_);
+    }
     return std::move(post_tuple_get_item);
   }
 
+  /*!
+   * \brief Records \p expr, whose sub-expressions are all constant or deferred, for evaluation
+   * by \p EvaluateDeferred. \p type is the type of the expression it replaces, if known.
+   */
+  Expr Defer(const Expr& expr, const Type& type) {
+    deferred_[expr] = type;
+    return expr;
+  }
+
+  /*! \brief Returns whether \p expr, ignoring any "on_device" annotation, is deferred. */
+  bool IsDeferred(const Expr& expr) const { return deferred_.count(IgnoreOnDevice(expr)) > 0; }
+
+  /*! \brief Returns whether \p expr is deferred and known to evaluate to a tensor. */
+  bool IsDeferredTensor(const Expr& expr) const {
+    auto it = deferred_.find(IgnoreOnDevice(expr));
+    return it != deferred_.end() && it->second.defined() && it->second.as<TensorTypeNode>();
+  }
+
+  /*!
+   * \brief Returns whether \p expr is a simple constant, is deferred or is a tuple of foldable
+   * expressions.
+   */
+  bool IsFoldable(const Expr& expr) const {
+    if (IsSimpleConstant(expr) || IsDeferred(expr)) {
+      return true;
+    } else if (const auto* tuple_node = AsIgnoringOnDevice<TupleNode>(expr)) {
+      return std::all_of(tuple_node->fields.begin(), tuple_node->fields.end(),
+                         [this](const Expr& field) { return IsFoldable(field); });
+    } else {
+      return false;
+    }
+  }
+
   // Convert value to expression.
   Expr ObjectToExpr(const ObjectRef& value) {
     if (value->IsInstance<runtime::NDArray::ContainerType>()) {
@@ -242,8 +380,8 @@ class ConstantFolder : public MixedModeMutator {
   }
 
   // Constant evaluate an expression.
-  Expr ConstEvaluate(const Expr& expr) {
-    VLOG_CONTEXT << "ConstEvaluate";
+  ObjectRef Evaluate(const Expr& expr) {
+    VLOG_CONTEXT << "Evaluate";
     VLOG(1) << "Evaluating :" << std::endl << PrettyPrint(expr);
 
     // We'll invoke the interpreter using the generic CPU device and target. Technically there's
@@ -254,10 +392,8 @@ class ConstantFolder : public MixedModeMutator {
     // needed for both execution and creation(due to JIT)
     With<transform::PassContext> fresh_build_ctx(transform::PassContext::Create());
 
-    Expr result = ObjectToExpr(
-        Eval(expr, module_->type_definitions, module_->Imports(), eval_cpu_dev_, eval_cpu_target_));
-    VLOG(1) << "Evaluated to constant:" << std::endl << PrettyPrint(result);
-    return result;
+    return Eval(expr, module_->type_definitions, module_->Imports(), eval_cpu_dev_,
+                eval_cpu_target_);
   }
 
   /*!
@@ -361,7 +497,9 @@ class ConstantFolder : public MixedModeMutator {
     auto cast_attrs = make_object<CastAttrs>();
     cast_attrs->dtype = dtype;
     Expr ret = Call(cast_op_, {value}, Attrs(cast_attrs), {});
-    return ConstEvaluate(ret);
+    const auto* const_node = value.as<ConstantNode>();
+    ICHECK(const_node != nullptr);
+    return Defer(ret, TensorType(const_node->tensor_type()->shape, dtype));
   }
 
   Optional<tvm::Array<IndexExpr>> GetConstantShape(const Expr& input) {
@@ -395,6 +533,10 @@ class ConstantFolder : public MixedModeMutator {
 
   // True if currently within a "primitive" Relay Function.
   bool inside_primitive_ = false;
+
+  // The foldable expressions not yet evaluated, with the types of the expressions they
+  // replace when known.
+  std::unordered_map<Expr, Type, ObjectPtrHash, ObjectPtrEqual> deferred_;
 };
 
 }  // namespace
@@ -412,7 +554,8 @@ TVM_REGISTER_GLOBAL("relay.analysis.check_constant").set_body_typed(IsComplexCon
 Expr FoldConstantExpr(const Expr& expr, const IRModule& mod) {
   VLOG_CONTEXT << "FoldConstantExpr";
   VLOG(1) << "folding:" << std::endl << PrettyPrint(expr);
-  Expr result = ConstantFolder(mod).VisitExpr(expr);
+  ConstantFolder folder(mod);
+  Expr result = folder.EvaluateDeferred(folder.VisitExpr(expr));
   VLOG(1) << "folded to:" << std::endl << PrettyPrint(result);
   return result;
 }
@@ -0,0 +1,211 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file aot_executor.cc
+ * \brief Executor running the main function generated by the AOT executor codegen.
+ */
+#include "./aot_executor.h"
+
+#include <tvm/runtime/container/string.h>
+#include <tvm/runtime/data_type.h>
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/registry.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../meta_data.h"
+
+namespace tvm {
+namespace runtime {
+
+void AotExecutor::Init(const std::string& config_json, const Module& module,
+                       const std::vector<Device>& devs) {
+  std::istringstream is(config_json);
+  dmlc::JSONReader reader(&is);
+  config_.Load(&reader);
+  ICHECK_EQ(devs.size(), 1U) << "The AOT executor runs a model on a single device";
+  ICHECK_EQ(devs[0].device_type, kDLCPU) << "The AOT executor runs a model on the host CPU";
+
+  module_ = module;
+  std::string run_func_name =
+      get_name_mangled(config_.mod_name, ::tvm::runtime::symbol::tvm_run_func_suffix);
+  run_func_ = module_.GetFunction(run_func_name, /*query_imports=*/true);
+  ICHECK(run_func_ != nullptr) << "Cannot find " << run_func_name << " in the library, which "
+                               << "must be compiled with the packed interface of the AOT executor";
+
+  for (const AotTensorInfo& info : config_.inputs) {
+    inputs_.push_back(NDArray::Empty(info.shape, String2DLDataType(info.dtype), devs[0]));
+  }
+  for (const AotTensorInfo& info : config_.outputs) {
+    outputs_.push_back(NDArray::Empty(info.shape, String2DLDataType(info.dtype), devs[0]));
+  }
+  for (const NDArray& input : inputs_) {
+    args_.push_back(*input.operator->());
+  }
+  for (const NDArray& output : outputs_) {
+    args_.push_back(*output.operator->());
+  }
+  arg_values_.resize(args_.size());
+  arg_type_codes_.assign(args_.size(), kTVMDLTensorHandle);
+  for (size_t i = 0; i < args_.size(); ++i) {
+    arg_values_[i].v_handle = &args_[i];
+  }
+}
+
+void AotExecutor::Run() {
+  TVMRetValue rv;
+  run_func_.CallPacked(
+      TVMArgs(arg_values_.data(), arg_type_codes_.data(), static_cast<int>(args_.size())), &rv);
+}
+
+int AotExecutor::GetInputIndex(const std::string& name) const {
+  for (size_t i = 0; i < config_.inputs.size(); ++i) {
+    if (config_.inputs[i].name == name) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+void AotExecutor::CheckExternalDLTensor(const DLTensor* external, size_t arg_index) const {
+  const DLTensor& internal = args_[arg_index];
+  ICHECK_EQ(reinterpret_cast<size_t>(static_cast<char*>(external->data) + external->byte_offset) %
+                kAllocAlignment,
+            0);
+  ICHECK(IsContiguous(*external))
+      << "Operators expect compact arrays, use set_input to copy a strided array";
+  ICHECK(DataType(internal.dtype) == DataType(external->dtype));
+  ICHECK_EQ(internal.ndim, external->ndim);
+  ICHECK_EQ(internal.device.device_type, external->device.device_type);
+  ICHECK_EQ(internal.device.device_id, external->device.device_id);
+  for (int i = 0; i < external->ndim; ++i) {
+    ICHECK_EQ(internal.shape[i], external->shape[i]);
+  }
+}
+
+void AotExecutor::SetInput(int index, DLTensor* data_in) {
+  ICHECK_LT(static_cast<size_t>(index), inputs_.size());
+  args_[index].data = inputs_[index]->data;
+  inputs_[index].CopyFrom(data_in);
+}
+
+void AotExecutor::SetInputZeroCopy(int index, DLTensor* data_ref) {
+  ICHECK_LT(static_cast<size_t>(index), inputs_.size());
+  CheckExternalDLTensor(data_ref, index);
+  args_[index].data = static_cast<char*>(data_ref->data) + data_ref->byte_offset;
+}
+
+void AotExecutor::SetOutputZeroCopy(int index, DLTensor* data_ref) {
+  ICHECK_LT(static_cast<size_t>(index), outputs_.size());
+  size_t arg_index = inputs_.size() + index;
+  CheckExternalDLTensor(data_ref, arg_index);
+  args_[arg_index].data = static_cast<char*>(data_ref->data) + data_ref->byte_offset;
+}
+
+NDArray AotExecutor::GetInput(int index) const {
+  ICHECK_LT(static_cast<size_t>(index), inputs_.size());
+  return inputs_[index];
+}
+
+NDArray AotExecutor::GetOutput(int index) const {
+  ICHECK_LT(static_cast<size_t>(index), outputs_.size());
+  return outputs_[index];
+}
+
+void AotExecutor::CopyOutputTo(int index, DLTensor* data_out) {
+  ICHECK_LT(static_cast<size_t>(index), outputs_.size());
+  NDArray::CopyFromTo(&args_[inputs_.size() + index], data_out);
+}
+
+PackedFunc AotExecutor::GetFunction(const std::string& name,
+                                    const ObjectPtr<Object>& sptr_to_self) {
+  if (name == "set_input") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      if (String::CanConvertFrom(args[0])) {
+        int in_idx = this->GetInputIndex(args[0].operator String());
+        if (in_idx >= 0) this->SetInput(in_idx, args[1]);
+      } else {
+        this->SetInput(args[0], args[1]);
+      }
+    });
+  } else if (name == "set_input_zero_copy") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      if (String::CanConvertFrom(args[0])) {
+        int in_idx = this->GetInputIndex(args[0].operator String());
+        if (in_idx >= 0) this->SetInputZeroCopy(in_idx, args[1]);
+      } else {
+        this->SetInputZeroCopy(args[0], args[1]);
+      }
+    });
+  } else if (name == "set_output_zero_copy") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->SetOutputZeroCopy(args[0], args[1]);
+    });
+  } else if (name == "get_output") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      if (args.num_args == 2) {
+        this->CopyOutputTo(args[0], args[1]);
+      } else {
+        *rv = this->GetOutput(args[0]);
+      }
+    });
+  } else if (name == "get_input") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      int in_idx = 0;
+      if (String::CanConvertFrom(args[0])) {
+        in_idx = this->GetInputIndex(args[0].operator String());
+      } else {
+        in_idx = args[0];
+      }
+      if (in_idx >= 0) {
+        *rv = this->GetInput(in_idx);
+      }
+    });
+  } else if (name == "get_num_outputs") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->NumOutputs(); });
+  } else if (name == "get_num_inputs") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->NumInputs(); });
+  } else if (name == "run") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->Run(); });
+  } else if (name == "get_input_index") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      CHECK(String::CanConvertFrom(args[0])) << "Input key is not a string";
+      *rv = this->GetInputIndex(args[0].operator String());
+    });
+  } else {
+    return PackedFunc();
+  }
+}
+
+TVM_REGISTER_GLOBAL("tvm.aot_executor.create").set_body([](TVMArgs args, TVMRetValue* rv) {
+  ICHECK_EQ(args.num_args, 4) << "The expected arguments of tvm.aot_executor.create are the "
+                              << "executor config, the library, and the device type and id";
+  Device dev{static_cast<DLDeviceType>(args[2].operator int()), args[3].operator int()};
+  auto exec = make_object<AotExecutor>();
+  exec->Init(args[0].operator std::string(), args[1].operator Module(), {dev});
+  *rv = Module(exec);
+});
+
+}  // namespace runtime
+}  // namespace tvm
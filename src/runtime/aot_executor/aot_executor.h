@@ -0,0 +1,170 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/runtime/aot_executor/aot_executor.h
+ * \brief Executor running the main function generated by the AOT executor codegen.
+ */
+#ifndef TVM_RUNTIME_AOT_EXECUTOR_AOT_EXECUTOR_H_
+#define TVM_RUNTIME_AOT_EXECUTOR_AOT_EXECUTOR_H_
+
+#include <dlpack/dlpack.h>
+#include <dmlc/json.h>
+#include <tvm/runtime/module.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/packed_func.h>
+
+#include <string>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+
+/*! \brief The name, shape and dtype of an input or output of an AOT compiled model. */
+struct AotTensorInfo {
+  std::string name;
+  std::vector<int64_t> shape;
+  std::string dtype;
+
+  void Save(dmlc::JSONWriter* writer) const {
+    writer->BeginObject();
+    writer->WriteObjectKeyValue("name", name);
+    writer->WriteObjectKeyValue("shape", shape);
+    writer->WriteObjectKeyValue("dtype", dtype);
+    writer->EndObject();
+  }
+
+  void Load(dmlc::JSONReader* reader) {
+    dmlc::JSONObjectReadHelper helper;
+    helper.DeclareField("name", &name);
+    helper.DeclareField("shape", &shape);
+    helper.DeclareField("dtype", &dtype);
+    helper.ReadAllFields(reader);
+  }
+};
+
+/*!
+ * \brief The interface of the main function of an AOT compiled model, which the AOT executor
+ * codegen emits as JSON.
+ */
+struct AotExecutorConfig {
+  /*! \brief The mangled module name, which prefixes the symbol of the main function. */
+  std::string mod_name;
+  std::vector<AotTensorInfo> inputs;
+  std::vector<AotTensorInfo> outputs;
+
+  void Save(dmlc::JSONWriter* writer) const {
+    writer->BeginObject();
+    writer->WriteObjectKeyValue("mod_name", mod_name);
+    writer->WriteObjectKeyValue("inputs", inputs);
+    writer->WriteObjectKeyValue("outputs", outputs);
+    writer->EndObject();
+  }
+
+  void Load(dmlc::JSONReader* reader) {
+    dmlc::JSONObjectReadHelper helper;
+    helper.DeclareField("mod_name", &mod_name);
+    helper.DeclareField("inputs", &inputs);
+    helper.DeclareField("outputs", &outputs);
+    helper.ReadAllFields(reader);
+  }
+};
+
+/*!
+ * \brief Executor calling the main function of an AOT compiled model, with the interface of
+ * GraphExecutor.
+ *
+ *  The main function runs the whole model, so a run is a single packed call taking the inputs
+ *  and outputs. The parameters are linked into the library and the intermediate tensors are
+ *  workspace of the calling thread, so executors created from the same library share the
+ *  weights and only own their inputs and outputs.
+ */
+class TVM_DLL AotExecutor : public ModuleNode {
+ public:
+  /*!
+   * \brief Initialize the executor.
+   * \param config_json The AotExecutorConfig of the model, as JSON.
+   * \param module The library holding the main function of the model.
+   * \param devs The device of the model, which must be exactly one host CPU device.
+   */
+  void Init(const std::string& config_json, const Module& module, const std::vector<Device>& devs);
+
+  PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self) final;
+
+  const char* type_key() const final { return "AotExecutor"; }
+
+  /*! \brief Run the model. */
+  void Run();
+  /*!
+   * \brief Get the index of an input.
+   * \param name The name of the input.
+   * \return The index of the input, or -1 if the model has no such input.
+   */
+  int GetInputIndex(const std::string& name) const;
+  /*!
+   * \brief Copy data into an input.
+   * \param index The input index.
+   * \param data_in The data to copy.
+   */
+  void SetInput(int index, DLTensor* data_in);
+  /*!
+   * \brief Bind an input to external memory, which the model reads in the following runs.
+   * \param index The input index.
+   * \param data_ref The tensor to bind, of the shape, dtype and device of the input.
+   */
+  void SetInputZeroCopy(int index, DLTensor* data_ref);
+  /*!
+   * \brief Bind an output to external memory, which the model writes in the following runs.
+   * \param index The output index.
+   * \param data_ref The tensor to bind, of the shape, dtype and device of the output.
+   */
+  void SetOutputZeroCopy(int index, DLTensor* data_ref);
+  int NumInputs() const { return static_cast<int>(inputs_.size()); }
+  int NumOutputs() const { return static_cast<int>(outputs_.size()); }
+  /*! \brief Get the array holding an input, unless the input is bound to external memory. */
+  NDArray GetInput(int index) const;
+  /*! \brief Get the array holding an output, unless the output is bound to external memory. */
+  NDArray GetOutput(int index) const;
+  /*! \brief Copy an output, wherever it is, to data_out. */
+  void CopyOutputTo(int index, DLTensor* data_out);
+
+ private:
+  /*! \brief Check that an external tensor can stand for the argument at arg_index. */
+  void CheckExternalDLTensor(const DLTensor* external, size_t arg_index) const;
+
+  AotExecutorConfig config_;
+  /*! \brief The library holding the main function. */
+  Module module_;
+  /*! \brief The main function of the model. */
+  PackedFunc run_func_;
+  std::vector<NDArray> inputs_;
+  std::vector<NDArray> outputs_;
+  /*!
+   * \brief The arguments of the main function, the inputs followed by the outputs. They view
+   *  inputs_ and outputs_ or external memory bound to them.
+   */
+  std::vector<DLTensor> args_;
+  std::vector<TVMValue> arg_values_;
+  std::vector<int> arg_type_codes_;
+};
+
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_AOT_EXECUTOR_AOT_EXECUTOR_H_
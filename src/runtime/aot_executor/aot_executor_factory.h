@@ -0,0 +1,78 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file tvm/runtime/aot_executor/aot_executor_factory.h
+ * \brief AOT executor factory creating AOT executors.
+ */
+
+#ifndef TVM_RUNTIME_AOT_EXECUTOR_AOT_EXECUTOR_FACTORY_H_
+#define TVM_RUNTIME_AOT_EXECUTOR_AOT_EXECUTOR_FACTORY_H_
+
+#include <tvm/runtime/module.h>
+#include <tvm/runtime/packed_func.h>
+
+#include <string>
+#include <vector>
+
+#include "./aot_executor.h"
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief Factory module of an AOT compiled model, which imports the library holding the model.
+ *
+ *  It is what relay.build returns for the AOT executor and what exported libraries load into, like
+ *  GraphExecutorFactory. Every executor it creates calls the same library, so they share the
+ *  parameters linked into it.
+ */
+class TVM_DLL AotExecutorFactory : public runtime::ModuleNode {
+ public:
+  /*!
+   * \brief Construct the AotExecutorFactory.
+   * \param config_json The AotExecutorConfig of the model, as JSON.
+   * \param module_name The module name of the model.
+   */
+  AotExecutorFactory(const std::string& config_json, const std::string& module_name = "default");
+
+  PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self) final;
+
+  const char* type_key() const override { return "AotExecutorFactory"; }
+
+  void SaveToBinary(dmlc::Stream* stream) override;
+
+  /*!
+   * \brief Create an executor of the model.
+   * \param devs The devices of the host and of the model.
+   * \return The created executor module.
+   */
+  Module ExecutorCreate(const std::vector<Device>& devs);
+
+ protected:
+  /*! \brief The AotExecutorConfig of the model, as JSON. */
+  std::string config_json_;
+  /*! \brief module name */
+  std::string module_name_;
+};
+
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_AOT_EXECUTOR_AOT_EXECUTOR_FACTORY_H_
@@ -26,8 +26,13 @@
 
 extern "C" {
 #include <mkl_cblas.h>
+#include <mkl_cbwr.h>
+#include <mkl_service.h>
 }
 
+#include <cstring>
+#include <vector>
+
 #include "gemm_common.h"
 
 namespace tvm {
@@ -153,6 +158,117 @@ struct MKLDgemmBatchIterativeOp {
   }
 };
 
+/*!
+ * \brief Header of a matrix packed by tvm.contrib.mkl.pack_matrix, followed by the packed data.
+ *
+ *  The packed format depends on the MKL version and on the code path MKL dispatches to on the
+ *  CPU, so both are recorded to reject a matrix packed on another machine.
+ */
+struct MKLPackedMatrixHeader {
+  int64_t magic;
+  int64_t mkl_version;
+  int64_t cpu_branch;
+  int64_t trans;
+  int64_t m;
+  int64_t n;
+  int64_t k;
+  int64_t ld;
+};
+static_assert(sizeof(MKLPackedMatrixHeader) == 64, "The packed data must stay 64 byte aligned");
+
+constexpr int64_t kMKLPackedMatrixMagic = 0x54564D4D4B4C5041;
+
+inline MKLPackedMatrixHeader MKLCurrentPackedMatrixHeader() {
+  MKLVersion version;
+  mkl_get_version(&version);
+  MKLPackedMatrixHeader header;
+  std::memset(&header, 0, sizeof(header));
+  header.magic = kMKLPackedMatrixMagic;
+  header.mkl_version =
+      version.MajorVersion * 10000 + version.MinorVersion * 100 + version.UpdateVersion;
+  header.cpu_branch = mkl_cbwr_get_auto_branch();
+  return header;
+}
+
+// Pack the constant right hand side B of a row major sgemm whose left hand side has n rows.
+// Note that data is stored in tvm as row major, so B is the packed A of the column major sgemm.
+inline NDArray PackSgemmMatrix(NDArray rhs, int n, bool transb) {
+  DLTensor* B = const_cast<DLTensor*>(rhs.operator->());
+  ICHECK_EQ(B->ndim, 2);
+  ICHECK_EQ(B->device.device_type, kDLCPU);
+  ICHECK_EQ(ElementStride(B), 1);
+  ICHECK(TypeMatch(B->dtype, kDLFloat, 32));
+  transb = IsInPlaceTransposed(B) ? !transb : transb;
+
+  MKLPackedMatrixHeader header = MKLCurrentPackedMatrixHeader();
+  header.trans = transb;
+  header.m = ColumnCount(B, transb);
+  header.n = n;
+  header.k = RowCount(B, transb);
+  header.ld = ColumnStride(B);
+  size_t bytes = cblas_sgemm_pack_get_size(CblasAMatrix, header.m, header.n, header.k);
+  NDArray packed = NDArray::Empty({static_cast<int64_t>(sizeof(header) + bytes)},
+                                  DLDataType{kDLUInt, 8, 1}, B->device);
+  char* data = static_cast<char*>(packed->data);
+  std::memcpy(data, &header, sizeof(header));
+  cblas_sgemm_pack(CblasColMajor, CblasAMatrix, MKLBooleanToTranspose(transb), header.m, header.n,
+                   header.k, 1.0f,
+                   reinterpret_cast<const float*>(static_cast<char*>(B->data) + B->byte_offset),
+                   header.ld, reinterpret_cast<float*>(data + sizeof(header)));
+  return packed;
+}
+
+// Row major sgemm with a right hand side packed by PackSgemmMatrix.
+inline void CallPackedSgemm(TVMArgs args, TVMRetValue* ret) {
+  DLTensor* A = args[0];
+  DLTensor* P = args[1];
+  DLTensor* C = args[2];
+  bool transa = args[3];
+  ICHECK_EQ(A->ndim, 2);
+  ICHECK_EQ(P->ndim, 1);
+  ICHECK_EQ(C->ndim, 2);
+
+  ICHECK_EQ(ElementStride(A), 1);
+  ICHECK_EQ(ElementStride(C), 1);
+
+  // C can never be transposed.
+  ICHECK(!IsInPlaceTransposed(C));
+
+  // Reversed strides indicates an in-place transpose operation.
+  transa = IsInPlaceTransposed(A) ? !transa : transa;
+
+  ICHECK(TypeMatch(A->dtype, kDLFloat, 32));
+  ICHECK(TypeMatch(P->dtype, kDLUInt, 8));
+  ICHECK(TypeMatch(C->dtype, kDLFloat, 32));
+
+  const char* packed = static_cast<const char*>(P->data) + P->byte_offset;
+  MKLPackedMatrixHeader header;
+  ICHECK_GE(P->shape[0], static_cast<int64_t>(sizeof(header)));
+  std::memcpy(&header, packed, sizeof(header));
+  ICHECK_EQ(header.magic, kMKLPackedMatrixMagic)
+      << "The right hand side was not packed by tvm.contrib.mkl.pack_matrix";
+  MKLPackedMatrixHeader current = MKLCurrentPackedMatrixHeader();
+  ICHECK(header.mkl_version == current.mkl_version && header.cpu_branch == current.cpu_branch)
+      << "The right hand side was packed by MKL " << header.mkl_version << " for code path "
+      << header.cpu_branch << ", but this is MKL " << current.mkl_version << " on code path "
+      << current.cpu_branch << ", build the model on the machine running it";
+
+  int m = ColumnCount(C, false);
+  int n = RowCount(A, transa);
+  int k = ColumnCount(A, transa);
+  ICHECK_EQ(RowCount(C, false), n);
+  ICHECK(header.m == m && header.n == n && header.k == k)
+      << "The right hand side was packed for a " << header.n << "x" << header.k << " by "
+      << header.k << "x" << header.m << " product, not " << n << "x" << k << " by " << k << "x"
+      << m;
+  cblas_sgemm_compute(CblasColMajor, CblasPacked, MKLBooleanToTranspose(transa), m, n, k,
+                      reinterpret_cast<const float*>(packed + sizeof(header)), header.ld,
+                      reinterpret_cast<float*>(static_cast<char*>(A->data) + A->byte_offset),
+                      ColumnStride(A), 0.0f,
+                      reinterpret_cast<float*>(static_cast<char*>(C->data) + C->byte_offset),
+                      ColumnStride(C));
+}
+
 // matrix multiplication for row major
 TVM_REGISTER_GLOBAL("tvm.contrib.mkl.matmul").set_body([](TVMArgs args, TVMRetValue* ret) {
   DLTensor* A = args[0];
@@ -175,6 +291,14 @@ TVM_REGISTER_GLOBAL("tvm.contrib.mkl.matmul_u8s8s32").set_body([](TVMArgs args,
   CallU8S8S32Gemm(args, ret, MKLGemmU8S8S32Op());
 });
 
+// pack the constant right hand side of a row major matrix multiplication
+TVM_REGISTER_GLOBAL("tvm.contrib.mkl.pack_matrix").set_body_typed(PackSgemmMatrix);
+
+// matrix multiplication for row major with a right hand side packed by pack_matrix
+TVM_REGISTER_GLOBAL("tvm.contrib.mkl.matmul_packed").set_body([](TVMArgs args, TVMRetValue* ret) {
+  CallPackedSgemm(args, ret);
+});
+
 TVM_REGISTER_GLOBAL("tvm.contrib.mkl.batch_matmul").set_body([](TVMArgs args, TVMRetValue* ret) {
   DLTensor* A = args[0];
   ICHECK(TypeMatch(A->dtype, kDLFloat, 32) || TypeMatch(A->dtype, kDLFloat, 64));
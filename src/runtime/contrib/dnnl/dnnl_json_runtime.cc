@@ -25,8 +25,16 @@
 #include <tvm/runtime/ndarray.h>
 #include <tvm/runtime/registry.h>
 
+#include <algorithm>
 #include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "../json/json_node.h"
@@ -43,6 +51,8 @@ using namespace tvm::runtime::json;
 class DNNLJSONRuntime : public JSONRuntimeBase {
   using tag = dnnl::memory::format_tag;
   using dt = dnnl::memory::data_type;
+  /*! \brief The shapes of the graph inputs, used as the key of the network cache. */
+  using ShapeKey = std::vector<dnnl::memory::dims>;
 
  public:
   DNNLJSONRuntime(const std::string& symbol_name, const std::string& graph_json,
@@ -52,47 +62,237 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
   const char* type_key() const { return "dnnl_json"; }
 
   void Init(const Array<NDArray>& consts) override {
-    BuildEngine();
+    engine_ = dnnl::engine(dnnl::engine::kind::cpu, 0);
 
     ICHECK_EQ(consts.size(), const_idx_.size())
         << "The number of input constants must match the number of required.";
 
     // Setup constants entries for weights.
     SetupConstants(consts);
+
+    // The batch size in the graph. Other batch sizes are served by networks built on demand.
+    ShapeKey graph_shapes;
+    for (auto nid : input_nodes_) {
+      if (nodes_[nid].GetOpType() != "input") continue;
+      for (const auto& shape : nodes_[nid].GetOpShape()) {
+        graph_shapes.push_back(shape);
+      }
+    }
+    graph_batch_ = graph_shapes.empty() || graph_shapes[0].empty() ? 1 : graph_shapes[0][0];
+    MarkBatchEntries();
+
+    // Build the network for static graphs up front so that errors surface at init time.
+    bool is_static = true;
+    for (const auto& shape : graph_shapes) {
+      for (auto dim : shape) is_static &= dim >= 0;
+    }
+    if (is_static) GetNetwork(graph_shapes);
   }
 
-  void Run() override {
+  void Run() override { Execute(data_entry_); }
+
+  void Invoke(const TVMArgs& args) override {
+    // Bind the buffers of this call to a local table so that concurrent calls do not race.
+    std::vector<const DLTensor*> data_entry = data_entry_;
+    BindInputOutputBuffers(args, &data_entry);
+    Execute(data_entry);
+  }
+
+ private:
+  /*!
+   * \brief The state of one call in flight: a DNNL stream and the memories of all non-constant
+   * slots. Primitives and constant memories are shared by all contexts.
+   */
+  struct ExecutionContext {
+    dnnl::stream stream;
+    std::unordered_map<size_t, dnnl::memory> mem;
+    std::vector<std::unordered_map<int, dnnl::memory>> net_args;
+  };
+
+  /*!
+   * \brief The DNNL primitives built for one set of input shapes.
+   *
+   * Graph entries are bound to memory slots. Primitives pick their preferred (possibly blocked)
+   * layouts, which are propagated to the consumers of their outputs; reorders are only inserted
+   * where a consumer needs another layout, and to convert graph inputs and outputs from and to
+   * the plain layout of the user buffers. Reorders of constants run once when the network is
+   * built.
+   */
+  struct Network {
+    /*! \brief The batch size the network is built for. */
+    dnnl::memory::dim batch;
+    /*! \brief The network layers that are represented in dnnl primitives. */
+    std::vector<dnnl::primitive> net;
+    /*! \brief The memory slots that are consumed by arguments. */
+    std::vector<std::unordered_map<int, size_t>> net_arg_slots;
+    /*! \brief The description of each memory slot. */
+    std::vector<dnnl::memory::desc> slot_desc;
+    /*! \brief Whether a memory slot holds constant data. */
+    std::vector<bool> slot_is_const;
+    /*! \brief The entry ID to its corresponding memory slot and offset. */
+    std::unordered_map<uint32_t, std::pair<size_t, size_t>> entry_slot;
+    /*! \brief The reordered copies of slots: (source slot, target layout, target slot). */
+    std::vector<std::tuple<size_t, dnnl::memory::desc, size_t>> reorders;
+    /*! \brief The reorders of constant slots, executed once after loading the constants. */
+    std::vector<std::tuple<dnnl::primitive, size_t, size_t>> const_reorders;
+    /*! \brief The memories of constant slots, shared by all execution contexts. */
+    std::unordered_map<size_t, dnnl::memory> shared_mem;
+    /*!
+     * \brief The execution contexts not used by a call. A call checks one out and returns it,
+     * so a network never holds more contexts than the peak number of concurrent calls.
+     */
+    std::vector<std::unique_ptr<ExecutionContext>> idle_contexts;
+    /*! \brief Protects idle_contexts. */
+    std::mutex context_mutex;
+  };
+
+  /*! \brief The maximum number of networks, i.e. distinct input shapes, kept in the cache. */
+  static constexpr size_t kMaxCachedNetworks = 8;
+
+  // Execute the network with the given data entries using a context checked out for the call.
+  void Execute(const std::vector<const DLTensor*>& data_entry) {
+    ShapeKey shapes;
+    for (auto eid : input_var_eid_) {
+      const DLTensor* tensor = data_entry[eid];
+      shapes.emplace_back(tensor->shape, tensor->shape + tensor->ndim);
+    }
+    // Holding a reference keeps the network alive even if it is evicted meanwhile.
+    std::shared_ptr<Network> net = GetNetwork(shapes);
+    // A context is returned to the network once the call succeeds and dropped if it throws.
+    std::unique_ptr<ExecutionContext> ctx = AcquireContext(net.get());
+
     // Fill in the input buffers.
-    for (size_t i = 0; i < input_nodes_.size(); ++i) {
-      auto eid = EntryID(input_nodes_[i], 0);
+    for (auto eid : input_var_eid_) {
+      auto it = net->entry_slot.find(eid);
+      if (it == net->entry_slot.end()) continue;
       // TODO(@comaniac): Support other data lengths.
-      size_t offset_in_bytes = entry_out_mem_[eid].second * 4;
-      size_t buffer_size = GetDataSize(*data_entry_[eid]);
-      write_to_dnnl_memory(data_entry_[eid]->data, entry_out_mem_[eid].first, buffer_size,
-                           offset_in_bytes);
+      size_t offset_in_bytes = it->second.second * 4;
+      size_t buffer_size = GetDataSize(*data_entry[eid]);
+      write_to_dnnl_memory(data_entry[eid]->data, GetMemory(*net, ctx.get(), it->second.first),
+                           buffer_size, offset_in_bytes);
     }
 
     // Invoke the engine through intepreting the stream.
-    for (size_t i = 0; i < net_.size(); ++i) {
-      net_.at(i).execute(stream_, net_args_.at(i));
+    for (size_t i = 0; i < net->net.size(); ++i) {
+      net->net.at(i).execute(ctx->stream, ctx->net_args.at(i));
     }
-    stream_.wait();
+    ctx->stream.wait();
 
     // Read output buffers.
     for (size_t i = 0; i < outputs_.size(); ++i) {
       auto eid = EntryID(outputs_[i]);
-      size_t offset_in_bytes = entry_out_mem_[eid].second * 4;
-      size_t buffer_size = GetDataSize(*data_entry_[eid]);
-      read_from_dnnl_memory(data_entry_[eid]->data, entry_out_mem_[eid].first, buffer_size,
-                            offset_in_bytes);
+      const auto& slot = net->entry_slot.at(eid);
+      size_t offset_in_bytes = slot.second * 4;
+      size_t buffer_size = GetDataSize(*data_entry[eid]);
+      read_from_dnnl_memory(data_entry[eid]->data, GetMemory(*net, ctx.get(), slot.first),
+                            buffer_size, offset_in_bytes);
     }
+    ReleaseContext(net.get(), std::move(ctx));
   }
 
- private:
-  // Build up the engine based on the input graph.
-  void BuildEngine() {
-    engine_ = dnnl::engine(dnnl::engine::kind::cpu, 0);
-    stream_ = dnnl::stream(engine_);
+  // Get the network for the given input shapes from the LRU cache, building it on a miss.
+  std::shared_ptr<Network> GetNetwork(const ShapeKey& shapes) {
+    std::lock_guard<std::mutex> lock(network_mutex_);
+    auto it = network_index_.find(shapes);
+    if (it != network_index_.end()) {
+      networks_.splice(networks_.begin(), networks_, it->second);
+      return it->second->second;
+    }
+    std::shared_ptr<Network> net = BuildNetwork(shapes);
+    networks_.emplace_front(shapes, net);
+    network_index_[shapes] = networks_.begin();
+    if (networks_.size() > kMaxCachedNetworks) {
+      network_index_.erase(networks_.back().first);
+      networks_.pop_back();
+    }
+    return net;
+  }
+
+  // Check an idle execution context out of the network, creating one if all are in use.
+  std::unique_ptr<ExecutionContext> AcquireContext(Network* net) {
+    {
+      std::lock_guard<std::mutex> lock(net->context_mutex);
+      if (!net->idle_contexts.empty()) {
+        std::unique_ptr<ExecutionContext> ctx = std::move(net->idle_contexts.back());
+        net->idle_contexts.pop_back();
+        return ctx;
+      }
+    }
+    std::unique_ptr<ExecutionContext> ctx(new ExecutionContext());
+    ctx->stream = dnnl::stream(engine_);
+    for (size_t slot = 0; slot < net->slot_desc.size(); ++slot) {
+      if (net->shared_mem.count(slot) == 0) {
+        ctx->mem.emplace(slot, dnnl::memory(net->slot_desc[slot], engine_));
+      }
+    }
+    for (const auto& args : net->net_arg_slots) {
+      std::unordered_map<int, dnnl::memory> mem_args;
+      for (const auto& kv : args) {
+        mem_args.emplace(kv.first, GetMemory(*net, ctx.get(), kv.second));
+      }
+      ctx->net_args.push_back(std::move(mem_args));
+    }
+    return ctx;
+  }
+
+  // Return an execution context to the network for the following calls.
+  void ReleaseContext(Network* net, std::unique_ptr<ExecutionContext> ctx) {
+    std::lock_guard<std::mutex> lock(net->context_mutex);
+    net->idle_contexts.push_back(std::move(ctx));
+  }
+
+  // Get the memory of a slot, which is either shared or owned by the context.
+  const dnnl::memory& GetMemory(const Network& net, ExecutionContext* ctx, size_t slot) const {
+    auto it = net.shared_mem.find(slot);
+    return it != net.shared_mem.end() ? it->second : ctx->mem.at(slot);
+  }
+
+  // Mark the entries whose leading dimension is the batch axis: the graph inputs of the graph
+  // batch size, and the outputs of the kernels reading such an entry. Only these entries follow
+  // the batch size of a network; others keep their graph shape even if it starts with the same
+  // extent.
+  void MarkBatchEntries() {
+    batch_entry_.assign(NumEntries(), false);
+    for (size_t nid = 0; nid < nodes_.size(); ++nid) {
+      const auto& node = nodes_[nid];
+      bool batched = node.GetOpType() == "input";
+      if (node.GetOpType() == "kernel") {
+        for (const auto& entry : node.GetInputs()) {
+          batched |= batch_entry_[EntryID(entry)];
+        }
+      }
+      const auto& shapes = node.GetOpShape();
+      for (uint32_t i = 0; i < node.GetNumOutput(); ++i) {
+        batch_entry_[EntryID(nid, i)] =
+            batched && !shapes[i].empty() && shapes[i][0] == graph_batch_;
+      }
+    }
+  }
+
+  // Build up the network for the given input shapes based on the input graph.
+  std::shared_ptr<Network> BuildNetwork(const ShapeKey& shapes) {
+    // Only the batch size, i.e. the leading dimension, may differ from the graph.
+    ICHECK_EQ(shapes.size(), input_var_eid_.size());
+    std::shared_ptr<Network> net = std::make_shared<Network>();
+    net->batch = shapes.empty() || shapes[0].empty() ? graph_batch_ : shapes[0][0];
+    size_t i = 0;
+    for (auto nid : input_nodes_) {
+      if (nodes_[nid].GetOpType() != "input") continue;
+      const auto& graph_shapes = nodes_[nid].GetOpShape();
+      for (uint32_t k = 0; k < graph_shapes.size(); ++k) {
+        const auto& graph_shape = graph_shapes[k];
+        const auto& shape = shapes[i++];
+        ICHECK_EQ(shape.size(), graph_shape.size())
+            << "Input " << nodes_[nid].GetOpName() << " has an unexpected rank.";
+        bool batched = batch_entry_[EntryID(nid, k)];
+        for (size_t j = 0; j < shape.size(); ++j) {
+          auto expected = j == 0 && batched ? net->batch : graph_shape[j];
+          ICHECK_EQ(shape[j], expected) << "Input " << nodes_[nid].GetOpName()
+                                        << " has an unexpected shape, only the batch size of "
+                                        << "the inputs may vary.";
+        }
+      }
+    }
 
     // Build subgraph engine.
     for (size_t nid = 0; nid < nodes_.size(); ++nid) {
@@ -101,63 +301,176 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
         ICHECK_EQ(node.GetOpType(), "kernel");
         auto op_name = node.GetOpName();
         if ("nn.conv2d" == op_name) {
-          Conv2d(nid);
+          Conv2d(net.get(), nid);
         } else if ("dnnl.conv2d_relu" == op_name) {
-          Conv2d(nid, true, false);
+          Conv2d(net.get(), nid, true, false);
         } else if ("dnnl.conv2d_bias_relu" == op_name) {
-          Conv2d(nid, true, true);
+          Conv2d(net.get(), nid, true, true);
         } else if ("nn.dense" == op_name) {
-          Dense(nid);
+          Dense(net.get(), nid);
         } else if ("nn.batch_norm" == op_name) {
-          BatchNorm(nid);
+          BatchNorm(net.get(), nid);
         } else if ("nn.relu" == op_name) {
-          Relu(nid);
+          Relu(net.get(), nid);
         } else if ("add" == op_name) {
-          Binary(nid, dnnl::algorithm::binary_add);
+          Binary(net.get(), nid, dnnl::algorithm::binary_add);
         } else if ("multiply" == op_name) {
-          Binary(nid, dnnl::algorithm::binary_mul);
+          Binary(net.get(), nid, dnnl::algorithm::binary_mul);
         } else {
           LOG(FATAL) << "Unsupported op: " << op_name;
         }
       }
     }
+
+    // Convert the graph outputs back to the plain layout of the user buffers.
+    for (const auto& out_entry : outputs_) {
+      auto& slot = net->entry_slot.at(EntryID(out_entry));
+      if (slot.second == 0) {
+        slot.first = Reorder(net.get(), slot.first, GetPlainDesc(*net, out_entry));
+      }
+    }
+
+    // Copy the constants into DNNL memories once, they are shared by all calls.
+    for (size_t slot = 0; slot < net->slot_desc.size(); ++slot) {
+      if (net->slot_is_const[slot] && net->shared_mem.count(slot) == 0) {
+        net->shared_mem.emplace(slot, dnnl::memory(net->slot_desc[slot], engine_));
+      }
+    }
+    for (size_t i = 0; i < const_idx_.size(); ++i) {
+      auto eid = EntryID(const_idx_[i], 0);
+      auto it = net->entry_slot.find(eid);
+      if (it == net->entry_slot.end()) continue;
+      // TODO(@comaniac): Support other data lengths.
+      write_to_dnnl_memory(data_entry_[eid]->data, net->shared_mem.at(it->second.first),
+                           GetDataSize(*data_entry_[eid]), it->second.second * 4);
+    }
+    // Reorder the weights to the layouts preferred by the primitives.
+    dnnl::stream stream(engine_);
+    for (const auto& reorder : net->const_reorders) {
+      std::get<0>(reorder).execute(stream,
+                                   {{DNNL_ARG_SRC, net->shared_mem.at(std::get<1>(reorder))},
+                                    {DNNL_ARG_DST, net->shared_mem.at(std::get<2>(reorder))}});
+    }
+    stream.wait();
+    return net;
+  }
+
+  // Get the shape of a graph entry in the given network.
+  dnnl::memory::dims GetShape(const Network& net, const JSONGraphNodeEntry& entry) const {
+    dnnl::memory::dims shape = nodes_[entry.id_].GetOpShape()[entry.index_];
+    if (batch_entry_[EntryID(entry)]) {
+      shape[0] = net.batch;
+    }
+    return shape;
+  }
+
+  // Get the plain memory description of a graph entry, i.e. the layout of user buffers.
+  dnnl::memory::desc GetPlainDesc(const Network& net, const JSONGraphNodeEntry& entry) {
+    return GenDNNLMemDescByShape(GetShape(net, entry), dt::f32);
+  }
+
+  // Get the memory description of a graph entry, which is the layout chosen by its producer.
+  dnnl::memory::desc GetEntryDesc(const Network& net, const JSONGraphNodeEntry& entry) {
+    auto it = net.entry_slot.find(EntryID(entry));
+    if (it == net.entry_slot.end() || it->second.second != 0) {
+      return GetPlainDesc(net, entry);
+    }
+    return net.slot_desc[it->second.first];
+  }
+
+  // Add a DNNL memory slot described by mem_desc.
+  size_t AddMemorySlot(Network* net, const dnnl::memory::desc& mem_desc, bool is_const) {
+    net->slot_desc.push_back(mem_desc);
+    net->slot_is_const.push_back(is_const);
+    return net->slot_desc.size() - 1;
+  }
+
+  // Add a DNNL memory slot filled with zeros and shared by all calls.
+  size_t AddZeroMemorySlot(Network* net, const dnnl::memory::desc& mem_desc) {
+    size_t slot = AddMemorySlot(net, mem_desc, true);
+    auto mem = dnnl::memory(mem_desc, engine_);
+    std::fill_n(static_cast<uint8_t*>(mem.get_data_handle()), mem_desc.get_size(), 0);
+    net->shared_mem.emplace(slot, mem);
+    return slot;
+  }
+
+  // Get a slot holding the data of the given slot in the layout of mem_desc, inserting a
+  // reorder if the layouts differ. Reorders of constants run once when the network is built.
+  size_t Reorder(Network* net, size_t slot, const dnnl::memory::desc& mem_desc) {
+    if (net->slot_desc[slot] == mem_desc) return slot;
+    for (const auto& reorder : net->reorders) {
+      if (std::get<0>(reorder) == slot && std::get<1>(reorder) == mem_desc) {
+        return std::get<2>(reorder);
+      }
+    }
+    bool is_const = net->slot_is_const[slot];
+    size_t dst = AddMemorySlot(net, mem_desc, is_const);
+    net->reorders.emplace_back(slot, mem_desc, dst);
+    auto reorder = dnnl::reorder(
+        dnnl::reorder::primitive_desc(engine_, net->slot_desc[slot], engine_, mem_desc));
+    if (is_const) {
+      net->const_reorders.emplace_back(reorder, slot, dst);
+    } else {
+      net->net.push_back(reorder);
+      net->net_arg_slots.push_back({{DNNL_ARG_SRC, slot}, {DNNL_ARG_DST, dst}});
+    }
+    return dst;
   }
 
-  // Bind a JSON graph node entry to a DNNL memory.
-  dnnl::memory BindDNNLMemory(const JSONGraphNodeEntry& entry, dnnl::memory::desc mem_desc,
-                              size_t offset = 0) {
+  // Bind a JSON graph node entry to a DNNL memory slot.
+  size_t BindDNNLMemory(Network* net, const JSONGraphNodeEntry& entry,
+                        dnnl::memory::desc mem_desc, size_t offset = 0) {
     auto eid = EntryID(entry);
-    if (entry_out_mem_.count(eid) == 0) {
-      return BindDNNLMemory(entry, dnnl::memory(mem_desc, engine_), offset);
+    if (net->entry_slot.count(eid) == 0) {
+      bool is_const = nodes_[entry.id_].GetOpType() == "const";
+      return BindDNNLMemory(net, entry, AddMemorySlot(net, mem_desc, is_const), offset);
     }
-    return entry_out_mem_[eid].first;
+    return net->entry_slot[eid].first;
   }
 
-  // Bind a JSON graph node entry to a given DNNL memory.
-  dnnl::memory BindDNNLMemory(const JSONGraphNodeEntry& entry, dnnl::memory mem,
-                              size_t offset = 0) {
+  // Bind a JSON graph node entry to a given DNNL memory slot.
+  size_t BindDNNLMemory(Network* net, const JSONGraphNodeEntry& entry, size_t slot,
+                        size_t offset = 0) {
     auto eid = EntryID(entry);
-    // Since the DNNL memory has been created before calling this function, we assume the entry
-    // has not yet been bound to the other DNNL memory; otherwise it may have memory leak.
-    ICHECK_EQ(entry_out_mem_.count(eid), 0);
+    // Since the DNNL memory slot has been created before calling this function, we assume the
+    // entry has not yet been bound to the other slot.
+    ICHECK_EQ(net->entry_slot.count(eid), 0);
 
     // TODO(@comanic): Support other data types (i.e., int8).
     auto data_node = nodes_[entry.id_];
     auto dltype = data_node.GetOpDataType()[entry.index_];
     ICHECK_EQ(dltype.bits, 32);
 
-    entry_out_mem_[eid] = {mem, offset};
-    return entry_out_mem_[eid].first;
+    net->entry_slot[eid] = {slot, offset};
+    return slot;
+  }
+
+  // Get a slot holding the given input entry in the layout of mem_desc. Entries which are not
+  // produced by a DNNL primitive, i.e. graph inputs and constants, are stored as plain_desc.
+  size_t BindInput(Network* net, const JSONGraphNodeEntry& entry,
+                   const dnnl::memory::desc& mem_desc, const dnnl::memory::desc& plain_desc) {
+    size_t slot = BindDNNLMemory(net, entry, plain_desc);
+    if (net->slot_desc[slot] != mem_desc) {
+      ICHECK_EQ(net->entry_slot[EntryID(entry)].second, 0)
+          << "Cannot reorder an entry which shares the memory with others.";
+    }
+    return Reorder(net, slot, mem_desc);
+  }
+
+  size_t BindInput(Network* net, const JSONGraphNodeEntry& entry,
+                   const dnnl::memory::desc& mem_desc) {
+    return BindInput(net, entry, mem_desc, GetPlainDesc(*net, entry));
   }
 
-  void Conv2d(const size_t& nid, const bool has_relu = false, const bool has_bias = false) {
+  void Conv2d(Network* net, const size_t& nid, const bool has_relu = false,
+              const bool has_bias = false) {
     auto node = nodes_[nid];
 
     // Setup attributes.
     auto data_entry = node.GetInputs()[0];
     auto weight_entry = node.GetInputs()[1];
-    dnnl::memory::dims input_shape = nodes_[data_entry.id_].GetOpShape()[data_entry.index_];
-    dnnl::memory::dims weight_shape = nodes_[weight_entry.id_].GetOpShape()[weight_entry.index_];
+    dnnl::memory::dims input_shape = GetShape(*net, data_entry);
+    dnnl::memory::dims weight_shape = GetShape(*net, weight_entry);
     std::vector<std::string> str_strides = node.GetAttr<std::vector<std::string>>("strides");
     std::vector<std::string> str_padding = node.GetAttr<std::vector<std::string>>("padding");
     dnnl::memory::dim groups = std::stoi(node.GetAttr<std::vector<std::string>>("groups")[0]);
@@ -190,11 +503,11 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
     dnnl::memory::dims padding_dims_l = {PH_L, PW_L};
     dnnl::memory::dims padding_dims_r = {PH_R, PW_R};
 
-    // Memory descriptions.
+    // Memory descriptions. Let the primitive choose the layouts.
     auto conv_src_md = dnnl::memory::desc(src_dims, dt::f32, tag::any);
     auto conv_weights_md = dnnl::memory::desc(weights_dims, dt::f32, tag::any);
     auto conv_bias_md = dnnl::memory::desc(bias_dims, dt::f32, tag::any);
-    auto conv_dst_md = dnnl::memory::desc(dst_dims, dt::f32, tag::nchw);
+    auto conv_dst_md = dnnl::memory::desc(dst_dims, dt::f32, tag::any);
 
     // Covn2d description.
     auto conv_desc = dnnl::convolution_forward::desc(
@@ -211,48 +524,50 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
 
     auto conv2d_prim_desc = dnnl::convolution_forward::primitive_desc(conv_desc, attr, engine_);
 
-    // Push to the network.
-    auto conv = dnnl::convolution_forward(conv2d_prim_desc);
-    net_.push_back(conv);
-
     // Data memory.
     ICHECK_EQ(node.GetAttr<std::vector<std::string>>("data_layout")[0], "NCHW");
-    auto conv2d_src_memory = BindDNNLMemory(data_entry, {src_dims, dt::f32, tag::nchw});
+    auto conv2d_src_memory = BindInput(net, data_entry, conv2d_prim_desc.src_desc(),
+                                       {src_dims, dt::f32, tag::nchw});
 
     // Weight memory.
     ICHECK_EQ(node.GetAttr<std::vector<std::string>>("kernel_layout")[0], "OIHW");
-    auto conv2d_weights_memory = BindDNNLMemory(
-        weight_entry, {weights_dims, dt::f32, (groups > 1) ? tag::goihw : tag::oihw});
+    auto conv2d_weights_memory =
+        BindInput(net, weight_entry, conv2d_prim_desc.weights_desc(),
+                  {weights_dims, dt::f32, (groups > 1) ? tag::goihw : tag::oihw});
 
     // Bias memory.
-    auto conv2d_bias_memory = dnnl::memory({bias_dims, dt::f32, tag::x}, engine_);
+    size_t conv2d_bias_memory;
     if (has_bias) {
       auto bias_entry = node.GetInputs()[2];
-      BindDNNLMemory(bias_entry, conv2d_bias_memory);
+      conv2d_bias_memory = BindInput(net, bias_entry, conv2d_prim_desc.bias_desc(),
+                                     {bias_dims, dt::f32, tag::x});
     } else {
-      float bias[OC] = {0};
-      write_to_dnnl_memory(bias, conv2d_bias_memory, OC * sizeof(float));
+      conv2d_bias_memory = AddZeroMemorySlot(net, conv2d_prim_desc.bias_desc());
     }
 
+    // Push to the network.
+    auto conv = dnnl::convolution_forward(conv2d_prim_desc);
+    net->net.push_back(conv);
+
     // Output memory.
     JSONGraphNodeEntry out_entry(nid, 0);
-    auto conv2d_dst_memory = BindDNNLMemory(out_entry, conv2d_prim_desc.dst_desc());
+    auto conv2d_dst_memory = BindDNNLMemory(net, out_entry, conv2d_prim_desc.dst_desc());
 
     // Bind memory buffers.
-    net_args_.push_back({{DNNL_ARG_SRC, conv2d_src_memory},
-                         {DNNL_ARG_WEIGHTS, conv2d_weights_memory},
-                         {DNNL_ARG_BIAS, conv2d_bias_memory},
-                         {DNNL_ARG_DST, conv2d_dst_memory}});
+    net->net_arg_slots.push_back({{DNNL_ARG_SRC, conv2d_src_memory},
+                                  {DNNL_ARG_WEIGHTS, conv2d_weights_memory},
+                                  {DNNL_ARG_BIAS, conv2d_bias_memory},
+                                  {DNNL_ARG_DST, conv2d_dst_memory}});
   }
 
-  void Dense(const size_t& nid) {
+  void Dense(Network* net, const size_t& nid) {
     auto node = nodes_[nid];
 
     // Setup attributes.
     auto data_entry = node.GetInputs()[0];
     auto weight_entry = node.GetInputs()[1];
-    dnnl::memory::dims input_shape = nodes_[data_entry.id_].GetOpShape()[data_entry.index_];
-    dnnl::memory::dims weight_shape = nodes_[weight_entry.id_].GetOpShape()[weight_entry.index_];
+    dnnl::memory::dims input_shape = GetShape(*net, data_entry);
+    dnnl::memory::dims weight_shape = GetShape(*net, weight_entry);
 
     dnnl::memory::dim B = input_shape[0],  // batch size
         IC = input_shape[1],               // input channels
@@ -264,36 +579,37 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
     dnnl::memory::dims bias_dims = {OC};
     dnnl::memory::dims out_dims = {B, OC};
 
-    // Memory descriptions.
-    auto data_md = dnnl::memory::desc({data_dims, dt::f32, tag::nc});
-    auto weight_md = dnnl::memory::desc({weight_dims, dt::f32, tag::nc});
-    auto bias_md = dnnl::memory::desc({bias_dims, dt::f32, tag::x});
-    auto dst_md = dnnl::memory::desc({out_dims, dt::f32, tag::nc});
+    // Memory descriptions. Let the primitive choose the layouts.
+    auto data_md = dnnl::memory::desc({data_dims, dt::f32, tag::any});
+    auto weight_md = dnnl::memory::desc({weight_dims, dt::f32, tag::any});
+    auto bias_md = dnnl::memory::desc({bias_dims, dt::f32, tag::any});
+    auto dst_md = dnnl::memory::desc({out_dims, dt::f32, tag::any});
 
     // Dense description.
     auto dense_desc = dnnl::inner_product_forward::desc(dnnl::prop_kind::forward_inference, data_md,
                                                         weight_md, bias_md, dst_md);
     auto dense_prim_desc = dnnl::inner_product_forward::primitive_desc(dense_desc, engine_);
 
+    // Memories.
+    auto data_memory = BindInput(net, data_entry, dense_prim_desc.src_desc(),
+                                 {data_dims, dt::f32, tag::nc});
+    auto weight_memory = BindInput(net, weight_entry, dense_prim_desc.weights_desc(),
+                                   {weight_dims, dt::f32, tag::nc});
+    auto bias_memory = AddZeroMemorySlot(net, dense_prim_desc.bias_desc());
+
     auto dense = dnnl::inner_product_forward(dense_prim_desc);
-    net_.push_back(dense);
+    net->net.push_back(dense);
 
-    // Memories.
-    auto data_memory = BindDNNLMemory(data_entry, data_md);
-    auto weight_memory = BindDNNLMemory(weight_entry, weight_md);
-    auto bias_memory = dnnl::memory(bias_md, engine_);
-    float bias[OC] = {0};
-    write_to_dnnl_memory(bias, bias_memory, OC * sizeof(float));
     JSONGraphNodeEntry out_entry(nid, 0);
-    auto dst_memory = BindDNNLMemory(out_entry, dense_prim_desc.dst_desc());
+    auto dst_memory = BindDNNLMemory(net, out_entry, dense_prim_desc.dst_desc());
 
-    net_args_.push_back({{DNNL_ARG_SRC, data_memory},
-                         {DNNL_ARG_WEIGHTS, weight_memory},
-                         {DNNL_ARG_BIAS, bias_memory},
-                         {DNNL_ARG_DST, dst_memory}});
+    net->net_arg_slots.push_back({{DNNL_ARG_SRC, data_memory},
+                                  {DNNL_ARG_WEIGHTS, weight_memory},
+                                  {DNNL_ARG_BIAS, bias_memory},
+                                  {DNNL_ARG_DST, dst_memory}});
   }
 
-  void BatchNorm(const size_t& nid) {
+  void BatchNorm(Network* net, const size_t& nid) {
     auto node = nodes_[nid];
 
     auto data_entry = node.GetInputs()[0];
@@ -301,92 +617,94 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
     auto beta_entry = node.GetInputs()[2];
     auto mean_entry = node.GetInputs()[3];
     auto variance_entry = node.GetInputs()[4];
-    dnnl::memory::dims data_shape = nodes_[data_entry.id_].GetOpShape()[data_entry.index_];
+    dnnl::memory::dims data_shape = GetShape(*net, data_entry);
     dnnl::memory::dim IC = data_shape[1];
     float epsilon = std::stof(node.GetAttr<std::vector<std::string>>("epsilon")[0]);
 
-    // Memory description.
-    dnnl::memory::desc data_md = GenDNNLMemDescByShape(data_shape, dt::f32);
+    // Memory description. Keep the layout chosen by the producer of the data.
+    dnnl::memory::desc data_md = GetEntryDesc(*net, data_entry);
 
     // BN description.
     auto bn_desc = dnnl::batch_normalization_forward::desc(
         dnnl::prop_kind::forward_inference, data_md, epsilon,
         dnnl::normalization_flags::use_global_stats | dnnl::normalization_flags::use_scale_shift);
     auto bn_prim_desc = dnnl::batch_normalization_forward::primitive_desc(bn_desc, engine_);
-    auto bn = dnnl::batch_normalization_forward(bn_prim_desc);
-    net_.push_back(bn);
 
     // Memories.
-    auto data_memory = BindDNNLMemory(data_entry, data_md);
-    JSONGraphNodeEntry out_entry(nid, 0);
-    auto out_memory = BindDNNLMemory(out_entry, data_md);
-    auto mean_memory = BindDNNLMemory(mean_entry, bn_prim_desc.mean_desc());
-    auto variance_memory = BindDNNLMemory(variance_entry, bn_prim_desc.variance_desc());
+    auto data_memory = BindInput(net, data_entry, data_md);
+    auto mean_memory = BindInput(net, mean_entry, bn_prim_desc.mean_desc());
+    auto variance_memory = BindInput(net, variance_entry, bn_prim_desc.variance_desc());
 
     // In DNNL, weight is composed of gamma+beta, so we point them to the same DNNL memory but
     // assign an offset to beta data for runtime serialization.
-    auto weight_memory = BindDNNLMemory(gamma_entry, bn_prim_desc.weights_desc(), 0);
-    BindDNNLMemory(beta_entry, weight_memory, IC);
-
-    net_args_.push_back({{DNNL_ARG_SRC, data_memory},
-                         {DNNL_ARG_DST, out_memory},
-                         {DNNL_ARG_SCALE_SHIFT, weight_memory},
-                         {DNNL_ARG_MEAN, mean_memory},
-                         {DNNL_ARG_VARIANCE, variance_memory}});
+    auto weight_memory = BindDNNLMemory(net, gamma_entry, bn_prim_desc.weights_desc(), 0);
+    BindDNNLMemory(net, beta_entry, weight_memory, IC);
+
+    auto bn = dnnl::batch_normalization_forward(bn_prim_desc);
+    net->net.push_back(bn);
+
+    JSONGraphNodeEntry out_entry(nid, 0);
+    auto out_memory = BindDNNLMemory(net, out_entry, bn_prim_desc.dst_desc());
+
+    net->net_arg_slots.push_back({{DNNL_ARG_SRC, data_memory},
+                                  {DNNL_ARG_DST, out_memory},
+                                  {DNNL_ARG_SCALE_SHIFT, weight_memory},
+                                  {DNNL_ARG_MEAN, mean_memory},
+                                  {DNNL_ARG_VARIANCE, variance_memory}});
   }
 
-  void Relu(const size_t& nid) {
+  void Relu(Network* net, const size_t& nid) {
     auto node = nodes_[nid];
 
     auto data_entry = node.GetInputs()[0];
-    dnnl::memory::dims shape = nodes_[data_entry.id_].GetOpShape()[data_entry.index_];
-    dnnl::memory::desc data_md = GenDNNLMemDescByShape(shape, dt::f32);
+    dnnl::memory::desc data_md = GetEntryDesc(*net, data_entry);
 
     auto relu_desc = dnnl::eltwise_forward::desc(dnnl::prop_kind::forward_inference,
                                                  dnnl::algorithm::eltwise_relu, data_md, 0);
     auto relu_prim_desc = dnnl::eltwise_forward::primitive_desc(relu_desc, engine_);
     ICHECK(data_md == relu_prim_desc.dst_desc());
 
+    auto data_memory = BindInput(net, data_entry, data_md);
+
     auto relu = dnnl::eltwise_forward(relu_prim_desc);
-    net_.push_back(relu);
+    net->net.push_back(relu);
 
-    auto data_memory = BindDNNLMemory(data_entry, data_md);
     JSONGraphNodeEntry out_entry(nid, 0);
-    auto out_memory = BindDNNLMemory(out_entry, data_md);
+    auto out_memory = BindDNNLMemory(net, out_entry, data_md);
 
-    net_args_.push_back({{DNNL_ARG_SRC, data_memory}, {DNNL_ARG_DST, out_memory}});
+    net->net_arg_slots.push_back({{DNNL_ARG_SRC, data_memory}, {DNNL_ARG_DST, out_memory}});
   }
 
-  void Binary(const size_t& nid, dnnl::algorithm algo) {
+  void Binary(Network* net, const size_t& nid, dnnl::algorithm algo) {
     auto node = nodes_[nid];
 
     // Memory and compute description.
     std::vector<dnnl::memory::dims> data_dims;
-    std::vector<dnnl::memory::desc> data_mds;
-    std::vector<dnnl::memory> data_memories;
+    std::vector<size_t> data_memories;
 
     ICHECK_EQ(node.GetInputs().size(), 2U);
     for (auto entry : node.GetInputs()) {
-      auto data_shape = nodes_[entry.id_].GetOpShape()[entry.index_];
-      dnnl::memory::desc data_md = GenDNNLMemDescByShape(data_shape, dt::f32);
-
-      data_dims.push_back(data_shape);
-      data_mds.push_back(data_md);
-      data_memories.push_back(BindDNNLMemory(entry, data_md));
+      data_dims.push_back(GetShape(*net, entry));
     }
     ICHECK(data_dims[0] == data_dims[1]);
-    auto out_md = data_mds[0];
-    JSONGraphNodeEntry out_entry(nid, 0);
-    auto out_memory = BindDNNLMemory(out_entry, out_md);
 
-    auto binary_desc = dnnl::binary::desc(algo, data_mds[0], data_mds[1], out_md);
+    // Compute in the layout of the first operand and bring the second one to the same layout.
+    auto out_md = GetEntryDesc(*net, node.GetInputs()[0]);
+    for (auto entry : node.GetInputs()) {
+      data_memories.push_back(BindInput(net, entry, out_md));
+    }
+
+    auto binary_desc = dnnl::binary::desc(algo, out_md, out_md, out_md);
     auto binary_prim_desc = dnnl::binary::primitive_desc(binary_desc, engine_);
     auto binary = dnnl::binary(binary_prim_desc);
-    net_.push_back(binary);
+    net->net.push_back(binary);
+
+    JSONGraphNodeEntry out_entry(nid, 0);
+    auto out_memory = BindDNNLMemory(net, out_entry, out_md);
 
-    net_args_.push_back({{DNNL_ARG_SRC_0, data_memories[0]},
-                         {DNNL_ARG_SRC_1, data_memories[1]},
-                         {DNNL_ARG_DST, out_memory}});
+    net->net_arg_slots.push_back({{DNNL_ARG_SRC_0, data_memories[0]},
+                                  {DNNL_ARG_SRC_1, data_memories[1]},
+                                  {DNNL_ARG_DST, out_memory}});
   }
 
   // Read from DNNL memory (+offset) and write to the handle.
@@ -429,14 +747,17 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
 
   /* The dnnl engine. */
   dnnl::engine engine_;
-  /* The dnnl stream. */
-  dnnl::stream stream_;
-  /* The network layers that are represented in dnnl primitives. */
-  std::vector<dnnl::primitive> net_;
-  /* The memory that is consumed by arguments. */
-  std::vector<std::unordered_map<int, dnnl::memory>> net_args_;
-  /* The entry ID to its corresponding output memory. */
-  std::unordered_map<uint32_t, std::pair<dnnl::memory, size_t>> entry_out_mem_;
+  /* The batch size of the graph inputs. */
+  dnnl::memory::dim graph_batch_{1};
+  /* Whether the leading dimension of each entry is the batch axis. */
+  std::vector<bool> batch_entry_;
+  /* The networks built for each set of input shapes, most recently used first. */
+  std::list<std::pair<ShapeKey, std::shared_ptr<Network>>> networks_;
+  /* The index of networks_ by input shapes. */
+  std::map<ShapeKey, std::list<std::pair<ShapeKey, std::shared_ptr<Network>>>::iterator>
+      network_index_;
+  /* Protects networks_ and network_index_. */
+  std::mutex network_mutex_;
 };
 
 runtime::Module DNNLJSONRuntimeCreate(String symbol_name, String graph_json,
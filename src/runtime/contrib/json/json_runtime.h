@@ -29,6 +29,7 @@
 #include <tvm/runtime/ndarray.h>
 
 #include <cstddef>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <type_traits>
@@ -62,6 +63,24 @@ class JSONRuntimeBase : public ModuleNode {
   /*! \brief Invoke the execution engine to inteprete a specific json runtime. */
   virtual void Run() = 0;
 
+  /*!
+   * \brief Execute the subgraph for one call with the given input and output tensors.
+   *
+   * The default implementation binds the tensors to the shared data_entry_ and calls Run(),
+   * so calls to the same module are serialized. Runtimes which keep the state of a call out of
+   * the module, e.g. by binding the tensors with BindInputOutputBuffers to a local copy of
+   * data_entry_, can override this to let concurrent calls share constants and engine state.
+   *
+   * \param args The packed args, inputs followed by outputs.
+   */
+  virtual void Invoke(const TVMArgs& args) {
+    std::lock_guard<std::mutex> lock(run_mutex_);
+    // Bind argument tensors to data entries.
+    this->SetInputOutputBuffers(args);
+    // Execute the subgraph.
+    this->Run();
+  }
+
   /*!
    * \brief Get a packed function.
    * \param name The name/symbol of the function.
@@ -78,11 +97,7 @@ class JSONRuntimeBase : public ModuleNode {
     } else if (this->symbol_name_ == name) {
       return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
         ICHECK(this->initialized_) << "The module has not been initialized";
-
-        // Bind argument tensors to data entries.
-        this->SetInputOutputBuffers(args);
-        // Execute the subgraph.
-        this->Run();
+        this->Invoke(args);
       });
     } else if ("__init_" + this->symbol_name_ == name) {
       // The function to initialize constant tensors.
@@ -144,7 +159,16 @@ class JSONRuntimeBase : public ModuleNode {
    *
    * \param args The packed args.
    */
-  void SetInputOutputBuffers(const TVMArgs& args) {
+  void SetInputOutputBuffers(const TVMArgs& args) { BindInputOutputBuffers(args, &data_entry_); }
+
+  /*!
+   * \brief Bind the DLTensor pointers of the input and output buffers to the corresponding
+   * entries of the given data entry table.
+   *
+   * \param args The packed args.
+   * \param data_entry The data entry table to update, usually data_entry_ or a per call copy.
+   */
+  void BindInputOutputBuffers(const TVMArgs& args, std::vector<const DLTensor*>* data_entry) const {
     ICHECK_EQ(args.size(), input_var_eid_.size() + outputs_.size())
         << "Found mismatch in the number of provided data entryies and required.";
 
@@ -164,7 +188,7 @@ class JSONRuntimeBase : public ModuleNode {
 
       // Assign input/output the NDArray pointers to data entry so that we can directly
       // read/write host buffers.
-      data_entry_[eid] = arg;
+      (*data_entry)[eid] = arg;
     }
   }
 
@@ -269,6 +293,8 @@ class JSONRuntimeBase : public ModuleNode {
   std::vector<uint32_t> const_idx_;
   /*! \brief Indicate if the engine has been initialized. */
   bool initialized_{false};
+  /*! \brief Serializes calls which bind their buffers to the shared data_entry_. */
+  std::mutex run_mutex_;
 };
 
 }  // namespace json
@@ -19,23 +19,30 @@
 
 /*!
  * \file random/mt_random_engine.cc
- * \brief mt19937 random engine
+ * \brief Random engine backed by the Philox4x32 counter-based generator.
  */
+#include <tvm/runtime/c_backend_api.h>
 #include <tvm/runtime/device_api.h>
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/ndarray.h>
 
 #include <algorithm>
+#include <cmath>
 #include <ctime>
-#include <random>
+#include <vector>
 
 #include "../3rdparty/compiler-rt/builtin_fp16.h"
+#include "philox.h"
 
 namespace tvm {
 namespace contrib {
 
 /*!
  * \brief An interface for generating [tensors of] random numbers.
+ *
+ *  Element i of a tensor fill is derived from the seed and the position of i in
+ *  the engine's stream only, so tensors are filled in parallel on the runtime
+ *  thread pool and the result does not depend on the number of threads.
  */
 class RandomEngine {
  public:
@@ -50,11 +57,12 @@ class RandomEngine {
   explicit RandomEngine(unsigned seed) { this->Seed(seed); }
 
   /*!
-   * \brief Seeds the underlying RNG, if possible.
+   * \brief Seeds the underlying RNG and restarts its stream.
    */
   inline void Seed(unsigned seed) {
-    rnd_engine_.seed(seed);
     this->rseed_ = static_cast<unsigned>(seed);
+    offset_ = 0;
+    num_cached_ = 0;
   }
 
   /*!
@@ -65,7 +73,14 @@ class RandomEngine {
   /*!
    * \return a random integer sampled from the RNG.
    */
-  inline unsigned GetRandInt() { return rnd_engine_(); }
+  inline unsigned GetRandInt() {
+    if (num_cached_ == 0) {
+      Philox4x32 philox(rseed_);
+      philox(offset_++, 0, cached_);
+      num_cached_ = Philox4x32::kBlockSize;
+    }
+    return cached_[--num_cached_];
+  }
 
   /*!
    * \brief Fills a tensor with values drawn from Unif(low, high)
@@ -83,9 +98,12 @@ class RandomEngine {
     ICHECK(dtype.code == kDLFloat && dtype.bits == 32 && dtype.lanes == 1);
 
     if (data->device.device_type == kDLCPU) {
-      std::uniform_real_distribution<float> uniform_dist(low, high);
-      std::generate_n(static_cast<float*>(data->data), size,
-                      [&]() { return uniform_dist(rnd_engine_); });
+      const float scale = high - low;
+      Fill(static_cast<float*>(data->data), size, [=](const uint32_t* bits, float* out, int n) {
+        for (int i = 0; i < n; ++i) {
+          out[i] = low + scale * ToUniform(bits[i]);
+        }
+      });
     } else {
       LOG(FATAL) << "Do not support random.uniform on this device yet";
     }
@@ -107,9 +125,18 @@ class RandomEngine {
     ICHECK(dtype.code == kDLFloat && dtype.bits == 32 && dtype.lanes == 1);
 
     if (data->device.device_type == kDLCPU) {
-      std::normal_distribution<float> normal_dist(loc, scale);
-      std::generate_n(static_cast<float*>(data->data), size,
-                      [&]() { return normal_dist(rnd_engine_); });
+      // Box-Muller transform, every pair of random words gives two samples.
+      Fill(static_cast<float*>(data->data), size, [=](const uint32_t* bits, float* out, int n) {
+        for (int i = 0; i < n; i += 2) {
+          // Shift u0 into (0, 1] so that the log is finite.
+          float u0 = 1.0f - ToUniform(bits[i]);
+          float u1 = ToUniform(bits[i + 1]);
+          float radius = scale * std::sqrt(-2.0f * std::log(u0));
+          float theta = 6.2831853071795864f * u1;
+          out[i] = loc + radius * std::cos(theta);
+          out[i + 1] = loc + radius * std::sin(theta);
+        }
+      });
     } else {
       LOG(FATAL) << "Do not support random.normal on this device yet";
     }
@@ -133,32 +160,110 @@ class RandomEngine {
   }
 
  private:
+  /*! \brief Number of values produced by one batch of Philox blocks. */
+  static constexpr int kBatchSize = 64;
+  /*! \brief Tensors smaller than this are filled on the calling thread. */
+  static constexpr int64_t kParallelMinSize = 1 << 16;
+
+  /*! \brief Map random bits to a float in [0, 1). */
+  static inline float ToUniform(uint32_t bits) {
+    return static_cast<float>(bits >> 8) * (1.0f / 16777216.0f);
+  }
+
+  /*! \brief Map random bits to a double in [low, high). */
+  static inline double ToUniform(uint32_t bits, double low, double high) {
+    return low + (high - low) * (static_cast<double>(bits) * (1.0 / 4294967296.0));
+  }
+
+  template <typename T, typename FTransform>
+  struct FillClosure {
+    T* data;
+    int64_t size;
+    int64_t num_batches;
+    uint64_t offset;
+    unsigned seed;
+    const FTransform* transform;
+  };
+
+  template <typename T, typename FTransform>
+  static int FillTask(int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+    auto* closure = static_cast<FillClosure<T, FTransform>*>(cdata);
+    int64_t chunk = (closure->num_batches + penv->num_task - 1) / penv->num_task;
+    int64_t begin = std::min(task_id * chunk, closure->num_batches);
+    int64_t end = std::min(begin + chunk, closure->num_batches);
+    FillBatches(*closure, begin, end);
+    return 0;
+  }
+
+  template <typename T, typename FTransform>
+  static void FillBatches(const FillClosure<T, FTransform>& closure, int64_t begin, int64_t end) {
+    constexpr int kBlocksPerBatch = kBatchSize / Philox4x32::kBlockSize;
+    Philox4x32 philox(closure.seed);
+    uint32_t bits[kBatchSize];
+    T values[kBatchSize];
+    for (int64_t batch = begin; batch < end; ++batch) {
+      uint64_t counter = closure.offset + static_cast<uint64_t>(batch) * kBlocksPerBatch;
+      for (int b = 0; b < kBlocksPerBatch; ++b) {
+        philox(counter + b, 0, bits + b * Philox4x32::kBlockSize);
+      }
+      int64_t start = batch * kBatchSize;
+      int n = static_cast<int>(std::min<int64_t>(kBatchSize, closure.size - start));
+      (*closure.transform)(bits, values, kBatchSize);
+      std::copy(values, values + n, closure.data + start);
+    }
+  }
+
+  /*!
+   * \brief Fill size elements of data with transform(bits, values, n), which maps
+   *  n random words to n values, and advance the stream past the words consumed.
+   */
+  template <typename T, typename FTransform>
+  void Fill(T* data, int64_t size, FTransform transform) {
+    constexpr int kBlocksPerBatch = kBatchSize / Philox4x32::kBlockSize;
+    int64_t num_batches = (size + kBatchSize - 1) / kBatchSize;
+    FillClosure<T, FTransform> closure{data, size, num_batches, offset_, rseed_, &transform};
+    offset_ += static_cast<uint64_t>(num_batches) * kBlocksPerBatch;
+    if (size < kParallelMinSize) {
+      FillBatches(closure, 0, num_batches);
+    } else {
+      int res = TVMBackendParallelLaunch(FillTask<T, FTransform>, &closure, 0);
+      ICHECK_EQ(res, 0) << "Parallel random fill failed";
+    }
+  }
+
+  template <typename T>
+  void FillUniform(T* data, int64_t size, double low, double high) {
+    Fill(data, size, [=](const uint32_t* bits, T* out, int n) {
+      for (int i = 0; i < n; ++i) {
+        out[i] = static_cast<T>(ToUniform(bits[i], low, high));
+      }
+    });
+  }
+
   void FillData(DLTensor* tensor, int64_t size) {
     // Make the value be 1.0 - 10.0, not (0.0 - 1.0) so that we could satisfy
     // quantized dtype (uint8 / int8) data non-empty requirement
-    std::uniform_real_distribution<> dist(1.0, 10.0);
     // Use float representation could make us work well on float / int type too.
     if (tensor->dtype.bits == 1) {
-      std::generate_n(static_cast<bool*>(tensor->data), size, [&]() { return dist(rnd_engine_); });
+      FillUniform(static_cast<bool*>(tensor->data), size, 1.0, 10.0);
     } else if (tensor->dtype.bits == 4) {
       // For uint4/int4 we pack two values into a single byte.
       // Thus, to ensure both values are non-zero, we use a distribution of 17 - 30.
-      std::uniform_real_distribution<> packed_dist(17.0, 30.0);
-      std::generate_n(reinterpret_cast<uint8_t*>(tensor->data), size,
-                      [&]() { return packed_dist(rnd_engine_); });
+      FillUniform(reinterpret_cast<uint8_t*>(tensor->data), size, 17.0, 30.0);
     } else if (tensor->dtype.bits == 8) {
-      std::generate_n(static_cast<uint8_t*>(tensor->data), size,
-                      [&]() { return dist(rnd_engine_); });
+      FillUniform(static_cast<uint8_t*>(tensor->data), size, 1.0, 10.0);
     } else if (tensor->dtype.bits == 16) {
-      std::generate_n(static_cast<uint16_t*>(tensor->data), size, [&]() {
-        return __truncXfYf2__<float, uint32_t, 23, uint16_t, uint16_t, 10>(
-            static_cast<float>(dist(rnd_engine_)));
-      });
+      Fill(static_cast<uint16_t*>(tensor->data), size,
+           [](const uint32_t* bits, uint16_t* out, int n) {
+             for (int i = 0; i < n; ++i) {
+               out[i] = __truncXfYf2__<float, uint32_t, 23, uint16_t, uint16_t, 10>(
+                   static_cast<float>(ToUniform(bits[i], 1.0, 10.0)));
+             }
+           });
     } else if (tensor->dtype.bits == 32) {
-      std::generate_n(static_cast<float*>(tensor->data), size, [&]() { return dist(rnd_engine_); });
+      FillUniform(static_cast<float*>(tensor->data), size, 1.0, 10.0);
     } else if (tensor->dtype.bits == 64) {
-      std::generate_n(static_cast<double*>(tensor->data), size,
-                      [&]() { return dist(rnd_engine_); });
+      FillUniform(static_cast<double*>(tensor->data), size, 1.0, 10.0);
     } else {
       LOG(FATAL) << "Doesn't support dtype code " << tensor->dtype.code << " dtype bits "
                  << tensor->dtype.bits;
@@ -166,8 +271,12 @@ class RandomEngine {
   }
 
  private:
-  std::mt19937 rnd_engine_;
   unsigned rseed_;
+  /*! \brief Index of the next unused Philox block in the stream. */
+  uint64_t offset_{0};
+  /*! \brief Words left over from the last block used by GetRandInt. */
+  uint32_t cached_[Philox4x32::kBlockSize];
+  int num_cached_{0};
 };
 
 }  // namespace contrib
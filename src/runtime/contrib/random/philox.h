@@ -0,0 +1,88 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file random/philox.h
+ * \brief Philox4x32-10 counter-based random number generator.
+ *
+ *  See Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3", SC'11.
+ *  Each output block is a pure function of the key and the block counter, so
+ *  any slice of a random stream can be generated independently, in any order
+ *  and on any thread, with results identical to sequential generation.
+ */
+#ifndef TVM_RUNTIME_CONTRIB_RANDOM_PHILOX_H_
+#define TVM_RUNTIME_CONTRIB_RANDOM_PHILOX_H_
+
+#include <cstdint>
+
+namespace tvm {
+namespace contrib {
+
+class Philox4x32 {
+ public:
+  /*! \brief Number of 32-bit words produced per counter value. */
+  static constexpr int kBlockSize = 4;
+
+  explicit Philox4x32(uint64_t key)
+      : key_{static_cast<uint32_t>(key), static_cast<uint32_t>(key >> 32)} {}
+
+  /*!
+   * \brief Generate the block of random words for a counter value.
+   * \param counter_lo The low 64 bits of the 128-bit counter.
+   * \param counter_hi The high 64 bits of the 128-bit counter.
+   * \param out The kBlockSize generated words.
+   */
+  void operator()(uint64_t counter_lo, uint64_t counter_hi, uint32_t out[kBlockSize]) const {
+    uint32_t c0 = static_cast<uint32_t>(counter_lo);
+    uint32_t c1 = static_cast<uint32_t>(counter_lo >> 32);
+    uint32_t c2 = static_cast<uint32_t>(counter_hi);
+    uint32_t c3 = static_cast<uint32_t>(counter_hi >> 32);
+    uint32_t k0 = key_[0];
+    uint32_t k1 = key_[1];
+    for (int round = 0; round < kRounds; ++round) {
+      uint64_t p0 = static_cast<uint64_t>(kMultiplier0) * c0;
+      uint64_t p1 = static_cast<uint64_t>(kMultiplier1) * c2;
+      uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+      uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+      c1 = static_cast<uint32_t>(p1);
+      c3 = static_cast<uint32_t>(p0);
+      c0 = n0;
+      c2 = n2;
+      k0 += kWeyl0;
+      k1 += kWeyl1;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+  }
+
+ private:
+  static constexpr int kRounds = 10;
+  static constexpr uint32_t kMultiplier0 = 0xD2511F53U;
+  static constexpr uint32_t kMultiplier1 = 0xCD9E8D57U;
+  static constexpr uint32_t kWeyl0 = 0x9E3779B9U;
+  static constexpr uint32_t kWeyl1 = 0xBB67AE85U;
+
+  uint32_t key_[2];
+};
+
+}  // namespace contrib
+}  // namespace tvm
+#endif  // TVM_RUNTIME_CONTRIB_RANDOM_PHILOX_H_
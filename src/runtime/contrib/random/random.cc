@@ -26,6 +26,7 @@
 #include <tvm/runtime/registry.h>
 
 #include <algorithm>
+#include <limits>
 
 #include "mt_random_engine.cc"
 
@@ -68,6 +69,12 @@ RandomThreadLocalEntry* RandomThreadLocalEntry::ThreadLocal() {
   return RandomThreadLocalStore::Get();
 }
 
+TVM_REGISTER_GLOBAL("tvm.contrib.random.seed").set_body([](TVMArgs args, TVMRetValue* ret) {
+  RandomThreadLocalEntry* entry = RandomThreadLocalEntry::ThreadLocal();
+  int seed = args[0];
+  entry->random_engine.Seed(seed);
+});
+
 TVM_REGISTER_GLOBAL("tvm.contrib.random.randint").set_body([](TVMArgs args, TVMRetValue* ret) {
   RandomThreadLocalEntry* entry = RandomThreadLocalEntry::ThreadLocal();
   int64_t low = args[0];
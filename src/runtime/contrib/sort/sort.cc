@@ -22,9 +22,13 @@
  */
 
 #include <dlpack/dlpack.h>
+#include <tvm/runtime/c_backend_api.h>
 #include <tvm/runtime/registry.h>
 
 #include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
 #include <vector>
 
 #include "../../../../3rdparty/compiler-rt/builtin_fp16.h"
@@ -62,6 +66,251 @@ bool CompareDescend(const std::pair<int64_t, float16>& lhs,
   return lhs.second.to_float() > rhs.second.to_float();
 }
 
+template <typename DType>
+bool CompareAscendStable(const std::pair<int64_t, DType>& lhs,
+                         const std::pair<int64_t, DType>& rhs) {
+  if (CompareAscend(lhs, rhs)) return true;
+  if (CompareAscend(rhs, lhs)) return false;
+  return lhs.first < rhs.first;
+}
+
+template <typename DType>
+bool CompareDescendStable(const std::pair<int64_t, DType>& lhs,
+                          const std::pair<int64_t, DType>& rhs) {
+  if (CompareDescend(lhs, rhs)) return true;
+  if (CompareDescend(rhs, lhs)) return false;
+  return lhs.first < rhs.first;
+}
+
+/*! \brief Rows at least this long are radix sorted when the key type allows it. */
+constexpr int64_t kRadixSortMinLength = 256;
+/*! \brief Use partial sort for topk when k * kPartialSortRatio < row length. */
+constexpr int64_t kPartialSortRatio = 8;
+/*! \brief Minimum number of elements to sort before work is split across threads. */
+constexpr int64_t kParallelMinElements = 16384;
+
+/*!
+ * \brief Maps 32-bit keys to unsigned integers with the same ordering,
+ *  which lets rows of these types be sorted with an LSD radix sort.
+ */
+template <typename DType>
+struct RadixKey {
+  static constexpr bool enabled = false;
+  static uint32_t Encode(DType value) { return 0; }
+};
+
+template <>
+struct RadixKey<int32_t> {
+  static constexpr bool enabled = true;
+  static uint32_t Encode(int32_t value) { return static_cast<uint32_t>(value) ^ 0x80000000U; }
+};
+
+template <>
+struct RadixKey<float> {
+  static constexpr bool enabled = true;
+  static uint32_t Encode(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    // -0.0 and 0.0 compare equal, keep them in input order like the comparison sort.
+    if (bits == 0x80000000U) bits = 0;
+    return (bits & 0x80000000U) ? ~bits : (bits | 0x80000000U);
+  }
+};
+
+/*!
+ * \brief Sorts strided rows of a tensor.
+ *
+ *  One RowSorter is created per parallel task and reused for every row the
+ *  task handles, so no heap allocation happens per row. The result is always
+ *  identical to std::stable_sort on (index, value) pairs.
+ */
+template <typename DataType>
+class RowSorter {
+ public:
+  using Entry = std::pair<int64_t, DataType>;
+
+  explicit RowSorter(int64_t max_len) {
+    entries_.reserve(max_len);
+    if (UseRadix(max_len)) {
+      keys_.resize(2 * max_len);
+      index_.resize(2 * max_len);
+    }
+  }
+
+  /*!
+   * \brief Sort the first num elements of a row.
+   * \param data Pointer to the first element of the row.
+   * \param stride Distance between two consecutive elements of the row.
+   * \param num Number of elements to sort.
+   * \param k Only the first k entries of the result are required to be sorted.
+   * \param is_ascend Whether to sort in ascending order.
+   * \return The sorted (index, value) entries.
+   */
+  const std::vector<Entry>& Sort(const DataType* data, int64_t stride, int64_t num, int64_t k,
+                                 bool is_ascend) {
+    entries_.clear();
+    if (k * kPartialSortRatio < num) {
+      Gather(data, stride, num);
+      if (is_ascend) {
+        std::partial_sort(entries_.begin(), entries_.begin() + k, entries_.end(),
+                          CompareAscendStable<DataType>);
+      } else {
+        std::partial_sort(entries_.begin(), entries_.begin() + k, entries_.end(),
+                          CompareDescendStable<DataType>);
+      }
+    } else if (UseRadix(num)) {
+      RadixSort(data, stride, num, is_ascend);
+    } else {
+      Gather(data, stride, num);
+      if (is_ascend) {
+        std::stable_sort(entries_.begin(), entries_.end(), CompareAscend<DataType>);
+      } else {
+        std::stable_sort(entries_.begin(), entries_.end(), CompareDescend<DataType>);
+      }
+    }
+    return entries_;
+  }
+
+ private:
+  static bool UseRadix(int64_t num) {
+    return RadixKey<DataType>::enabled && num >= kRadixSortMinLength &&
+           num <= static_cast<int64_t>(std::numeric_limits<uint32_t>::max());
+  }
+
+  void Gather(const DataType* data, int64_t stride, int64_t num) {
+    for (int64_t k = 0; k < num; ++k) {
+      entries_.emplace_back(k, data[k * stride]);
+    }
+  }
+
+  // Stable LSD radix sort with 8-bit digits, skipping digits shared by all keys.
+  void RadixSort(const DataType* data, int64_t stride, int64_t num, bool is_ascend) {
+    uint32_t* keys = keys_.data();
+    uint32_t* keys_swap = keys + num;
+    uint32_t* index = index_.data();
+    uint32_t* index_swap = index + num;
+    // Flipping all bits of the key turns the ascending sort into a stable descending one.
+    const uint32_t flip = is_ascend ? 0U : 0xFFFFFFFFU;
+    int64_t hist[4][256] = {};
+    for (int64_t i = 0; i < num; ++i) {
+      uint32_t key = RadixKey<DataType>::Encode(data[i * stride]) ^ flip;
+      keys[i] = key;
+      index[i] = static_cast<uint32_t>(i);
+      ++hist[0][key & 0xFF];
+      ++hist[1][(key >> 8) & 0xFF];
+      ++hist[2][(key >> 16) & 0xFF];
+      ++hist[3][key >> 24];
+    }
+    for (int pass = 0; pass < 4; ++pass) {
+      const int shift = pass * 8;
+      int64_t* count = hist[pass];
+      if (count[(keys[0] >> shift) & 0xFF] == num) continue;
+      int64_t offset = 0;
+      for (int d = 0; d < 256; ++d) {
+        int64_t c = count[d];
+        count[d] = offset;
+        offset += c;
+      }
+      for (int64_t i = 0; i < num; ++i) {
+        int64_t pos = count[(keys[i] >> shift) & 0xFF]++;
+        keys_swap[pos] = keys[i];
+        index_swap[pos] = index[i];
+      }
+      std::swap(keys, keys_swap);
+      std::swap(index, index_swap);
+    }
+    for (int64_t i = 0; i < num; ++i) {
+      entries_.emplace_back(index[i], data[index[i] * stride]);
+    }
+  }
+
+  std::vector<Entry> entries_;
+  std::vector<uint32_t> keys_;
+  std::vector<uint32_t> index_;
+};
+
+/*! \brief Rows of a tensor along the sort axis. */
+struct SortRows {
+  SortRows(const DLTensor* input, int axis) : axis_len(input->shape[axis]) {
+    for (int i = 0; i < input->ndim; ++i) {
+      if (i < axis) {
+        axis_mul_before *= input->shape[i];
+      } else if (i > axis) {
+        axis_mul_after *= input->shape[i];
+      }
+    }
+  }
+
+  int64_t num_rows() const { return axis_mul_before * axis_mul_after; }
+
+  /*! \brief Flat index of the first element of a row, given the length of the sort axis. */
+  int64_t BaseIndex(int64_t row, int64_t len) const {
+    return (row / axis_mul_after) * len * axis_mul_after + row % axis_mul_after;
+  }
+
+  int64_t axis_mul_before{1};
+  int64_t axis_mul_after{1};
+  int64_t axis_len;
+};
+
+template <typename FRange>
+struct RowRangeClosure {
+  int64_t num_rows;
+  FRange* frange;
+};
+
+template <typename FRange>
+int RowRangeTask(int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+  auto* closure = static_cast<RowRangeClosure<FRange>*>(cdata);
+  int64_t chunk = (closure->num_rows + penv->num_task - 1) / penv->num_task;
+  int64_t begin = std::min(task_id * chunk, closure->num_rows);
+  int64_t end = std::min(begin + chunk, closure->num_rows);
+  if (begin < end) {
+    (*closure->frange)(begin, end);
+  }
+  return 0;
+}
+
+/*!
+ * \brief Call frange(begin, end) on disjoint ranges of rows using the runtime thread pool.
+ *  Small problems run on the calling thread.
+ */
+template <typename FRange>
+void ParallelForRows(int64_t num_rows, int64_t row_len, FRange frange) {
+  if (num_rows <= 1 || num_rows * row_len < kParallelMinElements) {
+    frange(0, num_rows);
+    return;
+  }
+  RowRangeClosure<FRange> closure{num_rows, &frange};
+  int res = TVMBackendParallelLaunch(RowRangeTask<FRange>, &closure, 0);
+  ICHECK_EQ(res, 0) << "Parallel sort failed";
+}
+
+template <typename DataType>
+void argsort_nms(DLTensor* input, DLTensor* sort_num, DLTensor* output, int32_t axis,
+                 bool is_ascend) {
+  auto data_ptr = static_cast<DataType*>(input->data);
+  auto sort_num_ptr = static_cast<int32_t*>(sort_num->data);
+  auto out_ptr = static_cast<int32_t*>(output->data);
+  SortRows rows(input, axis);
+  const int64_t len = rows.axis_len;
+  const int64_t stride = rows.axis_mul_after;
+
+  ParallelForRows(rows.num_rows(), len, [&](int64_t begin, int64_t end) {
+    RowSorter<DataType> sorter(len);
+    for (int64_t row = begin; row < end; ++row) {
+      int64_t base_idx = rows.BaseIndex(row, len);
+      int64_t current_sort_num = sort_num_ptr[row];
+      const auto& sorted = sorter.Sort(data_ptr + base_idx, stride, current_sort_num,
+                                       current_sort_num, is_ascend);
+      for (int64_t k = 0; k < len; ++k) {
+        out_ptr[base_idx + k * stride] =
+            static_cast<int32_t>(k < static_cast<int64_t>(sorted.size()) ? sorted[k].first : k);
+      }
+    }
+  });
+}
+
 // Argsort implemented C library sort for nms.
 // Return indices of sorted tensor.
 // By default, the last axis will be used to sort.
@@ -77,12 +326,6 @@ TVM_REGISTER_GLOBAL("tvm.contrib.sort.argsort_nms").set_body([](TVMArgs args, TV
   bool is_ascend = args[4];
 
   auto dtype = input->dtype;
-  auto data_ptr = static_cast<float*>(input->data);
-  auto sort_num_ptr = static_cast<int32_t*>(sort_num->data);
-  std::vector<std::pair<int32_t, float>> sorter;
-  int64_t axis_mul_before = 1;
-  int64_t axis_mul_after = 1;
-
   if (axis < 0) {
     axis = input->ndim + axis;
   }
@@ -98,88 +341,34 @@ TVM_REGISTER_GLOBAL("tvm.contrib.sort.argsort_nms").set_body([](TVMArgs args, TV
                                   "input ndim "
                                << input->ndim;
 
-  for (int i = 0; i < input->ndim; ++i) {
-    if (i < axis) {
-      axis_mul_before *= input->shape[i];
-    } else if (i > axis) {
-      axis_mul_after *= input->shape[i];
-    }
-  }
-
-  for (int64_t i = 0; i < axis_mul_before; ++i) {
-    for (int64_t j = 0; j < axis_mul_after; ++j) {
-      sorter.clear();
-      int32_t current_sort_num = *(sort_num_ptr + i * axis_mul_after + j);
-      int64_t base_idx = i * input->shape[axis] * axis_mul_after + j;
-      for (int64_t k = 0; k < current_sort_num; ++k) {
-        int64_t full_idx = base_idx + k * axis_mul_after;
-        sorter.emplace_back(std::make_pair(k, *(data_ptr + full_idx)));
-      }
-      if (is_ascend) {
 #if (__ARM_FEATURE_FP16_SCALAR_ARITHMETIC == 1)
-        if (dtype.bits == 16) {
-          std::stable_sort(sorter.begin(), sorter.end(), CompareAscend<__fp16>);
-        } else {
-#endif
-          std::stable_sort(sorter.begin(), sorter.end(), CompareAscend<float>);
-#if (__ARM_FEATURE_FP16_SCALAR_ARITHMETIC == 1)
-        }
-#endif
-      } else {
-#if (__ARM_FEATURE_FP16_SCALAR_ARITHMETIC == 1)
-        if (dtype.bits == 16) {
-          std::stable_sort(sorter.begin(), sorter.end(), CompareDescend<__fp16>);
-        } else {
-#endif
-          std::stable_sort(sorter.begin(), sorter.end(), CompareDescend<float>);
-#if (__ARM_FEATURE_FP16_SCALAR_ARITHMETIC == 1)
-        }
-#endif
-      }
-      for (int32_t k = 0; k < input->shape[axis]; ++k) {
-        *(static_cast<int32_t*>(output->data) + base_idx + k * axis_mul_after) =
-            k < static_cast<int32_t>(sorter.size()) ? sorter[k].first : k;
-      }
-    }
+  if (dtype.bits == 16) {
+    argsort_nms<__fp16>(input, sort_num, output, axis, is_ascend);
+    return;
   }
+#endif
+  argsort_nms<float>(input, sort_num, output, axis, is_ascend);
 });
 
-template <typename DataType, typename OutType>
-void sort_impl(
-    DLTensor* input, DLTensor* output, int32_t axis, bool is_ascend,
-    std::function<void(OutType*, size_t, const std::pair<int64_t, DataType>&)> epilogue) {
+template <typename DataType, typename OutType, typename FEpilogue>
+void sort_impl(DLTensor* input, DLTensor* output, int32_t axis, bool is_ascend,
+               FEpilogue epilogue) {
   auto data_ptr = static_cast<DataType*>(input->data);
   auto out_ptr = static_cast<OutType*>(output->data);
-  std::vector<std::pair<int64_t, DataType>> sorter;
-
-  int axis_mul_before = 1;
-  int axis_mul_after = 1;
-  for (int i = 0; i < input->ndim; ++i) {
-    if (i < axis) {
-      axis_mul_before *= input->shape[i];
-    } else if (i > axis) {
-      axis_mul_after *= input->shape[i];
-    }
-  }
-
-  for (int i = 0; i < axis_mul_before; ++i) {
-    for (int j = 0; j < axis_mul_after; ++j) {
-      sorter.clear();
-      int64_t base_idx = i * input->shape[axis] * axis_mul_after + j;
-      for (int64_t k = 0; k < input->shape[axis]; ++k) {
-        int64_t full_idx = base_idx + k * axis_mul_after;
-        sorter.emplace_back(std::make_pair(k, data_ptr[full_idx]));
-      }
-      if (is_ascend) {
-        std::stable_sort(sorter.begin(), sorter.end(), CompareAscend<DataType>);
-      } else {
-        std::stable_sort(sorter.begin(), sorter.end(), CompareDescend<DataType>);
-      }
-      for (int64_t k = 0; k < input->shape[axis]; ++k) {
-        epilogue(out_ptr, base_idx + k * axis_mul_after, sorter[k]);
+  SortRows rows(input, axis);
+  const int64_t len = rows.axis_len;
+  const int64_t stride = rows.axis_mul_after;
+
+  ParallelForRows(rows.num_rows(), len, [&](int64_t begin, int64_t end) {
+    RowSorter<DataType> sorter(len);
+    for (int64_t row = begin; row < end; ++row) {
+      int64_t base_idx = rows.BaseIndex(row, len);
+      const auto& sorted = sorter.Sort(data_ptr + base_idx, stride, len, len, is_ascend);
+      for (int64_t k = 0; k < len; ++k) {
+        epilogue(out_ptr, base_idx + k * stride, sorted[k]);
       }
     }
-  }
+  });
 }
 
 template <typename DataType, typename OutType>
@@ -346,47 +535,27 @@ void topk(DLTensor* input, DLTensor* out_values, DLTensor* out_indices, int k, i
       (out_values == nullptr) ? nullptr : static_cast<DataType*>(out_values->data);
   IndicesType* indices_ptr =
       (out_indices == nullptr) ? nullptr : static_cast<IndicesType*>(out_indices->data);
-  std::vector<std::pair<int64_t, DataType>> sorter;
-
-  int axis_mul_before = 1;
-  int axis_mul_after = 1;
-  for (int i = 0; i < input->ndim; ++i) {
-    if (i < axis) {
-      axis_mul_before *= input->shape[i];
-    } else if (i > axis) {
-      axis_mul_after *= input->shape[i];
-    }
-  }
-  if (k < 1) {
-    k = input->shape[axis];
-  }
-
-  for (int i = 0; i < axis_mul_before; ++i) {
-    for (int j = 0; j < axis_mul_after; ++j) {
-      sorter.clear();
-      int64_t src_base_idx = i * input->shape[axis] * axis_mul_after + j;
-      int64_t dst_base_idx = i * k * axis_mul_after + j;
-      for (int64_t kk = 0; kk < input->shape[axis]; ++kk) {
-        int64_t full_idx = src_base_idx + kk * axis_mul_after;
-        sorter.emplace_back(std::make_pair(kk, data_ptr[full_idx]));
-      }
-      if (is_ascend) {
-        std::stable_sort(sorter.begin(), sorter.end(), CompareAscend<DataType>);
-      } else {
-        std::stable_sort(sorter.begin(), sorter.end(), CompareDescend<DataType>);
-      }
-      int64_t cnt = k > 0 ? k : input->shape[axis];
+  SortRows rows(input, axis);
+  const int64_t len = rows.axis_len;
+  const int64_t stride = rows.axis_mul_after;
+  const int64_t cnt = k < 1 ? len : k;
+
+  ParallelForRows(rows.num_rows(), len, [&](int64_t begin, int64_t end) {
+    RowSorter<DataType> sorter(len);
+    for (int64_t row = begin; row < end; ++row) {
+      int64_t src_base_idx = rows.BaseIndex(row, len);
+      int64_t dst_base_idx = rows.BaseIndex(row, cnt);
+      const auto& sorted = sorter.Sort(data_ptr + src_base_idx, stride, len, cnt, is_ascend);
       for (int64_t kk = 0; kk < cnt; ++kk) {
         if (indices_ptr != nullptr) {
-          indices_ptr[dst_base_idx + kk * axis_mul_after] =
-              static_cast<IndicesType>(sorter[kk].first);
+          indices_ptr[dst_base_idx + kk * stride] = static_cast<IndicesType>(sorted[kk].first);
         }
         if (values_ptr != nullptr) {
-          values_ptr[dst_base_idx + kk * axis_mul_after] = static_cast<DataType>(sorter[kk].second);
+          values_ptr[dst_base_idx + kk * stride] = static_cast<DataType>(sorted[kk].second);
         }
       }
     }
-  }
+  });
 }
 
 // Argsort implemented C library sort.
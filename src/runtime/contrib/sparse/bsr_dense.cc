@@ -0,0 +1,204 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file bsr_dense.cc
+ * \brief Dense x block sparse (BSR) matrix multiplication on CPU.
+ *
+ *  Computes out = data * W^T where W is an N x K matrix in BSR format. The dense operand is
+ *  transposed first so that a tile of rows of data is contiguous for each column of W. Each
+ *  block row of W is then multiplied with register blocked tiles of BS_R x NV SIMD vectors
+ *  of accumulators, sized to fit in the vector registers of the target.
+ */
+#include <dlpack/dlpack.h>
+#include <tvm/runtime/c_backend_api.h>
+#include <tvm/runtime/logging.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "parallel_for.h"
+#include "tensor_data.h"
+
+namespace tvm {
+namespace contrib {
+
+using namespace runtime;
+
+#if defined(__GNUC__) || defined(__clang__)
+/*! \brief The number of float lanes of the widest SIMD registers enabled for the build. */
+#if defined(__AVX512F__)
+constexpr int kLanes = 16;
+#elif defined(__AVX__)
+constexpr int kLanes = 8;
+#else
+constexpr int kLanes = 4;
+#endif
+/*! \brief A SIMD vector of floats, lowered to native registers by the compiler. */
+typedef float FloatVec __attribute__((vector_size(kLanes * sizeof(float))));
+#else
+constexpr int kLanes = 4;
+struct FloatVec {
+  float v[kLanes];
+  FloatVec& operator+=(const FloatVec& other) {
+    for (int i = 0; i < kLanes; ++i) v[i] += other.v[i];
+    return *this;
+  }
+  friend FloatVec operator*(float s, const FloatVec& x) {
+    FloatVec ret;
+    for (int i = 0; i < kLanes; ++i) ret.v[i] = s * x.v[i];
+    return ret;
+  }
+};
+#endif
+
+/*!
+ * \brief Multiply one block row of W with all rows of data.
+ * \tparam BS_R The number of rows of a block.
+ * \tparam NV The number of SIMD vectors of rows of data in a tile.
+ * \param data_t The transposed dense operand, K x M.
+ * \param out The output, M x N, starting at the first column of the block row.
+ */
+template <int BS_R, int NV>
+void BlockRow(const float* data_t, int64_t M, const float* w_data, const int32_t* w_indices,
+              int32_t begin, int32_t end, int64_t bs_c, float* out, int64_t N) {
+  constexpr int64_t kTileM = NV * kLanes;
+  int64_t m0 = 0;
+  for (; m0 + kTileM <= M; m0 += kTileM) {
+    FloatVec acc[BS_R][NV];
+    std::memset(acc, 0, sizeof(acc));
+    for (int32_t e = begin; e < end; ++e) {
+      const float* w = w_data + e * BS_R * bs_c;
+      const float* x_col = data_t + w_indices[e] * bs_c * M + m0;
+      for (int64_t c = 0; c < bs_c; ++c, x_col += M) {
+        FloatVec x[NV];
+        std::memcpy(x, x_col, sizeof(x));
+        for (int r = 0; r < BS_R; ++r) {
+          const float wv = w[r * bs_c + c];
+          for (int v = 0; v < NV; ++v) acc[r][v] += wv * x[v];
+        }
+      }
+    }
+    float tile[BS_R][kTileM];
+    std::memcpy(tile, acc, sizeof(tile));
+    for (int64_t m = 0; m < kTileM; ++m) {
+      for (int r = 0; r < BS_R; ++r) out[(m0 + m) * N + r] = tile[r][m];
+    }
+  }
+  // The remaining rows of data.
+  for (; m0 < M; ++m0) {
+    float acc[BS_R] = {0};
+    for (int32_t e = begin; e < end; ++e) {
+      const float* w = w_data + e * BS_R * bs_c;
+      const float* x_col = data_t + w_indices[e] * bs_c * M + m0;
+      for (int64_t c = 0; c < bs_c; ++c) {
+        for (int r = 0; r < BS_R; ++r) acc[r] += w[r * bs_c + c] * x_col[c * M];
+      }
+    }
+    for (int r = 0; r < BS_R; ++r) out[m0 * N + r] = acc[r];
+  }
+}
+
+// Fallback for block sizes without a specialized kernel.
+void BlockRowGeneric(const float* data_t, int64_t M, const float* w_data,
+                     const int32_t* w_indices, int32_t begin, int32_t end, int64_t bs_r,
+                     int64_t bs_c, float* out, int64_t N) {
+  for (int64_t m = 0; m < M; ++m) {
+    for (int64_t r = 0; r < bs_r; ++r) {
+      float acc = 0;
+      for (int32_t e = begin; e < end; ++e) {
+        const float* w = w_data + (e * bs_r + r) * bs_c;
+        const float* x_col = data_t + w_indices[e] * bs_c * M + m;
+        for (int64_t c = 0; c < bs_c; ++c) acc += w[c] * x_col[c * M];
+      }
+      out[m * N + r] = acc;
+    }
+  }
+}
+
+void BSRDense(const DLTensor* data, const DLTensor* w_data, const DLTensor* w_indices,
+              const DLTensor* w_indptr, DLTensor* out) {
+  ICHECK(data->dtype.code == kDLFloat && data->dtype.bits == 32) << "Only float32 is supported";
+  ICHECK(w_indices->dtype.code == kDLInt && w_indices->dtype.bits == 32);
+  ICHECK(w_indptr->dtype.code == kDLInt && w_indptr->dtype.bits == 32);
+  ICHECK_EQ(data->ndim, 2);
+  ICHECK_EQ(w_data->ndim, 3);
+  ICHECK_EQ(out->ndim, 2);
+  const int64_t M = data->shape[0], K = data->shape[1];
+  const int64_t bs_r = w_data->shape[1], bs_c = w_data->shape[2];
+  const int64_t num_block_rows = w_indptr->shape[0] - 1;
+  const int64_t N = num_block_rows * bs_r;
+  ICHECK_EQ(out->shape[0], M);
+  ICHECK_EQ(out->shape[1], N);
+
+  const float* x = Begin<const float>(data, "bsr_dense");
+  const float* w = Begin<const float>(w_data, "bsr_dense");
+  const int32_t* indices = Begin<const int32_t>(w_indices, "bsr_dense");
+  const int32_t* indptr = Begin<const int32_t>(w_indptr, "bsr_dense");
+  float* y = Begin<float>(out, "bsr_dense");
+
+  // Transpose the dense operand so that the rows multiplied with one column of W are contiguous.
+  const int device_id = out->device.device_id;
+  float* data_t = static_cast<float*>(
+      TVMBackendAllocWorkspace(kDLCPU, device_id, K * M * sizeof(float), kDLFloat, 32));
+  ICHECK(data_t != nullptr) << "bsr_dense: failed to allocate the workspace";
+  ParallelFor(K, K * M, [&](int64_t begin, int64_t end) {
+    for (int64_t k = begin; k < end; ++k) {
+      for (int64_t m = 0; m < M; ++m) data_t[k * M + m] = x[m * K + k];
+    }
+  });
+
+  const int64_t nnz = indptr[num_block_rows] - indptr[0];
+  ParallelFor(num_block_rows, nnz * bs_r * bs_c * M, [&](int64_t begin, int64_t end) {
+    for (int64_t br = begin; br < end; ++br) {
+      float* y_block = y + br * bs_r;
+      switch (bs_r) {
+        case 1:
+          BlockRow<1, 4>(data_t, M, w, indices, indptr[br], indptr[br + 1], bs_c, y_block, N);
+          break;
+        case 4:
+          BlockRow<4, 2>(data_t, M, w, indices, indptr[br], indptr[br + 1], bs_c, y_block, N);
+          break;
+        case 16:
+          BlockRow<16, 1>(data_t, M, w, indices, indptr[br], indptr[br + 1], bs_c, y_block, N);
+          break;
+        default:
+          BlockRowGeneric(data_t, M, w, indices, indptr[br], indptr[br + 1], bs_r, bs_c,
+                          y_block, N);
+      }
+    }
+  });
+  TVMBackendFreeWorkspace(kDLCPU, device_id, data_t);
+}
+
+// Dense x BSR matrix multiplication: out = data * W^T.
+// data is M x K, W is N x K given as w_data (nnz_blocks x bs_r x bs_c), w_indices (nnz_blocks)
+// and w_indptr (N / bs_r + 1).
+TVM_REGISTER_GLOBAL("tvm.contrib.sparse.bsr_dense").set_body([](TVMArgs args, TVMRetValue* ret) {
+  DLTensor* data = args[0];
+  DLTensor* w_data = args[1];
+  DLTensor* w_indices = args[2];
+  DLTensor* w_indptr = args[3];
+  DLTensor* out = args[4];
+  BSRDense(data, w_data, w_indices, w_indptr, out);
+});
+
+}  // namespace contrib
+}  // namespace tvm
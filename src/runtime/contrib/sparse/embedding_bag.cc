@@ -0,0 +1,194 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file embedding_bag.cc
+ * \brief Pooled embedding lookup (embedding bag) on CPU.
+ *
+ *  Each bag sums, or averages, a variable number of rows of an embedding table. Tables of
+ *  recommendation models are usually much larger than the last level cache, so the lookup is
+ *  bound by the latency of random row reads. The kernel prefetches the rows a few indices ahead
+ *  of the one being accumulated so that several row reads are in flight per thread.
+ */
+#include <dlpack/dlpack.h>
+#include <tvm/runtime/logging.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+#include "../../float_convert.h"
+#include "parallel_for.h"
+#include "tensor_data.h"
+
+namespace tvm {
+namespace contrib {
+
+using namespace runtime;
+
+/*! \brief The number of indices between the row being prefetched and the row being added. */
+constexpr int64_t kPrefetchDistance = 8;
+/*! \brief The cache line size assumed for prefetching. */
+constexpr int64_t kCacheLine = 64;
+
+enum class EmbeddingBagMode : int { kSum = 0, kMean = 1 };
+
+inline void PrefetchRow(const void* row, int64_t row_bytes) {
+#if defined(__GNUC__) || defined(__clang__)
+  const char* ptr = static_cast<const char*>(row);
+  for (int64_t i = 0; i < row_bytes; i += kCacheLine) {
+    __builtin_prefetch(ptr + i, 0, 0);
+  }
+#endif
+}
+
+/*!
+ * \brief Add one table row to the accumulator.
+ * \param buf Scratch space of dim floats for rows that need to be converted first.
+ */
+inline void AccumulateRow(const float* row, float* acc, float* buf, int64_t dim) {
+  for (int64_t d = 0; d < dim; ++d) acc[d] += row[d];
+}
+
+inline void AccumulateRow(const uint16_t* row, float* acc, float* buf, int64_t dim) {
+  ConvertFloat16ToFloat32(row, buf, dim);
+  for (int64_t d = 0; d < dim; ++d) acc[d] += buf[d];
+}
+
+inline void AccumulateRow(const int8_t* row, float* acc, float* buf, int64_t dim) {
+  for (int64_t d = 0; d < dim; ++d) acc[d] += static_cast<float>(row[d]);
+}
+
+/*!
+ * \brief Compute the bags [begin, end).
+ * \param scale The factor applied to every pooled row, the dequantization scale of int8 tables.
+ */
+template <typename T, typename IndexT>
+void EmbeddingBagRange(const T* weight, int64_t dim, const IndexT* indices, int64_t num_indices,
+                       const IndexT* offsets, int64_t num_bags, EmbeddingBagMode mode,
+                       float scale, float* out, int64_t begin, int64_t end) {
+  // An empty range, e.g. from a call without bags, must not read offsets[begin].
+  if (begin >= end || num_bags == 0) return;
+  const int64_t row_bytes = dim * sizeof(T);
+  std::vector<float> buf(std::is_same<T, float>::value ? 0 : dim);
+  const int64_t first = offsets[begin];
+  const int64_t last = end < num_bags ? offsets[end] : num_indices;
+  for (int64_t i = first; i < std::min(first + kPrefetchDistance, last); ++i) {
+    PrefetchRow(weight + indices[i] * dim, row_bytes);
+  }
+  for (int64_t b = begin; b < end; ++b) {
+    const int64_t bag_begin = offsets[b];
+    const int64_t bag_end = b + 1 < num_bags ? offsets[b + 1] : num_indices;
+    float* acc = out + b * dim;
+    std::fill(acc, acc + dim, 0.0f);
+    for (int64_t i = bag_begin; i < bag_end; ++i) {
+      if (i + kPrefetchDistance < last) {
+        PrefetchRow(weight + indices[i + kPrefetchDistance] * dim, row_bytes);
+      }
+      AccumulateRow(weight + indices[i] * dim, acc, buf.data(), dim);
+    }
+    float factor = scale;
+    if (mode == EmbeddingBagMode::kMean && bag_end > bag_begin) {
+      factor /= static_cast<float>(bag_end - bag_begin);
+    }
+    if (factor != 1.0f) {
+      for (int64_t d = 0; d < dim; ++d) acc[d] *= factor;
+    }
+  }
+}
+
+template <typename T, typename IndexT>
+void EmbeddingBag(const DLTensor* weight, const DLTensor* indices, const DLTensor* offsets,
+                  DLTensor* out, EmbeddingBagMode mode, float scale) {
+  const int64_t num_rows = weight->shape[0], dim = weight->shape[1];
+  const int64_t num_indices = indices->shape[0], num_bags = offsets->shape[0];
+  const T* w = Begin<const T>(weight, "embedding_bag");
+  const IndexT* idx = Begin<const IndexT>(indices, "embedding_bag");
+  const IndexT* off = Begin<const IndexT>(offsets, "embedding_bag");
+  float* y = Begin<float>(out, "embedding_bag");
+
+  // Validate up front: the pooling loops run on the thread pool and must not throw.
+  for (int64_t i = 0; i < num_indices; ++i) {
+    ICHECK(idx[i] >= 0 && idx[i] < num_rows)
+        << "embedding_bag: index " << idx[i] << " is out of range [0, " << num_rows << ")";
+  }
+  for (int64_t b = 0; b < num_bags; ++b) {
+    const int64_t bag_end = b + 1 < num_bags ? off[b + 1] : num_indices;
+    ICHECK(off[b] >= 0 && off[b] <= bag_end && bag_end <= num_indices)
+        << "embedding_bag: offsets must be non-decreasing and within [0, " << num_indices << "]";
+  }
+
+  ParallelFor(num_bags, num_indices * dim, [&](int64_t begin, int64_t end) {
+    EmbeddingBagRange<T, IndexT>(w, dim, idx, num_indices, off, num_bags, mode, scale, y, begin,
+                                 end);
+  });
+}
+
+template <typename IndexT>
+void EmbeddingBagDispatchTable(const DLTensor* weight, const DLTensor* indices,
+                               const DLTensor* offsets, DLTensor* out, EmbeddingBagMode mode,
+                               float scale) {
+  const DLDataType dtype = weight->dtype;
+  if (dtype.code == kDLFloat && dtype.bits == 32) {
+    EmbeddingBag<float, IndexT>(weight, indices, offsets, out, mode, scale);
+  } else if (dtype.code == kDLFloat && dtype.bits == 16) {
+    EmbeddingBag<uint16_t, IndexT>(weight, indices, offsets, out, mode, scale);
+  } else if (dtype.code == kDLInt && dtype.bits == 8) {
+    EmbeddingBag<int8_t, IndexT>(weight, indices, offsets, out, mode, scale);
+  } else {
+    LOG(FATAL) << "embedding_bag: unsupported table dtype " << DLDataType2String(dtype)
+               << ", expected float32, float16 or int8";
+  }
+}
+
+// Pooled embedding lookup: out[b] = scale * reduce(weight[indices[offsets[b]:offsets[b + 1]]]).
+// weight is num_rows x dim (float32, float16 or int8), indices and offsets are 1-D int32 or
+// int64 tensors of the same type, out is num_bags x dim float32. mode is 0 for sum, 1 for mean.
+TVM_REGISTER_GLOBAL("tvm.contrib.sparse.embedding_bag")
+    .set_body([](TVMArgs args, TVMRetValue* ret) {
+      DLTensor* weight = args[0];
+      DLTensor* indices = args[1];
+      DLTensor* offsets = args[2];
+      DLTensor* out = args[3];
+      int mode = args[4];
+      double scale = args[5];
+      ICHECK_EQ(weight->ndim, 2);
+      ICHECK_EQ(indices->ndim, 1);
+      ICHECK_EQ(offsets->ndim, 1);
+      ICHECK_EQ(out->ndim, 2);
+      ICHECK(out->dtype.code == kDLFloat && out->dtype.bits == 32) << "Output must be float32";
+      ICHECK_EQ(out->shape[0], offsets->shape[0]);
+      ICHECK_EQ(out->shape[1], weight->shape[1]);
+      ICHECK(mode == 0 || mode == 1) << "embedding_bag: mode must be 0 (sum) or 1 (mean)";
+      ICHECK(indices->dtype.code == kDLInt && indices->dtype.bits == offsets->dtype.bits &&
+             offsets->dtype.code == kDLInt)
+          << "embedding_bag: indices and offsets must be of the same integer type";
+      auto emb_mode = static_cast<EmbeddingBagMode>(mode);
+      if (indices->dtype.bits == 32) {
+        EmbeddingBagDispatchTable<int32_t>(weight, indices, offsets, out, emb_mode, scale);
+      } else if (indices->dtype.bits == 64) {
+        EmbeddingBagDispatchTable<int64_t>(weight, indices, offsets, out, emb_mode, scale);
+      } else {
+        LOG(FATAL) << "embedding_bag: indices must be int32 or int64";
+      }
+    });
+
+}  // namespace contrib
+}  // namespace tvm
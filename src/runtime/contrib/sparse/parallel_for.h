@@ -0,0 +1,74 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file parallel_for.h
+ * \brief Range parallel loops over the runtime thread pool for the contrib.sparse kernels.
+ */
+#ifndef TVM_RUNTIME_CONTRIB_SPARSE_PARALLEL_FOR_H_
+#define TVM_RUNTIME_CONTRIB_SPARSE_PARALLEL_FOR_H_
+
+#include <tvm/runtime/c_backend_api.h>
+#include <tvm/runtime/logging.h>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace tvm {
+namespace contrib {
+
+/*! \brief The minimum amount of work, in multiply-adds, to split over the thread pool. */
+constexpr int64_t kParallelMinWork = 1 << 16;
+
+template <typename FRange>
+struct RangeClosure {
+  int64_t num;
+  FRange* frange;
+};
+
+template <typename FRange>
+int RangeTask(int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+  auto* closure = static_cast<RangeClosure<FRange>*>(cdata);
+  int64_t chunk = (closure->num + penv->num_task - 1) / penv->num_task;
+  int64_t begin = std::min(task_id * chunk, closure->num);
+  int64_t end = std::min(begin + chunk, closure->num);
+  if (begin < end) {
+    (*closure->frange)(begin, end);
+  }
+  return 0;
+}
+
+/*!
+ * \brief Call frange(begin, end) on disjoint ranges of [0, num) using the runtime thread pool.
+ *  Small problems run on the calling thread.
+ */
+template <typename FRange>
+void ParallelFor(int64_t num, int64_t work, FRange frange) {
+  if (num <= 1 || work < kParallelMinWork) {
+    frange(0, num);
+    return;
+  }
+  RangeClosure<FRange> closure{num, &frange};
+  int res = TVMBackendParallelLaunch(RangeTask<FRange>, &closure, 0);
+  ICHECK_EQ(res, 0) << "Parallel sparse kernel failed";
+}
+
+}  // namespace contrib
+}  // namespace tvm
+#endif  // TVM_RUNTIME_CONTRIB_SPARSE_PARALLEL_FOR_H_
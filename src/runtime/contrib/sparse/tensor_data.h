@@ -0,0 +1,47 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file tensor_data.h
+ * \brief Access to the data of the tensors passed to the contrib.sparse kernels.
+ */
+#ifndef TVM_RUNTIME_CONTRIB_SPARSE_TENSOR_DATA_H_
+#define TVM_RUNTIME_CONTRIB_SPARSE_TENSOR_DATA_H_
+
+#include <dlpack/dlpack.h>
+#include <tvm/runtime/logging.h>
+#include <tvm/runtime/ndarray.h>
+
+namespace tvm {
+namespace contrib {
+
+/*!
+ * \brief The first element of a compact tensor, past its byte_offset.
+ * \param kernel The name of the calling kernel, for the error message.
+ */
+template <typename T>
+T* Begin(const DLTensor* arr, const char* kernel) {
+  ICHECK(runtime::IsContiguous(*arr)) << kernel << ": only compact tensors are supported";
+  return reinterpret_cast<T*>(static_cast<char*>(arr->data) + arr->byte_offset);
+}
+
+}  // namespace contrib
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_CONTRIB_SPARSE_TENSOR_DATA_H_
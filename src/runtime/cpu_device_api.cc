@@ -24,9 +24,16 @@
 #include <tvm/runtime/device_api.h>
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/registry.h>
+#include <tvm/runtime/threading_backend.h>
 
+#include <condition_variable>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
 
 #include "workspace_pool.h"
 
@@ -36,8 +43,95 @@
 
 namespace tvm {
 namespace runtime {
+/*!
+ * \brief A stream of the CPU device.
+ *
+ *  A worker thread runs the tasks of the stream in submission order, so that
+ *  copies on the stream overlap with work on the calling thread.
+ */
+class CPUStream {
+ public:
+  CPUStream() : numa_node_(threading::PreferredNUMANode()), worker_([this]() { this->Run(); }) {}
+
+  ~CPUStream() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      exit_ = true;
+    }
+    task_cv_.notify_one();
+    worker_.join();
+  }
+
+  /*!
+   * \brief Submit a task to the stream.
+   * \param task The task.
+   */
+  void Enqueue(std::function<void()> task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.push_back(std::move(task));
+      ++num_enqueued_;
+    }
+    task_cv_.notify_one();
+  }
+
+  /*! \return An event that completes with the tasks submitted so far. */
+  uint64_t Record() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return num_enqueued_;
+  }
+
+  /*!
+   * \brief Wait for an event of the stream.
+   * \param event The event returned by Record.
+   */
+  void Wait(uint64_t event) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this, event]() { return num_done_ >= event; });
+  }
+
+  /*! \brief Wait for the tasks submitted so far. */
+  void Sync() { Wait(Record()); }
+
+ private:
+  void Run() {
+    // Copy on the NUMA node of the thread pool that created the stream.
+    if (numa_node_ >= 0) {
+      threading::BindToNUMANode(numa_node_);
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      task_cv_.wait(lock, [this]() { return exit_ || !tasks_.empty(); });
+      if (tasks_.empty()) return;
+      std::function<void()> task = std::move(tasks_.front());
+      tasks_.pop_front();
+      lock.unlock();
+      task();
+      lock.lock();
+      ++num_done_;
+      done_cv_.notify_all();
+    }
+  }
+
+  std::mutex mutex_;
+  /*! \brief Signaled when a task is submitted or the stream is freed. */
+  std::condition_variable task_cv_;
+  /*! \brief Signaled when a task completes. */
+  std::condition_variable done_cv_;
+  std::deque<std::function<void()>> tasks_;
+  uint64_t num_enqueued_{0};
+  uint64_t num_done_{0};
+  bool exit_{false};
+  int numa_node_;
+  // Started last, once the fields above are initialized.
+  std::thread worker_;
+};
+
 class CPUDeviceAPI final : public DeviceAPI {
  public:
+  /*! \brief The smallest allocation placed on a NUMA node, smaller ones span few pages. */
+  static constexpr size_t kMinNUMAPlacedBytes = 64 << 10;
+
   void SetDevice(Device dev) final {}
   void GetAttr(Device dev, DeviceAttrKind kind, TVMRetValue* rv) final {
     if (kind == kExist) {
@@ -57,6 +151,14 @@ class CPUDeviceAPI final : public DeviceAPI {
     int ret = posix_memalign(&ptr, alignment, nbytes);
     if (ret != 0) throw std::bad_alloc();
 #endif
+    // Place large buffers, such as activations and workspaces, on the NUMA node of
+    // the thread pool, even when another thread touches them first.
+    if (nbytes >= kMinNUMAPlacedBytes) {
+      int numa_node = threading::PreferredNUMANode();
+      if (numa_node >= 0) {
+        threading::PlaceOnNUMANode(ptr, nbytes, numa_node);
+      }
+    }
     return ptr;
   }
 
@@ -68,7 +170,30 @@ class CPUDeviceAPI final : public DeviceAPI {
 #endif
   }
 
-  void StreamSync(Device dev, TVMStreamHandle stream) final {}
+  TVMStreamHandle CreateStream(Device dev) final { return new CPUStream(); }
+
+  void FreeStream(Device dev, TVMStreamHandle stream) final {
+    // The destructor runs the pending tasks first.
+    delete static_cast<CPUStream*>(stream);
+  }
+
+  void StreamSync(Device dev, TVMStreamHandle stream) final {
+    // Work on the default stream runs synchronously.
+    if (stream != nullptr) {
+      static_cast<CPUStream*>(stream)->Sync();
+    }
+  }
+
+  void SyncStreamFromTo(Device dev, TVMStreamHandle event_src, TVMStreamHandle event_dst) final {
+    if (event_src == nullptr) return;
+    CPUStream* src = static_cast<CPUStream*>(event_src);
+    if (event_dst == nullptr) {
+      src->Sync();
+    } else {
+      uint64_t event = src->Record();
+      static_cast<CPUStream*>(event_dst)->Enqueue([src, event]() { src->Wait(event); });
+    }
+  }
 
   void* AllocWorkspace(Device dev, size_t size, DLDataType type_hint) final;
   void FreeWorkspace(Device dev, void* data) final;
@@ -84,7 +209,14 @@ class CPUDeviceAPI final : public DeviceAPI {
   void CopyDataFromTo(const void* from, size_t from_offset, void* to, size_t to_offset, size_t size,
                       Device dev_from, Device dev_to, DLDataType type_hint,
                       TVMStreamHandle stream) final {
-    memcpy(static_cast<char*>(to) + to_offset, static_cast<const char*>(from) + from_offset, size);
+    char* dst = static_cast<char*>(to) + to_offset;
+    const char* src = static_cast<const char*>(from) + from_offset;
+    if (stream != nullptr) {
+      // The buffers must stay alive until the stream is synchronized.
+      static_cast<CPUStream*>(stream)->Enqueue([dst, src, size]() { memcpy(dst, src, size); });
+    } else {
+      memcpy(dst, src, size);
+    }
   }
 };
 
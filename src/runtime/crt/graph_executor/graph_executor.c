@@ -723,6 +723,180 @@ int TVMGraphExecutor_Load(TVMGraphExecutor* executor, JSONReader* reader) {
   return status;
 }
 
+// Return a pointer to the section of count elements of elem_size bytes at *offset, and move
+// *offset to the next 8-byte aligned section. Return NULL if the section overflows the blob.
+static const void* GraphBinary_Section(const uint8_t* base, size_t size, size_t* offset,
+                                       size_t count, size_t elem_size) {
+  size_t begin = *offset;
+  if (count > (size - begin) / elem_size) {
+    return NULL;
+  }
+  *offset = (begin + count * elem_size + 7) & ~((size_t)7);
+  if (*offset > size) {
+    *offset = size;
+  }
+  return base + begin;
+}
+
+// Return whether a node entry of a binary graph names an output of one of its nodes.
+static int GraphBinary_IsValidEntry(const TVMGraphBinaryHeader* header,
+                                    const uint32_t* node_row_ptr,
+                                    const TVMGraphExecutorNodeEntry* entry) {
+  return entry->node_id < header->num_nodes &&
+         entry->index < node_row_ptr[entry->node_id + 1] - node_row_ptr[entry->node_id];
+}
+
+/*!
+ * \brief Load a binary graph made by tvm.micro.graph_binary.
+ *
+ *  The graph tables are referenced in place, so nothing is parsed or allocated and the blob
+ *  must outlive the executor.
+ * \param executor The graph executor.
+ * \param graph_binary The binary graph, 8-byte aligned.
+ * \param graph_binary_size Size of graph_binary in bytes.
+ * \return 0 on success.
+ */
+int TVMGraphExecutor_LoadBinary(TVMGraphExecutor* executor, const void* graph_binary,
+                                size_t graph_binary_size) {
+  const uint8_t* base = (const uint8_t*)graph_binary;
+  const TVMGraphBinaryHeader* header = (const TVMGraphBinaryHeader*)graph_binary;
+  if (((uintptr_t)base & 7) != 0) {
+    fprintf(stderr, "binary graph must be 8-byte aligned\n");
+    return -1;
+  }
+  if (graph_binary_size < sizeof(TVMGraphBinaryHeader) || header->magic != kTVMGraphBinaryMagic) {
+    fprintf(stderr, "invalid binary graph format\n");
+    return -1;
+  }
+  if (header->version != kTVMGraphBinaryVersion) {
+    fprintf(stderr, "unsupported binary graph version %u\n", header->version);
+    return -1;
+  }
+  if (header->max_ndim != TVM_CRT_MAX_NDIM) {
+    fprintf(stderr, "binary graph was made for max_ndim=%u, but TVM_CRT_MAX_NDIM is %d\n",
+            header->max_ndim, TVM_CRT_MAX_NDIM);
+    return -1;
+  }
+
+  size_t offset = sizeof(TVMGraphBinaryHeader);
+  const TVMGraphBinaryNode* nodes =
+      GraphBinary_Section(base, graph_binary_size, &offset, header->num_nodes,
+                          sizeof(TVMGraphBinaryNode));
+  const uint32_t* input_nodes = GraphBinary_Section(base, graph_binary_size, &offset,
+                                                    header->num_input_nodes, sizeof(uint32_t));
+  const uint32_t* node_row_ptr = GraphBinary_Section(base, graph_binary_size, &offset,
+                                                     header->num_nodes + 1, sizeof(uint32_t));
+  const TVMGraphExecutorNodeEntry* outputs =
+      GraphBinary_Section(base, graph_binary_size, &offset, header->num_outputs,
+                          sizeof(TVMGraphExecutorNodeEntry));
+  const TVMGraphExecutorNodeEntry* node_inputs =
+      GraphBinary_Section(base, graph_binary_size, &offset, header->num_node_inputs,
+                          sizeof(TVMGraphExecutorNodeEntry));
+  const uint32_t* storage_id = GraphBinary_Section(base, graph_binary_size, &offset,
+                                                   header->num_entries, sizeof(uint32_t));
+  const uint32_t* ndim = GraphBinary_Section(base, graph_binary_size, &offset,
+                                             header->num_entries, sizeof(uint32_t));
+  const DLDataType* dtypes = GraphBinary_Section(base, graph_binary_size, &offset,
+                                                 header->num_entries, sizeof(DLDataType));
+  const int64_t* shape =
+      GraphBinary_Section(base, graph_binary_size, &offset,
+                          (size_t)header->num_entries * header->max_ndim, sizeof(int64_t));
+  const TVMGraphBinaryStorage* storage =
+      GraphBinary_Section(base, graph_binary_size, &offset, header->num_storage,
+                          sizeof(TVMGraphBinaryStorage));
+  const char* strings =
+      GraphBinary_Section(base, graph_binary_size, &offset, header->strings_size, 1);
+  if (!nodes || !input_nodes || !node_row_ptr || !outputs || !node_inputs || !storage_id ||
+      !ndim || !dtypes || !shape || !storage || !strings || header->strings_size == 0 ||
+      strings[header->strings_size - 1] != 0 ||
+      node_row_ptr[header->num_nodes] != header->num_entries) {
+    fprintf(stderr, "truncated or inconsistent binary graph\n");
+    return -1;
+  }
+  uint32_t nid;
+  for (nid = 0; nid < header->num_nodes; ++nid) {
+    const TVMGraphBinaryNode* node = nodes + nid;
+    if (node->name >= header->strings_size || node->func_name >= header->strings_size ||
+        node->inputs_begin > header->num_node_inputs ||
+        node->inputs_count > header->num_node_inputs - node->inputs_begin ||
+        node_row_ptr[nid] > node_row_ptr[nid + 1] ||
+        node->num_outputs > node_row_ptr[nid + 1] - node_row_ptr[nid]) {
+      fprintf(stderr, "invalid binary graph node %u\n", nid);
+      return -1;
+    }
+  }
+  // The executor indexes its tables with the ids below without checking them.
+  uint32_t idx;
+  for (idx = 0; idx < header->num_input_nodes; ++idx) {
+    if (input_nodes[idx] >= header->num_nodes) {
+      fprintf(stderr, "invalid binary graph input node %u\n", input_nodes[idx]);
+      return -1;
+    }
+  }
+  for (idx = 0; idx < header->num_outputs; ++idx) {
+    if (!GraphBinary_IsValidEntry(header, node_row_ptr, outputs + idx)) {
+      fprintf(stderr, "invalid binary graph output %u\n", idx);
+      return -1;
+    }
+  }
+  for (idx = 0; idx < header->num_node_inputs; ++idx) {
+    if (!GraphBinary_IsValidEntry(header, node_row_ptr, node_inputs + idx)) {
+      fprintf(stderr, "invalid binary graph node input %u\n", idx);
+      return -1;
+    }
+  }
+  for (idx = 0; idx < header->num_entries; ++idx) {
+    if (storage_id[idx] >= header->num_storage || ndim[idx] > header->max_ndim) {
+      fprintf(stderr, "invalid binary graph entry %u\n", idx);
+      return -1;
+    }
+  }
+  for (idx = 0; idx < header->num_storage; ++idx) {
+    if (storage[idx].entry_id >= header->num_entries) {
+      fprintf(stderr, "invalid binary graph storage %u\n", idx);
+      return -1;
+    }
+  }
+
+  // The graph tables are read only, they are never written through these pointers.
+  executor->binary = header;
+  executor->binary_nodes = nodes;
+  executor->binary_node_inputs = node_inputs;
+  executor->binary_dtypes = dtypes;
+  executor->binary_storage = storage;
+  executor->binary_strings = strings;
+  executor->nodes = NULL;
+  executor->nodes_count = header->num_nodes;
+  executor->input_nodes = (uint32_t*)input_nodes;
+  executor->input_nodes_count = header->num_input_nodes;
+  executor->node_row_ptr = (uint32_t*)node_row_ptr;
+  executor->node_row_ptr_count = header->num_nodes + 1;
+  executor->outputs = (TVMGraphExecutorNodeEntry*)outputs;
+  executor->outputs_count = header->num_outputs;
+  executor->attrs.storage_num_not_alloctaed = 0;
+  executor->attrs.storage_id = (uint32_t*)storage_id;
+  executor->attrs.device_index = NULL;
+  executor->attrs.dltype = NULL;
+  executor->attrs.dltype_count = header->num_entries;
+  executor->attrs.shape = (int64_t*)shape;
+  executor->attrs.ndim = (uint32_t*)ndim;
+  executor->attrs.shape_count = header->num_entries;
+  return 0;
+}
+
+/*!
+ * \brief Get the name of a node.
+ * \param executor The graph executor.
+ * \param nid The node id.
+ * \return The name of the node.
+ */
+const char* TVMGraphExecutor_GetNodeName(TVMGraphExecutor* executor, uint32_t nid) {
+  if (executor->binary) {
+    return executor->binary_strings + executor->binary_nodes[nid].name;
+  }
+  return executor->nodes[nid].name;
+}
+
 uint32_t TVMGraphExecutor_GetEntryId(TVMGraphExecutor* executor, uint32_t nid, uint32_t index) {
   return executor->node_row_ptr[nid] + index;
 }
@@ -747,7 +921,7 @@ int TVMGraphExecutor_GetInputIndex(TVMGraphExecutor* executor, const char* name)
   int32_t rv = -1;
   for (i = 0; i < executor->input_nodes_count; ++i) {
     uint32_t nid = executor->input_nodes[i];
-    if (!strcmp(executor->nodes[nid].name, name)) {
+    if (!strcmp(TVMGraphExecutor_GetNodeName(executor, nid), name)) {
       rv = i;
       break;
     }
@@ -915,6 +1089,39 @@ int TVMGraphExecutor_GetOutput(TVMGraphExecutor* executor, const int32_t idx, DL
   return status;
 }
 
+// Allocate a table of the executor, from its arena if it was created in one.
+static int TVMGraphExecutor_Allocate(TVMGraphExecutor* executor, size_t size, void** out_ptr) {
+  if (executor->arena == NULL) {
+    DLDevice dev = {kDLCPU, 0};
+    tvm_crt_error_t err = TVMPlatformMemoryAllocate(size, dev, out_ptr);
+    if (err != kTvmErrorNoError) {
+      fprintf(stderr, "memory allocate error: %08x", err);
+      return -1;
+    }
+    return 0;
+  }
+  size = TVM_GRAPH_EXECUTOR_ARENA_ALIGN(size);
+  if (size > executor->arena_size - executor->arena_used) {
+    fprintf(stderr, "graph executor arena is too small: %lu bytes used, %lu more requested\n",
+            (unsigned long)executor->arena_used, (unsigned long)size);
+    return -1;
+  }
+  *out_ptr = executor->arena + executor->arena_used;
+  executor->arena_used += size;
+  return 0;
+}
+
+// Fill array to reference data, without allocating its shape. Used for arena executors.
+static void TVMGraphExecutor_InitArray(TVMNDArray* array, int64_t* shape, int32_t ndim,
+                                       DLDataType dtype, DLDevice dev, void* data) {
+  memset(array, 0, sizeof(TVMNDArray));
+  array->dl_tensor.data = data;
+  array->dl_tensor.device = dev;
+  array->dl_tensor.ndim = ndim;
+  array->dl_tensor.dtype = dtype;
+  array->dl_tensor.shape = shape;
+}
+
 int TVMGraphExecutor_SetupStorage(TVMGraphExecutor* executor) {
   TVMPackedFunc lookup_linked_param;
   int lookup_linked_param_valid;
@@ -934,54 +1141,73 @@ int TVMGraphExecutor_SetupStorage(TVMGraphExecutor* executor) {
   TVMGraphExecutorGraphAttr* attrs = &(executor->attrs);
   DLDataType* vtype = NULL;
   DLDevice alloc_dev = {kDLCPU, 0};
-  tvm_crt_error_t err = TVMPlatformMemoryAllocate(sizeof(DLDataType) * attrs->dltype_count,
-                                                  alloc_dev, (void**)&vtype);
-  if (err != kTvmErrorNoError) {
-    fprintf(stderr, "memory allocate error: %08x", err);
-    return -1;
-  }
-  for (idx = 0; idx < attrs->dltype_count; idx++) {
-    vtype[idx] = String2DLDataType(attrs->dltype + idx * TVM_CRT_MAX_STRLEN_DLTYPE);
-  }
-
+  tvm_crt_error_t err;
   // Size and device type of each storage pool entry.
   TVMGraphExecutorPoolEntry* pool_entry = NULL;
-  err = TVMPlatformMemoryAllocate(sizeof(TVMGraphExecutorPoolEntry) * executor->nodes_count,
-                                  alloc_dev, (void**)&pool_entry);
-  if (err != kTvmErrorNoError) {
-    fprintf(stderr, "memory allocate error: %08x", err);
-    return -1;
-  }
-  memset(pool_entry, 0, sizeof(TVMGraphExecutorPoolEntry) * executor->nodes_count);
   uint32_t pool_entry_count = 0;
-  // Find the maximum space size.
-  for (idx = 0; idx < attrs->shape_count; idx++) {
-    int storage_id = attrs->storage_id[idx];
-    // Use the fallback device if no device index is available.
-    int device_type = executor->devices[0].device_type;
-    uint32_t size = Shape_Accumulate(attrs->shape + idx * TVM_CRT_MAX_NDIM, attrs->ndim[idx]);
-    DLDataType t = vtype[idx];
-    uint32_t bits = t.bits * t.lanes;
-    size_t bytes = ((bits + 7U) / 8U) * size;
-
-    uint32_t sid = storage_id;
-    if (sid >= pool_entry_count) {
-      pool_entry_count = sid + 1;
+  if (executor->binary) {
+    // A binary graph carries the parsed data types and the storage plan.
+    vtype = (DLDataType*)executor->binary_dtypes;
+    pool_entry_count = executor->binary->num_storage;
+  } else {
+    err = TVMPlatformMemoryAllocate(sizeof(DLDataType) * attrs->dltype_count, alloc_dev,
+                                    (void**)&vtype);
+    if (err != kTvmErrorNoError) {
+      fprintf(stderr, "memory allocate error: %08x", err);
+      return -1;
+    }
+    for (idx = 0; idx < attrs->dltype_count; idx++) {
+      vtype[idx] = String2DLDataType(attrs->dltype + idx * TVM_CRT_MAX_STRLEN_DLTYPE);
+    }
+
+    err = TVMPlatformMemoryAllocate(sizeof(TVMGraphExecutorPoolEntry) * executor->nodes_count,
+                                    alloc_dev, (void**)&pool_entry);
+    if (err != kTvmErrorNoError) {
+      fprintf(stderr, "memory allocate error: %08x", err);
+      return -1;
+    }
+    memset(pool_entry, 0, sizeof(TVMGraphExecutorPoolEntry) * executor->nodes_count);
+    // Find the maximum space size.
+    for (idx = 0; idx < attrs->shape_count; idx++) {
+      int storage_id = attrs->storage_id[idx];
+      // Use the fallback device if no device index is available.
+      int device_type = executor->devices[0].device_type;
+      uint32_t size = Shape_Accumulate(attrs->shape + idx * TVM_CRT_MAX_NDIM, attrs->ndim[idx]);
+      DLDataType t = vtype[idx];
+      uint32_t bits = t.bits * t.lanes;
+      size_t bytes = ((bits + 7U) / 8U) * size;
+
+      uint32_t sid = storage_id;
+      if (sid >= pool_entry_count) {
+        pool_entry_count = sid + 1;
+      }
+      pool_entry[sid].entry_id = idx;
+      pool_entry[sid].size = MAX(pool_entry[sid].size, bytes);
+      pool_entry[sid].device_type = device_type;
     }
-    pool_entry[sid].entry_id = idx;
-    pool_entry[sid].size = MAX(pool_entry[sid].size, bytes);
-    pool_entry[sid].device_type = device_type;
   }
 
   // Allocate the space.
-  err = TVMPlatformMemoryAllocate(sizeof(TVMGraphExecutorStorageEntry) * pool_entry_count,
-                                  alloc_dev, (void**)&executor->storage_pool);
-  if (err != kTvmErrorNoError) {
-    fprintf(stderr, "memory allocate error: %08x", err);
+  if (TVMGraphExecutor_Allocate(executor, sizeof(TVMGraphExecutorStorageEntry) * pool_entry_count,
+                                (void**)&executor->storage_pool) != 0) {
+    return -1;
+  }
+  // An arena executor holds the shapes of the storage pool entries in one table.
+  int64_t* pool_shape = NULL;
+  if (executor->arena != NULL &&
+      TVMGraphExecutor_Allocate(executor, sizeof(int64_t) * pool_entry_count,
+                                (void**)&pool_shape) != 0) {
     return -1;
   }
   for (idx = 0; idx < pool_entry_count; idx++) {
-    TVMGraphExecutorPoolEntry pit = pool_entry[idx];
+    TVMGraphExecutorPoolEntry pit;
+    if (executor->binary) {
+      pit.size = executor->binary_storage[idx].size;
+      pit.device_type = executor->binary_storage[idx].device_type;
+      pit.entry_id = executor->binary_storage[idx].entry_id;
+    } else {
+      pit = pool_entry[idx];
+    }
     DLDevice dev = executor->devices[0];
     uint8_t did_find_linked_param = 0;
     if (lookup_linked_param_valid) {
@@ -1007,9 +1233,19 @@ int TVMGraphExecutor_SetupStorage(TVMGraphExecutor* executor) {
           0,
       };
       shape[0] = (pit.size + 3) / 4;
-      int status = TVMNDArray_Empty(1, shape, dtype, dev,
-                                    &executor->storage_pool[executor->storage_pool_count].array);
-      CHECK_EQ(status, 0, "fail to create storage_pool with idx=%d\n", idx);
+      TVMNDArray* array = &executor->storage_pool[executor->storage_pool_count].array;
+      if (executor->arena != NULL) {
+        void* data;
+        if (TVMGraphExecutor_Allocate(executor, shape[0] * 4, &data) != 0) {
+          return -1;
+        }
+        memset(data, 0, shape[0] * 4);
+        pool_shape[idx] = shape[0];
+        TVMGraphExecutor_InitArray(array, pool_shape + idx, 1, dtype, dev, data);
+      } else {
+        int status = TVMNDArray_Empty(1, shape, dtype, dev, array);
+        CHECK_EQ(status, 0, "fail to create storage_pool with idx=%d\n", idx);
+      }
     }
     executor->storage_pool_count++;
   }
@@ -1018,21 +1254,38 @@ int TVMGraphExecutor_SetupStorage(TVMGraphExecutor* executor) {
   // memory assignment for each node entry. The allocated memory on each device
   // is mapped to this pool.
   executor->data_entry_count = executor->node_row_ptr[executor->node_row_ptr_count - 1];
-  err = TVMPlatformMemoryAllocate(sizeof(TVMNDArray) * executor->data_entry_count, alloc_dev,
-                                  (void**)&executor->data_entry);
-  if (err != kTvmErrorNoError) {
-    fprintf(stderr, "memory allocate error: %08x", err);
+  if (TVMGraphExecutor_Allocate(executor, sizeof(TVMNDArray) * executor->data_entry_count,
+                                (void**)&executor->data_entry) != 0) {
     return -1;
   }
+  // An arena executor copies the shapes of all entries at once, the graph may be read only.
+  int64_t* entry_shape = NULL;
+  if (executor->arena != NULL) {
+    size_t shape_size = sizeof(int64_t) * TVM_CRT_MAX_NDIM * executor->data_entry_count;
+    if (TVMGraphExecutor_Allocate(executor, shape_size, (void**)&entry_shape) != 0) {
+      return -1;
+    }
+    memcpy(entry_shape, attrs->shape, shape_size);
+  }
   for (idx = 0; idx < executor->data_entry_count; ++idx) {
     uint32_t storage_id = attrs->storage_id[idx];
     CHECK(storage_id < executor->storage_pool_count);
-    int status = TVMNDArray_CreateView(&(executor->storage_pool[storage_id].array),
-                                       attrs->shape + idx * TVM_CRT_MAX_NDIM, attrs->ndim[idx],
-                                       vtype[idx], &executor->data_entry[idx]);
+    TVMNDArray* pool = &(executor->storage_pool[storage_id].array);
+    if (executor->arena != NULL) {
+      TVMGraphExecutor_InitArray(&executor->data_entry[idx], entry_shape + idx * TVM_CRT_MAX_NDIM,
+                                 attrs->ndim[idx], vtype[idx], pool->dl_tensor.device,
+                                 pool->dl_tensor.data);
+      continue;
+    }
+    int status = TVMNDArray_CreateView(pool, attrs->shape + idx * TVM_CRT_MAX_NDIM,
+                                       attrs->ndim[idx], vtype[idx], &executor->data_entry[idx]);
     CHECK_EQ(status, 0, "fail to create for node with idx=%d, storage_id=%u\n", idx, storage_id);
   }
 
+  if (executor->binary) {
+    return 0;
+  }
+
   // Release memory
   err = TVMPlatformMemoryFree(vtype, alloc_dev);
   if (err != kTvmErrorNoError) {
@@ -1053,46 +1306,71 @@ int TVMGraphExecutor_SetupOpExecs(TVMGraphExecutor* executor) {
   int status = 0;
   uint32_t nid, idx;
   executor->op_execs_count = executor->nodes_count;
-  DLDevice dev = {kDLCPU, 0};
-  tvm_crt_error_t err = TVMPlatformMemoryAllocate(sizeof(TVMPackedFunc) * executor->op_execs_count,
-                                                  dev, (void**)&executor->op_execs);
-  if (err != kTvmErrorNoError) {
-    fprintf(stderr, "memory allocate error: %08x", err);
+  if (TVMGraphExecutor_Allocate(executor, sizeof(TVMPackedFunc) * executor->op_execs_count,
+                                (void**)&executor->op_execs) != 0) {
     status = -1;
     return status;
   }
   for (nid = 0; nid < executor->nodes_count; nid++) {
-    const TVMGraphExecutorNode* inode = executor->nodes + nid;
-    if (strcmp(inode->op_type, "null")) {
+    const char* op_type;
+    const TVMGraphExecutorNodeEntry* inputs;
+    uint32_t inputs_count;
+    const TVMOpParam* param;
+    TVMOpParam binary_param;
+    if (executor->binary) {
+      const TVMGraphBinaryNode* bnode = executor->binary_nodes + nid;
+      if (bnode->op_type == kTVMGraphBinaryOpNull) {
+        op_type = "null";
+      } else if (bnode->op_type == kTVMGraphBinaryOpTVMOp) {
+        op_type = "tvm_op";
+      } else {
+        op_type = "unknown";
+      }
+      inputs = executor->binary_node_inputs + bnode->inputs_begin;
+      inputs_count = bnode->inputs_count;
+      snprintf(binary_param.func_name, sizeof(binary_param.func_name), "%s",
+               executor->binary_strings + bnode->func_name);
+      binary_param.num_inputs = bnode->num_inputs;
+      binary_param.num_outputs = bnode->num_outputs;
+      binary_param.flatten_data = bnode->flatten_data;
+      param = &binary_param;
+    } else {
+      const TVMGraphExecutorNode* inode = executor->nodes + nid;
+      op_type = inode->op_type;
+      inputs = inode->inputs;
+      inputs_count = inode->inputs_count;
+      param = &(inode->param);
+    }
+    if (strcmp(op_type, "null")) {
       DLTensorPtr args[TVM_CRT_MAX_ARGS];
       uint32_t args_count = 0;
-      for (idx = 0; idx < inode->inputs_count; idx++) {
-        const TVMGraphExecutorNodeEntry* entry = inode->inputs + idx;
+      if (inputs_count + param->num_outputs >= TVM_CRT_MAX_ARGS) {
+        fprintf(stderr, "too many arguments: expected less than %d args, but got %d.\n",
+                TVM_CRT_MAX_ARGS, inputs_count + param->num_outputs);
+        status = -1;
+        break;
+      }
+      for (idx = 0; idx < inputs_count; idx++) {
+        const TVMGraphExecutorNodeEntry* entry = inputs + idx;
         uint32_t eid = TVMGraphExecutor_GetEntryId(executor, entry->node_id, entry->index);
         args[idx] = &(executor->data_entry[eid].dl_tensor);
         args_count++;
       }
-      for (idx = 0; idx < inode->param.num_outputs; idx++) {
+      for (idx = 0; idx < param->num_outputs; idx++) {
         uint32_t eid = TVMGraphExecutor_GetEntryId(executor, nid, idx);
         args[args_count] = &(executor->data_entry[eid].dl_tensor);
         args_count++;
       }
-      if (strcmp(inode->op_type, "tvm_op")) {
-        fprintf(stderr, "Can only take tvm_op as op, but \"%s\" is found.\n", inode->op_type);
-        status = -1;
-        break;
-      }
-      if (args_count >= TVM_CRT_MAX_ARGS) {
-        fprintf(stderr, "too many arguments: expected less than %d args, but got %d.\n",
-                TVM_CRT_MAX_ARGS, args_count);
+      if (strcmp(op_type, "tvm_op")) {
+        fprintf(stderr, "Can only take tvm_op as op, but \"%s\" is found.\n", op_type);
         status = -1;
         break;
       }
 #if TVM_CRT_DEBUG
-      printf("tvm_op: creating %s with node_id=%d\n", inode->param.func_name, nid);
+      printf("tvm_op: creating %s with node_id=%d\n", param->func_name, nid);
 #endif  // TVM_CRT_DEBUG
       TVMPackedFunc pf;
-      TVMGraphExecutor_CreateTVMOp(executor, &(inode->param), args, args_count, &pf);
+      TVMGraphExecutor_CreateTVMOp(executor, param, args, args_count, &pf);
       executor->op_execs[nid] = pf;
     } else {
       memset(&executor->op_execs[nid], 0, sizeof(TVMPackedFunc));
@@ -1150,6 +1428,22 @@ int32_t TVMGraphExecutor_CreateTVMOp(TVMGraphExecutor* executor, const TVMOpPara
   return status;
 }
 
+// Set up storage and operators of a loaded graph.
+static int TVMGraphExecutor_Setup(TVMGraphExecutor* executor, TVMModuleHandle module_handle,
+                                  const DLDevice* devs) {
+  executor->module_handle = module_handle;
+  executor->devices[0] = devs[0];
+
+  int status;
+  status = TVMGraphExecutor_SetupStorage(executor);
+  if (status != 0) {
+    return status;
+  }
+  status = TVMGraphExecutor_SetupOpExecs(executor);
+
+  return status;
+}
+
 /*!
  * \brief Initialize the graph executor with graph and device.
  * \param graph_json The execution graph.
@@ -1172,17 +1466,27 @@ int TVMGraphExecutor_Init(TVMGraphExecutor* executor, const char* graph_json,
   if (err != kTvmErrorNoError) {
     return -1;
   }
-  executor->module_handle = module_handle;
-  executor->devices[0] = devs[0];
+  return TVMGraphExecutor_Setup(executor, module_handle, devs);
+}
 
-  int status;
-  status = TVMGraphExecutor_SetupStorage(executor);
+/*!
+ * \brief Initialize the graph executor with a binary graph and device.
+ * \param graph_binary The binary graph, referenced in place.
+ * \param graph_binary_size Size of graph_binary in bytes.
+ * \param module_handle The module containing the compiled functions for the host
+ * processor.
+ * \param devs The device of the host and devices where graph nodes will be
+ * executed on.
+ * \return 0 on success.
+ */
+int TVMGraphExecutor_InitFromBinary(TVMGraphExecutor* executor, const void* graph_binary,
+                                    size_t graph_binary_size, TVMModuleHandle module_handle,
+                                    const DLDevice* devs) {
+  int status = TVMGraphExecutor_LoadBinary(executor, graph_binary, graph_binary_size);
   if (status != 0) {
     return status;
   }
-  status = TVMGraphExecutor_SetupOpExecs(executor);
-
-  return status;
+  return TVMGraphExecutor_Setup(executor, module_handle, devs);
 }
 
 int TVMGraphExecutor_Create(const char* sym_json, TVMModuleHandle module_handle,
@@ -1199,10 +1503,84 @@ int TVMGraphExecutor_Create(const char* sym_json, TVMModuleHandle module_handle,
   return TVMGraphExecutor_Init(*executor, sym_json, module_handle, devs);
 }
 
-int TVMGraphExecutor_Release(TVMGraphExecutor** pptr) {
+int TVMGraphExecutor_CreateFromBinary(const void* graph_binary, size_t graph_binary_size,
+                                      TVMModuleHandle module_handle, const DLDevice* devs,
+                                      TVMGraphExecutor** executor) {
+  DLDevice dev = {kDLCPU, 0};
+  tvm_crt_error_t err = TVMPlatformMemoryAllocate(sizeof(TVMGraphExecutor), dev, (void**)executor);
+  if (err != kTvmErrorNoError) {
+    fprintf(stderr, "memory allocate error: %08x", err);
+    return -1;
+  }
+
+  memset(*executor, 0, sizeof(TVMGraphExecutor));
+  return TVMGraphExecutor_InitFromBinary(*executor, graph_binary, graph_binary_size,
+                                         module_handle, devs);
+}
+
+int TVMGraphExecutor_GetArenaFootprint(const void* graph_binary, size_t graph_binary_size,
+                                       TVMGraphExecutorArenaFootprint* footprint) {
+  TVMGraphExecutor executor;
+  memset(&executor, 0, sizeof(executor));
+  int status = TVMGraphExecutor_LoadBinary(&executor, graph_binary, graph_binary_size);
+  if (status != 0) {
+    return status;
+  }
+  const TVMGraphBinaryHeader* header = executor.binary;
+  size_t storage_size = 0;
+  uint32_t idx;
+  for (idx = 0; idx < header->num_storage; ++idx) {
+    storage_size += TVM_GRAPH_EXECUTOR_ARENA_ALIGN(executor.binary_storage[idx].size);
+  }
+  footprint->executor =
+      TVM_GRAPH_EXECUTOR_ARENA_ALIGN(sizeof(TVMGraphExecutor)) +
+      TVM_GRAPH_EXECUTOR_ARENA_ALIGN(sizeof(TVMGraphExecutorStorageEntry) * header->num_storage) +
+      TVM_GRAPH_EXECUTOR_ARENA_ALIGN(sizeof(int64_t) * header->num_storage);
+  footprint->tensors =
+      TVM_GRAPH_EXECUTOR_ARENA_ALIGN(sizeof(TVMNDArray) * header->num_entries) +
+      TVM_GRAPH_EXECUTOR_ARENA_ALIGN(sizeof(int64_t) * TVM_CRT_MAX_NDIM * header->num_entries);
+  footprint->op_execs = TVM_GRAPH_EXECUTOR_ARENA_ALIGN(sizeof(TVMPackedFunc) * header->num_nodes);
+  footprint->storage = storage_size;
+  footprint->total = TVM_GRAPH_EXECUTOR_ARENA_SIZE(storage_size, header->num_storage,
+                                                   header->num_entries, header->num_nodes);
+  return 0;
+}
+
+int TVMGraphExecutor_CreateInArena(const void* graph_binary, size_t graph_binary_size,
+                                   TVMModuleHandle module_handle, const DLDevice* devs,
+                                   void* arena, size_t arena_size, TVMGraphExecutor** executor) {
+  TVMGraphExecutorArenaFootprint footprint;
+  int status = TVMGraphExecutor_GetArenaFootprint(graph_binary, graph_binary_size, &footprint);
+  if (status != 0) {
+    return status;
+  }
+  if (((uintptr_t)arena & (TVM_GRAPH_EXECUTOR_ARENA_ALIGNMENT - 1)) != 0) {
+    fprintf(stderr, "graph executor arena must be %d-byte aligned\n",
+            TVM_GRAPH_EXECUTOR_ARENA_ALIGNMENT);
+    return -1;
+  }
+  if (arena_size < footprint.total) {
+    fprintf(stderr, "graph executor arena has %lu bytes, but the graph needs %lu\n",
+            (unsigned long)arena_size, (unsigned long)footprint.total);
+    return -1;
+  }
+
+  *executor = (TVMGraphExecutor*)arena;
+  memset(*executor, 0, sizeof(TVMGraphExecutor));
+  (*executor)->arena = (uint8_t*)arena;
+  (*executor)->arena_size = arena_size;
+  (*executor)->arena_used = TVM_GRAPH_EXECUTOR_ARENA_ALIGN(sizeof(TVMGraphExecutor));
+  return TVMGraphExecutor_InitFromBinary(*executor, graph_binary, graph_binary_size,
+                                         module_handle, devs);
+}
+
+// Release the graph tables loaded from JSON. The tables of a binary graph are not owned.
+static int TVMGraphExecutor_ReleaseGraph(TVMGraphExecutor* executor) {
   int status = 0;
   int32_t idx;
-  TVMGraphExecutor* executor = (TVMGraphExecutor*)(*pptr);
+  if (executor->binary) {
+    return 0;
+  }
   for (idx = 0; idx < executor->nodes_count; ++idx) {
     status = TVMGraphExecutorNodeRelease(&(executor->nodes[idx]));
     if (status != 0) {
@@ -1218,6 +1596,30 @@ int TVMGraphExecutor_Release(TVMGraphExecutor** pptr) {
   if (status != 0) {
     return status;
   }
+  status = TVMPlatformMemoryFree(executor->input_nodes, dev);
+  if (status != 0) {
+    return status;
+  }
+  status = TVMPlatformMemoryFree(executor->node_row_ptr, dev);
+  if (status != 0) {
+    return status;
+  }
+  return TVMPlatformMemoryFree(executor->outputs, dev);
+}
+
+int TVMGraphExecutor_Release(TVMGraphExecutor** pptr) {
+  int status = 0;
+  int32_t idx;
+  TVMGraphExecutor* executor = (TVMGraphExecutor*)(*pptr);
+  DLDevice dev = {kDLCPU, 0};
+  if (executor->arena != NULL) {
+    // Everything lives in the caller's arena.
+    return 0;
+  }
+  status = TVMGraphExecutor_ReleaseGraph(executor);
+  if (status != 0) {
+    return status;
+  }
   for (idx = 0; idx < executor->storage_pool_count; ++idx) {
     if (executor->storage_pool[idx].is_linked_param == 0) {
       status = TVMNDArray_Release(&(executor->storage_pool[idx]).array);
@@ -1232,18 +1634,6 @@ int TVMGraphExecutor_Release(TVMGraphExecutor** pptr) {
       return status;
     }
   }
-  status = TVMPlatformMemoryFree(executor->input_nodes, dev);
-  if (status != 0) {
-    return status;
-  }
-  status = TVMPlatformMemoryFree(executor->node_row_ptr, dev);
-  if (status != 0) {
-    return status;
-  }
-  status = TVMPlatformMemoryFree(executor->outputs, dev);
-  if (status != 0) {
-    return status;
-  }
   status = TVMPlatformMemoryFree(executor->storage_pool, dev);
   if (status != 0) {
     return status;
@@ -0,0 +1,106 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/runtime/crt/include/tvm/runtime/crt/internal/graph_executor/graph_binary.h
+ * \brief Precompiled binary graph format, read in place by the graph executor.
+ *
+ * The format is produced on the host by tvm.micro.graph_binary from the graph JSON. It is a
+ * little-endian header followed by the sections below, in this order. Every section starts at a
+ * multiple of 8 bytes from the start of the blob, which must itself be 8-byte aligned:
+ *
+ *   nodes          TVMGraphBinaryNode[num_nodes]
+ *   input_nodes    uint32_t[num_input_nodes]
+ *   node_row_ptr   uint32_t[num_nodes + 1]
+ *   outputs        TVMGraphExecutorNodeEntry[num_outputs]
+ *   node_inputs    TVMGraphExecutorNodeEntry[num_node_inputs]
+ *   storage_id     uint32_t[num_entries]
+ *   ndim           uint32_t[num_entries]
+ *   dtype          DLDataType[num_entries]
+ *   shape          int64_t[num_entries * max_ndim]
+ *   storage        TVMGraphBinaryStorage[num_storage]
+ *   strings        char[strings_size], NUL terminated names
+ *
+ * The arrays have the in-memory layout the executor uses, so they are referenced, not copied.
+ */
+#ifndef TVM_RUNTIME_CRT_INCLUDE_TVM_RUNTIME_CRT_INTERNAL_GRAPH_EXECUTOR_GRAPH_BINARY_H_
+#define TVM_RUNTIME_CRT_INCLUDE_TVM_RUNTIME_CRT_INTERNAL_GRAPH_EXECUTOR_GRAPH_BINARY_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*! \brief Magic number at the start of a binary graph, "TVMGRAPH" read as a little-endian word. */
+static const uint64_t kTVMGraphBinaryMagic = 0x48504152474D5654;
+
+/*! \brief The version of the binary graph format described in this file. */
+static const uint32_t kTVMGraphBinaryVersion = 1;
+
+/*! \brief Header of a binary graph. */
+typedef struct TVMGraphBinaryHeader {
+  uint64_t magic;
+  uint32_t version;
+  /*! \brief The stride of the shape section, must match TVM_CRT_MAX_NDIM. */
+  uint32_t max_ndim;
+  uint32_t num_nodes;
+  uint32_t num_input_nodes;
+  uint32_t num_outputs;
+  uint32_t num_node_inputs;
+  /*! \brief The number of node entries, node_row_ptr[num_nodes]. */
+  uint32_t num_entries;
+  uint32_t num_storage;
+  uint32_t strings_size;
+  uint32_t reserved;
+} TVMGraphBinaryHeader;
+
+/*! \brief Operator type of a binary graph node. */
+typedef enum {
+  kTVMGraphBinaryOpNull = 0,
+  kTVMGraphBinaryOpTVMOp = 1,
+} TVMGraphBinaryOpType;
+
+/*! \brief A graph node. Names are offsets into the strings section. */
+typedef struct TVMGraphBinaryNode {
+  uint32_t op_type;
+  uint32_t name;
+  uint32_t func_name;
+  uint32_t num_inputs;
+  uint32_t num_outputs;
+  uint32_t flatten_data;
+  /*! \brief Index of the first input of the node in the node_inputs section. */
+  uint32_t inputs_begin;
+  uint32_t inputs_count;
+} TVMGraphBinaryNode;
+
+/*! \brief A storage pool entry of the memory plan. */
+typedef struct TVMGraphBinaryStorage {
+  /*! \brief Size in bytes, the largest of the entries sharing the storage. */
+  uint64_t size;
+  /*! \brief A node entry placed in this storage, giving the shape of linked parameters. */
+  uint32_t entry_id;
+  int32_t device_type;
+} TVMGraphBinaryStorage;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // TVM_RUNTIME_CRT_INCLUDE_TVM_RUNTIME_CRT_INTERNAL_GRAPH_EXECUTOR_GRAPH_BINARY_H_
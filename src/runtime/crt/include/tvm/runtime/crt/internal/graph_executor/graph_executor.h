@@ -30,6 +30,7 @@ extern "C" {
 
 #include <tvm/runtime/crt/graph_executor.h>
 #include <tvm/runtime/crt/internal/common/ndarray.h>
+#include <tvm/runtime/crt/internal/graph_executor/graph_binary.h>
 #include <tvm/runtime/crt/internal/graph_executor/load_json.h>
 #include <tvm/runtime/crt/module.h>
 
@@ -40,13 +41,11 @@ typedef struct TVMGraphExecutorPoolEntry {
   int entry_id;
 } TVMGraphExecutorPoolEntry;
 
-// Node entry
+// Node entry. Binary graphs store entries with this layout, see graph_binary.h.
 typedef struct TVMGraphExecutorNodeEntry {
   uint32_t node_id;
   uint32_t index;
   uint32_t version;
-  // JSON Loader
-  void (*Load)(JSONReader* reader);
 } TVMGraphExecutorNodeEntry;
 
 // Storage entry.
@@ -106,8 +105,43 @@ typedef struct TVMGraphExecutor {
   /*! \brief Operator on each node. */
   TVMPackedFunc* op_execs;
   uint32_t op_execs_count;
+  /*!
+   * \brief The binary graph the executor was loaded from, NULL for a JSON graph. The graph
+   *  tables of a binary graph point into the blob and are not owned by the executor.
+   */
+  const TVMGraphBinaryHeader* binary;
+  const TVMGraphBinaryNode* binary_nodes;
+  const TVMGraphExecutorNodeEntry* binary_node_inputs;
+  const DLDataType* binary_dtypes;
+  const TVMGraphBinaryStorage* binary_storage;
+  const char* binary_strings;
+  /*!
+   * \brief The arena the executor was created in, NULL if it uses TVMPlatformMemoryAllocate.
+   *  Allocations are taken from the front of the arena and never freed.
+   */
+  uint8_t* arena;
+  size_t arena_size;
+  size_t arena_used;
 } TVMGraphExecutor;
 
+#define TVM_GRAPH_EXECUTOR_ARENA_ALIGN(size)                   \
+  (((size_t)(size) + TVM_GRAPH_EXECUTOR_ARENA_ALIGNMENT - 1) & \
+   ~((size_t)TVM_GRAPH_EXECUTOR_ARENA_ALIGNMENT - 1))
+
+/*!
+ * \brief Size of the arena needed by a binary graph, usable to size a static buffer.
+ *
+ *  The arguments are emitted as defines by tvm.micro.graph_binary.emit_c_array. storage_size is
+ *  the sum of the storage sizes, each rounded up to TVM_GRAPH_EXECUTOR_ARENA_ALIGNMENT.
+ */
+#define TVM_GRAPH_EXECUTOR_ARENA_SIZE(storage_size, num_storage, num_entries, num_nodes)       \
+  (TVM_GRAPH_EXECUTOR_ARENA_ALIGN(sizeof(TVMGraphExecutor)) +                                \
+   TVM_GRAPH_EXECUTOR_ARENA_ALIGN(sizeof(TVMGraphExecutorStorageEntry) * (num_storage)) +    \
+   TVM_GRAPH_EXECUTOR_ARENA_ALIGN(sizeof(int64_t) * (num_storage)) +                         \
+   TVM_GRAPH_EXECUTOR_ARENA_ALIGN(sizeof(TVMNDArray) * (num_entries)) +                      \
+   TVM_GRAPH_EXECUTOR_ARENA_ALIGN(sizeof(int64_t) * TVM_CRT_MAX_NDIM * (num_entries)) +      \
+   TVM_GRAPH_EXECUTOR_ARENA_ALIGN(sizeof(TVMPackedFunc) * (num_nodes)) + (storage_size))
+
 typedef DLTensor* DLTensorPtr;
 
 // private functions
@@ -122,6 +156,9 @@ int32_t TVMGraphExecutor_CreateTVMOp(TVMGraphExecutor* executor, const TVMOpPara
                                      DLTensorPtr* args, const uint32_t args_count,
                                      TVMPackedFunc* pf);
 int TVMGraphExecutor_Load(TVMGraphExecutor* executor, JSONReader* reader);
+int TVMGraphExecutor_LoadBinary(TVMGraphExecutor* executor, const void* graph_binary,
+                                size_t graph_binary_size);
+const char* TVMGraphExecutor_GetNodeName(TVMGraphExecutor* executor, uint32_t nid);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,111 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file runtime/crt/include/tvm/runtime/crt/internal/memory/tlsf_allocator.h
+ * \brief Defines data types used in the TLSF memory manager.
+ *     Exposed for testing.
+ */
+
+#ifndef TVM_RUNTIME_CRT_INCLUDE_TVM_RUNTIME_CRT_INTERNAL_MEMORY_TLSF_ALLOCATOR_H_
+#define TVM_RUNTIME_CRT_INCLUDE_TVM_RUNTIME_CRT_INTERNAL_MEMORY_TLSF_ALLOCATOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <tvm/runtime/crt/tlsf_allocator.h>
+
+#include "crt_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \brief log2 of the alignment of every allocation. */
+#ifndef TVM_CRT_TLSF_ALIGNMENT_BYTES_LOG2
+#define TVM_CRT_TLSF_ALIGNMENT_BYTES_LOG2 4
+#endif
+
+#define TLSF_ALIGNMENT_BYTES (1 << TVM_CRT_TLSF_ALIGNMENT_BYTES_LOG2)
+
+/*! \brief log2 of the number of second-level size classes per power of two. */
+#define TLSF_SL_COUNT_LOG2 4
+#define TLSF_SL_COUNT (1 << TLSF_SL_COUNT_LOG2)
+
+/*! \brief Blocks below this size are all in first-level class 0, one class per alignment step. */
+#define TLSF_FL_SHIFT (TLSF_SL_COUNT_LOG2 + TVM_CRT_TLSF_ALIGNMENT_BYTES_LOG2)
+#define TLSF_SMALL_BLOCK_BYTES (1 << TLSF_FL_SHIFT)
+
+/*! \brief log2 of the largest block, which bounds the size of the pool that can be used. */
+#define TLSF_FL_INDEX_MAX 30
+#define TLSF_FL_COUNT (TLSF_FL_INDEX_MAX - TLSF_FL_SHIFT + 2)
+
+/*! \brief Flags kept in the low bits of TLSFBlock::size. */
+#define TLSF_BLOCK_FREE ((size_t)1)
+#define TLSF_BLOCK_PREV_FREE ((size_t)2)
+
+/*!
+ * \brief A block of the pool. The payload of a block starts TLSF_BLOCK_HEADER_BYTES after it and
+ *  the next block in memory starts right after the payload.
+ */
+typedef struct TLSFBlock {
+  /*! \brief The previous block in memory, valid only when that block is free. */
+  struct TLSFBlock* prev_phys;
+  /*! \brief Payload size in bytes, a multiple of the alignment, ORed with the flags. */
+  size_t size;
+  /*! \brief Links of the free list of the size class, stored in the payload of free blocks. */
+  struct TLSFBlock* next_free;
+  struct TLSFBlock* prev_free;
+} TLSFBlock;
+
+#define TLSF_ALIGN_UP(x) \
+  (((size_t)(x) + TLSF_ALIGNMENT_BYTES - 1) & ~((size_t)TLSF_ALIGNMENT_BYTES - 1))
+
+/*! \brief Bytes between a block and its payload. */
+#define TLSF_BLOCK_HEADER_BYTES TLSF_ALIGN_UP(offsetof(TLSFBlock, next_free))
+
+/*! \brief Smallest payload, large enough to hold the free list links. */
+#define TLSF_MIN_BLOCK_BYTES TLSF_ALIGN_UP(sizeof(TLSFBlock) - offsetof(TLSFBlock, next_free))
+
+/*! \brief Largest payload. */
+#define TLSF_MAX_BLOCK_BYTES (((size_t)1 << (TLSF_FL_INDEX_MAX + 1)) - TLSF_ALIGNMENT_BYTES)
+
+typedef struct TLSFMemoryManager {
+  // Public interface for this object.
+  MemoryManagerInterface interface;
+  // Bit i is set when first-level class i has a non-empty second-level class.
+  uint32_t fl_bitmap;
+  // Bit j of sl_bitmap[i] is set when free_lists[i][j] is not empty.
+  uint32_t sl_bitmap[TLSF_FL_COUNT];
+  // Heads of the free lists of each size class.
+  TLSFBlock* free_lists[TLSF_FL_COUNT][TLSF_SL_COUNT];
+  // Blocks are between pool_begin and pool_end, the zero-sized block ending the pool.
+  uint8_t* pool_begin;
+  TLSFBlock* pool_end;
+  // Payload bytes of the allocated blocks, and the largest value it reached.
+  size_t used_bytes;
+  size_t peak_used_bytes;
+  // The largest offset from pool_begin reached by an allocated block.
+  size_t high_water_bytes;
+} TLSFMemoryManager;
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // TVM_RUNTIME_CRT_INCLUDE_TVM_RUNTIME_CRT_INTERNAL_MEMORY_TLSF_ALLOCATOR_H_
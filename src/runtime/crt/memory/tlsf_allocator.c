@@ -0,0 +1,276 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+// LINT_C_FILE
+
+/*!
+ * \file tlsf_allocator.c
+ * \brief Two-level segregated fit memory manager
+ *
+ * To maximize portability, thread-safe feature has been dropped for now.
+ */
+
+#include <string.h>
+#include <tvm/runtime/c_runtime_api.h>
+#include <tvm/runtime/crt/error_codes.h>
+#include <tvm/runtime/crt/internal/memory/tlsf_allocator.h>
+#include <tvm/runtime/crt/logging.h>
+
+// Index of the most significant bit set in x, which is not 0.
+static int TLSF_Fls(size_t x) {
+#if defined(__GNUC__)
+  return (int)(sizeof(unsigned long long) * 8 - 1) - __builtin_clzll((unsigned long long)x);
+#else
+  int bit = -1;
+  while (x != 0) {
+    x >>= 1;
+    bit++;
+  }
+  return bit;
+#endif
+}
+
+// Index of the least significant bit set in x, which is not 0.
+static int TLSF_Ffs(uint32_t x) {
+#if defined(__GNUC__)
+  return __builtin_ctz(x);
+#else
+  int bit = 0;
+  while ((x & 1) == 0) {
+    x >>= 1;
+    bit++;
+  }
+  return bit;
+#endif
+}
+
+static size_t TLSFBlock_Size(const TLSFBlock* block) {
+  return block->size & ~(TLSF_BLOCK_FREE | TLSF_BLOCK_PREV_FREE);
+}
+
+static uint8_t* TLSFBlock_Payload(TLSFBlock* block) {
+  return (uint8_t*)block + TLSF_BLOCK_HEADER_BYTES;
+}
+
+static TLSFBlock* TLSFBlock_FromPayload(void* ptr) {
+  return (TLSFBlock*)((uint8_t*)ptr - TLSF_BLOCK_HEADER_BYTES);
+}
+
+static TLSFBlock* TLSFBlock_Next(TLSFBlock* block) {
+  return (TLSFBlock*)(TLSFBlock_Payload(block) + TLSFBlock_Size(block));
+}
+
+// Size class holding blocks of size bytes.
+static void TLSF_MappingInsert(size_t size, int* fl, int* sl) {
+  if (size < TLSF_SMALL_BLOCK_BYTES) {
+    *fl = 0;
+    *sl = (int)(size >> TVM_CRT_TLSF_ALIGNMENT_BYTES_LOG2);
+  } else {
+    int bit = TLSF_Fls(size);
+    *sl = (int)(size >> (bit - TLSF_SL_COUNT_LOG2)) ^ TLSF_SL_COUNT;
+    *fl = bit - (TLSF_FL_SHIFT - 1);
+  }
+}
+
+// First size class whose blocks are all at least size bytes.
+static void TLSF_MappingSearch(size_t size, int* fl, int* sl) {
+  if (size >= TLSF_SMALL_BLOCK_BYTES) {
+    size += ((size_t)1 << (TLSF_Fls(size) - TLSF_SL_COUNT_LOG2)) - 1;
+  }
+  TLSF_MappingInsert(size, fl, sl);
+}
+
+static void TLSF_InsertFree(TLSFMemoryManager* mgr, TLSFBlock* block) {
+  int fl, sl;
+  TLSF_MappingInsert(TLSFBlock_Size(block), &fl, &sl);
+  TLSFBlock* head = mgr->free_lists[fl][sl];
+  block->next_free = head;
+  block->prev_free = NULL;
+  if (head != NULL) {
+    head->prev_free = block;
+  }
+  mgr->free_lists[fl][sl] = block;
+  mgr->fl_bitmap |= 1U << fl;
+  mgr->sl_bitmap[fl] |= 1U << sl;
+}
+
+static void TLSF_RemoveFree(TLSFMemoryManager* mgr, TLSFBlock* block) {
+  int fl, sl;
+  TLSF_MappingInsert(TLSFBlock_Size(block), &fl, &sl);
+  if (block->prev_free != NULL) {
+    block->prev_free->next_free = block->next_free;
+  } else {
+    mgr->free_lists[fl][sl] = block->next_free;
+    if (block->next_free == NULL) {
+      mgr->sl_bitmap[fl] &= ~(1U << sl);
+      if (mgr->sl_bitmap[fl] == 0) {
+        mgr->fl_bitmap &= ~(1U << fl);
+      }
+    }
+  }
+  if (block->next_free != NULL) {
+    block->next_free->prev_free = block->prev_free;
+  }
+}
+
+// Find a free block of at least size bytes, NULL if there is none.
+static TLSFBlock* TLSF_FindFree(TLSFMemoryManager* mgr, size_t size) {
+  int fl, sl;
+  TLSF_MappingSearch(size, &fl, &sl);
+  if (fl >= TLSF_FL_COUNT) {
+    return NULL;
+  }
+  uint32_t sl_map = mgr->sl_bitmap[fl] & (~0U << sl);
+  if (sl_map == 0) {
+    // Take the smallest class of a larger first level.
+    uint32_t fl_map = fl + 1 < 32 ? mgr->fl_bitmap & (~0U << (fl + 1)) : 0;
+    if (fl_map == 0) {
+      return NULL;
+    }
+    fl = TLSF_Ffs(fl_map);
+    sl_map = mgr->sl_bitmap[fl];
+  }
+  return mgr->free_lists[fl][TLSF_Ffs(sl_map)];
+}
+
+/*!
+ * \brief Allocate memory from manager
+ * \param interface Pointer to this structure.
+ * \param num_bytes The size of memory
+ * \param dev Execution device. Fixed to {kDLCPU, 0}.
+ * \param out_ptr Receives the allocated memory, aligned to TLSF_ALIGNMENT_BYTES.
+ * \return kTvmErrorNoError if successful; a descriptive error code otherwise.
+ */
+tvm_crt_error_t TLSFMemoryManager_Allocate(MemoryManagerInterface* interface, size_t num_bytes,
+                                           DLDevice dev, void** out_ptr) {
+  TLSFMemoryManager* mgr = (TLSFMemoryManager*)interface;
+  *out_ptr = 0;
+  if (num_bytes > TLSF_MAX_BLOCK_BYTES) {
+    return kTvmErrorPlatformNoMemory;
+  }
+  size_t size = TLSF_ALIGN_UP(num_bytes);
+  if (size < TLSF_MIN_BLOCK_BYTES) {
+    size = TLSF_MIN_BLOCK_BYTES;
+  }
+
+  TLSFBlock* block = TLSF_FindFree(mgr, size);
+  if (block == NULL) {
+#if TVM_CRT_DEBUG > 1
+    TVMLogf("insufficient memory, requested=%zu, used=%zu", num_bytes, mgr->used_bytes);
+#endif
+    return kTvmErrorPlatformNoMemory;
+  }
+  TLSF_RemoveFree(mgr, block);
+
+  size_t block_size = TLSFBlock_Size(block);
+  TLSFBlock* next = TLSFBlock_Next(block);
+  if (block_size >= size + TLSF_BLOCK_HEADER_BYTES + TLSF_MIN_BLOCK_BYTES) {
+    // Split off the tail as a free block.
+    TLSFBlock* rest = (TLSFBlock*)(TLSFBlock_Payload(block) + size);
+    rest->size = (block_size - size - TLSF_BLOCK_HEADER_BYTES) | TLSF_BLOCK_FREE;
+    next->prev_phys = rest;
+    TLSF_InsertFree(mgr, rest);
+    block->size = size | (block->size & TLSF_BLOCK_PREV_FREE);
+  } else {
+    block->size &= ~TLSF_BLOCK_FREE;
+    next->size &= ~TLSF_BLOCK_PREV_FREE;
+  }
+
+  *out_ptr = TLSFBlock_Payload(block);
+  mgr->used_bytes += TLSFBlock_Size(block);
+  if (mgr->used_bytes > mgr->peak_used_bytes) {
+    mgr->peak_used_bytes = mgr->used_bytes;
+  }
+  size_t end = (size_t)((uint8_t*)TLSFBlock_Next(block) - mgr->pool_begin);
+  if (end > mgr->high_water_bytes) {
+    mgr->high_water_bytes = end;
+  }
+  mgr->interface.vleak_size++;
+  return kTvmErrorNoError;
+}
+
+/*!
+ * \brief Free the memory.
+ * \param interface Pointer to this structure.
+ * \param ptr A pointer returned from TVMPlatformMemoryAllocate which should be free'd.
+ * \param dev Execution device passed to TVMPlatformMemoryAllocate. Fixed to {kDLCPU, 0}.
+ * \return kTvmErrorNoError if successful; a descriptive error code otherwise.
+ */
+tvm_crt_error_t TLSFMemoryManager_Free(MemoryManagerInterface* interface, void* ptr, DLDevice dev) {
+  TLSFMemoryManager* mgr = (TLSFMemoryManager*)interface;
+  TLSFBlock* block = TLSFBlock_FromPayload(ptr);
+  CHECK_GE((uint8_t*)block, mgr->pool_begin, "pointer %p is not in the memory pool.", ptr);
+  CHECK_LT(block, mgr->pool_end, "pointer %p is not in the memory pool.", ptr);
+  CHECK_EQ((block->size & TLSF_BLOCK_FREE), 0, "pointer %p is already free.", ptr);
+  mgr->used_bytes -= TLSFBlock_Size(block);
+  mgr->interface.vleak_size--;
+
+  // Merge with the free neighbors.
+  if (block->size & TLSF_BLOCK_PREV_FREE) {
+    TLSFBlock* prev = block->prev_phys;
+    TLSF_RemoveFree(mgr, prev);
+    prev->size += TLSF_BLOCK_HEADER_BYTES + TLSFBlock_Size(block);
+    block = prev;
+  }
+  TLSFBlock* next = TLSFBlock_Next(block);
+  if (next->size & TLSF_BLOCK_FREE) {
+    TLSF_RemoveFree(mgr, next);
+    block->size += TLSF_BLOCK_HEADER_BYTES + TLSFBlock_Size(next);
+    next = TLSFBlock_Next(block);
+  }
+  block->size |= TLSF_BLOCK_FREE;
+  next->prev_phys = block;
+  next->size |= TLSF_BLOCK_PREV_FREE;
+  TLSF_InsertFree(mgr, block);
+  return kTvmErrorNoError;
+}
+
+tvm_crt_error_t TLSFMemoryManagerCreate(MemoryManagerInterface** interface, uint8_t* memory_pool,
+                                        size_t memory_pool_size_bytes) {
+  uint8_t* pool_end = memory_pool + memory_pool_size_bytes;
+  uint8_t* cursor = (uint8_t*)TLSF_ALIGN_UP((uintptr_t)memory_pool);
+  TLSFMemoryManager* mgr = (TLSFMemoryManager*)cursor;
+  cursor += TLSF_ALIGN_UP(sizeof(TLSFMemoryManager));
+  if (cursor + 2 * TLSF_BLOCK_HEADER_BYTES + TLSF_MIN_BLOCK_BYTES > pool_end) {
+    return kTvmErrorPlatformNoMemory;
+  }
+
+  memset(mgr, 0, sizeof(TLSFMemoryManager));
+  mgr->interface.Allocate = TLSFMemoryManager_Allocate;
+  mgr->interface.Free = TLSFMemoryManager_Free;
+  mgr->pool_begin = cursor;
+
+  // One free block spans the pool, followed by a zero-sized allocated block so that merging stops
+  // at the end of the pool.
+  size_t size = (size_t)(pool_end - cursor) - 2 * TLSF_BLOCK_HEADER_BYTES;
+  size &= ~((size_t)TLSF_ALIGNMENT_BYTES - 1);
+  if (size > TLSF_MAX_BLOCK_BYTES) {
+    size = TLSF_MAX_BLOCK_BYTES;
+  }
+  TLSFBlock* block = (TLSFBlock*)cursor;
+  block->prev_phys = NULL;
+  block->size = size | TLSF_BLOCK_FREE;
+  mgr->pool_end = TLSFBlock_Next(block);
+  mgr->pool_end->prev_phys = block;
+  mgr->pool_end->size = TLSF_BLOCK_PREV_FREE;
+  TLSF_InsertFree(mgr, block);
+
+  *interface = &mgr->interface;
+  return kTvmErrorNoError;
+}
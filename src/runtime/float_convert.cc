@@ -0,0 +1,275 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file float_convert.cc
+ * \brief Bulk conversion between float32 and the 16-bit floating point types.
+ *
+ *  The conversions use F16C and AVX-512 BF16 on x86 and NEON on AArch64 when they are
+ *  available on the host, and fall back to portable code otherwise.
+ */
+#include "float_convert.h"
+
+#include <builtin_fp16.h>
+#include <tvm/runtime/logging.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/registry.h>
+
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#include <immintrin.h>
+#define TVM_FLOAT_CONVERT_X86 1
+#if (defined(__clang__) && __clang_major__ >= 9) || (!defined(__clang__) && __GNUC__ >= 10)
+#define TVM_FLOAT_CONVERT_AVX512BF16 1
+#endif
+#endif
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace tvm {
+namespace runtime {
+namespace {
+
+inline uint16_t Float32ToBFloat16(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  // Keep NaN a quiet NaN instead of letting the rounding carry turn it into infinity.
+  if ((bits & 0x7FFFFFFFu) > 0x7F800000u) return static_cast<uint16_t>((bits >> 16) | 0x40u);
+  uint32_t rounding_bias = ((bits >> 16) & 1) + 0x7FFFu;
+  return static_cast<uint16_t>((bits + rounding_bias) >> 16);
+}
+
+inline float BFloat16ToFloat32(uint16_t value) {
+  uint32_t bits = static_cast<uint32_t>(value) << 16;
+  float ret;
+  std::memcpy(&ret, &bits, sizeof(ret));
+  return ret;
+}
+
+void F32ToF16Portable(const float* src, uint16_t* dst, int64_t n) {
+  for (int64_t i = 0; i < n; ++i) {
+    dst[i] = __truncXfYf2__<float, uint32_t, 23, uint16_t, uint16_t, 10>(src[i]);
+  }
+}
+
+void F16ToF32Portable(const uint16_t* src, float* dst, int64_t n) {
+  for (int64_t i = 0; i < n; ++i) {
+    dst[i] = __extendXfYf2__<uint16_t, uint16_t, 10, float, uint32_t, 23>(src[i]);
+  }
+}
+
+void F32ToBF16Portable(const float* src, uint16_t* dst, int64_t n) {
+  for (int64_t i = 0; i < n; ++i) dst[i] = Float32ToBFloat16(src[i]);
+}
+
+void BF16ToF32Portable(const uint16_t* src, float* dst, int64_t n) {
+  for (int64_t i = 0; i < n; ++i) dst[i] = BFloat16ToFloat32(src[i]);
+}
+
+#ifdef TVM_FLOAT_CONVERT_X86
+__attribute__((target("avx,f16c"))) void F32ToF16F16C(const float* src, uint16_t* dst,
+                                                       int64_t n) {
+  int64_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), half);
+  }
+  F32ToF16Portable(src + i, dst + i, n - i);
+}
+
+__attribute__((target("avx,f16c"))) void F16ToF32F16C(const uint16_t* src, float* dst,
+                                                       int64_t n) {
+  int64_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i half = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(half));
+  }
+  F16ToF32Portable(src + i, dst + i, n - i);
+}
+
+// SSE2 is part of x86-64, widening bfloat16 is a shift into the upper half of each lane.
+void BF16ToF32SSE2(const uint16_t* src, float* dst, int64_t n) {
+  int64_t i = 0;
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 8 <= n; i += 8) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_unpacklo_epi16(zero, v));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 4), _mm_unpackhi_epi16(zero, v));
+  }
+  BF16ToF32Portable(src + i, dst + i, n - i);
+}
+
+#ifdef TVM_FLOAT_CONVERT_AVX512BF16
+__attribute__((target("avx512f,avx512bf16"))) void F32ToBF16AVX512(const float* src,
+                                                                    uint16_t* dst, int64_t n) {
+  const __m512i exponent = _mm512_set1_epi32(0x7F800000);
+  const __m512i mantissa = _mm512_set1_epi32(0x007FFFFF);
+  int64_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m512 v = _mm512_loadu_ps(src + i);
+    // vcvtneps2bf16 flushes denormals to zero, round those as the portable code does.
+    __m512i bits = _mm512_castps_si512(v);
+    if (_mm512_testn_epi32_mask(bits, exponent) & _mm512_test_epi32_mask(bits, mantissa)) {
+      F32ToBF16Portable(src + i, dst + i, 16);
+      continue;
+    }
+    __m256bh bf16 = _mm512_cvtneps_pbh(v);
+    std::memcpy(dst + i, &bf16, sizeof(bf16));
+  }
+  F32ToBF16Portable(src + i, dst + i, n - i);
+}
+#endif
+
+bool HasF16C() {
+  unsigned eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return false;
+  return (ecx & bit_F16C) != 0 && __builtin_cpu_supports("avx");
+}
+
+bool HasAVX512BF16() {
+  unsigned eax, ebx, ecx, edx;
+  if (!__get_cpuid_count(7, 1, &eax, &ebx, &ecx, &edx)) return false;
+  return (eax & (1u << 5)) != 0 && __builtin_cpu_supports("avx512f");
+}
+#endif  // TVM_FLOAT_CONVERT_X86
+
+#if defined(__aarch64__)
+void F32ToF16NEON(const float* src, uint16_t* dst, int64_t n) {
+  int64_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    vst1_u16(dst + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i))));
+  }
+  F32ToF16Portable(src + i, dst + i, n - i);
+}
+
+void F16ToF32NEON(const uint16_t* src, float* dst, int64_t n) {
+  int64_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src + i))));
+  }
+  F16ToF32Portable(src + i, dst + i, n - i);
+}
+
+void BF16ToF32NEON(const uint16_t* src, float* dst, int64_t n) {
+  int64_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    vst1q_u32(reinterpret_cast<uint32_t*>(dst + i), vshll_n_u16(vld1_u16(src + i), 16));
+  }
+  BF16ToF32Portable(src + i, dst + i, n - i);
+}
+#endif  // __aarch64__
+
+/*! \brief The conversion kernels selected for the host CPU. */
+struct ConvertKernels {
+  void (*f32_to_f16)(const float*, uint16_t*, int64_t) = F32ToF16Portable;
+  void (*f16_to_f32)(const uint16_t*, float*, int64_t) = F16ToF32Portable;
+  void (*f32_to_bf16)(const float*, uint16_t*, int64_t) = F32ToBF16Portable;
+  void (*bf16_to_f32)(const uint16_t*, float*, int64_t) = BF16ToF32Portable;
+
+  ConvertKernels() {
+#ifdef TVM_FLOAT_CONVERT_X86
+    if (HasF16C()) {
+      f32_to_f16 = F32ToF16F16C;
+      f16_to_f32 = F16ToF32F16C;
+    }
+#ifdef TVM_FLOAT_CONVERT_AVX512BF16
+    if (HasAVX512BF16()) f32_to_bf16 = F32ToBF16AVX512;
+#endif
+    bf16_to_f32 = BF16ToF32SSE2;
+#endif
+#if defined(__aarch64__)
+    f32_to_f16 = F32ToF16NEON;
+    f16_to_f32 = F16ToF32NEON;
+    bf16_to_f32 = BF16ToF32NEON;
+#endif
+  }
+
+  static const ConvertKernels& Global() {
+    static ConvertKernels inst;
+    return inst;
+  }
+};
+
+inline bool IsFloat32(DLDataType t) { return t.code == kDLFloat && t.bits == 32 && t.lanes == 1; }
+inline bool IsFloat16(DLDataType t) { return t.code == kDLFloat && t.bits == 16 && t.lanes == 1; }
+inline bool IsBFloat16(DLDataType t) { return t.code == kDLBfloat && t.bits == 16 && t.lanes == 1; }
+
+}  // namespace
+
+void ConvertFloat32ToFloat16(const float* src, uint16_t* dst, int64_t n) {
+  ConvertKernels::Global().f32_to_f16(src, dst, n);
+}
+
+void ConvertFloat16ToFloat32(const uint16_t* src, float* dst, int64_t n) {
+  ConvertKernels::Global().f16_to_f32(src, dst, n);
+}
+
+void ConvertFloat32ToBFloat16(const float* src, uint16_t* dst, int64_t n) {
+  ConvertKernels::Global().f32_to_bf16(src, dst, n);
+}
+
+void ConvertBFloat16ToFloat32(const uint16_t* src, float* dst, int64_t n) {
+  ConvertKernels::Global().bf16_to_f32(src, dst, n);
+}
+
+bool IsDTypeConversionSupported(DLDataType from, DLDataType to) {
+  return (IsFloat32(from) && (IsFloat16(to) || IsBFloat16(to))) ||
+         (IsFloat32(to) && (IsFloat16(from) || IsBFloat16(from)));
+}
+
+void ConvertDType(const DLTensor* from, DLTensor* to) {
+  ICHECK(IsDTypeConversionSupported(from->dtype, to->dtype))
+      << "Cannot convert from " << DLDataType2String(from->dtype) << " to "
+      << DLDataType2String(to->dtype);
+  ICHECK(from->device.device_type == kDLCPU && to->device.device_type == kDLCPU)
+      << "Data type conversion is only supported between arrays on CPU";
+  ICHECK(IsContiguous(*from) && IsContiguous(*to))
+      << "Data type conversion is only supported between contiguous arrays";
+  ICHECK_EQ(from->ndim, to->ndim) << "Data type conversion requires arrays of the same shape";
+  int64_t n = 1;
+  for (int i = 0; i < from->ndim; ++i) {
+    ICHECK_EQ(from->shape[i], to->shape[i])
+        << "Data type conversion requires arrays of the same shape";
+    n *= from->shape[i];
+  }
+  const void* src = static_cast<const char*>(from->data) + from->byte_offset;
+  void* dst = static_cast<char*>(to->data) + to->byte_offset;
+  if (IsFloat32(from->dtype)) {
+    if (IsFloat16(to->dtype)) {
+      ConvertFloat32ToFloat16(static_cast<const float*>(src), static_cast<uint16_t*>(dst), n);
+    } else {
+      ConvertFloat32ToBFloat16(static_cast<const float*>(src), static_cast<uint16_t*>(dst), n);
+    }
+  } else if (IsFloat16(from->dtype)) {
+    ConvertFloat16ToFloat32(static_cast<const uint16_t*>(src), static_cast<float*>(dst), n);
+  } else {
+    ConvertBFloat16ToFloat32(static_cast<const uint16_t*>(src), static_cast<float*>(dst), n);
+  }
+}
+
+TVM_REGISTER_GLOBAL("runtime.NDArrayConvertDType").set_body_typed([](NDArray from, NDArray to) {
+  to.CopyFromConverted(from);
+});
+
+}  // namespace runtime
+}  // namespace tvm
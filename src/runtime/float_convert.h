@@ -0,0 +1,83 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file float_convert.h
+ * \brief Bulk conversion between float32 and the 16-bit floating point types.
+ */
+#ifndef TVM_RUNTIME_FLOAT_CONVERT_H_
+#define TVM_RUNTIME_FLOAT_CONVERT_H_
+
+#include <tvm/runtime/c_runtime_api.h>
+
+#include <cstdint>
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief Convert float32 values to IEEE float16, rounding to nearest even.
+ * \param src The source values.
+ * \param dst The destination buffer.
+ * \param n The number of values.
+ */
+TVM_DLL void ConvertFloat32ToFloat16(const float* src, uint16_t* dst, int64_t n);
+
+/*!
+ * \brief Convert IEEE float16 values to float32.
+ * \param src The source values.
+ * \param dst The destination buffer.
+ * \param n The number of values.
+ */
+TVM_DLL void ConvertFloat16ToFloat32(const uint16_t* src, float* dst, int64_t n);
+
+/*!
+ * \brief Convert float32 values to bfloat16, rounding to nearest even.
+ * \param src The source values.
+ * \param dst The destination buffer.
+ * \param n The number of values.
+ */
+TVM_DLL void ConvertFloat32ToBFloat16(const float* src, uint16_t* dst, int64_t n);
+
+/*!
+ * \brief Convert bfloat16 values to float32.
+ * \param src The source values.
+ * \param dst The destination buffer.
+ * \param n The number of values.
+ */
+TVM_DLL void ConvertBFloat16ToFloat32(const uint16_t* src, float* dst, int64_t n);
+
+/*!
+ * \brief Whether ConvertDType supports converting elements of one data type to another.
+ * \param from The source data type.
+ * \param to The destination data type.
+ * \return true if float32 is converted from or to float16 or bfloat16.
+ */
+TVM_DLL bool IsDTypeConversionSupported(DLDataType from, DLDataType to);
+
+/*!
+ * \brief Convert the elements of a tensor into another tensor of a different data type.
+ * \param from The source tensor on CPU.
+ * \param to The destination tensor on CPU with the same shape.
+ */
+TVM_DLL void ConvertDType(const DLTensor* from, DLTensor* to);
+
+}  // namespace runtime
+}  // namespace tvm
+#endif  // TVM_RUNTIME_FLOAT_CONVERT_H_
@@ -41,6 +41,7 @@
 #include <vector>
 
 #include "../file_utils.h"
+#include "../library_module.h"
 
 namespace tvm {
 namespace runtime {
@@ -55,7 +56,19 @@ inline size_t GetDataAlignment(const DLTensor& arr) {
 /*!
  * \brief Run all the operations one by one.
  */
+GraphExecutor::~GraphExecutor() {
+  for (const auto& dev_stream : prefetch_streams_) {
+    DeviceAPI* device_api = DeviceAPI::Get(dev_stream.first);
+    device_api->StreamSync(dev_stream.first, dev_stream.second);
+    device_api->FreeStream(dev_stream.first, dev_stream.second);
+  }
+}
+
 void GraphExecutor::Run() {
+  {
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+    if (!prefetched_eids_.empty()) CommitPrefetchedInputs();
+  }
   // setup the array and requirements.
   for (size_t i = 0; i < op_execs_.size(); ++i) {
     if (op_execs_[i]) op_execs_[i]();
@@ -129,8 +142,76 @@ int GraphExecutor::GetOutputIndex(const std::string& name) {
 void GraphExecutor::SetInput(int index, DLTensor* data_in) {
   ICHECK_LT(static_cast<size_t>(index), input_nodes_.size());
   uint32_t eid = this->entry_id(input_nodes_[index], 0);
+  CancelPrefetchedInput(eid);
   data_entry_[eid].CopyFrom(data_in);
 }
+
+void GraphExecutor::PrefetchInput(int index, DLTensor* data_in, NDArray source) {
+  ICHECK_LT(static_cast<size_t>(index), input_nodes_.size());
+  uint32_t eid = this->entry_id(input_nodes_[index], 0);
+  std::lock_guard<std::mutex> lock(prefetch_mutex_);
+  const NDArray& entry = data_entry_[eid];
+  uint32_t sid = attrs_.storage_id[eid];
+  NDArray& staged = input_storage_.at(sid).staged;
+  if (!staged.defined()) {
+    const NDArray& storage = storage_pool_[sid];
+    staged = NDArray::Empty(storage.Shape(), storage.DataType(), storage->device);
+  }
+  NDArray buffer = staged.CreateView(entry.Shape(), entry.DataType());
+  NDArray::CopyFromTo(data_in, const_cast<DLTensor*>(buffer.operator->()),
+                      GetPrefetchStream(entry->device));
+  if (source.defined()) prefetch_sources_.push_back(source);
+  if (std::find(prefetched_eids_.begin(), prefetched_eids_.end(), eid) == prefetched_eids_.end()) {
+    prefetched_eids_.push_back(eid);
+  }
+}
+
+void GraphExecutor::CommitPrefetchedInputs() {
+  for (const auto& dev_stream : prefetch_streams_) {
+    DeviceAPI::Get(dev_stream.first)->StreamSync(dev_stream.first, dev_stream.second);
+  }
+  for (uint32_t eid : prefetched_eids_) {
+    uint32_t sid = attrs_.storage_id[eid];
+    InputStorage& input = input_storage_.at(sid);
+    // The next prefetch writes the storage that the previous run used.
+    void* old_data = storage_pool_[sid]->data;
+    std::swap(storage_pool_[sid], input.staged);
+    void* new_data = storage_pool_[sid]->data;
+    // Arguments of the aliasing entries move along, unless set_output_zero_copy bound them
+    // to an array of the caller.
+    for (const auto& arg : input.args) {
+      if (arg.first == eid || arg.second->data == old_data) arg.second->data = new_data;
+    }
+    for (uint32_t alias : input.eids) {
+      data_entry_[alias] = storage_pool_[sid].CreateView(data_entry_[alias].Shape(),
+                                                         data_entry_[alias].DataType());
+    }
+  }
+  prefetched_eids_.clear();
+  prefetch_sources_.clear();
+}
+
+void GraphExecutor::CancelPrefetchedInput(uint32_t eid) {
+  std::lock_guard<std::mutex> lock(prefetch_mutex_);
+  auto it = std::find(prefetched_eids_.begin(), prefetched_eids_.end(), eid);
+  if (it == prefetched_eids_.end()) return;
+  // The pending copy writes the second storage, wait for it before the storage is reused.
+  Device dev = data_entry_[eid]->device;
+  DeviceAPI::Get(dev)->StreamSync(dev, GetPrefetchStream(dev));
+  prefetched_eids_.erase(it);
+}
+
+TVMStreamHandle GraphExecutor::GetPrefetchStream(Device dev) {
+  for (const auto& dev_stream : prefetch_streams_) {
+    if (dev_stream.first.device_type == dev.device_type &&
+        dev_stream.first.device_id == dev.device_id) {
+      return dev_stream.second;
+    }
+  }
+  TVMStreamHandle stream = DeviceAPI::Get(dev)->CreateStream(dev);
+  prefetch_streams_.emplace_back(dev, stream);
+  return stream;
+}
 /*!
  * \brief Check the legality of external DLTensor*.
  * \param external The external DLTensor*.
@@ -141,6 +222,8 @@ void GraphExecutor::CheckExternalDLTensor(const DLTensor* external, uint32_t eid
 
   ICHECK_EQ(data_alignment_[eid], details::GetDataAlignment(*external));
   ICHECK_EQ(reinterpret_cast<size_t>(external->data) % kAllocAlignment, 0);
+  ICHECK(IsContiguous(*external))
+      << "Operators expect compact arrays, use set_input to copy a strided array";
   ICHECK_EQ(internal->ndim, static_cast<size_t>(external->ndim));
   ICHECK_EQ(internal->device.device_type, external->device.device_type);
   ICHECK_EQ(internal->device.device_id, external->device.device_id);
@@ -156,6 +239,7 @@ void GraphExecutor::CheckExternalDLTensor(const DLTensor* external, uint32_t eid
 void GraphExecutor::SetInputZeroCopy(int index, DLTensor* data_ref) {
   ICHECK_LT(static_cast<size_t>(index), input_nodes_.size());
   uint32_t eid = this->entry_id(input_nodes_[index], 0);
+  CancelPrefetchedInput(eid);
   // check the consistency of input
   CheckExternalDLTensor(data_ref, eid);
   // Update the data pointer for each argument of each op
@@ -417,6 +501,14 @@ void GraphExecutor::SetupOpExecs() {
   for (size_t i = 0; i < outputs_.size(); i++) {
     output_node_eids.insert(entry_id(outputs_[i]));
   }
+  // Track what uses the storage of each input, for PrefetchInput to double buffer it.
+  for (uint32_t eid : input_node_eids) {
+    input_storage_[attrs_.storage_id[eid]];
+  }
+  for (uint32_t eid = 0; eid < num_node_entries(); ++eid) {
+    auto it = input_storage_.find(attrs_.storage_id[eid]);
+    if (it != input_storage_.end()) it->second.eids.push_back(eid);
+  }
 
   // setup the array and requirements.
   for (uint32_t nid = 0; nid < this->GetNumOfNodes(); ++nid) {
@@ -436,6 +528,19 @@ void GraphExecutor::SetupOpExecs() {
     std::shared_ptr<OpArgs> op_args = nullptr;
     std::tie(op_execs_[nid], op_args) = CreateTVMOp(inode.param, args);
 
+    // A __nop keeps no arguments, the operators reading its outputs are tracked instead.
+    if (inode.param.func_name != "__nop") {
+      for (size_t i = 0; i < args.size(); ++i) {
+        uint32_t eid = i < inode.inputs.size() ? this->entry_id(inode.inputs[i])
+                                               : this->entry_id(nid, i - inode.inputs.size());
+        auto it = input_storage_.find(attrs_.storage_id[eid]);
+        if (it != input_storage_.end()) {
+          auto* arg = static_cast<DLTensor*>(op_args->arg_values[i].v_handle);
+          it->second.args.emplace_back(eid, arg);
+        }
+      }
+    }
+
     for (size_t i = 0; i < inode.inputs.size(); i++) {
       uint32_t input_eid = this->entry_id(inode.inputs[i]);
       // check if op input is model input
@@ -502,6 +607,15 @@ GraphExecutor::CreateTVMOp(const TVMOpParam& param, const std::vector<DLTensor>&
   tvm::runtime::PackedFunc pf = module_.GetFunction(param.func_name, true);
   ICHECK(pf != nullptr) << "no such function in module: " << param.func_name;
 
+  // Generated operators are called directly with the argument arrays prepared above.
+  if (TVMBackendPackedCFunc faddr = GetBackendPackedCFunc(pf)) {
+    auto fexec = [arg_ptr, pf, faddr]() {
+      CallBackendPackedCFunc(faddr, arg_ptr->arg_values.data(), arg_ptr->arg_tcodes.data(),
+                             static_cast<int>(arg_ptr->arg_values.size()));
+    };
+    return {fexec, arg_ptr};
+  }
+
   auto fexec = [arg_ptr, pf]() {
     TVMRetValue rv;
     TVMArgs targs(arg_ptr->arg_values.data(), arg_ptr->arg_tcodes.data(),
@@ -532,6 +646,16 @@ PackedFunc GraphExecutor::GetFunction(const std::string& name,
         this->SetInputZeroCopy(args[0], args[1]);
       }
     });
+  } else if (name == "prefetch_input") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      int in_idx = String::CanConvertFrom(args[0]) ? this->GetInputIndex(args[0].operator String())
+                                                   : args[0].operator int();
+      if (in_idx < 0) return;
+      // Keep an array source alive until the copy is committed.
+      NDArray source;
+      if (args[1].type_code() == kTVMNDArrayHandle) source = args[1];
+      this->PrefetchInput(in_idx, args[1], source);
+    });
   } else if (name == "set_output_zero_copy") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       if (String::CanConvertFrom(args[0])) {
@@ -32,6 +32,7 @@
 #include <tvm/runtime/packed_func.h>
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -83,6 +84,7 @@ class TVM_DLL GraphExecutor : public ModuleNode {
    * \return The type key of the executor.
    */
   const char* type_key() const final { return "GraphExecutor"; }
+  ~GraphExecutor();
   void Run();
 
   /*!
@@ -126,6 +128,18 @@ class TVM_DLL GraphExecutor : public ModuleNode {
    * \param data_ref The input data that is referred.
    */
   void SetInputZeroCopy(int index, DLTensor* data_ref);
+  /*!
+   * \brief Copy the index-th input of the next run asynchronously.
+   *
+   *  The copy goes to a second storage of the input on a stream of its device, which the
+   *  run in flight does not use, so it can be called from another thread while Run executes.
+   *  The next Run waits for the copy and swaps the two storages, rebinding the entries that
+   *  alias the input, such as the outputs of reshapes, to the storage it copied into.
+   * \param index The input index.
+   * \param data_in The input data, which must stay valid until the next Run.
+   * \param source If defined, the array of data_in, kept alive until the next Run.
+   */
+  void PrefetchInput(int index, DLTensor* data_in, NDArray source = NDArray());
   /*!
    * \brief set index-th output to the graph without copying the data.
    * \param index The output index.
@@ -399,6 +413,16 @@ class TVM_DLL GraphExecutor : public ModuleNode {
    * \param eid The data_enrty_ index.
    */
   void CheckExternalDLTensor(const DLTensor* external, uint32_t eid) const;
+  /*! \brief Wait for the copies of PrefetchInput and make their storages the graph inputs. */
+  void CommitPrefetchedInputs();
+  /*! \brief Drop a pending PrefetchInput of an input entry. */
+  void CancelPrefetchedInput(uint32_t eid);
+  /*!
+   * \brief Get the stream used by PrefetchInput on a device.
+   * \param dev The device.
+   * \return The stream.
+   */
+  TVMStreamHandle GetPrefetchStream(Device dev);
   /*!
    * \brief Create an execution function given input.
    * \param attrs The node attributes.
@@ -447,6 +471,25 @@ class TVM_DLL GraphExecutor : public ModuleNode {
   std::vector<std::function<void()>> op_execs_;
   /*! \brief Linked parameter lookup function. */
   PackedFunc lookup_linked_param_;
+  /*! \brief A storage pool entry holding a graph input, which PrefetchInput double buffers. */
+  struct InputStorage {
+    /*! \brief The second storage, written by PrefetchInput. */
+    NDArray staged;
+    /*! \brief The entries backed by the storage, the input and the entries aliasing it. */
+    std::vector<uint32_t> eids;
+    /*! \brief The operator arguments bound to the storage, with the entry of each. */
+    std::vector<std::pair<uint32_t, DLTensor*>> args;
+  };
+  /*! \brief The storage pool entries holding graph inputs, by storage id. */
+  std::unordered_map<uint32_t, InputStorage> input_storage_;
+  /*! \brief Guards the PrefetchInput state, which Run and PrefetchInput may use concurrently. */
+  std::mutex prefetch_mutex_;
+  /*! \brief The input entries with a pending PrefetchInput. */
+  std::vector<uint32_t> prefetched_eids_;
+  /*! \brief The source arrays of pending PrefetchInput calls, kept alive until the next Run. */
+  std::vector<NDArray> prefetch_sources_;
+  /*! \brief The stream of each device used by PrefetchInput. */
+  std::vector<std::pair<Device, TVMStreamHandle>> prefetch_streams_;
   /*! \brief Module's _lookup_linked_param function, used by DefaultLookupLinkedParam. */
   PackedFunc module_lookup_linked_param_;
   /*!
@@ -71,17 +71,42 @@ class ModuleInternal {
   static std::vector<Module>* GetImportsAddr(ModuleNode* node) { return &(node->imports_); }
 };
 
-PackedFunc WrapPackedFunc(TVMBackendPackedCFunc faddr, const ObjectPtr<Object>& sptr_to_self) {
-  return PackedFunc([faddr, sptr_to_self](TVMArgs args, TVMRetValue* rv) {
+/*!
+ * \brief The body of a PackedFunc created by WrapPackedFunc.
+ *
+ *  A named type rather than a lambda, so that GetBackendPackedCFunc can recognize it.
+ */
+class BackendPackedCFuncWrapper {
+ public:
+  BackendPackedCFuncWrapper(TVMBackendPackedCFunc faddr, const ObjectPtr<Object>& sptr_to_self)
+      : faddr_(faddr), sptr_to_self_(sptr_to_self) {}
+
+  void operator()(TVMArgs args, TVMRetValue* rv) const {
     TVMValue ret_value;
     int ret_type_code = kTVMNullptr;
-    int ret = (*faddr)(const_cast<TVMValue*>(args.values), const_cast<int*>(args.type_codes),
-                       args.num_args, &ret_value, &ret_type_code, nullptr);
+    int ret = (*faddr_)(const_cast<TVMValue*>(args.values), const_cast<int*>(args.type_codes),
+                        args.num_args, &ret_value, &ret_type_code, nullptr);
     ICHECK_EQ(ret, 0) << TVMGetLastError();
     if (ret_type_code != kTVMNullptr) {
       *rv = TVMRetValue::MoveFromCHost(ret_value, ret_type_code);
     }
-  });
+  }
+
+  TVMBackendPackedCFunc faddr() const { return faddr_; }
+
+ private:
+  TVMBackendPackedCFunc faddr_;
+  ObjectPtr<Object> sptr_to_self_;
+};
+
+PackedFunc WrapPackedFunc(TVMBackendPackedCFunc faddr, const ObjectPtr<Object>& sptr_to_self) {
+  return PackedFunc(BackendPackedCFuncWrapper(faddr, sptr_to_self));
+}
+
+TVMBackendPackedCFunc GetBackendPackedCFunc(const PackedFunc& f) {
+  PackedFunc::FType body = f.body();
+  const BackendPackedCFuncWrapper* wrapper = body.target<BackendPackedCFuncWrapper>();
+  return wrapper != nullptr ? wrapper->faddr() : nullptr;
 }
 
 void InitContextFunctions(std::function<void*(const char*)> fgetsymbol) {
@@ -26,7 +26,9 @@
 
 #include <tvm/runtime/c_backend_api.h>
 #include <tvm/runtime/c_runtime_api.h>
+#include <tvm/runtime/logging.h>
 #include <tvm/runtime/module.h>
+#include <tvm/runtime/packed_func.h>
 
 #include <functional>
 #include <string>
@@ -72,6 +74,38 @@ class Library : public Object {
  */
 PackedFunc WrapPackedFunc(TVMBackendPackedCFunc faddr, const ObjectPtr<Object>& mptr);
 
+/*!
+ * \brief Get the function address called by a packed function made by WrapPackedFunc.
+ *
+ *  Callers that invoke a generated function many times, with arguments already laid out in
+ *  TVMValue and type code arrays, can use CallBackendPackedCFunc on the address instead of
+ *  PackedFunc::CallPacked, skipping the std::function dispatch, TVMArgs and TVMRetValue.
+ *  The packed function must be kept alive while the address is used, as it holds the module.
+ *
+ * \param f The packed function.
+ * \return The function address, or nullptr if f was not made by WrapPackedFunc.
+ */
+TVMBackendPackedCFunc GetBackendPackedCFunc(const PackedFunc& f);
+
+/*!
+ * \brief Call a generated function directly, with the error handling of WrapPackedFunc.
+ * \param faddr The function address, from GetBackendPackedCFunc.
+ * \param values The argument values.
+ * \param type_codes The argument type codes.
+ * \param num_args The number of arguments.
+ */
+inline void CallBackendPackedCFunc(TVMBackendPackedCFunc faddr, TVMValue* values, int* type_codes,
+                                   int num_args) {
+  TVMValue ret_value;
+  int ret_type_code = kTVMNullptr;
+  int ret = (*faddr)(values, type_codes, num_args, &ret_value, &ret_type_code, nullptr);
+  ICHECK_EQ(ret, 0) << TVMGetLastError();
+  if (ret_type_code != kTVMNullptr) {
+    // Release the returned value, which generated operators do not have.
+    TVMRetValue::MoveFromCHost(ret_value, ret_type_code);
+  }
+}
+
 /*!
  * \brief Utility to initialize conext function symbols during startup
  * \param fgetsymbol A symbol lookup function.
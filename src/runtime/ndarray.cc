@@ -27,6 +27,10 @@
 #include <tvm/runtime/ndarray.h>
 #include <tvm/runtime/registry.h>
 
+#include <cstring>
+#include <vector>
+
+#include "float_convert.h"
 #include "runtime_base.h"
 
 extern "C" {
@@ -96,6 +100,111 @@ void ArrayCopyToBytes(const DLTensor* handle, void* data, size_t nbytes) {
   DeviceAPI::Get(handle->device)->StreamSync(handle->device, nullptr);
 }
 
+// Whether the memory of a device can be read by the host directly.
+inline bool IsHostDevice(Device dev) {
+  return dev.device_type == kDLCPU || dev.device_type == kDLCUDAHost ||
+         dev.device_type == kDLROCMHost;
+}
+
+// The size of an element of a strided array, which must be a whole number of bytes.
+inline int64_t GetStridedElementBytes(DLDataType dtype) {
+  ICHECK_EQ((dtype.bits * dtype.lanes) % 8, 0)
+      << "Strided arrays require elements of a whole number of bytes";
+  return (dtype.bits * dtype.lanes) / 8;
+}
+
+// The strides of an array in elements, computed from the shape when the array is compact.
+static std::vector<int64_t> GetStrides(const DLTensor& arr) {
+  if (arr.strides != nullptr) return std::vector<int64_t>(arr.strides, arr.strides + arr.ndim);
+  std::vector<int64_t> strides(arr.ndim);
+  int64_t stride = 1;
+  for (int k = arr.ndim - 1; k >= 0; --k) {
+    strides[k] = stride;
+    stride *= arr.shape[k];
+  }
+  return strides;
+}
+
+// Whether strides describe a compact layout. The strides of axes of extent 1 do not matter.
+static bool IsCompactStrides(int ndim, const int64_t* shape, const int64_t* strides) {
+  int64_t expected_stride = 1;
+  for (int k = ndim - 1; k >= 0; --k) {
+    if (shape[k] == 0) return true;
+    if (shape[k] != 1 && strides[k] != expected_stride) return false;
+    expected_stride *= shape[k];
+  }
+  return true;
+}
+
+// Compute the range [*begin, *end) of element offsets from the first element covered by an array.
+// Returns false when the array has no elements.
+static bool GetElementRange(int ndim, const int64_t* shape, const int64_t* strides,
+                            int64_t* begin, int64_t* end) {
+  *begin = 0;
+  *end = 1;
+  for (int k = 0; k < ndim; ++k) {
+    if (shape[k] == 0) {
+      *end = *begin = 0;
+      return false;
+    }
+    int64_t extent = (shape[k] - 1) * strides[k];
+    if (extent < 0) {
+      *begin += extent;
+    } else {
+      *end += extent;
+    }
+  }
+  return true;
+}
+
+// Copy the elements of a strided array to another array of the same shape, both in host memory.
+// Runs that are contiguous in both arrays are copied with memcpy.
+static void StridedCopy(const DLTensor& from, const DLTensor& to) {
+  int64_t elem_bytes = GetStridedElementBytes(from.dtype);
+  ICHECK_EQ(elem_bytes, GetStridedElementBytes(to.dtype));
+  ICHECK_EQ(from.ndim, to.ndim);
+  int ndim = from.ndim;
+  for (int k = 0; k < ndim; ++k) {
+    ICHECK_EQ(from.shape[k], to.shape[k]);
+    if (from.shape[k] == 0) return;
+  }
+  const char* src = static_cast<const char*>(from.data) + from.byte_offset;
+  char* dst = static_cast<char*>(to.data) + to.byte_offset;
+  if (ndim == 0) {
+    std::memcpy(dst, src, elem_bytes);
+    return;
+  }
+  std::vector<int64_t> from_strides = GetStrides(from);
+  std::vector<int64_t> to_strides = GetStrides(to);
+  int64_t inner_size = from.shape[ndim - 1];
+  int64_t from_inner = from_strides[ndim - 1] * elem_bytes;
+  int64_t to_inner = to_strides[ndim - 1] * elem_bytes;
+  bool inner_contiguous = from_inner == elem_bytes && to_inner == elem_bytes;
+  // Index of the current run along the outer axes.
+  std::vector<int64_t> index(ndim - 1, 0);
+  int64_t from_offset = 0;
+  int64_t to_offset = 0;
+  while (true) {
+    if (inner_contiguous) {
+      std::memcpy(dst + to_offset, src + from_offset, inner_size * elem_bytes);
+    } else {
+      for (int64_t i = 0; i < inner_size; ++i) {
+        std::memcpy(dst + to_offset + i * to_inner, src + from_offset + i * from_inner, elem_bytes);
+      }
+    }
+    int k = ndim - 2;
+    for (; k >= 0; --k) {
+      from_offset += from_strides[k] * elem_bytes;
+      to_offset += to_strides[k] * elem_bytes;
+      if (++index[k] < from.shape[k]) break;
+      from_offset -= from_strides[k] * elem_bytes * from.shape[k];
+      to_offset -= to_strides[k] * elem_bytes * to.shape[k];
+      index[k] = 0;
+    }
+    if (k < 0) break;
+  }
+}
+
 struct NDArray::Internal {
   // Default deleter for the container
   static void DefaultDeleter(Object* ptr_obj) {
@@ -106,7 +215,7 @@ struct NDArray::Internal {
       tvm::runtime::DeviceAPI::Get(ptr->dl_tensor.device)
           ->FreeDataSpace(ptr->dl_tensor.device, ptr->dl_tensor.data);
     }
-    delete ptr;
+    PooledObjAllocator::Delete(ptr);
   }
   // Deleter for NDArray converted from DLPack
   // This is used from data which is passed from external DLPack(DLManagedTensor)
@@ -119,7 +228,7 @@ struct NDArray::Internal {
     if (tensor->deleter != nullptr) {
       (*tensor->deleter)(tensor);
     }
-    delete ptr;
+    PooledObjAllocator::Delete(ptr);
   }
   // Local create function which allocates tensor metadata
   // but does not allocate space for the data.
@@ -127,7 +236,7 @@ struct NDArray::Internal {
     VerifyDataType(dtype);
 
     // critical zone: construct header
-    NDArray::Container* data = new NDArray::Container();
+    NDArray::Container* data = PooledObjAllocator::New<NDArray::Container>();
     data->SetDeleter(DefaultDeleter);
 
     // RAII now in effect
@@ -142,6 +251,17 @@ struct NDArray::Internal {
     data->dl_tensor.device = dev;
     return ret;
   }
+  // Set the strides of a container whose shape is set, dropping them when the layout is compact.
+  static void SetStrides(NDArray::Container* data, const int64_t* strides) {
+    DLTensor& tensor = data->dl_tensor;
+    if (strides == nullptr || IsCompactStrides(tensor.ndim, tensor.shape, strides)) {
+      data->strides_.clear();
+      tensor.strides = nullptr;
+    } else {
+      data->strides_.assign(strides, strides + tensor.ndim);
+      tensor.strides = data->strides_.data();
+    }
+  }
   // Implementation of API function
   static DLTensor* MoveToFFIHandle(NDArray arr) {
     DLTensor* handle = NDArray::FFIGetHandle(arr);
@@ -188,6 +308,60 @@ NDArray NDArray::CreateView(ShapeTuple shape, DLDataType dtype) {
   return ret;
 }
 
+NDArray NDArray::CreateView(ShapeTuple shape, ShapeTuple strides, int64_t elem_offset) const {
+  ICHECK(data_ != nullptr);
+  const DLTensor& curr = get_mutable()->dl_tensor;
+  int64_t elem_bytes = GetStridedElementBytes(curr.dtype);
+  if (strides.empty()) {
+    DLTensor compact = curr;
+    compact.ndim = static_cast<int>(shape.size());
+    compact.shape = const_cast<int64_t*>(shape.data());
+    compact.strides = nullptr;
+    std::vector<int64_t> compact_strides = GetStrides(compact);
+    return CreateView(shape, ShapeTuple(compact_strides), elem_offset);
+  }
+  ICHECK_EQ(strides.size(), shape.size()) << "The view must have one stride per axis";
+  int64_t view_begin, view_end;
+  if (GetElementRange(static_cast<int>(shape.size()), shape.data(), strides.data(), &view_begin,
+                      &view_end)) {
+    std::vector<int64_t> curr_strides = GetStrides(curr);
+    int64_t curr_begin = 0, curr_end = 0;
+    GetElementRange(curr.ndim, curr.shape, curr_strides.data(), &curr_begin, &curr_end);
+    ICHECK(curr_begin <= elem_offset + view_begin && elem_offset + view_end <= curr_end)
+        << "Tries to create a view that exceeds the memory of the current one";
+  }
+
+  NDArray ret = Internal::Create(shape, curr.dtype, curr.device);
+  Container* view = ret.get_mutable();
+  Internal::SetStrides(view, strides.data());
+  // increase ref count
+  get_mutable()->IncRef();
+  view->manager_ctx = get_mutable();
+  int64_t byte_offset = static_cast<int64_t>(curr.byte_offset) + elem_offset * elem_bytes;
+  if (SupportsDataPointerOffset(curr.device)) {
+    view->dl_tensor.data = static_cast<char*>(curr.data) + byte_offset;
+  } else {
+    view->dl_tensor.data = curr.data;
+    view->dl_tensor.byte_offset = byte_offset;
+  }
+  return ret;
+}
+
+NDArray NDArray::Slice(int axis, int64_t begin, int64_t end) const {
+  ICHECK(data_ != nullptr);
+  const DLTensor& curr = get_mutable()->dl_tensor;
+  if (axis < 0) axis += curr.ndim;
+  ICHECK(axis >= 0 && axis < curr.ndim) << "Slice axis is out of range for a " << curr.ndim
+                                        << "-d array";
+  ICHECK(0 <= begin && begin <= end && end <= curr.shape[axis])
+      << "Slice [" << begin << ", " << end << ") is out of range for axis " << axis
+      << " of extent " << curr.shape[axis];
+  std::vector<int64_t> shape(curr.shape, curr.shape + curr.ndim);
+  std::vector<int64_t> strides = GetStrides(curr);
+  shape[axis] = end - begin;
+  return CreateView(ShapeTuple(shape), ShapeTuple(strides), begin * strides[axis]);
+}
+
 DLManagedTensor* NDArray::ToDLPack() const { return Internal::ToDLPack(get_mutable()); }
 
 NDArray NDArray::Empty(ShapeTuple shape, DLDataType dtype, Device dev, Optional<String> mem_scope) {
@@ -199,7 +373,7 @@ NDArray NDArray::Empty(ShapeTuple shape, DLDataType dtype, Device dev, Optional<
 }
 
 NDArray NDArray::FromDLPack(DLManagedTensor* tensor) {
-  NDArray::Container* data = new NDArray::Container();
+  NDArray::Container* data = PooledObjAllocator::New<NDArray::Container>();
   // construct header
   data->SetDeleter(Internal::DLPackDeleter);
   // fill up content.
@@ -211,6 +385,8 @@ NDArray NDArray::FromDLPack(DLManagedTensor* tensor) {
   shape.assign(data->dl_tensor.shape, data->dl_tensor.shape + data->dl_tensor.ndim);
   data->shape_ = ShapeTuple(shape);
   data->dl_tensor.shape = const_cast<ShapeTuple::index_type*>(data->shape_.data());
+  // own the strides of a strided tensor
+  Internal::SetStrides(data, tensor->dl_tensor.strides);
   return NDArray(GetObjectPtr<Object>(data));
 }
 
@@ -226,6 +402,12 @@ void NDArray::CopyFromBytes(const void* data, size_t nbytes) {
   ArrayCopyFromBytes(&get_mutable()->dl_tensor, data, nbytes);
 }
 
+void NDArray::CopyFromConverted(const NDArray& other) {
+  ICHECK(data_ != nullptr);
+  ICHECK(other.data_ != nullptr);
+  ConvertDType(&other.get_mutable()->dl_tensor, &get_mutable()->dl_tensor);
+}
+
 void NDArray::CopyFromTo(const DLTensor* from, DLTensor* to, TVMStreamHandle stream) {
   size_t from_size = GetDataSize(*from);
   size_t to_size = GetDataSize(*to);
@@ -241,7 +423,32 @@ void NDArray::CopyFromTo(const DLTensor* from, DLTensor* to, TVMStreamHandle str
   // api manager.
   Device dev = from->device.device_type != kDLCPU ? from->device : to->device;
 
-  DeviceAPI::Get(dev)->CopyDataFromTo(const_cast<DLTensor*>(from), to, stream);
+  if (runtime::IsContiguous(*from) && runtime::IsContiguous(*to)) {
+    DeviceAPI::Get(dev)->CopyDataFromTo(const_cast<DLTensor*>(from), to, stream);
+    return;
+  }
+  bool from_host = IsHostDevice(from->device);
+  bool to_host = IsHostDevice(to->device);
+  if (from_host && to_host) {
+    StridedCopy(*from, *to);
+    return;
+  }
+  ICHECK((from_host || runtime::IsContiguous(*from)) && (to_host || runtime::IsContiguous(*to)))
+      << "Copies of non-contiguous arrays are only supported in host memory";
+  // Stage the non-contiguous host array in a compact one. The copy is synchronized
+  // because the staging array is released on return.
+  NDArray staging = NDArray::Empty(ShapeTuple(from->shape, from->shape + from->ndim), from->dtype,
+                                   Device{kDLCPU, 0});
+  DLTensor* staging_tensor = &staging.get_mutable()->dl_tensor;
+  if (!runtime::IsContiguous(*from)) {
+    StridedCopy(*from, *staging_tensor);
+    DeviceAPI::Get(dev)->CopyDataFromTo(staging_tensor, to, stream);
+    DeviceAPI::Get(dev)->StreamSync(dev, stream);
+  } else {
+    DeviceAPI::Get(dev)->CopyDataFromTo(const_cast<DLTensor*>(from), staging_tensor, stream);
+    DeviceAPI::Get(dev)->StreamSync(dev, stream);
+    StridedCopy(*staging_tensor, *to);
+  }
 }
 
 ShapeTuple NDArray::Shape() const { return get_mutable()->shape_; }
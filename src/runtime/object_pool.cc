@@ -0,0 +1,129 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * \file src/runtime/object_pool.cc
+ * \brief Thread-caching memory pool of pooled runtime objects.
+ */
+#include <tvm/runtime/container/shape_tuple.h>
+#include <tvm/runtime/memory.h>
+#include <tvm/runtime/registry.h>
+
+#include <new>
+
+#ifndef TVM_USE_OBJECT_POOL
+#define TVM_USE_OBJECT_POOL 1
+#endif
+
+namespace tvm {
+namespace runtime {
+
+namespace {
+
+constexpr size_t kNumSizeClasses = ObjectPool::kMaxBlockBytes / ObjectPool::kSizeClassBytes;
+
+/*! \brief A free block, linked through its first word. */
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+/*!
+ * \brief The free lists of a thread.
+ *
+ *  It is trivially destructible, so objects released while the thread exits, after
+ *  ThreadCacheReaper ran, can still check exited and go to the system allocator.
+ */
+struct ThreadCache {
+  FreeBlock* free_list[kNumSizeClasses];
+  uint32_t num_free[kNumSizeClasses];
+  bool has_reaper;
+  bool exited;
+  ObjectPool::Stats stats;
+};
+
+thread_local ThreadCache thread_cache;
+
+/*! \brief Returns the cached blocks of a thread to the system allocator when it exits. */
+struct ThreadCacheReaper {
+  ~ThreadCacheReaper() {
+    ThreadCache& cache = thread_cache;
+    cache.exited = true;
+    for (size_t i = 0; i < kNumSizeClasses; ++i) {
+      while (FreeBlock* block = cache.free_list[i]) {
+        cache.free_list[i] = block->next;
+        ::operator delete(block);
+      }
+      cache.num_free[i] = 0;
+    }
+  }
+};
+
+inline size_t SizeClass(size_t size) { return (size - 1) / ObjectPool::kSizeClassBytes; }
+
+}  // namespace
+
+void* ObjectPool::Allocate(size_t size) {
+  ThreadCache& cache = thread_cache;
+#if TVM_USE_OBJECT_POOL
+  if (size != 0 && size <= kMaxBlockBytes) {
+    size_t size_class = SizeClass(size);
+    if (FreeBlock* block = cache.free_list[size_class]) {
+      cache.free_list[size_class] = block->next;
+      --cache.num_free[size_class];
+      ++cache.stats.num_reused;
+      return block;
+    }
+    // Allocate the whole size class so that the block can serve any size in it.
+    size = (size_class + 1) * kSizeClassBytes;
+  }
+#endif
+  ++cache.stats.num_system_allocs;
+  return ::operator new(size);
+}
+
+void ObjectPool::Free(void* ptr, size_t size) {
+#if TVM_USE_OBJECT_POOL
+  ThreadCache& cache = thread_cache;
+  if (size != 0 && size <= kMaxBlockBytes && !cache.exited) {
+    size_t size_class = SizeClass(size);
+    if (cache.num_free[size_class] < kMaxCachedBlocks) {
+      if (!cache.has_reaper) {
+        static thread_local ThreadCacheReaper reaper;
+        cache.has_reaper = true;
+      }
+      FreeBlock* block = static_cast<FreeBlock*>(ptr);
+      block->next = cache.free_list[size_class];
+      cache.free_list[size_class] = block;
+      ++cache.num_free[size_class];
+      return;
+    }
+  }
+#endif
+  ::operator delete(ptr);
+}
+
+ObjectPool::Stats ObjectPool::ThreadStats() { return thread_cache.stats; }
+
+TVM_REGISTER_GLOBAL("runtime.ObjectPoolThreadStats").set_body_typed([]() {
+  ObjectPool::Stats stats = ObjectPool::ThreadStats();
+  return ShapeTuple({static_cast<int64_t>(stats.num_reused),
+                     static_cast<int64_t>(stats.num_system_allocs)});
+});
+
+}  // namespace runtime
+}  // namespace tvm
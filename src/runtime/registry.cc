@@ -27,9 +27,11 @@
 #include <tvm/runtime/registry.h>
 
 #include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "runtime_base.h"
 
@@ -37,16 +39,82 @@ namespace tvm {
 namespace runtime {
 
 struct Registry::Manager {
+  /*! \brief Initial number of buckets of the lookup table, enough for the functions of libtvm. */
+  static constexpr size_t kInitialNumBuckets = 4096;
+
+  /*! \brief An entry of the lock-free lookup table. */
+  struct Entry {
+    std::string name;
+    size_t hash;
+    /*! \brief The registered function, nullptr after Remove. */
+    std::atomic<Registry*> registry;
+    /*! \brief Next entry of the bucket, set before the entry is published. */
+    Entry* next;
+  };
+
+  /*!
+   * \brief An insert-only hash table read without locking.
+   *
+   * Entries are published with a release store of the bucket head and never modified afterwards,
+   * except for their registry pointer. When the table fills up, writers publish a larger copy and
+   * retire this one; retired tables are kept alive, so a reader that still holds one never sees
+   * freed memory. Tables double in size, so the retired ones hold fewer entries than the live one.
+   */
+  struct Table {
+    explicit Table(size_t num_buckets)
+        : mask(num_buckets - 1), buckets(new std::atomic<Entry*>[num_buckets]) {
+      for (size_t i = 0; i < num_buckets; ++i) {
+        buckets[i].store(nullptr, std::memory_order_relaxed);
+      }
+    }
+
+    ~Table() {
+      for (size_t i = 0; i <= mask; ++i) {
+        Entry* e = buckets[i].load(std::memory_order_relaxed);
+        while (e != nullptr) {
+          Entry* next = e->next;
+          delete e;
+          e = next;
+        }
+      }
+    }
+
+    Entry* Find(const std::string& name, size_t hash) const {
+      for (Entry* e = buckets[hash & mask].load(std::memory_order_acquire); e != nullptr;
+           e = e->next) {
+        if (e->hash == hash && e->name == name) return e;
+      }
+      return nullptr;
+    }
+
+    // Must hold mutex.
+    void Insert(const std::string& name, size_t hash, Registry* registry) {
+      std::atomic<Entry*>& head = buckets[hash & mask];
+      Entry* e = new Entry{name, hash, {registry}, head.load(std::memory_order_relaxed)};
+      head.store(e, std::memory_order_release);
+      ++size;
+    }
+
+    size_t mask;
+    /*! \brief Number of entries, including removed ones. Only accessed by writers. */
+    size_t size{0};
+    std::unique_ptr<std::atomic<Entry*>[]> buckets;
+  };
+
   // map storing the functions.
   // We deliberately used raw pointer.
   // This is because PackedFunc can contain callbacks into the host language (Python) and the
   // resource can become invalid because of indeterministic order of destruction and forking.
   // The resources will only be recycled during program exit.
   std::unordered_map<std::string, Registry*> fmap;
-  // mutex
+  // The lock-free copy of fmap used by Get.
+  std::atomic<Table*> table;
+  // Tables replaced by a larger one, which readers may still be using.
+  std::vector<std::unique_ptr<Table>> retired_tables;
+  // mutex, held by writers
   std::mutex mutex;
 
-  Manager() {}
+  Manager() : table(new Table(kInitialNumBuckets)) {}
 
   static Manager* Global() {
     // We deliberately leak the Manager instance, to avoid leak sanitizers
@@ -55,6 +123,30 @@ struct Registry::Manager {
     static Manager* inst = new Manager();
     return inst;
   }
+
+  // Publish the registry of name in the lookup table, or remove it if registry is nullptr.
+  // Must hold mutex.
+  void Update(const std::string& name, Registry* registry) {
+    size_t hash = std::hash<std::string>()(name);
+    Table* t = table.load(std::memory_order_relaxed);
+    if (Entry* e = t->Find(name, hash)) {
+      e->registry.store(registry, std::memory_order_release);
+      return;
+    }
+    if (registry == nullptr) return;
+    if (t->size > t->mask) {
+      Table* grown = new Table(2 * (t->mask + 1));
+      for (const auto& kv : fmap) {
+        if (kv.first != name) {
+          grown->Insert(kv.first, std::hash<std::string>()(kv.first), kv.second);
+        }
+      }
+      retired_tables.emplace_back(t);
+      table.store(grown, std::memory_order_release);
+      t = grown;
+    }
+    t->Insert(name, hash, registry);
+  }
 };
 
 Registry& Registry::set_body(PackedFunc f) {  // NOLINT(*)
@@ -72,6 +164,7 @@ Registry& Registry::Register(const std::string& name, bool can_override) {  // N
   Registry* r = new Registry();
   r->name_ = name;
   m->fmap[name] = r;
+  m->Update(name, r);
   return *r;
 }
 
@@ -81,15 +174,18 @@ bool Registry::Remove(const std::string& name) {
   auto it = m->fmap.find(name);
   if (it == m->fmap.end()) return false;
   m->fmap.erase(it);
+  m->Update(name, nullptr);
   return true;
 }
 
 const PackedFunc* Registry::Get(const std::string& name) {
   Manager* m = Manager::Global();
-  std::lock_guard<std::mutex> lock(m->mutex);
-  auto it = m->fmap.find(name);
-  if (it == m->fmap.end()) return nullptr;
-  return &(it->second->func_);
+  const Manager::Table* t = m->table.load(std::memory_order_acquire);
+  const Manager::Entry* e = t->Find(name, std::hash<std::string>()(name));
+  if (e == nullptr) return nullptr;
+  Registry* r = e->registry.load(std::memory_order_acquire);
+  if (r == nullptr) return nullptr;
+  return &(r->func_);
 }
 
 std::vector<std::string> Registry::ListNames() {
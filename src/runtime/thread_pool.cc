@@ -35,6 +35,8 @@
 #include <atomic>
 #include <condition_variable>
 #include <cstring>
+#include <exception>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <sstream>
@@ -317,10 +319,11 @@ class ThreadPool {
 
   static ThreadPool* ThreadLocal() { return dmlc::ThreadLocalStore<ThreadPool>::Get(); }
 
-  void UpdateWorkerConfiguration(threading::ThreadGroup::AffinityMode mode, int nthreads) {
+  void UpdateWorkerConfiguration(threading::ThreadGroup::AffinityMode mode, int nthreads,
+                                 int numa_node = -1) {
     // this will also reset the affinity of the ThreadGroup
     // may use less than the MaxConcurrency number of workers
-    num_workers_used_ = threads_->Configure(mode, nthreads, exclude_worker0_);
+    num_workers_used_ = threads_->Configure(mode, nthreads, exclude_worker0_, numa_node);
     // if MaxConcurrency restricted the number of workers (e.g., due to
     // hyperthreading), respect the restriction
     num_workers_used_ = std::min(num_workers_, num_workers_used_);
@@ -373,11 +376,41 @@ TVM_REGISTER_GLOBAL("runtime.config_threadpool").set_body([](TVMArgs args, TVMRe
   threading::ThreadGroup::AffinityMode mode =
       static_cast<threading::ThreadGroup::AffinityMode>(static_cast<int>(args[0]));
   int nthreads = args[1];
-  ThreadPool::ThreadLocal()->UpdateWorkerConfiguration(mode, nthreads);
+  int numa_node = args.size() > 2 ? args[2] : -1;
+  ThreadPool::ThreadLocal()->UpdateWorkerConfiguration(mode, nthreads, numa_node);
+});
+
+TVM_REGISTER_GLOBAL("runtime.run_per_numa_node").set_body([](TVMArgs args, TVMRetValue* rv) {
+  PackedFunc ftask = args[0];
+  threading::RunPerNUMANode([ftask](int node) { ftask(node); });
 });
 
 namespace threading {
 void ResetThreadPool() { tvm::runtime::ThreadPool::ThreadLocal()->Reset(); }
+
+void RunPerNUMANode(std::function<void(int node)> ftask) {
+  int num_nodes = static_cast<int>(NUMATopology().size());
+  std::vector<std::exception_ptr> errors(num_nodes);
+  std::vector<std::thread> replicas;
+  for (int node = 0; node < num_nodes; ++node) {
+    replicas.emplace_back([&ftask, &errors, node]() {
+      try {
+        // Bind first, so that the workers of the pool start on the node.
+        BindToNUMANode(node);
+        ThreadPool::ThreadLocal()->UpdateWorkerConfiguration(ThreadGroup::kNUMANode, 0, node);
+        ftask(node);
+      } catch (...) {
+        errors[node] = std::current_exception();
+      }
+    });
+  }
+  for (std::thread& replica : replicas) {
+    replica.join();
+  }
+  for (const std::exception_ptr& error : errors) {
+    if (error) std::rethrow_exception(error);
+  }
+}
 }  // namespace threading
 
 }  // namespace runtime
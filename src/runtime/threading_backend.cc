@@ -25,7 +25,11 @@
 #include <tvm/runtime/threading_backend.h>
 
 #include <algorithm>
+#include <cstdlib>
+#include <string>
 #include <thread>
+#include <utility>
+#include <vector>
 #if defined(__linux__) || defined(__ANDROID__)
 #include <fstream>
 #include <sstream>
@@ -33,6 +37,8 @@
 #endif
 #if defined(__linux__)
 #include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 #endif
 #if defined(__hexagon__)
 #include <dlfcn.h>
@@ -42,6 +48,50 @@ namespace tvm {
 namespace runtime {
 namespace threading {
 
+namespace {
+
+/*! \brief The NUMA node the thread pool of this thread is confined to. */
+thread_local int preferred_numa_node = -1;
+
+#if defined(__linux__) || defined(__ANDROID__)
+/*!
+ * \brief Parse a list of CPU or node ids of sysfs, such as "0-3,8-11".
+ * \return The ids in ascending order, empty if the list is malformed.
+ */
+std::vector<unsigned int> ParseIdList(const std::string& list) {
+  std::vector<unsigned int> ids;
+  std::istringstream is(list);
+  std::string range;
+  while (std::getline(is, range, ',')) {
+    char* end;
+    unsigned long begin = strtoul(range.c_str(), &end, 10);  // NOLINT(*)
+    unsigned long last = begin;                                // NOLINT(*)
+    if (end == range.c_str()) return {};
+    if (*end == '-') {
+      const char* next = end + 1;
+      last = strtoul(next, &end, 10);
+      if (end == next || last < begin) return {};
+    }
+    for (unsigned long id = begin; id <= last; ++id) {  // NOLINT(*)
+      ids.push_back(static_cast<unsigned int>(id));
+    }
+  }
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  return ids;
+}
+
+/*! \brief Read the first token of a sysfs file, empty if the file is missing or empty. */
+std::string ReadSysfsToken(const std::string& path) {
+  std::string token;
+  std::ifstream ifs(path);
+  ifs >> token;
+  return token;
+}
+#endif
+
+}  // namespace
+
 class ThreadGroup::Impl {
  public:
   Impl(int num_workers, std::function<void(int)> worker_callback, bool exclude_worker0)
@@ -60,9 +110,24 @@ class ThreadGroup::Impl {
     }
   }
 
-  int Configure(AffinityMode mode, int nthreads, bool exclude_worker0) {
+  int Configure(AffinityMode mode, int nthreads, bool exclude_worker0, int numa_node) {
     int num_workers_used = 0;
-    if (mode == kLittle) {
+    const std::vector<NUMANode>& nodes = NUMATopology();
+    if (mode == kNUMANode) {
+      if (numa_node < 0) {
+        numa_node = CurrentNUMANode();
+      }
+      ICHECK_LT(numa_node, static_cast<int>(nodes.size()))
+          << "NUMA node " << numa_node << " does not exist, the system has " << nodes.size()
+          << " nodes";
+      // Use the share of the node in MaxConcurrency, which may leave out hyper-threads.
+      size_t num_cpus = 0;
+      for (const NUMANode& node : nodes) {
+        num_cpus += node.cpus.size();
+      }
+      num_workers_used = std::max(
+          1, static_cast<int>(nodes[numa_node].cpus.size() * MaxConcurrency() / num_cpus));
+    } else if (mode == kLittle) {
       num_workers_used = little_count_;
     } else if (mode == kBig) {
       num_workers_used = big_count_;
@@ -79,11 +144,15 @@ class ThreadGroup::Impl {
     // and N/2 physical cores this will set affinity to the first N/2 logical
     // ones.
     num_workers_used = std::min(num_workers_, num_workers_used);
+    // Memory is only placed explicitly when there is more than one node.
+    preferred_numa_node = mode == kNUMANode && nodes.size() > 1 ? numa_node : -1;
 
     const char* val = getenv("TVM_BIND_THREADS");
     if (val == nullptr || atoi(val) == 1) {
-      // Do not set affinity if there are more workers than found cores
-      if (sorted_order_.size() >= static_cast<unsigned int>(num_workers_)) {
+      if (mode == kNUMANode) {
+        SetNUMAAffinity(numa_node, exclude_worker0);
+      } else if (sorted_order_.size() >= static_cast<unsigned int>(num_workers_)) {
+        // Do not set affinity if there are more workers than found cores
         SetAffinity(exclude_worker0, mode == kLittle);
       } else {
         LOG(WARNING) << "The thread affinity cannot be set when the number of workers"
@@ -130,13 +199,32 @@ class ThreadGroup::Impl {
       pthread_setaffinity_np(threads_[i].native_handle(), sizeof(cpu_set_t), &cpuset);
 #endif
     }
-    if (exclude_worker0) {  // main thread run task
+    if (exclude_worker0 || main_thread_on_node_) {  // main thread run task
       // Master thread will have free migration on needed cores.
       // Typically, the OS will schedule the main thread to run at core 0,
       // which is idle, when other workers are running.
       // See the comment inside SetMasterThreadFullCpuAffinity function to get more detail.
       SetMasterThreadFullCpuAffinity(reverse);
+      main_thread_on_node_ = false;
+    }
+#endif
+  }
+
+  // bind the workers to the CPUs of a NUMA node in turn, and the main thread
+  // to the whole node, so that the memory they touch first is local to the node.
+  void SetNUMAAffinity(int numa_node, bool exclude_worker0) {
+#if defined(__linux__) && !defined(__ANDROID__)
+    const std::vector<unsigned int>& cpus = NUMATopology()[numa_node].cpus;
+    for (unsigned i = 0; i < threads_.size(); ++i) {
+      unsigned core_id = cpus[(i + exclude_worker0) % cpus.size()];
+      if (core_id >= CPU_SETSIZE) continue;
+      cpu_set_t cpuset;
+      CPU_ZERO(&cpuset);
+      CPU_SET(core_id, &cpuset);
+      pthread_setaffinity_np(threads_[i].native_handle(), sizeof(cpu_set_t), &cpuset);
     }
+    BindToNUMANode(numa_node);
+    main_thread_on_node_ = true;
 #endif
   }
 
@@ -223,6 +311,8 @@ class ThreadGroup::Impl {
   std::vector<unsigned int> sorted_order_;
   int big_count_ = 0;
   int little_count_ = 0;
+  // whether the main thread was bound to a NUMA node by the last configuration
+  bool main_thread_on_node_ = false;
 };
 
 ThreadGroup::ThreadGroup(int num_workers, std::function<void(int)> worker_callback,
@@ -231,8 +321,9 @@ ThreadGroup::ThreadGroup(int num_workers, std::function<void(int)> worker_callba
 ThreadGroup::~ThreadGroup() { delete impl_; }
 void ThreadGroup::Join() { impl_->Join(); }
 
-int ThreadGroup::Configure(AffinityMode mode, int nthreads, bool exclude_worker0) {
-  return impl_->Configure(mode, nthreads, exclude_worker0);
+int ThreadGroup::Configure(AffinityMode mode, int nthreads, bool exclude_worker0,
+                           int numa_node) {
+  return impl_->Configure(mode, nthreads, exclude_worker0, numa_node);
 }
 
 void Yield() { std::this_thread::yield(); }
@@ -265,6 +356,89 @@ int MaxConcurrency() {
   return std::max(max_concurrency, 1);
 }
 
+std::vector<NUMANode> ReadNUMATopology(const std::string& sysfs_root) {
+  std::vector<NUMANode> nodes;
+#if defined(__linux__) || defined(__ANDROID__)
+  std::string node_dir = sysfs_root + "/devices/system/node/";
+  for (unsigned int id : ParseIdList(ReadSysfsToken(node_dir + "online"))) {
+    std::vector<unsigned int> cpus =
+        ParseIdList(ReadSysfsToken(node_dir + "node" + std::to_string(id) + "/cpulist"));
+    // Skip the nodes with memory only.
+    if (!cpus.empty()) {
+      nodes.push_back(NUMANode{static_cast<int>(id), std::move(cpus)});
+    }
+  }
+#endif
+  if (nodes.empty()) {
+    NUMANode node{0, {}};
+    unsigned int num_cpus = std::max(std::thread::hardware_concurrency(), 1U);
+    for (unsigned int i = 0; i < num_cpus; ++i) {
+      node.cpus.push_back(i);
+    }
+    nodes.push_back(std::move(node));
+  }
+  return nodes;
+}
+
+const std::vector<NUMANode>& NUMATopology() {
+  static const std::vector<NUMANode> nodes = []() {
+    const char* sysfs_root = getenv("TVM_NUMA_SYSFS_ROOT");
+    return ReadNUMATopology(sysfs_root != nullptr ? sysfs_root : "/sys");
+  }();
+  return nodes;
+}
+
+int CurrentNUMANode() {
+#if defined(__linux__) && !defined(__ANDROID__)
+  const std::vector<NUMANode>& nodes = NUMATopology();
+  int cpu = sched_getcpu();
+  for (size_t i = 0; cpu >= 0 && i < nodes.size(); ++i) {
+    if (std::binary_search(nodes[i].cpus.begin(), nodes[i].cpus.end(),
+                           static_cast<unsigned int>(cpu))) {
+      return static_cast<int>(i);
+    }
+  }
+#endif
+  return 0;
+}
+
+void BindToNUMANode(int node) {
+  const std::vector<NUMANode>& nodes = NUMATopology();
+  ICHECK(node >= 0 && node < static_cast<int>(nodes.size()))
+      << "NUMA node " << node << " does not exist, the system has " << nodes.size() << " nodes";
+#if defined(__linux__) && !defined(__ANDROID__)
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  for (unsigned int cpu : nodes[node].cpus) {
+    if (cpu < CPU_SETSIZE) CPU_SET(cpu, &cpuset);
+  }
+  pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+#endif
+}
+
+int PreferredNUMANode() { return preferred_numa_node; }
+
+void PlaceOnNUMANode(void* ptr, size_t nbytes, int node) {
+#if defined(__linux__) && !defined(__ANDROID__) && defined(SYS_mbind)
+  // From linux/mempolicy.h, which is not installed everywhere.
+  constexpr int kMPolPreferred = 1;
+  constexpr unsigned kMPolMFMove = 1 << 1;
+  constexpr size_t kBitsPerWord = sizeof(unsigned long) * 8;  // NOLINT(*)
+  const std::vector<NUMANode>& nodes = NUMATopology();
+  if (node < 0 || node >= static_cast<int>(nodes.size())) return;
+  uintptr_t page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  uintptr_t begin = (reinterpret_cast<uintptr_t>(ptr) + page_size - 1) & ~(page_size - 1);
+  uintptr_t end = (reinterpret_cast<uintptr_t>(ptr) + nbytes) & ~(page_size - 1);
+  if (begin >= end) return;
+  size_t id = static_cast<size_t>(nodes[node].id);
+  std::vector<unsigned long> node_mask(id / kBitsPerWord + 1, 0);  // NOLINT(*)
+  node_mask[id / kBitsPerWord] |= 1UL << (id % kBitsPerWord);
+  // The kernel reads one bit less than the given number of nodes.
+  syscall(SYS_mbind, begin, end - begin, kMPolPreferred, node_mask.data(),
+          node_mask.size() * kBitsPerWord + 1, kMPolMFMove);
+#endif
+}
+
 }  // namespace threading
 }  // namespace runtime
 }  // namespace tvm
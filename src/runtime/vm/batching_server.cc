@@ -0,0 +1,327 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/runtime/vm/batching_server.cc
+ * \brief Server batching individual requests into calls of a model with a dynamic batch axis.
+ */
+#include "./batching_server.h"
+
+#include <tvm/runtime/container/adt.h>
+#include <tvm/runtime/container/string.h>
+#include <tvm/runtime/data_type.h>
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/registry.h>
+
+#include <exception>
+#include <string>
+#include <utility>
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+
+namespace {
+
+/*! \brief The rows of consecutive requests, viewed as one array without a copy. */
+struct AdjacentRows {
+  std::vector<NDArray> parts;
+  DLManagedTensor tensor;
+};
+
+const char* Begin(const NDArray& arr) {
+  return static_cast<const char*>(arr->data) + arr->byte_offset;
+}
+
+/*!
+ * \brief Concatenate arrays along their outer axis.
+ *
+ *  Compact host arrays lying one after the other in memory, from an aligned address on, are viewed
+ *  as one array, which keeps them alive, and other arrays are copied into a new one.
+ */
+NDArray ConcatRows(const std::vector<NDArray>& parts, int64_t rows) {
+  if (parts.size() == 1) return parts[0];
+  const NDArray& first = parts[0];
+  std::vector<int64_t> shape(first->shape, first->shape + first->ndim);
+  shape[0] = rows;
+
+  bool adjacent = reinterpret_cast<size_t>(Begin(first)) % kAllocAlignment == 0;
+  for (size_t i = 0; i < parts.size() && adjacent; ++i) {
+    adjacent = parts[i]->device.device_type == kDLCPU && parts[i].IsContiguous() &&
+               (i == 0 || Begin(parts[i - 1]) + GetDataSize(*parts[i - 1].operator->()) ==
+                              Begin(parts[i]));
+  }
+  if (adjacent) {
+    AdjacentRows* ctx = new AdjacentRows();
+    ctx->parts = parts;
+    ctx->tensor.dl_tensor = *first.operator->();
+    // Kernels expect a zero byte_offset, so the view starts at the data of the first rows.
+    ctx->tensor.dl_tensor.data = const_cast<char*>(Begin(first));
+    ctx->tensor.dl_tensor.byte_offset = 0;
+    ctx->tensor.dl_tensor.shape = shape.data();
+    ctx->tensor.dl_tensor.strides = nullptr;
+    ctx->tensor.manager_ctx = ctx;
+    ctx->tensor.deleter = [](DLManagedTensor* self) {
+      delete static_cast<AdjacentRows*>(self->manager_ctx);
+    };
+    return NDArray::FromDLPack(&ctx->tensor);
+  }
+
+  NDArray batched = NDArray::Empty(shape, first->dtype, first->device);
+  int64_t begin = 0;
+  for (const NDArray& part : parts) {
+    int64_t end = begin + part->shape[0];
+    batched.Slice(0, begin, end).CopyFrom(part);
+    begin = end;
+  }
+  return batched;
+}
+
+/*! \brief View the rows [begin, end) of the outputs of a batch of rows rows. */
+ObjectRef SliceRows(const ObjectRef& outputs, int64_t begin, int64_t end, int64_t rows) {
+  if (const auto* adt = outputs.as<ADTObj>()) {
+    std::vector<ObjectRef> fields;
+    for (size_t i = 0; i < adt->size; ++i) {
+      fields.push_back(SliceRows((*adt)[i], begin, end, rows));
+    }
+    return ADT(adt->tag, fields);
+  }
+  NDArray arr = Downcast<NDArray>(outputs);
+  ICHECK(arr->ndim > 0 && arr->shape[0] == rows)
+      << "Each output of a batch must have the " << rows << " rows of the batch as outer axis";
+  return arr.Slice(0, begin, end);
+}
+
+}  // namespace
+
+BatchingServer::BatchingServer(PackedFunc run, BatchingConfig config)
+    : run_(std::move(run)), config_(config) {
+  ICHECK(run_ != nullptr);
+  ICHECK_GT(config_.max_batch_size, 0);
+  ICHECK_GE(config_.timeout_us, 0);
+  worker_ = std::thread([this] { WorkerLoop(); });
+}
+
+BatchingServer::~BatchingServer() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_one();
+  worker_.join();
+}
+
+std::future<ObjectRef> BatchingServer::Submit(std::vector<NDArray> inputs) {
+  return Submit(std::move(inputs), PackedFunc());
+}
+
+std::future<ObjectRef> BatchingServer::Submit(std::vector<NDArray> inputs, PackedFunc callback) {
+  ICHECK(!inputs.empty()) << "A request needs at least one input";
+  int64_t rows = -1;
+  for (const NDArray& input : inputs) {
+    ICHECK(input.defined() && input->ndim > 0) << "The inputs of a request need a batch axis";
+    ICHECK(rows < 0 || input->shape[0] == rows)
+        << "All the inputs of a request must have the same extent of the batch axis";
+    rows = input->shape[0];
+  }
+  ICHECK_GT(rows, 0) << "A request needs at least one row";
+
+  Request request;
+  request.inputs = std::move(inputs);
+  request.rows = rows;
+  request.callback = std::move(callback);
+  request.arrival = std::chrono::steady_clock::now();
+  std::future<ObjectRef> result = request.result.get_future();
+  bool notify;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ICHECK(!stop_) << "The server is stopping";
+    // The worker waits either for a first request or for a full batch.
+    notify = queue_.empty();
+    queued_rows_ += rows;
+    notify = notify || queued_rows_ >= config_.max_batch_size;
+    queue_.push_back(std::move(request));
+  }
+  if (notify) cv_.notify_one();
+  return result;
+}
+
+bool BatchingServer::Compatible(const Request& a, const Request& b) {
+  if (a.inputs.size() != b.inputs.size()) return false;
+  for (size_t i = 0; i < a.inputs.size(); ++i) {
+    const DLTensor& x = *a.inputs[i].operator->();
+    const DLTensor& y = *b.inputs[i].operator->();
+    if (DataType(x.dtype) != DataType(y.dtype) || x.ndim != y.ndim ||
+        x.device.device_type != y.device.device_type || x.device.device_id != y.device.device_id) {
+      return false;
+    }
+    for (int k = 1; k < x.ndim; ++k) {
+      if (x.shape[k] != y.shape[k]) return false;
+    }
+  }
+  return true;
+}
+
+void BatchingServer::WorkerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+    if (queue_.empty()) return;
+    auto deadline = queue_.front().arrival + std::chrono::microseconds(config_.timeout_us);
+    cv_.wait_until(lock, deadline,
+                   [this] { return stop_ || queued_rows_ >= config_.max_batch_size; });
+
+    // Take the oldest request and the following ones that fit with it, in arrival order.
+    std::vector<Request> batch;
+    int64_t rows = 0;
+    while (!queue_.empty()) {
+      const Request& next = queue_.front();
+      if (!batch.empty() && (rows + next.rows > config_.max_batch_size ||
+                             !Compatible(batch.front(), next))) {
+        break;
+      }
+      rows += next.rows;
+      batch.push_back(std::move(queue_.front()));
+      queue_.pop_front();
+    }
+    queued_rows_ -= rows;
+
+    lock.unlock();
+    RunBatch(&batch, rows);
+    lock.lock();
+  }
+}
+
+void BatchingServer::RunBatch(std::vector<Request>* batch, int64_t rows) {
+  std::vector<ObjectRef> results;
+  try {
+    size_t num_inputs = batch->front().inputs.size();
+    std::vector<NDArray> inputs;
+    for (size_t i = 0; i < num_inputs; ++i) {
+      std::vector<NDArray> parts;
+      for (const Request& request : *batch) {
+        parts.push_back(request.inputs[i]);
+      }
+      inputs.push_back(ConcatRows(parts, rows));
+    }
+
+    std::vector<TVMValue> values(num_inputs);
+    std::vector<int> codes(num_inputs);
+    TVMArgsSetter setter(values.data(), codes.data());
+    for (size_t i = 0; i < num_inputs; ++i) {
+      setter(i, inputs[i]);
+    }
+    TVMRetValue rv;
+    run_.CallPacked(TVMArgs(values.data(), codes.data(), static_cast<int>(num_inputs)), &rv);
+    ObjectRef outputs = rv.AsObjectRef<ObjectRef>();
+
+    if (batch->size() == 1) {
+      results.push_back(outputs);
+    } else {
+      int64_t begin = 0;
+      for (const Request& request : *batch) {
+        results.push_back(SliceRows(outputs, begin, begin + request.rows, rows));
+        begin += request.rows;
+      }
+    }
+  } catch (const std::exception& e) {
+    for (Request& request : *batch) {
+      request.result.set_exception(std::current_exception());
+      if (request.callback != nullptr) Notify(request.callback, ObjectRef(), e.what());
+    }
+    return;
+  }
+  num_batches_++;
+  for (size_t i = 0; i < batch->size(); ++i) {
+    Request& request = (*batch)[i];
+    request.result.set_value(results[i]);
+    if (request.callback != nullptr) Notify(request.callback, results[i], "");
+  }
+}
+
+void BatchingServer::Notify(const PackedFunc& callback, const ObjectRef& outputs,
+                            const std::string& error) {
+  // An error of a callback must not stop the worker, which serves the other requests.
+  try {
+    callback(outputs, error);
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "The callback of a request failed: " << e.what();
+  }
+}
+
+PackedFunc BatchingServer::GetFunction(const std::string& name,
+                                       const ObjectPtr<Object>& sptr_to_self) {
+  if (name == "infer") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      std::vector<NDArray> inputs;
+      for (int i = 0; i < args.size(); ++i) {
+        inputs.push_back(args[i]);
+      }
+      *rv = Submit(std::move(inputs)).get();
+    });
+  } else if (name == "submit") {
+    // Calls the callback from the worker thread with the outputs, or with None and the error.
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      PackedFunc callback = args[0];
+      std::vector<NDArray> inputs;
+      for (int i = 1; i < args.size(); ++i) {
+        inputs.push_back(args[i]);
+      }
+      this->Submit(std::move(inputs), callback);
+    });
+  } else if (name == "num_batches") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->NumBatches(); });
+  } else {
+    return PackedFunc();
+  }
+}
+
+TVM_REGISTER_GLOBAL("runtime._VMBatchingServer").set_body([](TVMArgs args, TVMRetValue* rv) {
+  ICHECK_EQ(args.num_args, 4) << "The expected arguments of runtime._VMBatchingServer are the "
+                              << "virtual machine, the function name, the maximum batch size and "
+                              << "the timeout in microseconds";
+  Module vm = args[0];
+  std::string func_name = args[1];
+  BatchingConfig config;
+  config.max_batch_size = args[2];
+  config.timeout_us = args[3];
+  PackedFunc set_input = vm.GetFunction("set_input");
+  PackedFunc invoke = vm.GetFunction("invoke");
+  ICHECK(set_input != nullptr && invoke != nullptr) << "Expects a virtual machine module";
+  // The worker thread is the only caller of the virtual machine.
+  PackedFunc run([set_input, invoke, func_name](TVMArgs args, TVMRetValue* rv) {
+    std::vector<TVMValue> values(args.size() + 1);
+    std::vector<int> codes(args.size() + 1);
+    TVMArgsSetter setter(values.data(), codes.data());
+    setter(0, func_name);
+    for (int i = 0; i < args.size(); ++i) {
+      values[i + 1] = args.values[i];
+      codes[i + 1] = args.type_codes[i];
+    }
+    TVMRetValue unused;
+    set_input.CallPacked(TVMArgs(values.data(), codes.data(), args.size() + 1), &unused);
+    *rv = invoke(func_name);
+  });
+  *rv = Module(make_object<BatchingServer>(run, config));
+});
+
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
@@ -0,0 +1,140 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/runtime/vm/batching_server.h
+ * \brief Server batching individual requests into calls of a model with a dynamic batch axis.
+ */
+#ifndef TVM_RUNTIME_VM_BATCHING_SERVER_H_
+#define TVM_RUNTIME_VM_BATCHING_SERVER_H_
+
+#include <tvm/runtime/module.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/packed_func.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+
+/*! \brief How a BatchingServer forms the batches of a model. */
+struct BatchingConfig {
+  /*! \brief The number of rows above which no more requests join a batch. */
+  int64_t max_batch_size = 8;
+  /*!
+   * \brief How long in microseconds the oldest queued request waits for others to join its
+   *  batch before the batch runs anyway.
+   */
+  int64_t timeout_us = 1000;
+};
+
+/*!
+ * \brief Server running a model on batches formed from individual requests.
+ *
+ *  A request is a list of arrays whose outer axis is the batch axis. A worker thread takes the
+ *  queued requests in arrival order, concatenates their inputs along the batch axis and calls the
+ *  model once for the batch. The outputs, an array or a tuple of arrays with the batch axis
+ *  outermost, are scattered back to the requests as views, without a copy. A batch runs as soon
+ *  as it holds max_batch_size rows, or once its oldest request has waited timeout_us.
+ *
+ *  Only requests with the same number of inputs and the same dtype, device and inner shape of
+ *  each input share a batch. Inputs that already lie next to each other in host memory, such as
+ *  consecutive row slices of one array, are batched without a copy, as is a request running
+ *  alone.
+ */
+class TVM_DLL BatchingServer : public ModuleNode {
+ public:
+  /*!
+   * \brief Start a server.
+   * \param run The model, called with the batched inputs and returning an NDArray or an ADT of
+   *  NDArrays, whose outer axis is the batch axis.
+   * \param config How to form the batches.
+   */
+  BatchingServer(PackedFunc run, BatchingConfig config);
+  /*! \brief Run the queued requests, then stop the worker thread. */
+  ~BatchingServer();
+
+  /*!
+   * \brief Queue a request.
+   * \param inputs The inputs of the request, all with the same extent of the batch axis.
+   * \return The outputs of the model for the rows of the request, or the error of its batch.
+   */
+  std::future<ObjectRef> Submit(std::vector<NDArray> inputs);
+  /*!
+   * \brief Queue a request, and call a callback once it has run.
+   * \param inputs The inputs of the request, all with the same extent of the batch axis.
+   * \param callback Called from the worker thread with the outputs and an empty string, or with
+   *  None and the error of the batch.
+   * \return The outputs of the model for the rows of the request, or the error of its batch.
+   */
+  std::future<ObjectRef> Submit(std::vector<NDArray> inputs, PackedFunc callback);
+
+  /*! \brief The number of batches run so far. */
+  int64_t NumBatches() const { return num_batches_.load(); }
+
+  PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self) final;
+
+  const char* type_key() const final { return "VMBatchingServer"; }
+
+ private:
+  struct Request {
+    std::vector<NDArray> inputs;
+    /*! \brief The extent of the batch axis of the inputs. */
+    int64_t rows;
+    std::promise<ObjectRef> result;
+    PackedFunc callback;
+    std::chrono::steady_clock::time_point arrival;
+  };
+
+  /*! \brief Whether two requests can share a batch. */
+  static bool Compatible(const Request& a, const Request& b);
+  /*! \brief Take batches off the queue and run them, until the server stops. */
+  void WorkerLoop();
+  /*! \brief Run a batch of requests holding rows rows in total, and fulfill their results. */
+  void RunBatch(std::vector<Request>* batch, int64_t rows);
+  /*! \brief Call the callback of a request. */
+  static void Notify(const PackedFunc& callback, const ObjectRef& outputs,
+                     const std::string& error);
+
+  PackedFunc run_;
+  BatchingConfig config_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Request> queue_;
+  /*! \brief The number of rows of the queued requests. */
+  int64_t queued_rows_{0};
+  bool stop_{false};
+  std::atomic<int64_t> num_batches_{0};
+  std::thread worker_;
+};
+
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_VM_BATCHING_SERVER_H_
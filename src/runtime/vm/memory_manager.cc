@@ -21,6 +21,9 @@
  * \file tvm/runtime/vm/memory_manager.cc
  * \brief Allocate and manage memory for the runtime.
  */
+#include <tvm/runtime/container/shape_tuple.h>
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/registry.h>
 #include <tvm/runtime/vm/memory_manager.h>
 
 #include <memory>
@@ -39,7 +42,7 @@ static void BufferDeleter(Object* obj) {
   Buffer* buffer = reinterpret_cast<Buffer*>(ptr->manager_ctx);
   MemoryManager::GetAllocator(buffer->device)->Free(*(buffer));
   delete buffer;
-  delete ptr;
+  PooledObjAllocator::Delete(ptr);
 }
 
 void StorageObj::Deleter(Object* obj) {
@@ -55,7 +58,7 @@ void StorageObj::Deleter(Object* obj) {
   // reference count from allocation.
   StorageObj* storage = reinterpret_cast<StorageObj*>(ptr->manager_ctx);
   storage->DecRef();
-  delete ptr;
+  PooledObjAllocator::Delete(ptr);
 }
 
 inline void VerifyDataType(DLDataType dtype) {
@@ -80,9 +83,15 @@ NDArray StorageObj::AllocNDArray(size_t offset, std::vector<int64_t> shape, DLDa
   VerifyDataType(dtype);
 
   // crtical zone: allocate header, cannot throw
-  NDArray::Container* container =
-      new NDArray::Container(this->buffer.data, shape, dtype, this->buffer.device);
-  container->dl_tensor.byte_offset = offset;
+  NDArray::Container* container = PooledObjAllocator::New<NDArray::Container>(
+      this->buffer.data, shape, dtype, this->buffer.device);
+  // Kernels expect the tensors at an offset of a planned storage region to have a zero
+  // byte_offset, so move the data pointer when the device allows it.
+  if (offset != 0 && SupportsDataPointerOffset(this->buffer.device)) {
+    container->dl_tensor.data = static_cast<char*>(this->buffer.data) + offset;
+  } else {
+    container->dl_tensor.byte_offset = offset;
+  }
 
   container->SetDeleter(StorageObj::Deleter);
   size_t needed_size = GetDataSize(container->dl_tensor);
@@ -159,7 +168,8 @@ Allocator* MemoryManager::GetAllocator(Device dev) {
 
 NDArray Allocator::Empty(std::vector<int64_t> shape, DLDataType dtype, DLDevice dev) {
   VerifyDataType(dtype);
-  NDArray::Container* container = new NDArray::Container(nullptr, shape, dtype, dev);
+  NDArray::Container* container =
+      PooledObjAllocator::New<NDArray::Container>(nullptr, shape, dtype, dev);
   container->SetDeleter(BufferDeleter);
   size_t size = GetDataSize(container->dl_tensor);
   size_t alignment = GetDataAlignment(container->dl_tensor);
@@ -170,6 +180,36 @@ NDArray Allocator::Empty(std::vector<int64_t> shape, DLDataType dtype, DLDevice
   return NDArray(GetObjectPtr<Object>(container));
 }
 
+Allocator::Stats Allocator::GetStats() const {
+  return Stats{num_allocs_.load(std::memory_order_relaxed),
+               peak_bytes_.load(std::memory_order_relaxed)};
+}
+
+void Allocator::ResetStats() {
+  num_allocs_ = 0;
+  peak_bytes_ = UsedMemory();
+}
+
+void Allocator::RecordAlloc(size_t used_memory) {
+  num_allocs_.fetch_add(1, std::memory_order_relaxed);
+  size_t peak = peak_bytes_.load(std::memory_order_relaxed);
+  while (used_memory > peak &&
+         !peak_bytes_.compare_exchange_weak(peak, used_memory, std::memory_order_relaxed)) {
+  }
+}
+
+TVM_REGISTER_GLOBAL("runtime.VMAllocatorStats")
+    .set_body_typed([](int device_type, int device_id, bool reset) {
+      Device dev{static_cast<DLDeviceType>(device_type), device_id};
+      Allocator* allocator = MemoryManager::GetAllocator(dev);
+      Allocator::Stats stats = allocator->GetStats();
+      if (reset) {
+        allocator->ResetStats();
+      }
+      return ShapeTuple({static_cast<int64_t>(stats.num_allocs),
+                         static_cast<int64_t>(stats.peak_bytes)});
+    });
+
 }  // namespace vm
 }  // namespace runtime
 }  // namespace tvm
@@ -41,7 +41,7 @@ class NaiveAllocator final : public Allocator {
     buf.device = device_;
     buf.size = nbytes;
     buf.data = DeviceAPI::Get(device_)->AllocDataSpace(device_, nbytes, alignment, type_hint);
-    used_memory_.fetch_add(nbytes, std::memory_order_relaxed);
+    RecordAlloc(used_memory_.fetch_add(nbytes, std::memory_order_relaxed) + nbytes);
     DLOG(INFO) << "allocate " << nbytes << " B, used memory " << used_memory_ << " B";
     return buf;
   }
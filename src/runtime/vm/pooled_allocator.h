@@ -66,7 +66,7 @@ class PooledAllocator final : public Allocator {
       buf.data = DeviceAPI::Get(device_)->AllocDataSpace(device_, size, alignment, type_hint);
     }
 
-    used_memory_.fetch_add(size, std::memory_order_relaxed);
+    RecordAlloc(used_memory_.fetch_add(size, std::memory_order_relaxed) + size);
     VLOG(1) << "allocate " << size << " B, used memory " << used_memory_ << " B";
     return buf;
   }
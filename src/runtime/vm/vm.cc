@@ -36,6 +36,7 @@
 #include <vector>
 
 #include "../file_utils.h"
+#include "../library_module.h"
 
 using namespace tvm::runtime;
 
@@ -68,7 +69,8 @@ inline ObjectRef CopyTo(ObjectRef src, const DLDevice& dev) {
   if (src->IsInstance<NDArray::ContainerType>()) {
     auto nd_array = Downcast<NDArray>(src);
     // TODO(mbs): Should respect device id also.
-    if (nd_array->device.device_type != dev.device_type) {
+    // Operators expect compact arrays, so strided views are copied too.
+    if (nd_array->device.device_type != dev.device_type || !nd_array.IsContiguous()) {
       VLOG(2) << "copying from " << nd_array->device.device_type << " to " << dev.device_type;
       return nd_array.CopyTo(dev);
     }
@@ -359,7 +361,14 @@ void VirtualMachine::InvokePacked(Index packed_index, const PackedFunc& func, In
     }
   }
 
-  if (!is_empty_output) {
+  if (is_empty_output) {
+    return;
+  }
+  if (static_cast<size_t>(packed_index) < packed_cfuncs_.size() &&
+      packed_cfuncs_[packed_index] != nullptr) {
+    CallBackendPackedCFunc(packed_cfuncs_[packed_index], values.data(), codes.data(),
+                           static_cast<int>(arity));
+  } else {
     TVMRetValue rv;
     func.CallPacked(TVMArgs(values.data(), codes.data(), arity), &rv);
   }
@@ -380,10 +389,12 @@ void VirtualMachine::LoadExecutable(const Executable* exec) {
     auto packed_index = static_cast<size_t>(it.second);
     if (packed_funcs_.size() <= packed_index) {
       packed_funcs_.resize(packed_index + 1);
+      packed_cfuncs_.resize(packed_index + 1);
     }
     tvm::runtime::PackedFunc pf = lib.GetFunction(packed_name, /*query_imports=*/true);
     ICHECK(pf != nullptr) << "Cannot find function in module: " << packed_name;
     packed_funcs_[packed_index] = pf;
+    packed_cfuncs_[packed_index] = GetBackendPackedCFunc(pf);
   }
   for (size_t i = 0; i < packed_funcs_.size(); ++i) {
     ICHECK(packed_funcs_[i] != nullptr) << "Packed function " << i << " is not initialized";
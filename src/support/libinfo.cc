@@ -127,6 +127,10 @@
 #define TVM_INFO_USE_FALLBACK_STL_MAP "NOT-FOUND"
 #endif
 
+#ifndef TVM_INFO_USE_OBJECT_POOL
+#define TVM_INFO_USE_OBJECT_POOL "NOT-FOUND"
+#endif
+
 #ifndef TVM_INFO_USE_BYODT_POSIT
 #define TVM_INFO_USE_BYODT_POSIT "NOT-FOUND"
 #endif
@@ -179,6 +183,10 @@
 #define TVM_INFO_USE_RANDOM "NOT-FOUND"
 #endif
 
+#ifndef TVM_INFO_USE_SPARSE
+#define TVM_INFO_USE_SPARSE "NOT-FOUND"
+#endif
+
 #ifndef TVM_INFO_USE_MICRO_STANDALONE_RUNTIME
 #define TVM_INFO_USE_MICRO_STANDALONE_RUNTIME "NOT-FOUND"
 #endif
@@ -254,6 +262,7 @@ TVM_DLL Map<String, String> GetLibInfo() {
       {"HIDE_PRIVATE_SYMBOLS", TVM_INFO_HIDE_PRIVATE_SYMBOLS},
       {"USE_TF_TVMDSOOP", TVM_INFO_USE_TF_TVMDSOOP},
       {"USE_FALLBACK_STL_MAP", TVM_INFO_USE_FALLBACK_STL_MAP},
+      {"USE_OBJECT_POOL", TVM_INFO_USE_OBJECT_POOL},
       {"USE_BYODT_POSIT", TVM_INFO_USE_BYODT_POSIT},
       {"USE_BLAS", TVM_INFO_USE_BLAS},
       {"USE_MKL", TVM_INFO_USE_MKL},
@@ -267,6 +276,7 @@ TVM_DLL Map<String, String> GetLibInfo() {
       {"USE_SORT", TVM_INFO_USE_SORT},
       {"USE_NNPACK", TVM_INFO_USE_NNPACK},
       {"USE_RANDOM", TVM_INFO_USE_RANDOM},
+      {"USE_SPARSE", TVM_INFO_USE_SPARSE},
       {"USE_MICRO_STANDALONE_RUNTIME", TVM_INFO_USE_MICRO_STANDALONE_RUNTIME},
       {"USE_CPP_RPC", TVM_INFO_USE_CPP_RPC},
       {"USE_TFLITE", TVM_INFO_USE_TFLITE},
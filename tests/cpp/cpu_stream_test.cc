@@ -0,0 +1,217 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <tvm/runtime/c_runtime_api.h>
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/ndarray.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "../../src/runtime/graph_executor/graph_executor.h"
+
+using namespace tvm::runtime;
+
+namespace {
+
+constexpr DLDevice kCPU{kDLCPU, 0};
+
+NDArray Filled(int64_t size, uint8_t value) {
+  NDArray arr = NDArray::Empty({size}, {kDLUInt, 8, 1}, kCPU);
+  std::memset(arr->data, value, size);
+  return arr;
+}
+
+bool AllEqual(const NDArray& arr, uint8_t value) {
+  const uint8_t* data = static_cast<const uint8_t*>(arr->data);
+  for (int64_t i = 0; i < arr->shape[0]; ++i) {
+    if (data[i] != value) return false;
+  }
+  return true;
+}
+
+// Stands in for an operator that runs while the inputs of the next run are copied.
+void Compute(const NDArray& arr) {
+  const uint8_t* data = static_cast<const uint8_t*>(arr->data);
+  volatile uint64_t sum = 0;
+  for (int r = 0; r < 4; ++r) {
+    for (int64_t i = 0; i < arr->shape[0]; ++i) {
+      sum += data[i];
+    }
+  }
+}
+
+// Blocks the operator of a run until the test releases it.
+struct Gate {
+  std::atomic<bool> closed{false};
+  std::atomic<bool> waiting{false};
+};
+
+// Provides the operator of the graph in GraphExecutorPrefetch, which adds one to its input.
+class AddOneModule : public ModuleNode {
+ public:
+  explicit AddOneModule(Gate* gate) : gate_(gate) {}
+
+  const char* type_key() const final { return "AddOneModule"; }
+
+  PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self) final {
+    if (name != "add_one") return PackedFunc();
+    Gate* gate = gate_;
+    return PackedFunc([gate](TVMArgs args, TVMRetValue* rv) {
+      gate->waiting = true;
+      while (gate->closed) std::this_thread::yield();
+      gate->waiting = false;
+      DLTensor* in = args[0];
+      DLTensor* out = args[1];
+      const uint8_t* x = static_cast<const uint8_t*>(in->data);
+      uint8_t* y = static_cast<uint8_t*>(out->data);
+      for (int64_t i = 0; i < in->shape[0]; ++i) {
+        y[i] = x[i] + 1;
+      }
+    });
+  }
+
+ private:
+  Gate* gate_;
+};
+
+NDArray GraphInput(uint8_t value) {
+  NDArray x = NDArray::Empty({2, 3}, {kDLUInt, 8, 1}, kCPU);
+  std::memset(x->data, value, 6);
+  return x;
+}
+
+}  // namespace
+
+TEST(CPUStream, AsyncCopy) {
+  constexpr int64_t kSize = 16 << 20;
+  NDArray from = Filled(kSize, 7);
+  NDArray to = Filled(kSize, 0);
+  TVMStreamHandle stream;
+  ASSERT_EQ(TVMStreamCreate(kDLCPU, 0, &stream), 0);
+  ASSERT_NE(stream, nullptr);
+  ASSERT_EQ(TVMArrayCopyFromTo(const_cast<DLTensor*>(from.operator->()),
+                               const_cast<DLTensor*>(to.operator->()), stream),
+            0);
+  ASSERT_EQ(TVMSynchronize(kDLCPU, 0, stream), 0);
+  EXPECT_TRUE(AllEqual(to, 7));
+  ASSERT_EQ(TVMStreamFree(kDLCPU, 0, stream), 0);
+}
+
+TEST(CPUStream, SyncStreamFromTo) {
+  constexpr int64_t kSize = 4 << 20;
+  NDArray a = Filled(kSize, 1);
+  NDArray b = Filled(kSize, 0);
+  NDArray c = Filled(kSize, 0);
+  DeviceAPI* api = DeviceAPI::Get(kCPU);
+  TVMStreamHandle first = api->CreateStream(kCPU);
+  TVMStreamHandle second = api->CreateStream(kCPU);
+  for (int i = 0; i < 8; ++i) {
+    NDArray::CopyFromTo(a.operator->(), const_cast<DLTensor*>(b.operator->()), first);
+    // The copy from b on the second stream waits for the copy to b on the first.
+    api->SyncStreamFromTo(kCPU, first, second);
+    NDArray::CopyFromTo(b.operator->(), const_cast<DLTensor*>(c.operator->()), second);
+    api->StreamSync(kCPU, second);
+    EXPECT_TRUE(AllEqual(c, 1));
+    std::memset(b->data, 0, kSize);
+    std::memset(c->data, 0, kSize);
+  }
+  // Freeing a stream runs its pending copies.
+  NDArray::CopyFromTo(a.operator->(), const_cast<DLTensor*>(c.operator->()), second);
+  api->FreeStream(kCPU, first);
+  api->FreeStream(kCPU, second);
+  EXPECT_TRUE(AllEqual(c, 1));
+}
+
+// Copy the next input on a stream while computing on the current one.
+TEST(CPUStream, CopyOverlapsCompute) {
+  constexpr int64_t kSize = 4 << 20;
+  NDArray next_input = Filled(kSize, 3);
+  NDArray staging = Filled(kSize, 0);
+  NDArray current = Filled(kSize, 1);
+  DeviceAPI* api = DeviceAPI::Get(kCPU);
+  TVMStreamHandle stream = api->CreateStream(kCPU);
+  for (int r = 0; r < 4; ++r) {
+    NDArray::CopyFromTo(next_input.operator->(), const_cast<DLTensor*>(staging.operator->()),
+                        stream);
+    Compute(current);
+    api->StreamSync(kCPU, stream);
+    EXPECT_TRUE(AllEqual(staging, 3));
+    EXPECT_TRUE(AllEqual(current, 1));
+    std::memset(staging->data, 0, kSize);
+  }
+  api->FreeStream(kCPU, stream);
+}
+
+TEST(CPUStream, GraphExecutorPrefetch) {
+  // The reshape of x is a __nop whose output shares the storage of x.
+  const std::string json = R"({
+    "nodes": [
+      {"op": "null", "name": "x", "inputs": []},
+      {"op": "tvm_op", "name": "reshape", "inputs": [[0, 0, 0]],
+       "attrs": {"func_name": "__nop", "num_inputs": "1", "num_outputs": "1",
+                 "flatten_data": "0"}},
+      {"op": "tvm_op", "name": "add_one", "inputs": [[1, 0, 0]],
+       "attrs": {"func_name": "add_one", "num_inputs": "1", "num_outputs": "1",
+                 "flatten_data": "1"}}
+    ],
+    "arg_nodes": [0],
+    "node_row_ptr": [0, 1, 2, 3],
+    "heads": [[2, 0, 0]],
+    "attrs": {
+      "dltype": ["list_str", ["uint8", "uint8", "uint8"]],
+      "shape": ["list_shape", [[2, 3], [6], [6]]],
+      "storage_id": ["list_int", [0, 0, 1]]
+    }
+  })";
+  Gate gate;
+  auto graph = make_object<GraphExecutor>();
+  graph->Init(json, Module(make_object<AddOneModule>(&gate)), {kCPU});
+
+  // Prefetch the input of the next run while a run is in flight, and check that the run
+  // still reads its own input through the reshape.
+  NDArray first = GraphInput(5);
+  graph->PrefetchInput(0, const_cast<DLTensor*>(first.operator->()));
+  for (uint8_t value : {9, 13, 17}) {
+    gate.closed = true;
+    std::thread run([&] { graph->Run(); });
+    while (!gate.waiting) std::this_thread::yield();
+    NDArray next = GraphInput(value);
+    graph->PrefetchInput(0, const_cast<DLTensor*>(next.operator->()), next);
+    // Give the copy time to land before the operator reads its input.
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    gate.closed = false;
+    run.join();
+    EXPECT_TRUE(AllEqual(graph->GetOutput(0), value - 4 + 1));
+  }
+  graph->Run();
+  EXPECT_TRUE(AllEqual(graph->GetOutput(0), 17 + 1));
+
+  // set_input after a prefetch wins.
+  NDArray prefetched = GraphInput(21);
+  NDArray set = GraphInput(30);
+  graph->PrefetchInput(0, const_cast<DLTensor*>(prefetched.operator->()));
+  graph->SetInput(0, const_cast<DLTensor*>(set.operator->()));
+  graph->Run();
+  EXPECT_TRUE(AllEqual(graph->GetOutput(0), 30 + 1));
+}
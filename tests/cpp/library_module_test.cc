@@ -0,0 +1,71 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "../../src/runtime/library_module.h"
+
+#include <gtest/gtest.h>
+#include <tvm/runtime/c_backend_api.h>
+#include <tvm/runtime/packed_func.h>
+
+#include <string>
+
+using namespace tvm::runtime;
+
+namespace {
+
+// Stands in for a generated operator: increments the first element of its float32 argument.
+int AddOneKernel(TVMValue* args, int* type_codes, int num_args, TVMValue* out_ret_value,
+                 int* out_ret_tcode, void* resource_handle) {
+  if (num_args != 1 || type_codes[0] != kTVMDLTensorHandle) {
+    TVMAPISetLastError("AddOneKernel expects one DLTensor");
+    return -1;
+  }
+  static_cast<float*>(static_cast<DLTensor*>(args[0].v_handle)->data)[0] += 1.0f;
+  return 0;
+}
+
+}  // namespace
+
+TEST(LibraryModule, GetBackendPackedCFunc) {
+  PackedFunc wrapped = WrapPackedFunc(AddOneKernel, ObjectPtr<Object>());
+  EXPECT_EQ(GetBackendPackedCFunc(wrapped), AddOneKernel);
+  PackedFunc lambda([](TVMArgs args, TVMRetValue* rv) {});
+  EXPECT_EQ(GetBackendPackedCFunc(lambda), nullptr);
+  EXPECT_EQ(GetBackendPackedCFunc(PackedFunc()), nullptr);
+}
+
+TEST(LibraryModule, CallBackendPackedCFunc) {
+  float data = 0.0f;
+  int64_t shape = 1;
+  DLTensor tensor{&data, {kDLCPU, 0}, 1, {kDLFloat, 32, 1}, &shape, nullptr, 0};
+  TVMValue value;
+  value.v_handle = &tensor;
+  int type_code = kTVMDLTensorHandle;
+  CallBackendPackedCFunc(AddOneKernel, &value, &type_code, 1);
+  EXPECT_EQ(data, 1.0f);
+
+  int wrong_type_code = kTVMNullptr;
+  try {
+    CallBackendPackedCFunc(AddOneKernel, &value, &wrong_type_code, 1);
+    FAIL() << "CallBackendPackedCFunc should raise the error of the function";
+  } catch (const Error& e) {
+    EXPECT_NE(std::string(e.what()).find("AddOneKernel expects one DLTensor"), std::string::npos);
+  }
+}
+
@@ -0,0 +1,158 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <tvm/runtime/ndarray.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace tvm::runtime;
+
+namespace {
+
+constexpr DLDataType kFloat32{kDLFloat, 32, 1};
+constexpr DLDevice kCPU{kDLCPU, 0};
+
+// A rows x cols float32 array holding 0, 1, 2, ... in row-major order.
+NDArray Iota(int64_t rows, int64_t cols) {
+  NDArray arr = NDArray::Empty({rows, cols}, kFloat32, kCPU);
+  float* data = static_cast<float*>(arr->data);
+  for (int64_t i = 0; i < rows * cols; ++i) {
+    data[i] = static_cast<float>(i);
+  }
+  return arr;
+}
+
+float At(const NDArray& arr, int64_t i, int64_t j) {
+  const char* data = static_cast<const char*>(arr->data) + arr->byte_offset;
+  int64_t offset = arr->strides == nullptr ? i * arr->shape[1] + j
+                                           : i * arr->strides[0] + j * arr->strides[1];
+  return reinterpret_cast<const float*>(data)[offset];
+}
+
+// Copy a strided array into a new compact one.
+NDArray Compact(const NDArray& arr) {
+  NDArray ret = NDArray::Empty(arr.Shape(), arr.DataType(), kCPU);
+  ret.CopyFrom(arr);
+  return ret;
+}
+
+}  // namespace
+
+TEST(NDArray, SliceOuterAxis) {
+  NDArray arr = Iota(4, 3);
+  NDArray view = arr.Slice(0, 1, 3);
+  EXPECT_EQ(view->shape[0], 2);
+  EXPECT_EQ(view->shape[1], 3);
+  EXPECT_EQ(view->strides, nullptr);
+  EXPECT_TRUE(view.IsContiguous());
+  EXPECT_EQ(At(view, 0, 0), 3.0f);
+  EXPECT_EQ(At(view, 1, 2), 8.0f);
+  // The view shares the memory of the array and keeps it alive.
+  static_cast<float*>(view->data)[0] = -1.0f;
+  EXPECT_EQ(At(arr, 1, 0), -1.0f);
+  arr = NDArray();
+  EXPECT_EQ(At(view, 1, 1), 7.0f);
+}
+
+TEST(NDArray, SliceInnerAxis) {
+  NDArray arr = Iota(4, 3);
+  NDArray view = arr.Slice(1, 1, 3);
+  EXPECT_EQ(view->shape[0], 4);
+  EXPECT_EQ(view->shape[1], 2);
+  ASSERT_NE(view->strides, nullptr);
+  EXPECT_EQ(view->strides[0], 3);
+  EXPECT_EQ(view->strides[1], 1);
+  EXPECT_FALSE(view.IsContiguous());
+
+  NDArray compact = Compact(view);
+  EXPECT_TRUE(compact.IsContiguous());
+  for (int64_t i = 0; i < 4; ++i) {
+    for (int64_t j = 0; j < 2; ++j) {
+      EXPECT_EQ(At(compact, i, j), static_cast<float>(i * 3 + j + 1));
+    }
+  }
+
+  // Slices of slices, and copies into a strided view.
+  NDArray corner = view.Slice(-2, 2, 4);
+  EXPECT_EQ(At(corner, 1, 1), 11.0f);
+  NDArray zeros = NDArray::Empty({2, 2}, kFloat32, kCPU);
+  std::fill_n(static_cast<float*>(zeros->data), 4, 0.0f);
+  corner.CopyFrom(zeros);
+  EXPECT_EQ(At(arr, 2, 0), 6.0f);
+  EXPECT_EQ(At(arr, 2, 1), 0.0f);
+  EXPECT_EQ(At(arr, 3, 2), 0.0f);
+}
+
+TEST(NDArray, CreateStridedView) {
+  NDArray arr = Iota(4, 3);
+  // The transpose of the array.
+  NDArray transposed = arr.CreateView({3, 4}, {1, 3}, 0);
+  EXPECT_EQ(At(Compact(transposed), 2, 1), 5.0f);
+  // Every other row, starting from the second.
+  NDArray odd_rows = arr.CreateView({2, 3}, {6, 1}, 3);
+  EXPECT_EQ(At(Compact(odd_rows), 1, 0), 9.0f);
+  // A broadcast of the first row.
+  NDArray broadcast = arr.CreateView({5, 3}, {0, 1}, 0);
+  EXPECT_EQ(At(Compact(broadcast), 4, 2), 2.0f);
+  // Strides of axes of extent 1 are ignored.
+  EXPECT_EQ(arr.CreateView({1, 12}, {100, 1}, 0)->strides, nullptr);
+
+  EXPECT_THROW(arr.CreateView({2, 3}, {6, 1}, 4), Error);
+  EXPECT_THROW(arr.CreateView({3, 4}, {1, 3}, -1), Error);
+  EXPECT_THROW(arr.Slice(0, 2, 5), Error);
+  EXPECT_THROW(arr.Slice(2, 0, 1), Error);
+}
+
+TEST(NDArray, FromStridedDLPack) {
+  NDArray arr = Iota(4, 3);
+  int64_t shape[] = {3, 4};
+  int64_t strides[] = {1, 3};
+  DLManagedTensor* tensor = arr.ToDLPack();
+  tensor->dl_tensor.shape = shape;
+  tensor->dl_tensor.strides = strides;
+  NDArray transposed = NDArray::FromDLPack(tensor);
+  // The array owns a copy of the strides.
+  strides[0] = 0;
+  ASSERT_NE(transposed->strides, nullptr);
+  EXPECT_EQ(transposed->strides[0], 1);
+  EXPECT_EQ(At(Compact(transposed), 1, 3), 10.0f);
+
+  int64_t row_shape[] = {1, 12};
+  int64_t row_strides[] = {12, 1};
+  tensor = arr.ToDLPack();
+  tensor->dl_tensor.shape = row_shape;
+  tensor->dl_tensor.strides = row_strides;
+  EXPECT_EQ(NDArray::FromDLPack(tensor)->strides, nullptr);
+}
+
+// Splitting a batch into per-sample arrays with views shares the memory of the batch.
+TEST(NDArray, SplitBatch) {
+  constexpr int64_t kBatch = 8;
+  constexpr int64_t kSampleSize = 3 * 4 * 4;
+  NDArray batch = Iota(kBatch, kSampleSize);
+  for (int64_t i = 0; i < kBatch; ++i) {
+    NDArray sample = batch.Slice(0, i, i + 1);
+    ASSERT_TRUE(sample.IsContiguous());
+    EXPECT_EQ(static_cast<char*>(sample->data) + sample->byte_offset,
+              static_cast<char*>(batch->data) + i * kSampleSize * sizeof(float));
+    EXPECT_EQ(At(sample, 0, kSampleSize - 1), static_cast<float>((i + 1) * kSampleSize - 1));
+  }
+}
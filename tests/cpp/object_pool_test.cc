@@ -0,0 +1,113 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <tvm/runtime/container/adt.h>
+#include <tvm/runtime/container/shape_tuple.h>
+#include <tvm/runtime/memory.h>
+#include <tvm/runtime/ndarray.h>
+
+#include <thread>
+#include <vector>
+
+using namespace tvm::runtime;
+
+namespace {
+
+// The allocations a VM makes for an operator with dynamic output shape: the shape,
+// the output tensor and the tuple of outputs.
+void AllocTensorAndTuple(int64_t n) {
+  ShapeTuple shape{n, 4};
+  NDArray out = NDArray::Empty(shape, {kDLFloat, 32, 1}, {kDLCPU, 0});
+  ADT tuple(0, {out, out});
+  ICHECK_EQ(Downcast<NDArray>(tuple[1]).Shape()[0], n);
+}
+
+}  // namespace
+
+TEST(ObjectPool, ReusesFreedBlocks) {
+  ObjectPool::Stats before = ObjectPool::ThreadStats();
+  for (int i = 0; i < 100; ++i) {
+    ShapeTuple shape{i, 2, 3};
+    EXPECT_EQ(shape[0], i);
+    EXPECT_EQ(shape.size(), 3);
+  }
+  ObjectPool::Stats after = ObjectPool::ThreadStats();
+  if (after.num_reused == before.num_reused) {
+    GTEST_SKIP() << "TVM is built with USE_OBJECT_POOL=OFF";
+  }
+  EXPECT_EQ(after.num_system_allocs - before.num_system_allocs, 1);
+  EXPECT_EQ(after.num_reused - before.num_reused, 99);
+}
+
+TEST(ObjectPool, InplaceArrays) {
+  for (int round = 0; round < 2; ++round) {
+    // Up to 64 fields, which exceeds the largest pooled block.
+    for (size_t num_fields = 0; num_fields <= 64; ++num_fields) {
+      std::vector<ObjectRef> fields;
+      for (size_t i = 0; i < num_fields; ++i) {
+        fields.push_back(ShapeTuple{static_cast<int64_t>(i)});
+      }
+      ADT adt(static_cast<int32_t>(num_fields), fields);
+      ASSERT_EQ(adt.size(), num_fields);
+      EXPECT_EQ(adt.tag(), static_cast<int32_t>(num_fields));
+      for (size_t i = 0; i < num_fields; ++i) {
+        EXPECT_EQ(Downcast<ShapeTuple>(adt[i])[0], static_cast<int64_t>(i));
+      }
+    }
+  }
+}
+
+// Objects may be released by another thread than the one that allocated them,
+// including threads that exit right after.
+TEST(ObjectPool, FreeOnOtherThread) {
+  std::vector<ShapeTuple> shapes;
+  for (int i = 0; i < 1000; ++i) {
+    shapes.push_back(ShapeTuple{i});
+  }
+  std::thread consumer([&shapes]() {
+    for (int i = 0; i < 1000; ++i) {
+      ShapeTuple other{i, i};
+      EXPECT_EQ(other[1], i);
+    }
+    shapes.clear();
+  });
+  consumer.join();
+  EXPECT_TRUE(shapes.empty());
+  for (int i = 0; i < 1000; ++i) {
+    AllocTensorAndTuple(i);
+  }
+}
+
+// Once warmed up, the runtime objects a VM allocates per operator all come from the pool.
+TEST(ObjectPool, SteadyStateAllocations) {
+  constexpr uint64_t kNumCalls = 1000;
+  AllocTensorAndTuple(1);
+  ObjectPool::Stats before = ObjectPool::ThreadStats();
+  for (uint64_t i = 0; i < kNumCalls; ++i) {
+    AllocTensorAndTuple(i % 16);
+  }
+  ObjectPool::Stats after = ObjectPool::ThreadStats();
+  if (after.num_reused == before.num_reused) {
+    GTEST_SKIP() << "TVM is built with USE_OBJECT_POOL=OFF";
+  }
+  EXPECT_EQ(after.num_system_allocs - before.num_system_allocs, 0);
+  // At least the shape, the tensor and the tuple.
+  EXPECT_GE(after.num_reused - before.num_reused, 3 * kNumCalls);
+}
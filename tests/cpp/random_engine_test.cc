@@ -21,6 +21,8 @@
 #include <gtest/gtest.h>
 #include <tvm/support/random_engine.h>
 
+#include "../../src/runtime/contrib/random/philox.h"
+
 TEST(RandomEngine, Randomness) {
   int64_t rand_state = 0;
 
@@ -63,3 +65,20 @@ TEST(RandomEngine, Serialization) {
   rand_state_b = rand_state_a;
   for (int i = 0; i < 100000; i++) ICHECK_EQ(rng_a(), rng_b());
 }
+
+TEST(RandomEngine, Philox4x32KnownAnswer) {
+  // Known answer vectors from the Random123 reference implementation.
+  uint32_t out[4];
+  tvm::contrib::Philox4x32(0)(0, 0, out);
+  ICHECK_EQ(out[0], 0x6627e8d5U);
+  ICHECK_EQ(out[1], 0xe169c58dU);
+  ICHECK_EQ(out[2], 0xbc57ac4cU);
+  ICHECK_EQ(out[3], 0x9b00dbd8U);
+
+  tvm::contrib::Philox4x32 philox(0x299f31d0a4093822ULL);
+  philox(0x85a308d3243f6a88ULL, 0x0370734413198a2eULL, out);
+  ICHECK_EQ(out[0], 0xd16cfe09U);
+  ICHECK_EQ(out[1], 0x94fdccebU);
+  ICHECK_EQ(out[2], 0x5001e420U);
+  ICHECK_EQ(out[3], 0x24126ea1U);
+}
@@ -0,0 +1,98 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <tvm/runtime/packed_func.h>
+#include <tvm/runtime/registry.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tvm::runtime;
+
+namespace {
+
+std::string TestFuncName(int i) { return "testing.registry_test." + std::to_string(i); }
+
+void RegisterTestFunc(int i) {
+  Registry::Register(TestFuncName(i), true).set_body_typed([i]() { return i; });
+}
+
+}  // namespace
+
+TEST(Registry, RegisterRemove) {
+  EXPECT_EQ(Registry::Get(TestFuncName(-1)), nullptr);
+  RegisterTestFunc(-1);
+  const PackedFunc* f = Registry::Get(TestFuncName(-1));
+  ASSERT_NE(f, nullptr);
+  EXPECT_EQ(static_cast<int>((*f)()), -1);
+  EXPECT_TRUE(Registry::Remove(TestFuncName(-1)));
+  EXPECT_EQ(Registry::Get(TestFuncName(-1)), nullptr);
+  EXPECT_FALSE(Registry::Remove(TestFuncName(-1)));
+  RegisterTestFunc(-1);
+  EXPECT_NE(Registry::Get(TestFuncName(-1)), nullptr);
+  EXPECT_TRUE(Registry::Remove(TestFuncName(-1)));
+}
+
+// Lookups run without a lock while another thread registers enough functions to grow the
+// lookup table several times.
+TEST(Registry, ConcurrentGetDuringRegister) {
+  constexpr int kNumStable = 1000;
+  constexpr int kNumAdded = 20000;
+  for (int i = 0; i < kNumStable; ++i) {
+    RegisterTestFunc(i);
+  }
+
+  std::atomic<int> num_errors{0};
+  std::thread writer([&]() {
+    for (int i = kNumStable; i < kNumStable + kNumAdded; ++i) {
+      RegisterTestFunc(i);
+      if (i % 3 == 0) Registry::Remove(TestFuncName(i));
+    }
+  });
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([&, t]() {
+      for (int k = 0; k < 50000; ++k) {
+        int i = (k * 7919 + t) % kNumStable;
+        const PackedFunc* f = Registry::Get(TestFuncName(i));
+        if (f == nullptr || static_cast<int>((*f)()) != i) num_errors++;
+      }
+    });
+  }
+  for (auto& reader : readers) reader.join();
+  writer.join();
+  EXPECT_EQ(num_errors.load(), 0);
+
+  for (int i = kNumStable; i < kNumStable + kNumAdded; ++i) {
+    const PackedFunc* f = Registry::Get(TestFuncName(i));
+    if (i % 3 == 0) {
+      EXPECT_EQ(f, nullptr);
+    } else {
+      ASSERT_NE(f, nullptr);
+      EXPECT_EQ(static_cast<int>((*f)()), i);
+    }
+  }
+  for (int i = 0; i < kNumStable + kNumAdded; ++i) {
+    Registry::Remove(TestFuncName(i));
+  }
+}
+
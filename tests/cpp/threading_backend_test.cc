@@ -17,12 +17,25 @@
  * under the License.
  */
 
+#include <ftw.h>
 #include <gtest/gtest.h>
+#include <sys/stat.h>
 #include <tvm/runtime/c_backend_api.h>
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/runtime/threading_backend.h>
 
+#include <algorithm>
 #include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <string>
 #include <thread>
+#include <vector>
 
 constexpr size_t N = 128;
 
@@ -63,3 +76,143 @@ TEST(ThreadingBackend, TVMBackendParallelLaunchMultipleThreads) {
     }
   }
 }
+
+namespace {
+
+// Write a sysfs file of a simulated topology, creating its directory.
+void WriteSysfsFile(const std::string& root, const std::string& dir, const std::string& name,
+                    const std::string& content) {
+  std::string path = root;
+  for (size_t begin = 0; begin < dir.size();) {
+    size_t end = dir.find('/', begin);
+    if (end == std::string::npos) end = dir.size();
+    path += "/" + dir.substr(begin, end - begin);
+    mkdir(path.c_str(), 0755);
+    begin = end + 1;
+  }
+  std::ofstream(path + "/" + name) << content;
+}
+
+// Remove a directory of a simulated topology with its contents.
+void RemoveTree(const std::string& root) {
+  nftw(
+      root.c_str(),
+      [](const char* path, const struct stat* st, int type, struct FTW* ftw) {
+        return remove(path);
+      },
+      16, FTW_DEPTH | FTW_PHYS);
+}
+
+// Sum the floats of an array in parallel on the thread pool of the calling thread.
+float ParallelSum(const float* data, size_t size) {
+  struct Job {
+    const float* data;
+    size_t size;
+    std::atomic<float> sum{0.0f};
+  } job;
+  job.data = data;
+  job.size = size;
+  TVMBackendParallelLaunch(
+      [](int task_id, TVMParallelGroupEnv* penv, void* cdata) -> int {
+        Job* job = static_cast<Job*>(cdata);
+        size_t chunk = (job->size + penv->num_task - 1) / penv->num_task;
+        size_t end = std::min(job->size, (task_id + 1) * chunk);
+        float sum = 0.0f;
+        for (size_t i = task_id * chunk; i < end; ++i) {
+          sum += job->data[i];
+        }
+        float expected = job->sum.load();
+        while (!job->sum.compare_exchange_weak(expected, expected + sum)) {
+        }
+        return 0;
+      },
+      &job, 0);
+  return job.sum.load();
+}
+
+}  // namespace
+
+TEST(ThreadingBackend, ReadNUMATopology) {
+  char root_template[] = "/tmp/tvm_numa_XXXXXX";
+  ASSERT_NE(mkdtemp(root_template), nullptr);
+  std::string root = root_template;
+  WriteSysfsFile(root, "devices/system/node", "online", "0-1,3\n");
+  WriteSysfsFile(root, "devices/system/node/node0", "cpulist", "0-3,8-11\n");
+  WriteSysfsFile(root, "devices/system/node/node1", "cpulist", "4-7,12-15\n");
+  // A node with memory only.
+  WriteSysfsFile(root, "devices/system/node/node3", "cpulist", "\n");
+
+  using tvm::runtime::threading::NUMANode;
+  std::vector<NUMANode> nodes = tvm::runtime::threading::ReadNUMATopology(root);
+  ASSERT_EQ(nodes.size(), 2);
+  EXPECT_EQ(nodes[0].id, 0);
+  EXPECT_EQ(nodes[0].cpus, (std::vector<unsigned int>{0, 1, 2, 3, 8, 9, 10, 11}));
+  EXPECT_EQ(nodes[1].id, 1);
+  EXPECT_EQ(nodes[1].cpus, (std::vector<unsigned int>{4, 5, 6, 7, 12, 13, 14, 15}));
+
+  // Without NUMA information, all CPUs are on one node.
+  nodes = tvm::runtime::threading::ReadNUMATopology(root + "/missing");
+  ASSERT_EQ(nodes.size(), 1);
+  EXPECT_EQ(nodes[0].cpus.size(), std::max(std::thread::hardware_concurrency(), 1U));
+
+  RemoveTree(root);
+  struct stat st;
+  EXPECT_NE(stat(root.c_str(), &st), 0);
+}
+
+TEST(ThreadingBackend, ConfigThreadPoolOnNUMANode) {
+  using tvm::runtime::threading::NUMATopology;
+  const tvm::runtime::PackedFunc* config_threadpool =
+      tvm::runtime::Registry::Get("runtime.config_threadpool");
+  ASSERT_NE(config_threadpool, nullptr);
+  std::vector<float> data(N, 1.0f);
+  for (int node = 0; node < static_cast<int>(NUMATopology().size()); ++node) {
+    (*config_threadpool)(2, 0, node);
+    EXPECT_EQ(tvm::runtime::threading::PreferredNUMANode(), NUMATopology().size() > 1 ? node : -1);
+    EXPECT_EQ(ParallelSum(data.data(), N), static_cast<float>(N));
+  }
+  EXPECT_THROW((*config_threadpool)(2, 0, static_cast<int>(NUMATopology().size())),
+               tvm::runtime::Error);
+  (*config_threadpool)(1, 0);
+  EXPECT_EQ(tvm::runtime::threading::PreferredNUMANode(), -1);
+  EXPECT_EQ(ParallelSum(data.data(), N), static_cast<float>(N));
+}
+
+TEST(ThreadingBackend, RunPerNUMANode) {
+  std::mutex mutex;
+  std::set<int> nodes;
+  std::vector<float> data(N, 1.0f);
+  tvm::runtime::threading::RunPerNUMANode([&](int node) {
+    EXPECT_EQ(ParallelSum(data.data(), N), static_cast<float>(N));
+    std::lock_guard<std::mutex> lock(mutex);
+    nodes.insert(node);
+  });
+  EXPECT_EQ(nodes.size(), tvm::runtime::threading::NUMATopology().size());
+
+  EXPECT_THROW(tvm::runtime::threading::RunPerNUMANode([](int node) {
+                 if (node == 0) LOG(FATAL) << "replica failed";
+               }),
+               tvm::runtime::Error);
+}
+
+// Serve requests with one replica per NUMA node, each with its own memory. Set
+// TVM_NUMA_SYSFS_ROOT to simulate a topology on a machine with one node.
+TEST(ThreadingBackend, NUMAReplicas) {
+  constexpr size_t kSize = 1 << 20;
+  constexpr int kNumRequests = 4;
+  DLDevice cpu{kDLCPU, 0};
+  DLDataType float32{kDLFloat, 32, 1};
+  tvm::runtime::DeviceAPI* api = tvm::runtime::DeviceAPI::Get(cpu);
+  std::atomic<int> num_replicas{0};
+  tvm::runtime::threading::RunPerNUMANode([&](int node) {
+    float* data =
+        static_cast<float*>(api->AllocDataSpace(cpu, kSize * sizeof(float), 64, float32));
+    std::fill_n(data, kSize, 1.0f);
+    for (int r = 0; r < kNumRequests; ++r) {
+      EXPECT_EQ(ParallelSum(data, kSize), static_cast<float>(kSize));
+    }
+    api->FreeDataSpace(cpu, data);
+    ++num_replicas;
+  });
+  EXPECT_EQ(num_replicas.load(), static_cast<int>(tvm::runtime::threading::NUMATopology().size()));
+}
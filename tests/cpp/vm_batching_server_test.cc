@@ -0,0 +1,146 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <tvm/runtime/container/adt.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/packed_func.h>
+
+#include <atomic>
+#include <vector>
+
+#include "../../src/runtime/vm/batching_server.h"
+
+using namespace tvm::runtime;
+using namespace tvm::runtime::vm;
+
+namespace {
+
+constexpr DLDevice kCPU{kDLCPU, 0};
+constexpr int64_t kWidth = 4;
+
+NDArray Rows(int64_t rows, float first, int64_t width = kWidth) {
+  NDArray arr = NDArray::Empty({rows, width}, {kDLFloat, 32, 1}, kCPU);
+  float* data = static_cast<float*>(arr->data);
+  for (int64_t i = 0; i < rows * width; ++i) {
+    data[i] = first + i;
+  }
+  return arr;
+}
+
+void ExpectDoubled(const NDArray& out, const NDArray& in) {
+  ASSERT_EQ(out->shape[0], in->shape[0]);
+  ASSERT_EQ(out->shape[1], in->shape[1]);
+  const float* x = static_cast<const float*>(in->data);
+  const float* y = static_cast<const float*>(out->data);
+  for (int64_t i = 0; i < in->shape[0] * in->shape[1]; ++i) {
+    EXPECT_EQ(y[i], 2 * x[i]);
+  }
+}
+
+// Stands in for a model with a dynamic batch axis, which returns twice its input and the sum of
+// each row of its input. It records the data pointer and byte_offset of its last input in
+// last_input and last_offset, if given.
+PackedFunc Model(std::atomic<const void*>* last_input = nullptr,
+                 std::atomic<uint64_t>* last_offset = nullptr) {
+  return PackedFunc([=](TVMArgs args, TVMRetValue* rv) {
+    NDArray x = args[0];
+    if (last_input) *last_input = x->data;
+    if (last_offset) *last_offset = x->byte_offset;
+    int64_t rows = x->shape[0];
+    int64_t width = x->shape[1];
+    NDArray doubled = NDArray::Empty({rows, width}, x->dtype, kCPU);
+    NDArray sums = NDArray::Empty({rows}, x->dtype, kCPU);
+    const float* in = static_cast<const float*>(x->data);
+    float* out = static_cast<float*>(doubled->data);
+    float* sum = static_cast<float*>(sums->data);
+    for (int64_t r = 0; r < rows; ++r) {
+      sum[r] = 0;
+      for (int64_t c = 0; c < width; ++c) {
+        out[r * width + c] = 2 * in[r * width + c];
+        sum[r] += in[r * width + c];
+      }
+    }
+    *rv = ADT(0, std::vector<ObjectRef>{doubled, sums});
+  });
+}
+
+}  // namespace
+
+TEST(VMBatchingServer, ScattersOutputs) {
+  auto server = make_object<BatchingServer>(Model(), BatchingConfig{8, 50000});
+  std::vector<NDArray> inputs;
+  std::vector<std::future<ObjectRef>> results;
+  for (int i = 0; i < 6; ++i) {
+    inputs.push_back(Rows(1 + i % 3, 100 * i));
+    results.push_back(server->Submit({inputs.back()}));
+  }
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    ADT outputs = Downcast<ADT>(results[i].get());
+    ExpectDoubled(Downcast<NDArray>(outputs[0]), inputs[i]);
+    NDArray sums = Downcast<NDArray>(outputs[1]);
+    ASSERT_EQ(sums->shape[0], inputs[i]->shape[0]);
+  }
+  // 12 rows run in batches of at most 8 rows, or in more batches when the submits are slow.
+  EXPECT_GE(server->NumBatches(), 2);
+  EXPECT_LE(server->NumBatches(), 6);
+}
+
+TEST(VMBatchingServer, SeparatesIncompatibleRequests) {
+  auto server = make_object<BatchingServer>(Model(), BatchingConfig{8, 1000});
+  NDArray wide = Rows(2, 0);
+  NDArray narrow = Rows(2, 0, 2);
+  std::future<ObjectRef> wide_out = server->Submit({wide});
+  std::future<ObjectRef> narrow_out = server->Submit({narrow});
+  ExpectDoubled(Downcast<NDArray>(Downcast<ADT>(wide_out.get())[0]), wide);
+  ExpectDoubled(Downcast<NDArray>(Downcast<ADT>(narrow_out.get())[0]), narrow);
+  EXPECT_EQ(server->NumBatches(), 2);
+}
+
+TEST(VMBatchingServer, BatchesAdjacentRowsWithoutCopy) {
+  std::atomic<const void*> last_input{nullptr};
+  std::atomic<uint64_t> last_offset{1};
+  auto server = make_object<BatchingServer>(Model(&last_input, &last_offset),
+                                            BatchingConfig{8, 1000000});
+  // The batch starts at row 8 of the array, an aligned address past its data pointer.
+  NDArray all = Rows(16, 0);
+  constexpr int64_t kFirstRow = 8;
+  std::vector<std::future<ObjectRef>> results;
+  for (int64_t i = kFirstRow; i < 16; i += 2) {
+    results.push_back(server->Submit({all.Slice(0, i, i + 2)}));
+  }
+  for (size_t i = 0; i < results.size(); ++i) {
+    int64_t begin = kFirstRow + 2 * i;
+    ExpectDoubled(Downcast<NDArray>(Downcast<ADT>(results[i].get())[0]),
+                  all.Slice(0, begin, begin + 2));
+  }
+  EXPECT_EQ(server->NumBatches(), 1);
+  EXPECT_EQ(last_input.load(), static_cast<const float*>(all->data) + kFirstRow * kWidth);
+  EXPECT_EQ(last_offset.load(), 0U);
+}
+
+TEST(VMBatchingServer, PropagatesErrors) {
+  PackedFunc failing([](TVMArgs args, TVMRetValue* rv) { LOG(FATAL) << "model failed"; });
+  auto server = make_object<BatchingServer>(failing, BatchingConfig{4, 1000});
+  std::future<ObjectRef> first = server->Submit({Rows(1, 0)});
+  std::future<ObjectRef> second = server->Submit({Rows(1, 0)});
+  EXPECT_THROW(first.get(), Error);
+  EXPECT_THROW(second.get(), Error);
+  EXPECT_THROW(server->Submit({NDArray::Empty({}, {kDLFloat, 32, 1}, kCPU)}), Error);
+}
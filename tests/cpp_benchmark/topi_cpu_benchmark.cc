@@ -0,0 +1,331 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file topi_cpu_benchmark.cc
+ * \brief Micro-benchmarks of the code generated for TOPI operators on the host CPU.
+ *
+ *  Every case builds one operator with its default x86 schedule, runs it until a minimum time
+ *  has elapsed and reports the time per call together with GFLOP/s and GB/s. The bandwidth
+ *  counts every input and output byte once. Results are printed as a table and can be written
+ *  as JSON, in a layout close to the one of Google Benchmark, to compare TVM versions:
+ *
+ *    cppbench --target "llvm -mcpu=skylake-avx512" --json out.json --filter dense
+ */
+#include <dmlc/json.h>
+#include <tvm/driver/driver_api.h>
+#include <tvm/runtime/logging.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/threading_backend.h>
+#include <tvm/te/operation.h>
+#include <tvm/topi/broadcast.h>
+#include <tvm/topi/nn.h>
+#include <tvm/topi/nn/dense.h>
+#include <tvm/topi/nn/pooling.h>
+#include <tvm/topi/nn/softmax.h>
+#include <tvm/topi/reduction.h>
+#include <tvm/topi/transform.h>
+#include <tvm/topi/x86/default.h>
+#include <tvm/topi/x86/injective.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace tvm {
+namespace topi {
+namespace benchmark {
+
+/*! \brief The measurement of one case. */
+struct BenchmarkResult {
+  std::string name;
+  int64_t iterations;
+  double mean_ms;
+  double min_ms;
+  double gflops;
+  double gbps;
+};
+
+}  // namespace benchmark
+}  // namespace topi
+}  // namespace tvm
+
+namespace dmlc {
+namespace json {
+template <>
+struct Handler<tvm::topi::benchmark::BenchmarkResult> {
+  inline static void Write(dmlc::JSONWriter* writer,
+                           const tvm::topi::benchmark::BenchmarkResult& r) {
+    writer->BeginObject();
+    writer->WriteObjectKeyValue("name", r.name);
+    writer->WriteObjectKeyValue("iterations", r.iterations);
+    writer->WriteObjectKeyValue("real_time", r.mean_ms);
+    writer->WriteObjectKeyValue("min_time", r.min_ms);
+    writer->WriteObjectKeyValue("time_unit", std::string("ms"));
+    writer->WriteObjectKeyValue("gflops_per_second", r.gflops);
+    writer->WriteObjectKeyValue("gbytes_per_second", r.gbps);
+    writer->EndObject();
+  }
+};
+}  // namespace json
+}  // namespace dmlc
+
+namespace tvm {
+namespace topi {
+namespace benchmark {
+
+using namespace tvm::te;
+using runtime::NDArray;
+
+/*! \brief An operator to benchmark. */
+struct BenchmarkCase {
+  /*! \brief The name of the case, the operator followed by its shapes. */
+  std::string name;
+  /*! \brief Create the input placeholders and the output tensor. */
+  std::function<Array<Tensor>()> fcompute;
+  /*! \brief Create the schedule of the output tensor. */
+  std::function<Schedule(const Target&, const Array<Tensor>&)> fschedule;
+  /*! \brief The number of floating point operations of one call, 0 for data movement ops. */
+  double flops;
+};
+
+int64_t TensorBytes(const Tensor& t) {
+  int64_t size = (t->dtype.bits() * t->dtype.lanes() + 7) / 8;
+  for (const PrimExpr& dim : t->shape) {
+    const auto* imm = dim.as<IntImmNode>();
+    ICHECK(imm != nullptr) << "Benchmark shapes must be static";
+    size *= imm->value;
+  }
+  return size;
+}
+
+NDArray Empty(const Tensor& t, Device dev) {
+  std::vector<int64_t> shape;
+  for (const PrimExpr& dim : t->shape) shape.push_back(dim.as<IntImmNode>()->value);
+  return NDArray::Empty(shape, t->dtype, dev);
+}
+
+void FillRandom(NDArray arr) {
+  // A fixed linear congruential sequence keeps the inputs identical across runs and builds.
+  uint32_t state = 42;
+  int64_t n = 1;
+  for (int64_t dim : arr.Shape()) n *= dim;
+  if (arr->dtype.code != kDLFloat || arr->dtype.bits != 32) return;
+  float* data = static_cast<float*>(arr->data);
+  for (int64_t i = 0; i < n; ++i) {
+    state = state * 1664525u + 1013904223u;
+    data[i] = static_cast<float>(state >> 8) / static_cast<float>(1 << 24) - 0.5f;
+  }
+}
+
+BenchmarkResult Run(const BenchmarkCase& bench, const Target& target, double min_time_ms) {
+  Array<Tensor> tensors = bench.fcompute();
+  Schedule s = bench.fschedule(target, {tensors.back()});
+  std::unordered_map<Tensor, tir::Buffer> binds;
+  IRModule lowered = LowerSchedule(s, tensors, "default", binds);
+  runtime::Module mod = build(lowered, target, Target());
+  runtime::PackedFunc func = mod.GetFunction("default");
+  ICHECK(func != nullptr);
+
+  Device dev{kDLCPU, 0};
+  std::vector<NDArray> args;
+  std::vector<TVMValue> values(tensors.size());
+  std::vector<int> type_codes(tensors.size());
+  runtime::TVMArgsSetter setter(values.data(), type_codes.data());
+  int64_t bytes = 0;
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    args.push_back(Empty(tensors[i], dev));
+    FillRandom(args.back());
+    setter(i, args.back());
+    bytes += TensorBytes(tensors[i]);
+  }
+  runtime::TVMArgs call_args(values.data(), type_codes.data(), static_cast<int>(values.size()));
+  runtime::TVMRetValue rv;
+
+  // Warm up the caches and the thread pool before timing.
+  func.CallPacked(call_args, &rv);
+  int64_t iterations = 0;
+  double total_ms = 0, min_ms = 0;
+  while (total_ms < min_time_ms || iterations < 3) {
+    auto start = std::chrono::high_resolution_clock::now();
+    func.CallPacked(call_args, &rv);
+    auto stop = std::chrono::high_resolution_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(stop - start).count();
+    min_ms = iterations == 0 ? ms : std::min(min_ms, ms);
+    total_ms += ms;
+    ++iterations;
+  }
+  BenchmarkResult result;
+  result.name = bench.name;
+  result.iterations = iterations;
+  result.mean_ms = total_ms / iterations;
+  result.min_ms = min_ms;
+  result.gflops = bench.flops / result.mean_ms / 1e6;
+  result.gbps = static_cast<double>(bytes) / result.mean_ms / 1e6;
+  return result;
+}
+
+Schedule DefaultSchedule(const Target& target, const Array<Tensor>& outs) {
+  return x86::default_schedule(target, outs);
+}
+
+Schedule InjectiveSchedule(const Target& target, const Array<Tensor>& outs) {
+  return x86::schedule_injective(target, outs);
+}
+
+Tensor Input(const Array<PrimExpr>& shape, const std::string& name) {
+  return placeholder(shape, DataType::Float(32), name);
+}
+
+std::vector<BenchmarkCase> Cases() {
+  std::vector<BenchmarkCase> cases;
+  // ResNet-50 stage 1 3x3 convolution.
+  cases.push_back({"conv2d_nchw/1x64x56x56/64x64x3x3",
+                   [] {
+                     Tensor data = Input({1, 64, 56, 56}, "data");
+                     Tensor kernel = Input({64, 64, 3, 3}, "kernel");
+                     return Array<Tensor>{data, kernel, conv2d_nchw(data, kernel, 1, 1, 1, 1)};
+                   },
+                   DefaultSchedule, 2.0 * 64 * 56 * 56 * 64 * 9});
+  // BERT-base projection.
+  cases.push_back({"dense/128x768/768x768",
+                   [] {
+                     Tensor data = Input({128, 768}, "data");
+                     Tensor weight = Input({768, 768}, "weight");
+                     return Array<Tensor>{data, weight,
+                                          nn::dense(data, weight, Tensor(), DataType::Float(32))};
+                   },
+                   DefaultSchedule, 2.0 * 128 * 768 * 768});
+  cases.push_back({"softmax/128x1000",
+                   [] {
+                     Tensor data = Input({128, 1000}, "data");
+                     return Array<Tensor>{data, nn::softmax(data, -1)};
+                   },
+                   DefaultSchedule, 4.0 * 128 * 1000});
+  cases.push_back({"max_pool2d/1x64x112x112/3x3s2",
+                   [] {
+                     Tensor data = Input({1, 64, 112, 112}, "data");
+                     return Array<Tensor>{data, nn::pool2d(data, {3, 3}, {2, 2}, {1, 1},
+                                                           {1, 1, 1, 1}, nn::kMaxPool, false)};
+                   },
+                   DefaultSchedule, 9.0 * 64 * 56 * 56});
+  cases.push_back({"avg_pool2d/1x64x112x112/3x3s2",
+                   [] {
+                     Tensor data = Input({1, 64, 112, 112}, "data");
+                     return Array<Tensor>{data, nn::pool2d(data, {3, 3}, {2, 2}, {1, 1},
+                                                           {1, 1, 1, 1}, nn::kAvgPool, false)};
+                   },
+                   DefaultSchedule, 10.0 * 64 * 56 * 56});
+  cases.push_back({"sum/1024x1024/axis1",
+                   [] {
+                     Tensor data = Input({1024, 1024}, "data");
+                     return Array<Tensor>{data, topi::sum(data, {1})};
+                   },
+                   DefaultSchedule, 1024.0 * 1024});
+  cases.push_back({"max/1024x1024/axis0",
+                   [] {
+                     Tensor data = Input({1024, 1024}, "data");
+                     return Array<Tensor>{data, topi::max(data, {0})};
+                   },
+                   DefaultSchedule, 1024.0 * 1024});
+  cases.push_back({"add/1x64x56x56/1x64x1x1",
+                   [] {
+                     Tensor lhs = Input({1, 64, 56, 56}, "lhs");
+                     Tensor rhs = Input({1, 64, 1, 1}, "rhs");
+                     return Array<Tensor>{lhs, rhs, topi::add(lhs, rhs)};
+                   },
+                   InjectiveSchedule, 64.0 * 56 * 56});
+  cases.push_back({"relu/1x256x56x56",
+                   [] {
+                     Tensor data = Input({1, 256, 56, 56}, "data");
+                     return Array<Tensor>{data, relu<float>(data)};
+                   },
+                   InjectiveSchedule, 256.0 * 56 * 56});
+  cases.push_back({"transpose/1024x1024",
+                   [] {
+                     Tensor data = Input({1024, 1024}, "data");
+                     return Array<Tensor>{data, topi::transpose(data, {1, 0})};
+                   },
+                   InjectiveSchedule, 0});
+  return cases;
+}
+
+void WriteJSON(const std::string& path, const std::string& target,
+               const std::vector<BenchmarkResult>& results) {
+  std::ofstream os(path);
+  ICHECK(os.good()) << "Cannot open " << path;
+  dmlc::JSONWriter writer(&os);
+  writer.BeginObject();
+  std::map<std::string, std::string> context;
+  context["target"] = target;
+  context["num_threads"] = std::to_string(runtime::threading::MaxConcurrency());
+  writer.WriteObjectKeyValue("context", context);
+  writer.WriteObjectKeyValue("benchmarks", results);
+  writer.EndObject();
+  os << "\n";
+}
+
+int Main(int argc, char** argv) {
+  std::string target = "llvm";
+  std::string filter;
+  std::string json_path;
+  double min_time_ms = 500;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    ICHECK(i + 1 < argc) << "Missing value for " << arg;
+    if (arg == "--target") {
+      target = argv[++i];
+    } else if (arg == "--filter") {
+      filter = argv[++i];
+    } else if (arg == "--json") {
+      json_path = argv[++i];
+    } else if (arg == "--min_time_ms") {
+      min_time_ms = std::stod(argv[++i]);
+    } else {
+      LOG(FATAL) << "Unknown argument " << arg
+                 << ", expected --target, --filter, --json or --min_time_ms";
+    }
+  }
+
+  std::vector<BenchmarkResult> results;
+  std::printf("%-40s %10s %12s %12s %10s %10s\n", "name", "iterations", "mean (ms)", "min (ms)",
+              "GFLOP/s", "GB/s");
+  for (const BenchmarkCase& bench : Cases()) {
+    if (bench.name.find(filter) == std::string::npos) continue;
+    BenchmarkResult r = Run(bench, Target(target), min_time_ms);
+    std::printf("%-40s %10ld %12.4f %12.4f %10.2f %10.2f\n", r.name.c_str(),
+                static_cast<long>(r.iterations), r.mean_ms, r.min_ms, r.gflops, r.gbps);
+    results.push_back(r);
+  }
+  if (!json_path.empty()) {
+    WriteJSON(json_path, target, results);
+  }
+  return 0;
+}
+
+}  // namespace benchmark
+}  // namespace topi
+}  // namespace tvm
+
+int main(int argc, char** argv) { return tvm::topi::benchmark::Main(argc, argv); }
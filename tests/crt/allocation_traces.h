@@ -0,0 +1,191 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file allocation_traces.h
+ * \brief Memory allocation traces replayed by the allocator tests.
+ */
+
+#ifndef TESTS_CRT_ALLOCATION_TRACES_H_
+#define TESTS_CRT_ALLOCATION_TRACES_H_
+
+#include <stddef.h>
+
+/*! \brief One call in an allocation trace. */
+struct AllocationTraceOp {
+  /*! \brief 'a' to allocate num_bytes as the block id, 'f' to free the block id. */
+  char op;
+  /*! \brief Id of the block, reused once the block is freed. */
+  int id;
+  size_t num_bytes;
+};
+
+/*!
+ * \brief Calls to TVMPlatformMemoryAllocate and TVMPlatformMemoryFree made by the CRT graph
+ *  executor for MobileNetV1 (224x224, int8, parameters not linked): graph loading and setup, three
+ *  inferences, and release. The operators allocate the workspaces of the generated kernels, a
+ *  padded input for 3x3 convolutions and per-channel requantization parameters.
+ */
+static const AllocationTraceOp kMobileNetV1Trace[] = {
+    {'a', 0, 272}, {'a', 1, 48}, {'a', 2, 800}, {'a', 3, 8338}, {'a', 4, 48}, {'a', 5, 40},
+    {'f', 5, 0}, {'f', 4, 0}, {'a', 4, 22656}, {'a', 5, 48}, {'a', 6, 40}, {'f', 6, 0}, {'f', 5, 0},
+    {'a', 5, 0}, {'a', 6, 48}, {'a', 7, 40}, {'f', 7, 0}, {'f', 6, 0}, {'a', 6, 0}, {'a', 7, 48},
+    {'a', 8, 40}, {'f', 8, 0}, {'f', 7, 0}, {'a', 7, 24}, {'a', 8, 48}, {'a', 9, 40}, {'f', 9, 0},
+    {'f', 8, 0}, {'a', 8, 0}, {'a', 9, 48}, {'a', 10, 40}, {'f', 10, 0}, {'f', 9, 0}, {'a', 9, 24},
+    {'a', 10, 48}, {'a', 11, 40}, {'f', 11, 0}, {'f', 10, 0}, {'a', 10, 0}, {'a', 11, 48},
+    {'a', 12, 40}, {'f', 12, 0}, {'f', 11, 0}, {'a', 11, 24}, {'a', 12, 48}, {'a', 13, 40},
+    {'f', 13, 0}, {'f', 12, 0}, {'a', 12, 0}, {'a', 13, 48}, {'a', 14, 40}, {'f', 14, 0},
+    {'f', 13, 0}, {'a', 13, 24}, {'a', 14, 48}, {'a', 15, 40}, {'f', 15, 0}, {'f', 14, 0},
+    {'a', 14, 0}, {'a', 15, 48}, {'a', 16, 40}, {'f', 16, 0}, {'f', 15, 0}, {'a', 15, 24},
+    {'a', 16, 48}, {'a', 17, 40}, {'f', 17, 0}, {'f', 16, 0}, {'a', 16, 0}, {'a', 17, 48},
+    {'a', 18, 40}, {'f', 18, 0}, {'f', 17, 0}, {'a', 17, 24}, {'a', 18, 48}, {'a', 19, 40},
+    {'f', 19, 0}, {'f', 18, 0}, {'a', 18, 0}, {'a', 19, 48}, {'a', 20, 40}, {'f', 20, 0},
+    {'f', 19, 0}, {'a', 19, 24}, {'a', 20, 48}, {'a', 21, 40}, {'f', 21, 0}, {'f', 20, 0},
+    {'a', 20, 0}, {'a', 21, 48}, {'a', 22, 40}, {'f', 22, 0}, {'f', 21, 0}, {'a', 21, 24},
+    {'a', 22, 48}, {'a', 23, 40}, {'f', 23, 0}, {'f', 22, 0}, {'a', 22, 0}, {'a', 23, 48},
+    {'a', 24, 40}, {'f', 24, 0}, {'f', 23, 0}, {'a', 23, 24}, {'a', 24, 48}, {'a', 25, 40},
+    {'f', 25, 0}, {'f', 24, 0}, {'a', 24, 0}, {'a', 25, 48}, {'a', 26, 40}, {'f', 26, 0},
+    {'f', 25, 0}, {'a', 25, 24}, {'a', 26, 48}, {'a', 27, 40}, {'f', 27, 0}, {'f', 26, 0},
+    {'a', 26, 0}, {'a', 27, 48}, {'a', 28, 40}, {'f', 28, 0}, {'f', 27, 0}, {'a', 27, 24},
+    {'a', 28, 48}, {'a', 29, 40}, {'f', 29, 0}, {'f', 28, 0}, {'a', 28, 0}, {'a', 29, 48},
+    {'a', 30, 40}, {'f', 30, 0}, {'f', 29, 0}, {'a', 29, 24}, {'a', 30, 48}, {'a', 31, 40},
+    {'f', 31, 0}, {'f', 30, 0}, {'a', 30, 0}, {'a', 31, 48}, {'a', 32, 40}, {'f', 32, 0},
+    {'f', 31, 0}, {'a', 31, 24}, {'a', 32, 48}, {'a', 33, 40}, {'f', 33, 0}, {'f', 32, 0},
+    {'a', 32, 0}, {'a', 33, 48}, {'a', 34, 40}, {'f', 34, 0}, {'f', 33, 0}, {'a', 33, 24},
+    {'a', 34, 48}, {'a', 35, 40}, {'f', 35, 0}, {'f', 34, 0}, {'a', 34, 0}, {'a', 35, 48},
+    {'a', 36, 40}, {'f', 36, 0}, {'f', 35, 0}, {'a', 35, 24}, {'a', 36, 48}, {'a', 37, 40},
+    {'f', 37, 0}, {'f', 36, 0}, {'a', 36, 0}, {'a', 37, 48}, {'a', 38, 40}, {'f', 38, 0},
+    {'f', 37, 0}, {'a', 37, 24}, {'a', 38, 48}, {'a', 39, 40}, {'f', 39, 0}, {'f', 38, 0},
+    {'a', 38, 0}, {'a', 39, 48}, {'a', 40, 40}, {'f', 40, 0}, {'f', 39, 0}, {'a', 39, 24},
+    {'a', 40, 48}, {'a', 41, 40}, {'f', 41, 0}, {'f', 40, 0}, {'a', 40, 0}, {'a', 41, 48},
+    {'a', 42, 40}, {'f', 42, 0}, {'f', 41, 0}, {'a', 41, 24}, {'a', 42, 48}, {'a', 43, 40},
+    {'f', 43, 0}, {'f', 42, 0}, {'a', 42, 0}, {'a', 43, 48}, {'a', 44, 40}, {'f', 44, 0},
+    {'f', 43, 0}, {'a', 43, 24}, {'a', 44, 48}, {'a', 45, 40}, {'f', 45, 0}, {'f', 44, 0},
+    {'a', 44, 0}, {'a', 45, 48}, {'a', 46, 40}, {'f', 46, 0}, {'f', 45, 0}, {'a', 45, 24},
+    {'a', 46, 48}, {'a', 47, 40}, {'f', 47, 0}, {'f', 46, 0}, {'a', 46, 0}, {'a', 47, 48},
+    {'a', 48, 40}, {'f', 48, 0}, {'f', 47, 0}, {'a', 47, 24}, {'a', 48, 48}, {'a', 49, 40},
+    {'f', 49, 0}, {'f', 48, 0}, {'a', 48, 0}, {'a', 49, 48}, {'a', 50, 40}, {'f', 50, 0},
+    {'f', 49, 0}, {'a', 49, 24}, {'a', 50, 48}, {'a', 51, 40}, {'f', 51, 0}, {'f', 50, 0},
+    {'a', 50, 0}, {'a', 51, 48}, {'a', 52, 40}, {'f', 52, 0}, {'f', 51, 0}, {'a', 51, 24},
+    {'a', 52, 48}, {'a', 53, 40}, {'f', 53, 0}, {'f', 52, 0}, {'a', 52, 0}, {'a', 53, 48},
+    {'a', 54, 40}, {'f', 54, 0}, {'f', 53, 0}, {'a', 53, 24}, {'a', 54, 48}, {'a', 55, 40},
+    {'f', 55, 0}, {'f', 54, 0}, {'a', 54, 0}, {'a', 55, 48}, {'a', 56, 40}, {'f', 56, 0},
+    {'f', 55, 0}, {'a', 55, 24}, {'a', 56, 48}, {'a', 57, 40}, {'f', 57, 0}, {'f', 56, 0},
+    {'a', 56, 0}, {'a', 57, 48}, {'a', 58, 40}, {'f', 58, 0}, {'f', 57, 0}, {'a', 57, 24},
+    {'a', 58, 48}, {'a', 59, 40}, {'f', 59, 0}, {'f', 58, 0}, {'a', 58, 0}, {'a', 59, 48},
+    {'a', 60, 40}, {'f', 60, 0}, {'f', 59, 0}, {'a', 59, 24}, {'a', 60, 48}, {'a', 61, 40},
+    {'f', 61, 0}, {'f', 60, 0}, {'a', 60, 12}, {'a', 61, 48}, {'a', 62, 40}, {'f', 62, 0},
+    {'f', 61, 0}, {'a', 61, 0}, {'a', 62, 48}, {'a', 63, 40}, {'f', 63, 0}, {'f', 62, 0},
+    {'a', 62, 24}, {'a', 63, 48}, {'a', 64, 40}, {'f', 64, 0}, {'f', 63, 0}, {'a', 63, 12},
+    {'a', 64, 48}, {'a', 65, 40}, {'f', 65, 0}, {'f', 64, 0}, {'a', 64, 116}, {'a', 65, 48},
+    {'a', 66, 40}, {'f', 66, 0}, {'f', 65, 0}, {'a', 65, 12}, {'a', 66, 48}, {'a', 67, 40},
+    {'f', 67, 0}, {'f', 66, 0}, {'a', 66, 590}, {'a', 67, 48}, {'a', 68, 40}, {'f', 68, 0},
+    {'f', 67, 0}, {'a', 67, 236}, {'a', 68, 48}, {'a', 69, 40}, {'f', 69, 0}, {'f', 68, 0},
+    {'a', 68, 2832}, {'a', 69, 236}, {'a', 70, 48}, {'a', 71, 40}, {'f', 71, 0}, {'f', 70, 0},
+    {'a', 70, 236}, {'a', 71, 48}, {'a', 72, 40}, {'f', 72, 0}, {'f', 71, 0}, {'a', 71, 240},
+    {'f', 2, 0}, {'f', 1, 0}, {'f', 3, 0}, {'a', 1, 236}, {'a', 2, 944}, {'a', 3, 1792},
+    {'a', 72, 8}, {'a', 73, 150528}, {'a', 74, 8}, {'a', 75, 401408}, {'a', 76, 8},
+    {'a', 77, 401408}, {'a', 78, 8}, {'a', 79, 802816}, {'a', 80, 8}, {'a', 81, 864}, {'a', 82, 8},
+    {'a', 83, 288}, {'a', 84, 8}, {'a', 85, 2048}, {'a', 86, 8}, {'a', 87, 576}, {'a', 88, 8},
+    {'a', 89, 8192}, {'a', 90, 8}, {'a', 91, 1152}, {'a', 92, 8}, {'a', 93, 16384}, {'a', 94, 8},
+    {'a', 95, 1152}, {'a', 96, 8}, {'a', 97, 32768}, {'a', 98, 8}, {'a', 99, 2304}, {'a', 100, 8},
+    {'a', 101, 65536}, {'a', 102, 8}, {'a', 103, 2304}, {'a', 104, 8}, {'a', 105, 131072},
+    {'a', 106, 8}, {'a', 107, 4608}, {'a', 108, 8}, {'a', 109, 262144}, {'a', 110, 8},
+    {'a', 111, 4608}, {'a', 112, 8}, {'a', 113, 262144}, {'a', 114, 8}, {'a', 115, 4608},
+    {'a', 116, 8}, {'a', 117, 262144}, {'a', 118, 8}, {'a', 119, 4608}, {'a', 120, 8},
+    {'a', 121, 262144}, {'a', 122, 8}, {'a', 123, 4608}, {'a', 124, 8}, {'a', 125, 262144},
+    {'a', 126, 8}, {'a', 127, 4608}, {'a', 128, 8}, {'a', 129, 524288}, {'a', 130, 8},
+    {'a', 131, 9216}, {'a', 132, 8}, {'a', 133, 1048576}, {'a', 134, 8}, {'a', 135, 1024000},
+    {'a', 136, 2832}, {'a', 137, 32}, {'a', 138, 8}, {'a', 139, 32}, {'a', 140, 8}, {'a', 141, 32},
+    {'a', 142, 8}, {'a', 143, 32}, {'a', 144, 8}, {'a', 145, 32}, {'a', 146, 8}, {'a', 147, 32},
+    {'a', 148, 8}, {'a', 149, 32}, {'a', 150, 8}, {'a', 151, 32}, {'a', 152, 8}, {'a', 153, 32},
+    {'a', 154, 8}, {'a', 155, 32}, {'a', 156, 8}, {'a', 157, 32}, {'a', 158, 8}, {'a', 159, 32},
+    {'a', 160, 8}, {'a', 161, 32}, {'a', 162, 8}, {'a', 163, 32}, {'a', 164, 8}, {'a', 165, 32},
+    {'a', 166, 8}, {'a', 167, 32}, {'a', 168, 8}, {'a', 169, 32}, {'a', 170, 8}, {'a', 171, 32},
+    {'a', 172, 8}, {'a', 173, 32}, {'a', 174, 8}, {'a', 175, 32}, {'a', 176, 8}, {'a', 177, 32},
+    {'a', 178, 8}, {'a', 179, 32}, {'a', 180, 8}, {'a', 181, 32}, {'a', 182, 8}, {'a', 183, 32},
+    {'a', 184, 8}, {'a', 185, 32}, {'a', 186, 8}, {'a', 187, 32}, {'a', 188, 8}, {'a', 189, 32},
+    {'a', 190, 8}, {'a', 191, 32}, {'a', 192, 16}, {'a', 193, 8}, {'a', 194, 16}, {'a', 195, 16},
+    {'f', 1, 0}, {'f', 2, 0}, {'a', 1, 28320}, {'a', 2, 153228}, {'a', 196, 256}, {'f', 196, 0},
+    {'f', 2, 0}, {'a', 2, 415872}, {'a', 196, 256}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 512},
+    {'f', 2, 0}, {'a', 2, 831744}, {'a', 196, 512}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 1024},
+    {'f', 2, 0}, {'a', 2, 430592}, {'a', 196, 1024}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 1024},
+    {'f', 2, 0}, {'a', 2, 430592}, {'a', 196, 1024}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 2048},
+    {'f', 2, 0}, {'a', 2, 230400}, {'a', 196, 2048}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 2048},
+    {'f', 2, 0}, {'a', 2, 230400}, {'a', 196, 2048}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 4096},
+    {'f', 2, 0}, {'a', 2, 131072}, {'a', 196, 4096}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 4096},
+    {'f', 2, 0}, {'a', 2, 131072}, {'a', 196, 4096}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 4096},
+    {'f', 2, 0}, {'a', 2, 131072}, {'a', 196, 4096}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 4096},
+    {'f', 2, 0}, {'a', 2, 131072}, {'a', 196, 4096}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 4096},
+    {'f', 2, 0}, {'a', 2, 131072}, {'a', 196, 4096}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 4096},
+    {'f', 2, 0}, {'a', 2, 131072}, {'a', 196, 4096}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 8192},
+    {'f', 2, 0}, {'a', 2, 82944}, {'a', 196, 8192}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 8192},
+    {'f', 2, 0}, {'a', 2, 8000}, {'f', 2, 0}, {'a', 2, 153228}, {'a', 196, 256}, {'f', 196, 0},
+    {'f', 2, 0}, {'a', 2, 415872}, {'a', 196, 256}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 512},
+    {'f', 2, 0}, {'a', 2, 831744}, {'a', 196, 512}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 1024},
+    {'f', 2, 0}, {'a', 2, 430592}, {'a', 196, 1024}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 1024},
+    {'f', 2, 0}, {'a', 2, 430592}, {'a', 196, 1024}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 2048},
+    {'f', 2, 0}, {'a', 2, 230400}, {'a', 196, 2048}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 2048},
+    {'f', 2, 0}, {'a', 2, 230400}, {'a', 196, 2048}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 4096},
+    {'f', 2, 0}, {'a', 2, 131072}, {'a', 196, 4096}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 4096},
+    {'f', 2, 0}, {'a', 2, 131072}, {'a', 196, 4096}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 4096},
+    {'f', 2, 0}, {'a', 2, 131072}, {'a', 196, 4096}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 4096},
+    {'f', 2, 0}, {'a', 2, 131072}, {'a', 196, 4096}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 4096},
+    {'f', 2, 0}, {'a', 2, 131072}, {'a', 196, 4096}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 4096},
+    {'f', 2, 0}, {'a', 2, 131072}, {'a', 196, 4096}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 8192},
+    {'f', 2, 0}, {'a', 2, 82944}, {'a', 196, 8192}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 8192},
+    {'f', 2, 0}, {'a', 2, 8000}, {'f', 2, 0}, {'a', 2, 153228}, {'a', 196, 256}, {'f', 196, 0},
+    {'f', 2, 0}, {'a', 2, 415872}, {'a', 196, 256}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 512},
+    {'f', 2, 0}, {'a', 2, 831744}, {'a', 196, 512}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 1024},
+    {'f', 2, 0}, {'a', 2, 430592}, {'a', 196, 1024}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 1024},
+    {'f', 2, 0}, {'a', 2, 430592}, {'a', 196, 1024}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 2048},
+    {'f', 2, 0}, {'a', 2, 230400}, {'a', 196, 2048}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 2048},
+    {'f', 2, 0}, {'a', 2, 230400}, {'a', 196, 2048}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 4096},
+    {'f', 2, 0}, {'a', 2, 131072}, {'a', 196, 4096}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 4096},
+    {'f', 2, 0}, {'a', 2, 131072}, {'a', 196, 4096}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 4096},
+    {'f', 2, 0}, {'a', 2, 131072}, {'a', 196, 4096}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 4096},
+    {'f', 2, 0}, {'a', 2, 131072}, {'a', 196, 4096}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 4096},
+    {'f', 2, 0}, {'a', 2, 131072}, {'a', 196, 4096}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 4096},
+    {'f', 2, 0}, {'a', 2, 131072}, {'a', 196, 4096}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 8192},
+    {'f', 2, 0}, {'a', 2, 82944}, {'a', 196, 8192}, {'f', 196, 0}, {'f', 2, 0}, {'a', 2, 8192},
+    {'f', 2, 0}, {'a', 2, 8000}, {'f', 2, 0}, {'f', 5, 0}, {'f', 6, 0}, {'f', 7, 0}, {'f', 8, 0},
+    {'f', 9, 0}, {'f', 10, 0}, {'f', 11, 0}, {'f', 12, 0}, {'f', 13, 0}, {'f', 14, 0}, {'f', 15, 0},
+    {'f', 16, 0}, {'f', 17, 0}, {'f', 18, 0}, {'f', 19, 0}, {'f', 20, 0}, {'f', 21, 0},
+    {'f', 22, 0}, {'f', 23, 0}, {'f', 24, 0}, {'f', 25, 0}, {'f', 26, 0}, {'f', 27, 0},
+    {'f', 28, 0}, {'f', 29, 0}, {'f', 30, 0}, {'f', 31, 0}, {'f', 32, 0}, {'f', 33, 0},
+    {'f', 34, 0}, {'f', 35, 0}, {'f', 36, 0}, {'f', 37, 0}, {'f', 38, 0}, {'f', 39, 0},
+    {'f', 40, 0}, {'f', 41, 0}, {'f', 42, 0}, {'f', 43, 0}, {'f', 44, 0}, {'f', 45, 0},
+    {'f', 46, 0}, {'f', 47, 0}, {'f', 48, 0}, {'f', 49, 0}, {'f', 50, 0}, {'f', 51, 0},
+    {'f', 52, 0}, {'f', 53, 0}, {'f', 54, 0}, {'f', 55, 0}, {'f', 56, 0}, {'f', 57, 0},
+    {'f', 58, 0}, {'f', 59, 0}, {'f', 60, 0}, {'f', 61, 0}, {'f', 62, 0}, {'f', 63, 0}, {'f', 4, 0},
+    {'f', 67, 0}, {'f', 70, 0}, {'f', 66, 0}, {'f', 68, 0}, {'f', 69, 0}, {'f', 64, 0},
+    {'f', 71, 0}, {'f', 65, 0}, {'f', 137, 0}, {'f', 138, 0}, {'f', 139, 0}, {'f', 140, 0},
+    {'f', 141, 0}, {'f', 142, 0}, {'f', 143, 0}, {'f', 144, 0}, {'f', 145, 0}, {'f', 146, 0},
+    {'f', 147, 0}, {'f', 148, 0}, {'f', 149, 0}, {'f', 150, 0}, {'f', 151, 0}, {'f', 152, 0},
+    {'f', 153, 0}, {'f', 154, 0}, {'f', 155, 0}, {'f', 156, 0}, {'f', 157, 0}, {'f', 158, 0},
+    {'f', 159, 0}, {'f', 160, 0}, {'f', 161, 0}, {'f', 162, 0}, {'f', 163, 0}, {'f', 164, 0},
+    {'f', 165, 0}, {'f', 166, 0}, {'f', 167, 0}, {'f', 168, 0}, {'f', 169, 0}, {'f', 170, 0},
+    {'f', 171, 0}, {'f', 172, 0}, {'f', 173, 0}, {'f', 174, 0}, {'f', 175, 0}, {'f', 176, 0},
+    {'f', 177, 0}, {'f', 178, 0}, {'f', 179, 0}, {'f', 180, 0}, {'f', 181, 0}, {'f', 182, 0},
+    {'f', 183, 0}, {'f', 184, 0}, {'f', 185, 0}, {'f', 186, 0}, {'f', 187, 0}, {'f', 188, 0},
+    {'f', 189, 0}, {'f', 190, 0}, {'f', 191, 0}, {'f', 192, 0}, {'f', 193, 0}, {'f', 194, 0},
+    {'f', 195, 0}, {'f', 3, 0}, {'f', 136, 0}, {'f', 1, 0}, {'f', 0, 0},
+};
+
+#endif  // TESTS_CRT_ALLOCATION_TRACES_H_
@@ -20,9 +20,16 @@
 #include "../../src/runtime/crt/include/tvm/runtime/crt/internal/graph_executor/graph_executor.h"
 
 #include <gtest/gtest.h>
+#include <tvm/runtime/crt/func_registry.h>
+#include <tvm/runtime/crt/module.h>
 
 #include "../../src/runtime/crt/include/tvm/runtime/crt/internal/graph_executor/load_json.h"
 
+extern "C" {
+// Defined in platform.cc.
+extern size_t g_num_platform_memory_allocate_calls;
+}
+
 namespace {
 
 constexpr const char* kJson = R"(
@@ -112,4 +119,146 @@ TEST(TVMGraphExecutor_Load, Parse) {
   EXPECT_EQ(executor.nodes_count, 3);
 }
 
+// kJson compiled by tvm.micro.compile_graph_binary.
+constexpr uint64_t kGraphBinary[60] = {
+    0x48504152474d5654ULL, 0x0000000600000001ULL, 0x0000000200000003ULL, 0x0000000200000001ULL,
+    0x0000000300000003ULL, 0x000000000000001fULL, 0x0000000100000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000300000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000600000001ULL, 0x0000000200000006ULL,
+    0x0000000000000001ULL, 0x0000000200000000ULL, 0x0000000100000000ULL, 0x0000000100000000ULL,
+    0x0000000300000002ULL, 0x0000000000000002ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000100000000ULL, 0x0000000000000000ULL, 0x0000000100000000ULL, 0x0000000000000002ULL,
+    0x0000000200000002ULL, 0x0000000000000002ULL, 0x0001200200012002ULL, 0x0000000000012002ULL,
+    0x000000000000000aULL, 0x0000000000000005ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000001ULL, 0x0000000000000005ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x000000000000000aULL, 0x0000000000000005ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+    0x0000000000000000ULL, 0x0000000000000000ULL, 0x00000000000000c8ULL, 0x0000000100000000ULL,
+    0x0000000000000014ULL, 0x0000000100000001ULL, 0x00000000000000c8ULL, 0x0000000100000002ULL,
+    0x7674003070007800ULL, 0x6665645f6e65676dULL, 0x7375665f746c7561ULL, 0x00006464615f6465ULL,
+};
+
+// Check a binary graph can be loaded and references its tables in place.
+TEST(TVMGraphExecutor_LoadBinary, Parse) {
+  TVMGraphExecutor executor;
+  memset(&executor, 0, sizeof(executor));
+  int status = TVMGraphExecutor_LoadBinary(&executor, kGraphBinary, sizeof(kGraphBinary));
+  EXPECT_EQ(status, 0);
+  EXPECT_EQ(executor.nodes_count, 3);
+  EXPECT_EQ(executor.input_nodes_count, 2);
+  EXPECT_EQ(executor.outputs_count, 1);
+  EXPECT_EQ(executor.outputs[0].node_id, 2);
+  EXPECT_EQ(TVMGraphExecutor_GetInputIndex(&executor, "p0"), 1);
+  EXPECT_STREQ(executor.binary_strings + executor.binary_nodes[2].func_name,
+               "tvmgen_default_fused_add");
+  EXPECT_EQ(executor.binary_storage[0].size, 10 * 5 * 4);
+}
+
+// Check a truncated binary graph is rejected.
+TEST(TVMGraphExecutor_LoadBinary, Truncated) {
+  TVMGraphExecutor executor;
+  memset(&executor, 0, sizeof(executor));
+  int status = TVMGraphExecutor_LoadBinary(&executor, kGraphBinary, sizeof(kGraphBinary) - 8);
+  EXPECT_NE(status, 0);
+}
+
+// Check a binary graph whose output names an entry out of range is rejected.
+TEST(TVMGraphExecutor_LoadBinary, InvalidEntry) {
+  // The output of the graph is the node entry in word 21.
+  constexpr int kOutputWord = 21;
+  for (uint64_t output : {0x0000000000000003ULL, 0x0000000100000002ULL}) {
+    uint64_t graph_binary[60];
+    memcpy(graph_binary, kGraphBinary, sizeof(graph_binary));
+    graph_binary[kOutputWord] = output;
+    TVMGraphExecutor executor;
+    memset(&executor, 0, sizeof(executor));
+    EXPECT_NE(TVMGraphExecutor_LoadBinary(&executor, graph_binary, sizeof(graph_binary)), 0);
+  }
+}
+
+// Check the arena footprint of a binary graph matches TVM_GRAPH_EXECUTOR_ARENA_SIZE.
+TEST(TVMGraphExecutor_Arena, Footprint) {
+  TVMGraphExecutorArenaFootprint footprint;
+  int status = TVMGraphExecutor_GetArenaFootprint(kGraphBinary, sizeof(kGraphBinary), &footprint);
+  EXPECT_EQ(status, 0);
+  // 200, 20 and 200 bytes of storage, each aligned to 16 bytes.
+  EXPECT_EQ(footprint.storage, 208 + 32 + 208);
+  EXPECT_EQ(footprint.total,
+            footprint.executor + footprint.tensors + footprint.op_execs + footprint.storage);
+  EXPECT_EQ(footprint.total, TVM_GRAPH_EXECUTOR_ARENA_SIZE(448, 3, 3, 3));
+}
+
+// Check an arena smaller than the footprint is rejected.
+TEST(TVMGraphExecutor_Arena, TooSmall) {
+  alignas(TVM_GRAPH_EXECUTOR_ARENA_ALIGNMENT) static uint8_t arena[1024];
+  DLDevice dev = {kDLCPU, 0};
+  TVMGraphExecutor* executor = nullptr;
+  int status = TVMGraphExecutor_CreateInArena(kGraphBinary, sizeof(kGraphBinary), nullptr, &dev,
+                                              arena, sizeof(arena), &executor);
+  EXPECT_NE(status, 0);
+  EXPECT_EQ(executor, nullptr);
+}
+
+// Stands in for the operator of kJson, adding p0 to each row of x.
+int StubFusedAdd(TVMValue* args, int* type_codes, int num_args, TVMValue* out_ret_value,
+                 int* out_ret_tcode, void* resource_handle) {
+  const DLTensor* x = static_cast<DLTensor*>(args[0].v_handle);
+  const DLTensor* p0 = static_cast<DLTensor*>(args[1].v_handle);
+  DLTensor* out = static_cast<DLTensor*>(args[2].v_handle);
+  for (int64_t i = 0; i < x->shape[0]; ++i) {
+    for (int64_t j = 0; j < x->shape[1]; ++j) {
+      static_cast<float*>(out->data)[i * 5 + j] =
+          static_cast<float*>(x->data)[i * 5 + j] + static_cast<float*>(p0->data)[j];
+    }
+  }
+  return 0;
+}
+
+const TVMBackendPackedCFunc kStubFuncs[] = {StubFusedAdd};
+const TVMFuncRegistry kStubRegistry = {"\x01tvmgen_default_fused_add\0", kStubFuncs};
+const TVMModule kStubModule = {&kStubRegistry};
+
+// Check an executor created in an arena runs without allocating from the platform.
+TEST(TVMGraphExecutor_Arena, RunWithoutAllocating) {
+  alignas(TVM_GRAPH_EXECUTOR_ARENA_ALIGNMENT) static uint8_t arena[4096];
+  TVMModuleHandle module;
+  ASSERT_EQ(TVMModCreateFromCModule(&kStubModule, &module), 0);
+  DLDevice dev = {kDLCPU, 0};
+
+  size_t num_calls = g_num_platform_memory_allocate_calls;
+  TVMGraphExecutor* executor = nullptr;
+  ASSERT_EQ(TVMGraphExecutor_CreateInArena(kGraphBinary, sizeof(kGraphBinary), module, &dev, arena,
+                                           sizeof(arena), &executor),
+            0);
+  EXPECT_EQ(executor, reinterpret_cast<TVMGraphExecutor*>(arena));
+
+  float x_data[10 * 5];
+  float p0_data[5];
+  float out_data[10 * 5];
+  for (int i = 0; i < 10 * 5; ++i) {
+    x_data[i] = i;
+  }
+  for (int j = 0; j < 5; ++j) {
+    p0_data[j] = 100 * j;
+  }
+  int64_t x_shape[2] = {10, 5};
+  int64_t p0_shape[2] = {1, 5};
+  DLDataType float32 = {kDLFloat, 32, 1};
+  DLTensor x = {x_data, dev, 2, float32, x_shape, nullptr, 0};
+  DLTensor p0 = {p0_data, dev, 2, float32, p0_shape, nullptr, 0};
+  DLTensor out = {out_data, dev, 2, float32, x_shape, nullptr, 0};
+  TVMGraphExecutor_SetInput(executor, "x", &x);
+  TVMGraphExecutor_SetInput(executor, "p0", &p0);
+  TVMGraphExecutor_Run(executor);
+  EXPECT_EQ(TVMGraphExecutor_GetOutput(executor, 0, &out), 0);
+  EXPECT_EQ(g_num_platform_memory_allocate_calls, num_calls);
+
+  for (int i = 0; i < 10; ++i) {
+    for (int j = 0; j < 5; ++j) {
+      EXPECT_EQ(out_data[i * 5 + j], i * 5 + j + 100 * j);
+    }
+  }
+  EXPECT_EQ(TVMModFree(module), 0);
+}
+
 }  // namespace
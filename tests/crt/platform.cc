@@ -52,7 +52,11 @@ void TVMLogf(const char* fmt, ...) {
   }
 }
 
+// The number of TVMPlatformMemoryAllocate calls, for tests of code that must not allocate.
+size_t g_num_platform_memory_allocate_calls = 0;
+
 tvm_crt_error_t TVMPlatformMemoryAllocate(size_t num_bytes, DLDevice dev, void** out_ptr) {
+  ++g_num_platform_memory_allocate_calls;
   *out_ptr = malloc(num_bytes);
   return *out_ptr ? kTvmErrorNoError : kTvmErrorPlatformNoMemory;
 }
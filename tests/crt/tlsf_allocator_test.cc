@@ -0,0 +1,181 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <tvm/runtime/crt/internal/memory/page_allocator.h>
+#include <tvm/runtime/crt/internal/memory/tlsf_allocator.h>
+#include <tvm/runtime/crt/page_allocator.h>
+#include <tvm/runtime/crt/tlsf_allocator.h>
+
+#include <vector>
+
+#include "allocation_traces.h"
+#include "crt_config.h"
+
+static constexpr const size_t kMemoryPoolSizeBytes = 64 * 1024;
+
+class TLSFAllocatorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    memset(memory_pool, 0, sizeof(memory_pool));
+    ASSERT_EQ(TLSFMemoryManagerCreate(&interface, memory_pool, sizeof(memory_pool)),
+              kTvmErrorNoError);
+    mgr = reinterpret_cast<TLSFMemoryManager*>(interface);
+    dev_ = {kDLCPU, 0};
+  }
+
+  void* Allocate(size_t num_bytes) {
+    void* ptr = nullptr;
+    EXPECT_EQ(interface->Allocate(interface, num_bytes, dev_, &ptr), kTvmErrorNoError);
+    return ptr;
+  }
+
+  uint8_t memory_pool[kMemoryPoolSizeBytes];
+  MemoryManagerInterface* interface;
+  TLSFMemoryManager* mgr;
+  DLDevice dev_;
+};
+
+TEST_F(TLSFAllocatorTest, AllocFree) {
+  std::vector<void*> ptrs;
+  for (size_t num_bytes = 1; num_bytes < 4096; num_bytes = num_bytes * 3 + 1) {
+    void* ptr = Allocate(num_bytes);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % TLSF_ALIGNMENT_BYTES, 0);
+    memset(ptr, 0xff, num_bytes);
+    ptrs.push_back(ptr);
+  }
+  EXPECT_EQ(static_cast<size_t>(interface->vleak_size), ptrs.size());
+  for (void* ptr : ptrs) {
+    EXPECT_EQ(interface->Free(interface, ptr, dev_), kTvmErrorNoError);
+  }
+  EXPECT_EQ(interface->vleak_size, 0);
+  EXPECT_EQ(mgr->used_bytes, 0);
+}
+
+// Freed neighbors are merged, so the whole pool can be allocated again.
+TEST_F(TLSFAllocatorTest, Coalesce) {
+  void* whole = Allocate(kMemoryPoolSizeBytes / 2);
+  ASSERT_EQ(interface->Free(interface, whole, dev_), kTvmErrorNoError);
+
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 64; i++) {
+    ptrs.push_back(Allocate(200));
+  }
+  // Free in an order that merges with the previous, the next, and both neighbors.
+  for (int i = 0; i < 64; i += 2) {
+    ASSERT_EQ(interface->Free(interface, ptrs[i], dev_), kTvmErrorNoError);
+  }
+  for (int i = 1; i < 64; i += 2) {
+    ASSERT_EQ(interface->Free(interface, ptrs[i], dev_), kTvmErrorNoError);
+  }
+  EXPECT_EQ(Allocate(kMemoryPoolSizeBytes / 2), whole);
+}
+
+TEST_F(TLSFAllocatorTest, OutOfMemory) {
+  void* ptr = nullptr;
+  EXPECT_EQ(interface->Allocate(interface, kMemoryPoolSizeBytes, dev_, &ptr),
+            kTvmErrorPlatformNoMemory);
+  EXPECT_EQ(ptr, nullptr);
+
+  void* big = Allocate(kMemoryPoolSizeBytes * 3 / 4);
+  EXPECT_EQ(interface->Allocate(interface, kMemoryPoolSizeBytes / 2, dev_, &ptr),
+            kTvmErrorPlatformNoMemory);
+  EXPECT_EQ(interface->Free(interface, big, dev_), kTvmErrorNoError);
+  EXPECT_EQ(interface->Allocate(interface, kMemoryPoolSizeBytes / 2, dev_, &ptr),
+            kTvmErrorNoError);
+}
+
+// A request is served from a size class whose blocks are all large enough, so a block is at most
+// 1/16 larger than the request.
+TEST_F(TLSFAllocatorTest, BoundedRounding) {
+  for (size_t num_bytes = 1; num_bytes < kMemoryPoolSizeBytes / 2;
+       num_bytes = num_bytes * 5 / 4 + 7) {
+    void* ptr = Allocate(num_bytes);
+    size_t block_size = reinterpret_cast<TLSFBlock*>(static_cast<uint8_t*>(ptr) -
+                                                     TLSF_BLOCK_HEADER_BYTES)
+                            ->size &
+                        ~(TLSF_BLOCK_FREE | TLSF_BLOCK_PREV_FREE);
+    size_t aligned = TLSF_ALIGN_UP(num_bytes);
+    EXPECT_LE(block_size, aligned + aligned / TLSF_SL_COUNT + TLSF_MIN_BLOCK_BYTES);
+    ASSERT_EQ(interface->Free(interface, ptr, dev_), kTvmErrorNoError);
+  }
+}
+
+namespace {
+
+typedef tvm_crt_error_t (*CreateMemoryManager)(MemoryManagerInterface** manager, uint8_t* pool,
+                                               size_t pool_size);
+
+tvm_crt_error_t CreatePageMemoryManager(MemoryManagerInterface** manager, uint8_t* pool,
+                                        size_t pool_size) {
+  return PageMemoryManagerCreate(manager, pool, pool_size, 8 /* page_size_log2 */);
+}
+
+// Replay trace on a new memory manager made in pool. Return false if an allocation fails.
+template <size_t N>
+bool ReplayTrace(CreateMemoryManager create, const AllocationTraceOp (&trace)[N], uint8_t* pool,
+                 size_t pool_size) {
+  MemoryManagerInterface* interface;
+  // The page allocator expects a zeroed pool.
+  memset(pool, 0, pool_size);
+  if (create(&interface, pool, pool_size) != kTvmErrorNoError) {
+    return false;
+  }
+  DLDevice dev = {kDLCPU, 0};
+  std::vector<void*> blocks(N);
+  for (const AllocationTraceOp& op : trace) {
+    if (op.op == 'a') {
+      if (interface->Allocate(interface, op.num_bytes, dev, &blocks[op.id]) != kTvmErrorNoError) {
+        return false;
+      }
+    } else {
+      interface->Free(interface, blocks[op.id], dev);
+    }
+  }
+  return true;
+}
+
+// The smallest pool in which trace can be replayed, within 256 bytes.
+template <size_t N>
+size_t MinPoolSize(CreateMemoryManager create, const AllocationTraceOp (&trace)[N],
+                   std::vector<uint8_t>* pool) {
+  // The page allocator does not check that the pool holds its metadata, so start above that.
+  size_t low = 4096, high = pool->size();
+  while (high - low > 256) {
+    size_t mid = (low + high) / 2;
+    if (ReplayTrace(create, trace, pool->data(), mid)) {
+      high = mid;
+    } else {
+      low = mid;
+    }
+  }
+  return high;
+}
+
+}  // namespace
+
+// Replay the allocations of a model on the page and TLSF allocators, and check the TLSF allocator
+// needs no larger a pool. apps/benchmark/crt_allocator_bench.cc times the same replay.
+TEST(TLSFAllocatorTraceTest, MobileNetV1) {
+  std::vector<uint8_t> pool(16 * 1024 * 1024);
+  size_t page_pool_size = MinPoolSize(CreatePageMemoryManager, kMobileNetV1Trace, &pool);
+  size_t tlsf_pool_size = MinPoolSize(TLSFMemoryManagerCreate, kMobileNetV1Trace, &pool);
+  EXPECT_LE(tlsf_pool_size, page_pool_size);
+}
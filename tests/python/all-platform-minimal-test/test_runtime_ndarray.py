@@ -60,6 +60,32 @@ def test_fp16_conversion():
         tvm.testing.assert_allclose(expected, real)
 
 
+def test_convert_float_dtype():
+    n = 1003
+    x = np.random.uniform(-1000, 1000, size=(n,)).astype("float32")
+    x[:3] = [0.0, np.inf, -np.inf]
+    # Denormals, which must not be flushed to zero by the vectorized conversions.
+    x[16:20] = np.array([1, 0x400000, 0x7FFFFF, 0x18000], dtype="uint32").view("float32")
+
+    a = tvm.nd.array(x)
+    b = tvm.nd.empty((n,), "float16")
+    a.convert_to(b)
+    np.testing.assert_array_equal(b.numpy(), x.astype("float16"))
+
+    c = tvm.nd.empty((n,), "float32")
+    b.convert_to(c)
+    np.testing.assert_array_equal(c.numpy(), x.astype("float16").astype("float32"))
+
+    # bfloat16 keeps the upper half of float32 after rounding to nearest even.
+    d = tvm.nd.empty((n,), "bfloat16")
+    a.convert_to(d)
+    e = tvm.nd.empty((n,), "float32")
+    d.convert_to(e)
+    bits = x.view("uint32")
+    expected = ((bits + 0x7FFF + ((bits >> 16) & 1)) >> 16) << 16
+    np.testing.assert_array_equal(e.numpy().view("uint32"), expected)
+
+
 def test_dtype():
     dtype = tvm.DataType("handle")
     assert dtype.type_code == tvm.DataTypeCode.HANDLE
@@ -68,4 +94,5 @@ def test_dtype():
 if __name__ == "__main__":
     test_nd_create()
     test_fp16_conversion()
+    test_convert_float_dtype()
     test_dtype()
@@ -101,6 +101,77 @@ def test_matmul_add():
     verify_matmul_add(1, 16, 3, mkldnn, True, True)
 
 
+def verify_matmul_packed(m, l, n, transa=False, transb=False):
+    if not tvm.get_global_func("tvm.contrib.mkl.matmul_packed", True):
+        pytest.skip("Packed weight matmul is supported only for MKL.")
+    ashape = (l, n) if transa else (n, l)
+    bshape = (m, l) if transb else (l, m)
+    dev = tvm.cpu(0)
+    b_np = np.random.uniform(size=bshape).astype("float32")
+    packed = mkl.pack_matrix(tvm.nd.array(b_np, dev), n, transb)
+    assert packed.dtype == "uint8"
+
+    A = te.placeholder(ashape, name="A", dtype="float32")
+    P = te.placeholder(packed.shape, name="P", dtype="uint8")
+    C = mkl.matmul_packed(A, P, m, transa)
+    s = te.create_schedule(C.op)
+    f = tvm.build(s, [A, P, C], "llvm")
+
+    c = tvm.nd.array(np.zeros((n, m), dtype=C.dtype), dev)
+    b_ref = b_np.transpose() if transb else b_np
+    for _ in range(2):
+        a_np = np.random.uniform(size=ashape).astype(A.dtype)
+        f(tvm.nd.array(a_np, dev), packed, c)
+        a_ref = a_np.transpose() if transa else a_np
+        tvm.testing.assert_allclose(c.numpy(), np.dot(a_ref, b_ref), rtol=1e-5)
+
+
+def test_matmul_packed():
+    verify_matmul_packed(235, 128, 1024)
+    verify_matmul_packed(235, 128, 1024, True, False)
+    verify_matmul_packed(235, 128, 1024, False, True)
+    verify_matmul_packed(235, 128, 1024, True, True)
+    verify_matmul_packed(1, 16, 3)
+    verify_matmul_packed(1000, 512, 1, False, True)
+
+
+def test_matmul_packed_checks_shape():
+    if not tvm.get_global_func("tvm.contrib.mkl.matmul_packed", True):
+        pytest.skip("Packed weight matmul is supported only for MKL.")
+    dev = tvm.cpu(0)
+    packed = mkl.pack_matrix(tvm.nd.array(np.ones((16, 8), "float32"), dev), 4)
+    A = te.placeholder((2, 16), name="A", dtype="float32")
+    P = te.placeholder(packed.shape, name="P", dtype="uint8")
+    C = mkl.matmul_packed(A, P, 8)
+    f = tvm.build(te.create_schedule(C.op), [A, P, C], "llvm")
+    # The matrix was packed for a left hand side of 4 rows.
+    with pytest.raises(tvm.TVMError):
+        f(tvm.nd.array(np.ones((2, 16), "float32"), dev), packed, tvm.nd.empty((2, 8), device=dev))
+
+
+def test_relay_dense_mkl_packed():
+    if not tvm.get_global_func("tvm.contrib.mkl.matmul_packed", True):
+        pytest.skip("Packed weight matmul is supported only for MKL.")
+    from tvm import relay
+    from tvm.contrib import graph_executor
+
+    x_np = np.random.uniform(size=(1, 256)).astype("float32")
+    w_np = np.random.uniform(size=(512, 256)).astype("float32")
+    x = relay.var("x", shape=x_np.shape)
+    y = relay.nn.dense(x, relay.const(w_np))
+    mod = tvm.IRModule.from_expr(relay.Function([x], y))
+    with tvm.transform.PassContext(opt_level=3):
+        lib = relay.build(mod, target="llvm -libs=mkl")
+    # The weight is packed at compile time into a uint8 parameter of the module.
+    assert any(p.dtype == "uint8" for p in lib.get_params().values())
+
+    module = graph_executor.GraphModule(lib["default"](tvm.cpu(0)))
+    for _ in range(2):
+        module.set_input("x", x_np)
+        module.run()
+        tvm.testing.assert_allclose(module.get_output(0).numpy(), np.dot(x_np, w_np.T), rtol=1e-5)
+
+
 def verify_quantized_matmul_add(m, l, n, transa=False, transb=False):
     if not tvm.get_global_func("tvm.contrib.mkl.matmul_u8s8s32", True):
         pytest.skip("Quantized dense is supported only for MKL. TVM GPU CI uses openblas")
@@ -238,5 +309,8 @@ def test_batch_matmul():
 
 if __name__ == "__main__":
     test_matmul_add()
+    test_matmul_packed()
+    test_matmul_packed_checks_shape()
+    test_relay_dense_mkl_packed()
     test_quantized_matmul_add()
     test_batch_matmul()
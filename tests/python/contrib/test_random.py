@@ -96,6 +96,34 @@ def test_normal():
     verify()
 
 
+def test_reproducible_across_thread_counts():
+    if not tvm.get_global_func("tvm.contrib.random.seed", True):
+        print("skip because extern function is not available")
+        return
+    seed = tvm.get_global_func("tvm.contrib.random.seed")
+    normal = tvm.get_global_func("tvm.contrib.random.normal")
+    config_threadpool = tvm.get_global_func("runtime.config_threadpool")
+    dev = tvm.cpu(0)
+
+    def sample(num_threads):
+        config_threadpool(1, num_threads)
+        seed(42)
+        first = tvm.nd.empty((1023, 1025), "float32", dev)
+        second = tvm.nd.empty((1023, 1025), "float32", dev)
+        normal(0.0, 1.0, first)
+        normal(0.0, 1.0, second)
+        return first.numpy(), second.numpy()
+
+    try:
+        first_serial, second_serial = sample(1)
+        first_parallel, second_parallel = sample(0)
+    finally:
+        config_threadpool(1, 0)
+    np.testing.assert_equal(first_serial, first_parallel)
+    np.testing.assert_equal(second_serial, second_parallel)
+    assert not np.array_equal(first_serial, second_serial)
+
+
 @tvm.testing.uses_gpu
 def test_random_fill():
     def test_local(dev, dtype):
@@ -159,4 +187,5 @@ if __name__ == "__main__":
     test_randint()
     test_uniform()
     test_normal()
+    test_reproducible_across_thread_counts()
     test_random_fill()
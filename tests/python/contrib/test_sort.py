@@ -14,11 +14,14 @@
 # KIND, either express or implied.  See the License for the
 # specific language governing permissions and limitations
 # under the License.
+import sys
+
 import tvm
 import tvm.testing
 from tvm import te
 from tvm.topi.cuda import sort_by_key
 import numpy as np
+import pytest
 
 
 def test_sort():
@@ -123,7 +126,38 @@ def test_sort_by_key_gpu():
             tvm.testing.assert_allclose(values_out.numpy(), ref_values_out, rtol=1e-5)
 
 
+def _stable_argsort(np_data, axis, is_ascend):
+    key = np_data if is_ascend else -np_data
+    return np.argsort(key, axis=axis, kind="stable")
+
+
+@pytest.mark.parametrize("dtype", ["float32", "int32", "float64"])
+@pytest.mark.parametrize("is_ascend", [True, False])
+def test_argsort_long_rows(dtype, is_ascend):
+    # Long rows with duplicated keys go through the radix sort path for 32-bit keys.
+    dshape = (3, 1000, 7)
+    axis = 1
+    np_data = np.random.randint(-50, 50, size=dshape).astype(dtype)
+    dev = tvm.cpu(0)
+    a = tvm.nd.array(np_data, dev)
+    c = tvm.nd.array(np.zeros(dshape, dtype="int32"), dev)
+    tvm.get_global_func("tvm.contrib.sort.argsort")(a, c, axis, is_ascend)
+    tvm.testing.assert_allclose(c.numpy(), _stable_argsort(np_data, axis, is_ascend))
+
+
+@pytest.mark.parametrize("k", [1, 5, 4096])
+def test_topk_partial(k):
+    dshape = (64, 4096)
+    np_data = np.random.randint(0, 1000, size=dshape).astype("float32")
+    dev = tvm.cpu(0)
+    a = tvm.nd.array(np_data, dev)
+    values = tvm.nd.array(np.zeros((64, k), dtype="float32"), dev)
+    indices = tvm.nd.array(np.zeros((64, k), dtype="int64"), dev)
+    tvm.get_global_func("tvm.contrib.sort.topk")(a, values, indices, k, -1, "both", False)
+    ref_indices = _stable_argsort(np_data, -1, False)[:, :k]
+    tvm.testing.assert_allclose(indices.numpy(), ref_indices)
+    tvm.testing.assert_allclose(values.numpy(), np.take_along_axis(np_data, ref_indices, -1))
+
+
 if __name__ == "__main__":
-    test_sort()
-    test_sort_np()
-    test_sort_by_key_gpu()
+    sys.exit(pytest.main([__file__] + sys.argv[1:]))
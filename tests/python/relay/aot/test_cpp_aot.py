@@ -0,0 +1,179 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Tests of the AOT executor running models on the host through the C++ runtime."""
+import sys
+import threading
+
+import numpy as np
+import pytest
+
+import tvm
+import tvm.testing
+from tvm import relay
+from tvm.contrib import aot_executor, graph_executor, utils
+from tvm.relay.backend import Executor, Runtime
+
+pytestmark = pytest.mark.skipif(
+    tvm.get_global_func("tvm.aot_executor.create", allow_missing=True) is None,
+    reason="AOT executor not enabled",
+)
+
+
+def _conv_model(channels=8, size=16):
+    data = relay.var("data", shape=(1, 3, size, size), dtype="float32")
+    weight = relay.var("weight", shape=(channels, 3, 3, 3), dtype="float32")
+    bias = relay.var("bias", shape=(channels,), dtype="float32")
+    conv = relay.nn.conv2d(data, weight, padding=(1, 1), channels=channels, kernel_size=(3, 3))
+    out = relay.nn.relu(relay.nn.bias_add(conv, bias))
+    mod = tvm.IRModule.from_expr(relay.Function([data, weight, bias], out))
+    params = {
+        "weight": np.random.uniform(-1, 1, (channels, 3, 3, 3)).astype("float32"),
+        "bias": np.random.uniform(-1, 1, (channels,)).astype("float32"),
+    }
+    return mod, params
+
+
+def _two_output_model():
+    x = relay.var("x", shape=(4, 8), dtype="float32")
+    y = relay.var("y", shape=(4, 8), dtype="float32")
+    out = relay.Tuple([relay.add(x, y), relay.multiply(relay.exp(x), y)])
+    return tvm.IRModule.from_expr(relay.Function([x, y], out))
+
+
+def _build(mod, params=None, executor="aot"):
+    with tvm.transform.PassContext(opt_level=3, config={"tir.disable_vectorize": True}):
+        return relay.build(
+            mod,
+            target="c",
+            executor=Executor(executor),
+            runtime=Runtime("cpp"),
+            params=params,
+        )
+
+
+def _export_and_load(factory, name):
+    temp_dir = utils.tempdir()
+    path = temp_dir.relpath(name)
+    factory.export_library(path)
+    return tvm.runtime.load_module(path)
+
+
+def _graph_module(mod, params, dev):
+    loaded = _export_and_load(_build(mod, params, "graph"), "graph.so")
+    return graph_executor.GraphModule(loaded["default"](dev))
+
+
+def test_conv2d():
+    mod, params = _conv_model()
+    data = np.random.uniform(-1, 1, (1, 3, 16, 16)).astype("float32")
+    dev = tvm.cpu(0)
+
+    ref = _graph_module(mod, params, dev)
+    ref.run(data=data)
+
+    factory = _build(mod, params)
+    assert factory.get_executor_config()
+    loaded = _export_and_load(factory, "conv2d.so")
+    amod = aot_executor.AotModule(loaded["default"](dev))
+    assert amod.get_num_inputs() == 1
+    assert amod.get_num_outputs() == 1
+    assert amod.get_input_index("data") == 0
+    assert amod.get_input_index("weight") == -1
+    amod.set_input("data", data)
+    amod.run()
+    tvm.testing.assert_allclose(amod.get_output(0).numpy(), ref.get_output(0).numpy(), rtol=1e-5)
+
+
+def test_tuple_output_and_zero_copy():
+    mod = _two_output_model()
+    x = np.random.uniform(-1, 1, (4, 8)).astype("float32")
+    y = np.random.uniform(-1, 1, (4, 8)).astype("float32")
+    dev = tvm.cpu(0)
+    factory = _build(mod)
+    loaded = _export_and_load(factory, "two_outputs.so")
+    amod = aot_executor.create(factory.get_executor_config(), loaded, dev)
+
+    amod.run(x=x, y=y)
+    tvm.testing.assert_allclose(amod.get_output(0).numpy(), x + y, rtol=1e-5)
+    tvm.testing.assert_allclose(amod.get_output(1).numpy(), np.exp(x) * y, rtol=1e-5)
+
+    # Bind the inputs and the second output to arrays of the caller.
+    x_nd = tvm.nd.array(y, dev)
+    y_nd = tvm.nd.array(x, dev)
+    out_nd = tvm.nd.empty((4, 8), "float32", dev)
+    amod.set_input_zero_copy("x", x_nd)
+    amod.set_input_zero_copy(1, y_nd)
+    amod.set_output_zero_copy(1, out_nd)
+    amod.run()
+    tvm.testing.assert_allclose(amod.get_output(0).numpy(), x + y, rtol=1e-5)
+    tvm.testing.assert_allclose(out_nd.numpy(), np.exp(y) * x, rtol=1e-5)
+    copied = tvm.nd.empty((4, 8), "float32", dev)
+    amod.get_output(1, copied)
+    tvm.testing.assert_allclose(copied.numpy(), out_nd.numpy())
+
+    # Copying an input again reads it from the executor's own array.
+    amod.set_input("x", x)
+    amod.run()
+    tvm.testing.assert_allclose(amod.get_output(0).numpy(), 2 * x, rtol=1e-5)
+
+    with pytest.raises(tvm.TVMError):
+        amod.set_input_zero_copy("x", tvm.nd.empty((4, 4), "float32", dev))
+
+
+def test_instances_share_the_library():
+    mod, params = _conv_model()
+    dev = tvm.cpu(0)
+    loaded = _export_and_load(_build(mod, params), "shared.so")
+    modules = [aot_executor.AotModule(loaded["default"](dev)) for _ in range(4)]
+    inputs = [np.random.uniform(-1, 1, (1, 3, 16, 16)).astype("float32") for _ in modules]
+
+    ref = _graph_module(mod, params, dev)
+    expected = []
+    for data in inputs:
+        ref.run(data=data)
+        expected.append(ref.get_output(0).numpy())
+
+    results = [None] * len(modules)
+
+    def run(i):
+        for _ in range(10):
+            modules[i].run(data=inputs[i])
+        results[i] = modules[i].get_output(0).numpy()
+
+    threads = [threading.Thread(target=run, args=(i,)) for i in range(len(modules))]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    for result, ref_out in zip(results, expected):
+        tvm.testing.assert_allclose(result, ref_out, rtol=1e-5)
+
+
+@pytest.mark.parametrize("size", [8, 32])
+def test_matches_graph_executor(size):
+    mod, params = _conv_model(size=size)
+    data = np.random.uniform(-1, 1, (1, 3, size, size)).astype("float32")
+    dev = tvm.cpu(0)
+    gmod = _graph_module(mod, params, dev)
+    amod = aot_executor.AotModule(_export_and_load(_build(mod, params), "aot.so")["default"](dev))
+    gmod.run(data=data)
+    amod.run(data=data)
+    tvm.testing.assert_allclose(amod.get_output(0).numpy(), gmod.get_output(0).numpy(), rtol=1e-5)
+
+
+if __name__ == "__main__":
+    sys.exit(pytest.main([__file__] + sys.argv[1:]))
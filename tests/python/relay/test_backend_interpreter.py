@@ -126,6 +126,44 @@ def test_loop():
     check_eval(sum_up, [i_data, accum_data], sum(range(1, 11)), mod=mod)
 
 
+def test_list_processing():
+    mod = tvm.IRModule()
+    p = relay.prelude.Prelude(mod)
+    _, cons, nil = mod.get_type("List")
+    list_map = mod.get_global_var("map")
+    foldl = mod.get_global_var("foldl")
+
+    # make_list(i) = [i - 1, ..., 1, 0]
+    make_list = relay.GlobalVar("make_list")
+    i = relay.var("i", shape=[], dtype="int32")
+    sb = ScopeBuilder()
+    with sb.if_scope(relay.equal(i, relay.const(0, "int32"))):
+        sb.ret(nil())
+    with sb.else_scope():
+        one_less = relay.subtract(i, relay.const(1, "int32"))
+        sb.ret(cons(one_less, relay.Call(make_list, [one_less])))
+    mod[make_list] = relay.Function([i], sb.get())
+
+    x = relay.var("x", shape=[], dtype="int32")
+    double = relay.Function([x], relay.add(x, x))
+    a = relay.var("a", shape=[], dtype="int32")
+    b = relay.var("b", shape=[], dtype="int32")
+    add = relay.Function([a, b], relay.add(a, b))
+    n = relay.var("n", shape=[], dtype="int32")
+    mod["main"] = relay.Function(
+        [n], foldl(add, relay.const(0, "int32"), list_map(double, relay.Call(make_list, [n])))
+    )
+
+    length = 200
+    n_data = np.array(length, dtype="int32")
+    expected = length * (length - 1)
+    dev = tvm.cpu()
+    target = tvm.target.Target("llvm")
+    for kind in ["debug", "vm"]:
+        func = relay.create_executor(kind, mod=mod, device=dev, target=target).evaluate()
+        testing.assert_allclose(func(n_data).numpy(), expected)
+
+
 def test_ref():
     mod = tvm.IRModule()
     three_with_ref = relay.GlobalVar("three_with_ref")
@@ -17,12 +17,14 @@
 """Unit tests for JSON codegen and runtime."""
 import os
 import sys
+import threading
 
 import numpy as np
 
 import tvm
 import tvm.relay.op as reg
 import tvm.relay.testing
+import tvm.topi.testing
 from tvm import relay, runtime
 from tvm.contrib import utils
 from tvm.relay import transform
@@ -713,6 +715,99 @@ def test_partial_constant():
     check_result(mod, ref_mod, {"in_2": data2, "in_4": data4}, (10, 10), tol=1e-5)
 
 
+def test_dynamic_batch():
+    """Test calling a subgraph with batch sizes other than the one it was built for."""
+    if not tvm.get_global_func("runtime.DNNLJSONRuntimeCreate", True):
+        print("skip because DNNL codegen is not available")
+        return
+
+    dtype = "float32"
+    ishape = (1, 8, 14, 14)
+    wshape = (16, 8, 3, 3)
+    w_data = np.random.uniform(0, 1, wshape).astype(dtype)
+
+    # The conv2d output may be in a blocked layout which is consumed by relu as is.
+    data0 = relay.var("data", shape=ishape, dtype=dtype)
+    out = relay.nn.conv2d(data0, relay.const(w_data), kernel_size=(3, 3), padding=(1, 1))
+    out = relay.nn.relu(out)
+    func = relay.Function([data0], out)
+    func = set_func_attr(func, "dnnl", "tvmgen_default_dnnl_0")
+    glb_var = relay.GlobalVar("tvmgen_default_dnnl_0")
+    mod = tvm.IRModule()
+    mod[glb_var] = func
+    data = relay.var("data", shape=ishape, dtype=dtype)
+    mod["main"] = relay.Function([data], glb_var(data))
+    mod = transform.InferType()(mod)
+
+    te_compiler.get().clear()
+    with tvm.transform.PassContext(opt_level=3):
+        lib = relay.build(mod, target="llvm")
+    dnnl_func = lib.get_lib()["tvmgen_default_dnnl_0"]
+
+    # Revisit a batch size to hit the cached primitives.
+    for batch in [1, 4, 2, 4]:
+        i_data = np.random.uniform(0, 1, (batch,) + ishape[1:]).astype(dtype)
+        out = tvm.nd.empty((batch, 16, 14, 14), dtype=dtype)
+        dnnl_func(tvm.nd.array(i_data), out)
+        ref = tvm.topi.testing.conv2d_nchw_python(i_data, w_data, 1, 1)
+        tvm.testing.assert_allclose(out.numpy(), np.maximum(ref, 0), rtol=1e-5, atol=1e-5)
+
+
+def test_concurrent_calls():
+    """Test calling one subgraph from several threads at once."""
+    if not tvm.get_global_func("runtime.DNNLJSONRuntimeCreate", True):
+        print("skip because DNNL codegen is not available")
+        return
+
+    dtype = "float32"
+    ishape = (1, 8, 14, 14)
+    wshape = (16, 8, 3, 3)
+    w_data = np.random.uniform(0, 1, wshape).astype(dtype)
+
+    data0 = relay.var("data", shape=ishape, dtype=dtype)
+    out = relay.nn.conv2d(data0, relay.const(w_data), kernel_size=(3, 3), padding=(1, 1))
+    out = relay.nn.relu(out)
+    func = relay.Function([data0], out)
+    func = set_func_attr(func, "dnnl", "tvmgen_default_dnnl_0")
+    glb_var = relay.GlobalVar("tvmgen_default_dnnl_0")
+    mod = tvm.IRModule()
+    mod[glb_var] = func
+    data = relay.var("data", shape=ishape, dtype=dtype)
+    mod["main"] = relay.Function([data], glb_var(data))
+    mod = transform.InferType()(mod)
+
+    te_compiler.get().clear()
+    with tvm.transform.PassContext(opt_level=3):
+        lib = relay.build(mod, target="llvm")
+    dnnl_func = lib.get_lib()["tvmgen_default_dnnl_0"]
+
+    # Each thread has its own inputs, and some threads share a batch size.
+    num_threads = 8
+    num_calls = 20
+    batches = [1 + i % 3 for i in range(num_threads)]
+    inputs = [np.random.uniform(0, 1, (batch,) + ishape[1:]).astype(dtype) for batch in batches]
+    expected = [np.maximum(tvm.topi.testing.conv2d_nchw_python(i, w_data, 1, 1), 0) for i in inputs]
+    outputs = [[] for _ in range(num_threads)]
+
+    def run(index):
+        i_data = tvm.nd.array(inputs[index])
+        for _ in range(num_calls):
+            out = tvm.nd.empty((batches[index], 16, 14, 14), dtype=dtype)
+            dnnl_func(i_data, out)
+            outputs[index].append(out.numpy())
+
+    threads = [threading.Thread(target=run, args=(i,)) for i in range(num_threads)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+
+    for index in range(num_threads):
+        assert len(outputs[index]) == num_calls
+        for out in outputs[index]:
+            tvm.testing.assert_allclose(out, expected[index], rtol=1e-5, atol=1e-5)
+
+
 if __name__ == "__main__":
     test_conv2d()
     test_add()
@@ -724,3 +819,5 @@ if __name__ == "__main__":
     test_composite()
     test_constant()
     test_partial_constant()
+    test_dynamic_batch()
+    test_concurrent_calls()
@@ -35,12 +35,12 @@ def check_memory_plan(func, check_fn):
     # TODO(mbs): Why does the executor need to be shared? Seems wrong.
     ex = relay.create_executor("vm", mod)
 
-    # Compute without memory planning.
-    no_plan_result = ex.evaluate()(*args)
-
     # Compute with memory planning.
+    plan_result = ex.evaluate()(*args)
+
+    # Compute without memory planning.
     with tvm.transform.PassContext(opt_level=1, disabled_pass=["MemoryPlan"]):
-        plan_result = ex.evaluate()(*args)
+        no_plan_result = ex.evaluate()(*args)
 
     # Compute Python result.
     py_res = check_fn(*[arg.numpy() for arg in args])
@@ -116,7 +116,74 @@ def test_no_fuse():
     check_memory_plan(func, check_no_fuse)
 
 
+def static_storage(mod):
+    """Return the number and total size of the storages main allocates with a constant size."""
+    alloc_storage = relay.op.get("memory.alloc_storage")
+    on_device = relay.op.get("on_device")
+    sizes = []
+
+    def visit(node):
+        if isinstance(node, relay.Call) and node.op == alloc_storage:
+            size = node.args[0]
+            if isinstance(size, relay.Call) and size.op == on_device:
+                size = size.args[0]
+            if isinstance(size, relay.Constant):
+                sizes.append(int(size.data.numpy()))
+
+    relay.analysis.post_order_visit(mod["main"], visit)
+    return len(sizes), sum(sizes)
+
+
+def test_coalesce_and_reuse():
+    # Each dense is an operator of its own, so each allocates its output.
+    x = relay.var("x", shape=(8, 64))
+    weights = [relay.var("w%d" % i, shape=(64, 64)) for i in range(6)]
+    y = x
+    for w in weights:
+        y = relay.nn.relu(relay.nn.dense(y, w))
+    func = relay.Function([x] + weights, y)
+    mod = tvm.IRModule.from_expr(func)
+
+    planned, _ = relay.vm.VMCompiler().optimize(mod, target="llvm")
+    with tvm.transform.PassContext(disabled_pass=["MemoryPlan"]):
+        unplanned, _ = relay.vm.VMCompiler().optimize(mod, target="llvm")
+    num_planned, planned_bytes = static_storage(planned)
+    num_unplanned, unplanned_bytes = static_storage(unplanned)
+    # The five intermediates alternate between two halves of a region, the output has its own.
+    assert num_unplanned >= 6
+    assert num_planned <= num_unplanned - 4
+    assert planned_bytes <= unplanned_bytes // 2
+
+    def check_dense_chain(x, *weights):
+        for w in weights:
+            x = np.maximum(np.matmul(x, np.transpose(w)), 0)
+        return x
+
+    check_memory_plan(func, check_dense_chain)
+
+
+def test_if():
+    x = relay.var("x", shape=(16,))
+    cond = relay.var("cond", shape=(), dtype="bool")
+    y = relay.add(x, x)
+    z = relay.If(cond, relay.multiply(y, y), relay.subtract(y, x))
+    func = relay.Function([x, cond], relay.add(z, y))
+    mod = tvm.IRModule.from_expr(func)
+    x_data = np.random.rand(16).astype("float32")
+    for cond_data in [True, False]:
+        args = [tvm.nd.array(x_data), tvm.nd.array(np.array(cond_data))]
+        plan_result = relay.create_executor("vm", mod).evaluate()(*args)
+        with tvm.transform.PassContext(opt_level=1, disabled_pass=["MemoryPlan"]):
+            no_plan_result = relay.create_executor("vm", mod).evaluate()(*args)
+        y_data = x_data + x_data
+        expected = (y_data * y_data if cond_data else y_data - x_data) + y_data
+        np.testing.assert_allclose(plan_result.numpy(), no_plan_result.numpy())
+        np.testing.assert_allclose(plan_result.numpy(), expected, rtol=1e-6)
+
+
 if __name__ == "__main__":
     test_tyck_alloc_tensor()
     test_add()
     test_add_sub()
+    test_coalesce_and_reuse()
+    test_if()
@@ -622,6 +622,47 @@ def test_nll_loss(dev, target):
     _verify((10, 5), dtype="float64")
 
 
+@tvm.testing.parametrize_targets("llvm")
+def test_embedding_bag(dev, target):
+    def _ref(weight_np, indices_np, offsets_np, mode, scale):
+        ends = list(offsets_np[1:]) + [len(indices_np)]
+        out = np.zeros((len(offsets_np), weight_np.shape[1]), dtype="float32")
+        for b, (begin, end) in enumerate(zip(offsets_np, ends)):
+            rows = weight_np[indices_np[begin:end]].astype("float32")
+            if end > begin:
+                out[b] = rows.sum(axis=0) if mode == "sum" else rows.mean(axis=0)
+        return out * scale
+
+    def _verify(num_rows, dim, bag_sizes, dtype, index_dtype, mode, scale=1.0):
+        weight_np = np.random.uniform(-1, 1, (num_rows, dim))
+        weight_np = (weight_np * 100 if dtype == "int8" else weight_np).astype(dtype)
+        offsets_np = np.cumsum([0] + bag_sizes[:-1]).astype(index_dtype)
+        indices_np = np.random.randint(0, num_rows, sum(bag_sizes)).astype(index_dtype)
+        out_np = _ref(weight_np, indices_np, offsets_np, mode, scale)
+
+        weight = relay.var("weight", relay.TensorType(weight_np.shape, dtype))
+        indices = relay.var("indices", relay.TensorType(indices_np.shape, index_dtype))
+        offsets = relay.var("offsets", relay.TensorType(offsets_np.shape, index_dtype))
+        out = relay.nn.contrib_embedding_bag(weight, indices, offsets, mode, scale)
+        checked = run_infer_type(out)
+        assert checked.checked_type == relay.ty.TensorType((len(bag_sizes), dim), "float32")
+        func = relay.Function([weight, indices, offsets], out)
+        # The contrib.sparse kernel is only used when the target links it.
+        targets = [target]
+        if tvm.get_global_func("tvm.contrib.sparse.embedding_bag", True):
+            targets.append(target + " -libs=sparse")
+        for tgt in targets:
+            out_relay = relay.create_executor("graph", device=dev, target=tgt).evaluate(func)(
+                weight_np, indices_np, offsets_np
+            )
+            tvm.testing.assert_allclose(out_relay.numpy(), out_np, rtol=1e-3, atol=1e-3)
+
+    _verify(100, 16, [3, 0, 5, 1], "float32", "int32", "sum")
+    _verify(100, 16, [3, 0, 5, 1], "float32", "int64", "mean")
+    _verify(1000, 64, [20] * 32, "float16", "int64", "sum")
+    _verify(1000, 33, [7, 2, 0, 9], "int8", "int32", "mean", scale=0.01)
+
+
 if __name__ == "__main__":
     import sys
     import pytest
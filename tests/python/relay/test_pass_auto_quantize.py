@@ -136,6 +136,35 @@ def test_calibrate_percentile():
         relay.quantize.quantize(mod, params, dataset)
 
 
+@pytest.mark.parametrize("calibrate_mode", ["kl_divergence", "percentile"])
+def test_calibrate_streaming(calibrate_mode):
+    mod, params = testing.synthetic.get_workload()
+    dataset = get_calibration_dataset(mod, "data")
+    with relay.quantize.qconfig(calibrate_mode=calibrate_mode, calibrate_streaming=True):
+        relay.quantize.quantize(mod, params, dataset)
+
+
+def test_calibration_stats():
+    from tvm.relay.quantize import _quantize
+    from tvm.relay.quantize.kl_divergence import _find_scale_by_kl
+
+    # The histogram of a single batch matches the one of the offline kl_divergence.
+    data = np.random.normal(size=(10000,)).astype("float32")
+    stats = _quantize.CalibrationStats(1, 8001)
+    _quantize.CalibrationStatsUpdate(stats, [tvm.nd.array(data)])
+    threshold = _quantize.CalibrationStatsFindThresholds(stats, "kl_divergence", 255, 0.99999)
+    np.testing.assert_allclose(threshold[0].value, _find_scale_by_kl(data), rtol=1e-2)
+
+    # Batches with a growing range re-bin the histogram.
+    batches = [np.random.normal(scale=s, size=(10000,)).astype("float32") for s in [1, 2, 4]]
+    stats = _quantize.CalibrationStats(1, 8001)
+    for batch in batches:
+        _quantize.CalibrationStatsUpdate(stats, [tvm.nd.array(batch)])
+    threshold = _quantize.CalibrationStatsFindThresholds(stats, "percentile", 255, 0.99)
+    expected = np.percentile(np.abs(np.concatenate(batches)), 99)
+    np.testing.assert_allclose(threshold[0].value, expected, rtol=1e-2)
+
+
 ####################################
 # Quant/Dequant Partitioning Tests #
 ####################################
@@ -411,6 +440,9 @@ if __name__ == "__main__":
     test_calibrate_target(True)
     test_calibrate_memory_bound()
     test_calibrate_percentile()
+    test_calibrate_streaming("kl_divergence")
+    test_calibrate_streaming("percentile")
+    test_calibration_stats()
 
     test_add_partition()
     test_conv2d_partition()
@@ -366,6 +366,41 @@ def test_fold_dropout():
     tvm.ir.assert_structural_equal(run_infer_type(before_mod["main"]), after_mod["main"])
 
 
+def test_fold_quantized_weights():
+    """Folds the weight quantization and layout transforms of a quantized network, which are
+    evaluated together."""
+    num_layers = 8
+    np.random.seed(0)
+    x = relay.var("x", shape=(1, 16, 8, 8), dtype="int8")
+    y = x
+    weights = []
+    for _ in range(num_layers):
+        w = np.random.uniform(-1, 1, (16, 16, 3, 3)).astype("float32")
+        scale = np.float32(np.abs(w).max() / 127)
+        weights.append(np.clip(np.round(w / scale), -127, 127).astype("int8").transpose(2, 3, 1, 0))
+        qw = relay.round(relay.const(w) / relay.const(scale))
+        qw = relay.cast(relay.clip(qw, -127, 127), "int8")
+        qw = relay.layout_transform(qw, "OIHW", "HWIO")
+        y = relay.nn.conv2d(y, qw, padding=(1, 1), kernel_layout="HWIO", out_dtype="int32")
+        y = relay.cast(relay.clip(relay.right_shift(y, relay.const(8)), -127, 127), "int8")
+    mod = tvm.IRModule.from_expr(relay.Function([x], y))
+    mod = relay.transform.InferType()(mod)
+
+    mod = relay.transform.FoldConstant()(mod)
+
+    convs = []
+
+    def visit(expr):
+        if isinstance(expr, relay.Call) and expr.op == relay.op.get("nn.conv2d"):
+            convs.append(expr)
+
+    relay.analysis.post_order_visit(mod["main"], visit)
+    assert len(convs) == num_layers
+    for conv, expected in zip(convs, weights):
+        assert isinstance(conv.args[1], relay.Constant)
+        np.testing.assert_array_equal(conv.args[1].data.numpy(), expected)
+
+
 if __name__ == "__main__":
     import sys
     import pytest
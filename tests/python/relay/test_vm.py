@@ -1112,6 +1112,30 @@ def test_multi_targets():
     tvm.testing.assert_allclose(actual_result.numpy(), expected_result)
 
 
+def test_batching_server():
+    x = relay.var("x", shape=(relay.Any(), 4), dtype="float32")
+    w = relay.const(np.random.uniform(-1, 1, (8, 4)).astype("float32"))
+    dense = relay.nn.dense(x, w)
+    mod = tvm.IRModule.from_expr(relay.Function([x], relay.Tuple([dense, relay.sum(x, axis=1)])))
+    exe = relay.vm.compile(mod, "llvm")
+    vm = runtime.vm.VirtualMachine(exe, tvm.cpu())
+    server = runtime.vm.BatchingServer(vm, max_batch_size=8, timeout_us=100000)
+
+    inputs = [np.random.uniform(-1, 1, (1 + i % 3, 4)).astype("float32") for i in range(8)]
+    futures = [server.submit(data) for data in inputs]
+    for data, future in zip(inputs, futures):
+        dense_out, sum_out = future.result()
+        tvm.testing.assert_allclose(dense_out.numpy(), data @ w.data.numpy().T, rtol=1e-5)
+        tvm.testing.assert_allclose(sum_out.numpy(), data.sum(axis=1), rtol=1e-5)
+    # 15 rows run in batches of at most 8 rows.
+    assert 2 <= server.num_batches < len(inputs)
+
+    dense_out, _ = server.infer(inputs[0])
+    tvm.testing.assert_allclose(dense_out.numpy(), inputs[0] @ w.data.numpy().T, rtol=1e-5)
+    with pytest.raises(tvm.TVMError):
+        server.infer(np.zeros((2, 3), "float32"))
+
+
 if __name__ == "__main__":
     import sys
 
@@ -392,6 +392,36 @@ def test_sparse_dense_bsr_relu(dev, target):
     verify_sparse_dense_bsr(M, N, K, BS_R, BS_C, density, False, dev, target)
 
 
+@tvm.testing.parametrize_targets("llvm")
+def test_sparse_dense_bsr_contrib(dev, target):
+    if not tvm.get_global_func("tvm.contrib.sparse.bsr_dense", True):
+        print("skip because contrib.sparse is not enabled...")
+        return
+    for M, (BS_R, BS_C) in [(1, (1, 1)), (37, (4, 1)), (128, (16, 1)), (9, (8, 2))]:
+        N, K, density = 64, 128, 0.3
+        X_np = np.random.randn(M, K).astype("float32")
+        W_sp_np = random_bsr_matrix(N, K, BS_R, BS_C, density=density, dtype="float32")
+        Y_np = X_np @ W_sp_np.todense().T
+
+        W_data = te.placeholder(shape=W_sp_np.data.shape, dtype="float32")
+        W_indices = te.placeholder(shape=W_sp_np.indices.shape, dtype="int32")
+        W_indptr = te.placeholder(shape=W_sp_np.indptr.shape, dtype="int32")
+        X = te.placeholder(shape=X_np.shape, dtype="float32")
+        with tvm.target.Target(target):
+            Y = topi.x86.sparse_dense_bsr_contrib(X, W_data, W_indices, W_indptr)
+            s = topi.x86.schedule_sparse_dense_bsr_contrib([Y])
+            func = tvm.build(s, [X, W_data, W_indices, W_indptr, Y])
+        Y_tvm = tvm.nd.array(np.zeros(Y_np.shape, dtype="float32"), device=dev)
+        func(
+            tvm.nd.array(X_np, device=dev),
+            tvm.nd.array(W_sp_np.data, device=dev),
+            tvm.nd.array(W_sp_np.indices.astype("int32"), device=dev),
+            tvm.nd.array(W_sp_np.indptr.astype("int32"), device=dev),
+            Y_tvm,
+        )
+        tvm.testing.assert_allclose(Y_tvm.numpy(), Y_np, atol=1e-4, rtol=1e-4)
+
+
 def test_sparse_dense_bsr_reverse():
     M, N, K, BS_R, BS_C, density = 1, 64, 128, 8, 16, 0.9
     X_np = np.random.randn(M, K).astype("float32")
@@ -0,0 +1,100 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+"""Tests for the binary graph format of the C runtime graph executor."""
+
+import struct
+import sys
+
+import pytest
+
+from tvm.micro import graph_binary
+
+GRAPH = {
+    "nodes": [
+        {"op": "null", "name": "x", "inputs": []},
+        {"op": "null", "name": "p0", "inputs": []},
+        {
+            "op": "tvm_op",
+            "name": "tvmgen_default_fused_add",
+            "attrs": {
+                "num_outputs": "1",
+                "num_inputs": "2",
+                "flatten_data": "0",
+                "func_name": "tvmgen_default_fused_add",
+            },
+            "inputs": [[0, 0, 0], [1, 0, 0]],
+        },
+    ],
+    "arg_nodes": [0, 1],
+    "heads": [[2, 0, 0]],
+    "attrs": {
+        "dltype": ["list_str", ["float32", "float32", "float16"]],
+        "device_index": ["list_int", [1, 1, 1]],
+        "storage_id": ["list_int", [0, 1, 0]],
+        "shape": ["list_shape", [[10, 5], [1, 5], [10, 6]]],
+    },
+    "node_row_ptr": [0, 1, 2, 3],
+}
+
+
+def test_header():
+    binary = graph_binary.compile_graph_binary(GRAPH)
+    assert len(binary) % 8 == 0
+    header = struct.unpack_from("<QIIIIIIIIII", binary)
+    magic, version, max_ndim, nodes, inputs, outputs, node_inputs, entries, storage = header[:9]
+    assert magic == graph_binary.GRAPH_BINARY_MAGIC
+    assert binary[:8] == b"TVMGRAPH"
+    assert version == graph_binary.GRAPH_BINARY_VERSION
+    assert max_ndim == graph_binary.DEFAULT_MAX_NDIM
+    assert (nodes, inputs, outputs, node_inputs, entries, storage) == (3, 2, 1, 2, 3, 2)
+    # The strings section ends the binary.
+    assert binary.rstrip(b"\0").endswith(b"tvmgen_default_fused_add")
+
+
+def test_storage_plan():
+    binary = graph_binary.compile_graph_binary(GRAPH, max_ndim=4)
+    storage = struct.Struct("<QIi")
+    offset = binary.rindex(b"\0x\0") - 2 * storage.size
+    # Storage 0 holds entries 0 and 2, sized by the larger one and shaped by the last one.
+    assert storage.unpack_from(binary, offset) == (10 * 5 * 4, 2, 1)
+    assert storage.unpack_from(binary, offset + storage.size) == (1 * 5 * 4, 1, 1)
+
+
+def test_max_ndim():
+    with pytest.raises(ValueError):
+        graph_binary.compile_graph_binary(GRAPH, max_ndim=1)
+
+
+def test_arena_sizes():
+    binary = graph_binary.compile_graph_binary(GRAPH)
+    sizes = graph_binary.arena_sizes(binary)
+    # Storage is 200 and 20 bytes, each aligned to the arena alignment.
+    assert sizes == {"storage_size": 208 + 32, "num_storage": 2, "num_entries": 3, "num_nodes": 3}
+
+
+def test_emit_c_array():
+    binary = graph_binary.compile_graph_binary(GRAPH)
+    source = graph_binary.emit_c_array(binary, "graph")
+    assert f"const uint64_t graph[{len(binary) // 8}] = {{" in source
+    assert "0x48504152474d5654ULL" in source
+    assert "const size_t graph_size = sizeof(graph);" in source
+    assert "#define GRAPH_STORAGE_SIZE 240" in source
+
+
+if __name__ == "__main__":
+    sys.exit(pytest.main([__file__] + sys.argv[1:]))